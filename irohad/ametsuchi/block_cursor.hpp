@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_CURSOR_HPP
+#define IROHA_BLOCK_CURSOR_HPP
+
+#include <deque>
+
+#include <boost/optional.hpp>
+#include "ametsuchi/block_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Lazily iterates over consecutive blocks of a block query, starting from
+     * a given height up to the top block at the moment of cursor creation.
+     * Blocks are read in small batches, so at most read_ahead blocks are held
+     * by the cursor regardless of the length of the chain.
+     */
+    class BlockCursor {
+     public:
+      /// Number of blocks read from the block query at once by default
+      static const uint32_t kDefaultReadAhead = 8;
+
+      /**
+       * @param block_query - source of blocks, must outlive the cursor
+       * @param height - height of the first block
+       * @param read_ahead - maximum number of blocks read at once
+       */
+      BlockCursor(BlockQuery &block_query,
+                  shared_model::interface::types::HeightType height,
+                  uint32_t read_ahead = kDefaultReadAhead);
+
+      /**
+       * Get the next block. Blocks which cannot be read from the storage are
+       * skipped, same as in BlockQuery::getBlocks
+       * @return next block or boost::none if there are no blocks left
+       */
+      boost::optional<std::shared_ptr<shared_model::interface::Block>> next();
+
+     private:
+      BlockQuery &block_query_;
+      shared_model::interface::types::HeightType next_height_;
+      const shared_model::interface::types::HeightType last_height_;
+      const uint32_t read_ahead_;
+
+      std::deque<std::shared_ptr<shared_model::interface::Block>> buffer_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_CURSOR_HPP
@@ -26,6 +26,19 @@ namespace iroha {
       using wBlock = std::shared_ptr<shared_model::interface::Block>;
 
      public:
+      /// error of a block lookup
+      struct GetBlockError {
+        enum class Code {
+          /// no block with the requested attributes
+          kNoBlock,
+          /// storage failed to perform the lookup
+          kInternalError
+        };
+
+        Code code;
+        std::string message;
+      };
+
       virtual ~BlockQuery() = default;
 
       /**
@@ -70,11 +83,31 @@ namespace iroha {
       virtual boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) = 0;
 
+      /**
+       * Synchronously checks whether transactions with given hashes are
+       * present in any block with a single storage query
+       * @param hashes - transactions' hashes
+       * @return statuses (Committed, Rejected or Missing) of the transactions
+       * in the order of hashes if storage query was successful, boost::none
+       * otherwise
+       */
+      virtual boost::optional<std::vector<TxCacheStatusType>> checkTxsPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) = 0;
+
       /**
        * Get the top-most block
        * @return result of Model Block or error message
        */
       virtual expected::Result<wBlock, std::string> getTopBlock() = 0;
+
+      /**
+       * Get block with given hash
+       * @param hash - hash of the block
+       * @return result of Model Block, or error with kNoBlock code if there is
+       * no such block, or with kInternalError code if storage failed
+       */
+      virtual expected::Result<wBlock, GetBlockError> getBlockByHash(
+          const shared_model::crypto::Hash &hash) = 0;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
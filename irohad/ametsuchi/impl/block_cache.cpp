@@ -0,0 +1,76 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockCache::BlockCache(size_t capacity)
+        : capacity_(capacity), hits_(0), misses_(0) {}
+
+    void BlockCache::insert(BlockType block) {
+      if (capacity_ == 0) {
+        return;
+      }
+      // hashes are evaluated lazily, so they are computed before the block
+      // becomes visible to concurrent readers
+      block->hash();
+      for (const auto &tx : block->transactions()) {
+        tx.hash();
+      }
+
+      const auto height = block->height();
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto found = index_.find(height);
+      if (found != index_.end()) {
+        lru_.erase(found->second);
+        index_.erase(found);
+      }
+      lru_.push_front(std::move(block));
+      index_.emplace(height, lru_.begin());
+      if (lru_.size() > capacity_) {
+        index_.erase(lru_.back()->height());
+        lru_.pop_back();
+      }
+    }
+
+    boost::optional<BlockCache::BlockType> BlockCache::get(
+        shared_model::interface::types::HeightType height) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto found = index_.find(height);
+      if (found == index_.end()) {
+        ++misses_;
+        return boost::none;
+      }
+      ++hits_;
+      lru_.splice(lru_.begin(), lru_, found->second);
+      return *found->second;
+    }
+
+    void BlockCache::clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      index_.clear();
+      lru_.clear();
+    }
+
+    size_t BlockCache::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return lru_.size();
+    }
+
+    uint64_t BlockCache::hits() const {
+      return hits_;
+    }
+
+    uint64_t BlockCache::misses() const {
+      return misses_;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_CACHE_HPP
+#define IROHA_BLOCK_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/types.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Size-bounded LRU cache of deserialized blocks keyed by height. The cache
+     * is shared by all block readers of a storage, so cached blocks are
+     * shared between them and must not be modified.
+     */
+    class BlockCache {
+     public:
+      using BlockType = std::shared_ptr<shared_model::interface::Block>;
+
+      /// Number of blocks kept by default
+      static const size_t kDefaultCapacity = 16;
+
+      /**
+       * @param capacity - maximum number of cached blocks
+       */
+      explicit BlockCache(size_t capacity = kDefaultCapacity);
+
+      /**
+       * Put block to the cache, replacing a block with the same height. The
+       * least recently used block is evicted if the cache is full
+       * @param block - block to insert
+       */
+      void insert(BlockType block);
+
+      /**
+       * Get block with given height and mark it as recently used
+       * @param height - height of the block
+       * @return block, if it is cached
+       */
+      boost::optional<BlockType> get(
+          shared_model::interface::types::HeightType height);
+
+      /**
+       * Remove all blocks from the cache
+       */
+      void clear();
+
+      /**
+       * @return number of cached blocks
+       */
+      size_t size() const;
+
+      /**
+       * @return number of get() calls which found the block
+       */
+      uint64_t hits() const;
+
+      /**
+       * @return number of get() calls which did not find the block
+       */
+      uint64_t misses() const;
+
+     private:
+      using LruList = std::list<BlockType>;
+
+      const size_t capacity_;
+
+      /// blocks ordered from the most recently used to the least
+      LruList lru_;
+      std::unordered_map<shared_model::interface::types::HeightType,
+                         LruList::iterator>
+          index_;
+      mutable std::mutex mutex_;
+
+      std::atomic<uint64_t> hits_;
+      std::atomic<uint64_t> misses_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_CACHE_HPP
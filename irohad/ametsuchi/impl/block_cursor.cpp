@@ -0,0 +1,40 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/block_cursor.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockCursor::BlockCursor(BlockQuery &block_query,
+                             shared_model::interface::types::HeightType height,
+                             uint32_t read_ahead)
+        : block_query_(block_query),
+          next_height_(height),
+          last_height_(block_query_.getTopBlockHeight()),
+          read_ahead_(std::max(read_ahead, 1u)) {}
+
+    boost::optional<std::shared_ptr<shared_model::interface::Block>>
+    BlockCursor::next() {
+      while (buffer_.empty() and next_height_ <= last_height_) {
+        const auto count = static_cast<uint32_t>(std::min<uint64_t>(
+            read_ahead_, uint64_t{last_height_} - next_height_ + 1));
+        auto blocks = block_query_.getBlocks(next_height_, count);
+        std::move(blocks.begin(), blocks.end(), std::back_inserter(buffer_));
+        next_height_ += count;
+      }
+      if (buffer_.empty()) {
+        return boost::none;
+      }
+      auto block = std::move(buffer_.front());
+      buffer_.pop_front();
+      return block;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -5,6 +5,7 @@
 
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
 
+#include <boost/format.hpp>
 #include <boost/variant/apply_visitor.hpp>
 #include "ametsuchi/impl/peer_query_wsv.hpp"
 #include "ametsuchi/impl/postgres_block_index.hpp"
@@ -42,38 +43,47 @@ namespace iroha {
       *sql_ << "BEGIN";
     }
 
-    bool MutableStorageImpl::apply(
-        std::shared_ptr<const shared_model::interface::Block> block,
-        MutableStoragePredicate predicate) {
+    bool MutableStorageImpl::execute(
+        const shared_model::interface::Block &block) {
       auto execute_transaction = [this](auto &transaction) {
         command_executor_->setCreatorAccountId(transaction.creatorAccountId());
         command_executor_->doValidation(false);
 
-        auto execute_command = [this](const auto &command) {
-          auto command_applied =
-              boost::apply_visitor(*command_executor_, command.get());
-
-          return command_applied.match(
-              [](expected::Value<void> &) { return true; },
-              [&](expected::Error<CommandError> &e) {
-                log_->error(e.error.toString());
-                return false;
-              });
-        };
-
-        return std::all_of(transaction.commands().begin(),
-                           transaction.commands().end(),
-                           execute_command);
+        for (const auto &command : transaction.commands()) {
+          // the command is queued, and its result is checked with the batch
+          boost::apply_visitor(*command_executor_, command.get());
+        }
       };
 
+      // commands of the whole block are sent in a single round trip
+      command_executor_->startBatch();
+      std::for_each(block.transactions().begin(),
+                    block.transactions().end(),
+                    execute_transaction);
+      return command_executor_->executeBatch().match(
+          [](expected::Value<void> &) { return true; },
+          [&](expected::Error<BatchCommandError> &e) {
+            log_->error("{} {} of the block failed: {}",
+                        e.error.is_command_error ? "Command"
+                                                 : "Statement before command",
+                        e.error.command_index,
+                        e.error.error.toString());
+            return false;
+          });
+    }
+
+    bool MutableStorageImpl::apply(
+        std::shared_ptr<const shared_model::interface::Block> block,
+        MutableStoragePredicate predicate) {
       log_->info("Applying block: height {}, hash {}",
                  block->height(),
                  block->hash().hex());
 
-      auto block_applied = predicate(block, *peer_query_, top_hash_)
-          and std::all_of(block->transactions().begin(),
-                          block->transactions().end(),
-                          execute_transaction);
+      if (not predicate(block, *peer_query_, top_hash_)) {
+        return false;
+      }
+
+      auto block_applied = execute(*block);
       if (block_applied) {
         block_storage_->insert(block);
         block_index_->index(*block);
@@ -123,6 +133,40 @@ namespace iroha {
       });
     }
 
+    bool MutableStorageImpl::replay(const shared_model::interface::Block &block,
+                                    bool index) {
+      return withSavepoint([&] {
+        log_->info("Replaying block: height {}, hash {}",
+                   block.height(),
+                   block.hash().hex());
+        if (not execute(block)) {
+          return false;
+        }
+        if (index) {
+          block_index_->index(block);
+        }
+        top_hash_ = block.hash();
+        return true;
+      });
+    }
+
+    void MutableStorageImpl::index(
+        const shared_model::interface::Block &block) {
+      block_index_->index(block);
+      top_hash_ = block.hash();
+    }
+
+    expected::Result<void, std::string> MutableStorageImpl::commitReplayed() {
+      try {
+        *sql_ << "COMMIT";
+        committed = true;
+        return {};
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            (boost::format("Failed to commit blocks: %s") % e.what()).str());
+      }
+    }
+
     MutableStorageImpl::~MutableStorageImpl() {
       if (not committed) {
         try {
@@ -11,6 +11,7 @@
 #include <soci/soci.h>
 #include "ametsuchi/block_storage.hpp"
 #include "ametsuchi/command_executor.hpp"
+#include "common/result.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "logger/logger_fwd.hpp"
 #include "logger/logger_manager_fwd.hpp"
@@ -40,6 +41,30 @@ namespace iroha {
                      std::shared_ptr<shared_model::interface::Block>> blocks,
                  MutableStoragePredicate predicate) override;
 
+      /**
+       * Apply the block, which is already in the block store, so it is not
+       * passed to the block storage of the mutable storage
+       * @param block - block to apply
+       * @param index - whether to add the block to the block index, false if
+       * the index already contains it
+       * @return true if the block is applied
+       */
+      bool replay(const shared_model::interface::Block &block, bool index);
+
+      /**
+       * Add the block, which is already in the block store, to the block
+       * index without applying its commands
+       * @param block - block to index
+       */
+      void index(const shared_model::interface::Block &block);
+
+      /**
+       * Commit the replayed and indexed blocks. Unlike the commit of the
+       * storage, the blocks are not stored, since they are already there
+       * @return void on success, otherwise error message
+       */
+      expected::Result<void, std::string> commitReplayed();
+
       ~MutableStorageImpl() override;
 
      private:
@@ -58,12 +83,18 @@ namespace iroha {
       bool apply(std::shared_ptr<const shared_model::interface::Block> block,
                  MutableStoragePredicate predicate);
 
+      /**
+       * Executes commands of the block
+       * @return true if all of the commands succeeded
+       */
+      bool execute(const shared_model::interface::Block &block);
+
       shared_model::interface::types::HashType top_hash_;
 
       std::unique_ptr<soci::session> sql_;
       std::unique_ptr<PeerQuery> peer_query_;
       std::unique_ptr<BlockIndex> block_index_;
-      std::shared_ptr<CommandExecutor> command_executor_;
+      std::shared_ptr<PostgresCommandExecutor> command_executor_;
       std::unique_ptr<BlockStorage> block_storage_;
 
       bool committed;
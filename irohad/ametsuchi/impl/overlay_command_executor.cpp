@@ -0,0 +1,854 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/overlay_command_executor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/tuple/tuple.hpp>
+#include "ametsuchi/impl/postgres_connection.hpp"
+#include "common/visitor.hpp"
+#include "interfaces/commands/add_asset_quantity.hpp"
+#include "interfaces/commands/add_peer.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/append_role.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/create_asset.hpp"
+#include "interfaces/commands/create_domain.hpp"
+#include "interfaces/commands/create_role.hpp"
+#include "interfaces/commands/detach_role.hpp"
+#include "interfaces/commands/grant_permission.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/revoke_permission.hpp"
+#include "interfaces/commands/set_account_detail.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/commands/subtract_asset_quantity.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/transaction.hpp"
+#include "logger/logger.hpp"
+#include "utils/string_builder.hpp"
+
+namespace {
+  template <typename QueryArgsCallable>
+  iroha::expected::Error<iroha::ametsuchi::CommandError> makeCommandError(
+      std::string &&command_name,
+      const iroha::ametsuchi::CommandError::ErrorCodeType code,
+      QueryArgsCallable &&query_args) noexcept {
+    return iroha::expected::makeError(iroha::ametsuchi::CommandError{
+        std::move(command_name), code, query_args()});
+  }
+
+  /// query arguments are reported the same way as by the postgres executor
+  shared_model::detail::PrettyStringBuilder getQueryArgsStringBuilder() {
+    return shared_model::detail::PrettyStringBuilder().init("Query arguments");
+  }
+
+  /**
+   * Get the second field of the string, like split_part(str, delimiter, 2)
+   * of PostgreSQL does
+   */
+  std::string secondPart(const std::string &str, char delimiter) {
+    auto begin = str.find(delimiter);
+    if (begin == std::string::npos) {
+      return {};
+    }
+    ++begin;
+    return str.substr(begin, str.find(delimiter, begin) - begin);
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    OverlayCommandExecutor::OverlayCommandExecutor(soci::session &sql,
+                                                   CommandExecutor &fallback,
+                                                   logger::LoggerPtr log)
+        : sql_(sql),
+          fallback_(fallback),
+          do_validation_(true),
+          transaction_started_(false),
+          flushed_in_transaction_(false),
+          log_(std::move(log)) {}
+
+    void OverlayCommandExecutor::setCreatorAccountId(
+        const shared_model::interface::types::AccountIdType
+            &creator_account_id) {
+      creator_account_id_ = creator_account_id;
+      fallback_.setCreatorAccountId(creator_account_id);
+    }
+
+    void OverlayCommandExecutor::doValidation(bool do_validation) {
+      do_validation_ = do_validation;
+      fallback_.doValidation(do_validation);
+    }
+
+    template <typename CommandType>
+    CommandResult OverlayCommandExecutor::executeFallback(
+        const CommandType &command, const std::string &command_name) {
+      auto statement = flush();
+      if (not statement.empty()) {
+        try {
+          sql_ << statement;
+        } catch (const std::exception &e) {
+          log_->error("Failed to write changes before {}: {}",
+                      command_name,
+                      e.what());
+          return expected::makeError(CommandError{command_name, 1, e.what()});
+        }
+      }
+      auto result = fallback_(command);
+      dropCache();
+      return result;
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::AddAssetQuantity &command) {
+      auto &account_id = creator_account_id_;
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      int precision = command.amount().precision();
+
+      auto str_args = [&account_id, &asset_id, &amount, precision] {
+        return getQueryArgsStringBuilder()
+            .append("account_id", account_id)
+            .append("asset_id", asset_id)
+            .append("amount", amount)
+            .append("precision", std::to_string(precision))
+            .finalize();
+      };
+
+      try {
+        auto value = parseDecimal(amount);
+        if (not value) {
+          return makeCommandError("AddAssetQuantity", 1, str_args);
+        }
+        auto asset_precision = assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        auto &current = balance(account_id, asset_id);
+        auto new_value =
+            add(current.amount.value_or(Decimal{0, 0}), *value);
+        const bool fits_asset = fits(new_value, precision);
+        const bool has_perm = not do_validation_
+            or hasDomainOrGlobalPermission(
+                   shared_model::interface::permissions::Role::kAddAssetQty,
+                   shared_model::interface::permissions::Role::
+                       kAddDomainAssetQty,
+                   asset_id);
+
+        if (accountExists(account_id) and has_asset and fits_asset
+            and has_perm) {
+          setBalance(current, std::move(new_value), {account_id, asset_id});
+          return {};
+        }
+        // error codes are checked in the order of the prepared statement
+        if (not has_perm) {
+          return makeCommandError("AddAssetQuantity", 2, str_args);
+        }
+        if (not has_asset) {
+          return makeCommandError("AddAssetQuantity", 3, str_args);
+        }
+        if (not fits_asset) {
+          return makeCommandError("AddAssetQuantity", 4, str_args);
+        }
+        return makeCommandError("AddAssetQuantity", 1, str_args);
+      } catch (const std::exception &e) {
+        log_->error("Failed to read state of AddAssetQuantity: {}", e.what());
+        return makeCommandError("AddAssetQuantity", 1, str_args);
+      }
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::AddPeer &command) {
+      return executeFallback(command, "AddPeer");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::AddSignatory &command) {
+      return executeFallback(command, "AddSignatory");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::AppendRole &command) {
+      return executeFallback(command, "AppendRole");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::CreateAccount &command) {
+      return executeFallback(command, "CreateAccount");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::CreateAsset &command) {
+      return executeFallback(command, "CreateAsset");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::CreateDomain &command) {
+      return executeFallback(command, "CreateDomain");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::CreateRole &command) {
+      return executeFallback(command, "CreateRole");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::DetachRole &command) {
+      return executeFallback(command, "DetachRole");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::GrantPermission &command) {
+      return executeFallback(command, "GrantPermission");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::RemoveSignatory &command) {
+      return executeFallback(command, "RemoveSignatory");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::RevokePermission &command) {
+      return executeFallback(command, "RevokePermission");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::SetAccountDetail &command) {
+      return executeFallback(command, "SetAccountDetail");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::SetQuorum &command) {
+      return executeFallback(command, "SetQuorum");
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::SubtractAssetQuantity &command) {
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      uint32_t precision = command.amount().precision();
+
+      auto str_args = [&creator_account_id = creator_account_id_,
+                       &asset_id,
+                       &amount,
+                       precision] {
+        return getQueryArgsStringBuilder()
+            .append("creator_account_id", creator_account_id)
+            .append("asset_id", asset_id)
+            .append("amount", amount)
+            .append("precision", std::to_string(precision))
+            .finalize();
+      };
+
+      try {
+        auto value = parseDecimal(amount);
+        if (not value) {
+          return makeCommandError("SubtractAssetQuantity", 1, str_args);
+        }
+        auto asset_precision = assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        auto &current = balance(creator_account_id_, asset_id);
+        auto new_value =
+            subtract(current.amount.value_or(Decimal{0, 0}), *value);
+        const bool enough = new_value.value >= 0;
+        const bool has_perm = not do_validation_
+            or hasDomainOrGlobalPermission(
+                   shared_model::interface::permissions::Role::
+                       kSubtractAssetQty,
+                   shared_model::interface::permissions::Role::
+                       kSubtractDomainAssetQty,
+                   asset_id);
+
+        if (accountExists(creator_account_id_) and has_asset and enough
+            and has_perm) {
+          setBalance(current,
+                     std::move(new_value),
+                     {creator_account_id_, asset_id});
+          return {};
+        }
+        if (not has_perm) {
+          return makeCommandError("SubtractAssetQuantity", 2, str_args);
+        }
+        if (not has_asset) {
+          return makeCommandError("SubtractAssetQuantity", 3, str_args);
+        }
+        if (not enough) {
+          return makeCommandError("SubtractAssetQuantity", 4, str_args);
+        }
+        return makeCommandError("SubtractAssetQuantity", 1, str_args);
+      } catch (const std::exception &e) {
+        log_->error("Failed to read state of SubtractAssetQuantity: {}",
+                    e.what());
+        return makeCommandError("SubtractAssetQuantity", 1, str_args);
+      }
+    }
+
+    CommandResult OverlayCommandExecutor::operator()(
+        const shared_model::interface::TransferAsset &command) {
+      auto &src_account_id = command.srcAccountId();
+      auto &dest_account_id = command.destAccountId();
+      // both amounts of a transfer to the same account are written to one
+      // row by the prepared statement, which is left to the database
+      if (src_account_id == dest_account_id) {
+        return executeFallback(command, "TransferAsset");
+      }
+      auto &asset_id = command.assetId();
+      auto amount = command.amount().toStringRepr();
+      uint32_t precision = command.amount().precision();
+
+      auto str_args =
+          [&src_account_id, &dest_account_id, &asset_id, &amount, precision] {
+            return getQueryArgsStringBuilder()
+                .append("src_account_id", src_account_id)
+                .append("dest_account_id", dest_account_id)
+                .append("asset_id", asset_id)
+                .append("amount", amount)
+                .append("precision", std::to_string(precision))
+                .finalize();
+          };
+
+      try {
+        auto value = parseDecimal(amount);
+        if (not value) {
+          return makeCommandError("TransferAsset", 1, str_args);
+        }
+        const bool has_src = accountExists(src_account_id);
+        const bool has_dest = accountExists(dest_account_id);
+        auto asset_precision = assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        auto &src = balance(src_account_id, asset_id);
+        auto &dest = balance(dest_account_id, asset_id);
+        auto new_src = subtract(src.amount.value_or(Decimal{0, 0}), *value);
+        auto new_dest = add(*value, dest.amount.value_or(Decimal{0, 0}));
+        const bool enough = new_src.value >= 0;
+        const bool fits_asset = fits(new_dest, precision);
+        bool has_perm = true;
+        if (do_validation_) {
+          const bool dest_can_receive =
+              rolePermissions(dest_account_id)
+                  .test(shared_model::interface::permissions::Role::kReceive);
+          const bool can_transfer = creator_account_id_ != src_account_id
+              ? grantablePermissions(creator_account_id_, src_account_id)
+                    .test(shared_model::interface::permissions::Grantable::
+                              kTransferMyAssets)
+              : rolePermissions(creator_account_id_)
+                    .test(shared_model::interface::permissions::Role::
+                              kTransfer);
+          has_perm = dest_can_receive and can_transfer;
+        }
+
+        if (has_src and has_dest and has_asset and enough and fits_asset
+            and has_perm) {
+          setBalance(src, std::move(new_src), {src_account_id, asset_id});
+          setBalance(dest, std::move(new_dest), {dest_account_id, asset_id});
+          return {};
+        }
+        if (not has_perm) {
+          return makeCommandError("TransferAsset", 2, str_args);
+        }
+        if (not has_dest) {
+          return makeCommandError("TransferAsset", 4, str_args);
+        }
+        if (not has_src) {
+          return makeCommandError("TransferAsset", 3, str_args);
+        }
+        if (not has_asset) {
+          return makeCommandError("TransferAsset", 5, str_args);
+        }
+        if (not enough) {
+          return makeCommandError("TransferAsset", 6, str_args);
+        }
+        if (not fits_asset) {
+          return makeCommandError("TransferAsset", 7, str_args);
+        }
+        return makeCommandError("TransferAsset", 1, str_args);
+      } catch (const std::exception &e) {
+        log_->error("Failed to read state of TransferAsset: {}", e.what());
+        return makeCommandError("TransferAsset", 1, str_args);
+      }
+    }
+
+    bool OverlayCommandExecutor::appliesInMemory(
+        const shared_model::interface::Transaction &transaction) {
+      if (literal(transaction.creatorAccountId()) == nullptr) {
+        return false;
+      }
+      auto is_amount = [](const shared_model::interface::Amount &amount) {
+        return static_cast<bool>(parseDecimal(amount.toStringRepr()));
+      };
+      return std::all_of(
+          transaction.commands().begin(),
+          transaction.commands().end(),
+          [this, &is_amount](const auto &command) {
+            return visit_in_place(
+                command.get(),
+                [&](const shared_model::interface::AddAssetQuantity &c) {
+                  return literal(c.assetId()) != nullptr
+                      and is_amount(c.amount());
+                },
+                [&](const shared_model::interface::SubtractAssetQuantity &c) {
+                  return literal(c.assetId()) != nullptr
+                      and is_amount(c.amount());
+                },
+                [&](const shared_model::interface::TransferAsset &c) {
+                  return c.srcAccountId() != c.destAccountId()
+                      and literal(c.srcAccountId()) != nullptr
+                      and literal(c.destAccountId()) != nullptr
+                      and literal(c.assetId()) != nullptr
+                      and is_amount(c.amount());
+                },
+                [](const auto &) { return false; });
+          });
+    }
+
+    void OverlayCommandExecutor::prefetch(
+        const std::vector<std::reference_wrapper<
+            const shared_model::interface::Transaction>> &transactions) {
+      Keys keys;
+      for (const auto &transaction : transactions) {
+        for (const auto &command : transaction.get().commands()) {
+          collectKeys(command, transaction.get().creatorAccountId(), keys);
+        }
+      }
+      load(keys);
+    }
+
+    void OverlayCommandExecutor::beginTransaction() {
+      undo_log_.clear();
+      transaction_started_ = true;
+      flushed_in_transaction_ = false;
+    }
+
+    void OverlayCommandExecutor::commitTransaction() {
+      undo_log_.clear();
+      transaction_started_ = false;
+    }
+
+    void OverlayCommandExecutor::rollbackTransaction() {
+      std::for_each(undo_log_.rbegin(), undo_log_.rend(), [this](auto &entry) {
+        auto &balance = balances_[entry.first];
+        balance = std::move(entry.second);
+        // the database has the changes of the transaction if they were
+        // written, so the previous balance has to be written again
+        balance.dirty = balance.dirty or flushed_in_transaction_;
+      });
+      undo_log_.clear();
+      transaction_started_ = false;
+    }
+
+    std::string OverlayCommandExecutor::flush() {
+      std::string updated, deleted;
+      for (auto &entry : balances_) {
+        auto &balance = entry.second;
+        if (not balance.dirty) {
+          continue;
+        }
+        balance.dirty = false;
+        auto key = literals_.at(entry.first.first) + ", "
+            + literals_.at(entry.first.second);
+        if (balance.amount) {
+          updated += (updated.empty() ? "(" : ", (") + key + ", "
+              + toString(*balance.amount) + "::decimal)";
+        } else {
+          deleted += (deleted.empty() ? "(" : ", (") + key + ")";
+        }
+      }
+      if (transaction_started_ and not(updated.empty() and deleted.empty())) {
+        flushed_in_transaction_ = true;
+      }
+
+      std::string statement;
+      if (not updated.empty()) {
+        statement +=
+            "INSERT INTO account_has_asset(account_id, asset_id, amount) "
+            "VALUES "
+            + updated
+            + " ON CONFLICT (account_id, asset_id) "
+              "DO UPDATE SET amount = EXCLUDED.amount;";
+      }
+      if (not deleted.empty()) {
+        statement +=
+            "DELETE FROM account_has_asset WHERE (account_id, asset_id) IN ("
+            + deleted + ");";
+      }
+      return statement;
+    }
+
+    void OverlayCommandExecutor::dropCache() {
+      accounts_.clear();
+      assets_.clear();
+      role_permissions_.clear();
+      grantable_permissions_.clear();
+      for (auto it = balances_.begin(); it != balances_.end();) {
+        it = it->second.dirty ? std::next(it) : balances_.erase(it);
+      }
+    }
+
+    void OverlayCommandExecutor::discard() {
+      dropCache();
+      balances_.clear();
+      undo_log_.clear();
+    }
+
+    boost::optional<OverlayCommandExecutor::Decimal>
+    OverlayCommandExecutor::parseDecimal(const std::string &str) {
+      auto is_digit = [](char c) { return c >= '0' and c <= '9'; };
+      auto point = std::find(str.begin(), str.end(), '.');
+      if (point == str.begin() or not std::all_of(str.begin(), point, is_digit)
+          or (point != str.end()
+              and (point + 1 == str.end()
+                   or not std::all_of(point + 1, str.end(), is_digit)))) {
+        return boost::none;
+      }
+      std::string digits(str.begin(), point);
+      size_t scale = 0;
+      if (point != str.end()) {
+        digits.append(point + 1, str.end());
+        scale = str.end() - point - 1;
+      }
+      return Decimal{boost::multiprecision::cpp_int(digits), scale};
+    }
+
+    std::string OverlayCommandExecutor::toString(const Decimal &decimal) {
+      auto digits = decimal.value.str();
+      if (decimal.scale == 0) {
+        return digits;
+      }
+      if (digits.size() <= decimal.scale) {
+        digits.insert(0, decimal.scale + 1 - digits.size(), '0');
+      }
+      digits.insert(digits.size() - decimal.scale, 1, '.');
+      return digits;
+    }
+
+    OverlayCommandExecutor::Decimal OverlayCommandExecutor::add(
+        const Decimal &lhs, const Decimal &rhs) {
+      const auto scale = std::max(lhs.scale, rhs.scale);
+      return Decimal{
+          lhs.value * boost::multiprecision::pow(
+                          boost::multiprecision::cpp_int(10),
+                          static_cast<unsigned>(scale - lhs.scale))
+              + rhs.value
+                  * boost::multiprecision::pow(
+                        boost::multiprecision::cpp_int(10),
+                        static_cast<unsigned>(scale - rhs.scale)),
+          scale};
+    }
+
+    OverlayCommandExecutor::Decimal OverlayCommandExecutor::subtract(
+        const Decimal &lhs, const Decimal &rhs) {
+      return add(lhs, Decimal{-rhs.value, rhs.scale});
+    }
+
+    bool OverlayCommandExecutor::fits(
+        const Decimal &decimal,
+        shared_model::interface::types::PrecisionType precision) {
+      // value < 2 ^ (256 - precision), compared without the fraction
+      return decimal.value
+          < boost::multiprecision::pow(boost::multiprecision::cpp_int(2),
+                                       256u - precision)
+          * boost::multiprecision::pow(boost::multiprecision::cpp_int(10),
+                                       static_cast<unsigned>(decimal.scale));
+    }
+
+    const std::string *OverlayCommandExecutor::literal(const std::string &id) {
+      auto it = literals_.find(id);
+      if (it != literals_.end()) {
+        return &it->second;
+      }
+      auto *connection = getPostgresConnection(sql_);
+      if (connection == nullptr) {
+        return nullptr;
+      }
+      return quoteLiteral(connection, id)
+          .match(
+              [this, &id](expected::Value<std::string> &quoted)
+                  -> const std::string * {
+                return &(literals_[id] = std::move(quoted.value));
+              },
+              [](expected::Error<std::string> &) -> const std::string * {
+                return nullptr;
+              });
+    }
+
+    void OverlayCommandExecutor::collectKeys(
+        const shared_model::interface::Command &command,
+        const shared_model::interface::types::AccountIdType
+            &creator_account_id,
+        Keys &keys) const {
+      auto account = [this, &keys](const auto &account_id) {
+        if (accounts_.count(account_id) == 0) {
+          keys.accounts.insert(account_id);
+        }
+      };
+      auto asset = [this, &keys](const auto &asset_id) {
+        if (assets_.count(asset_id) == 0) {
+          keys.assets.insert(asset_id);
+        }
+      };
+      auto balance = [this, &keys](const auto &account_id,
+                                   const auto &asset_id) {
+        AccountAsset key{account_id, asset_id};
+        if (balances_.count(key) == 0) {
+          keys.balances.insert(std::move(key));
+        }
+      };
+      auto roles = [this, &keys](const auto &account_id) {
+        if (role_permissions_.count(account_id) == 0) {
+          keys.roles.insert(account_id);
+        }
+      };
+      auto grantable = [this, &keys](const auto &permittee_id,
+                                     const auto &account_id) {
+        AccountPair key{permittee_id, account_id};
+        if (grantable_permissions_.count(key) == 0) {
+          keys.grantable.insert(std::move(key));
+        }
+      };
+
+      visit_in_place(
+          command.get(),
+          [&](const shared_model::interface::AddAssetQuantity &c) {
+            account(creator_account_id);
+            asset(c.assetId());
+            balance(creator_account_id, c.assetId());
+            roles(creator_account_id);
+          },
+          [&](const shared_model::interface::SubtractAssetQuantity &c) {
+            account(creator_account_id);
+            asset(c.assetId());
+            balance(creator_account_id, c.assetId());
+            roles(creator_account_id);
+          },
+          [&](const shared_model::interface::TransferAsset &c) {
+            account(c.srcAccountId());
+            account(c.destAccountId());
+            asset(c.assetId());
+            balance(c.srcAccountId(), c.assetId());
+            balance(c.destAccountId(), c.assetId());
+            roles(c.destAccountId());
+            if (creator_account_id == c.srcAccountId()) {
+              roles(creator_account_id);
+            } else {
+              grantable(creator_account_id, c.srcAccountId());
+            }
+          },
+          [](const auto &) {});
+    }
+
+    void OverlayCommandExecutor::load(const Keys &keys) {
+      auto quoted = [this](const std::string &id) {
+        auto result = literal(id);
+        if (result == nullptr) {
+          throw std::runtime_error("Failed to quote " + id);
+        }
+        return *result;
+      };
+      auto list = [&quoted](const auto &ids) {
+        std::string result;
+        for (const auto &id : ids) {
+          result += (result.empty() ? "" : ", ") + quoted(id);
+        }
+        return result;
+      };
+      auto pair_list = [&quoted](const auto &pairs) {
+        std::string result;
+        for (const auto &pair : pairs) {
+          result += (result.empty() ? "(" : ", (") + quoted(pair.first) + ", "
+              + quoted(pair.second) + ")";
+        }
+        return result;
+      };
+
+      // rows are kind of the state, its key and value
+      std::vector<std::string> selects;
+      if (not keys.accounts.empty()) {
+        selects.push_back(
+            "SELECT 0, account_id::text, NULL::text, NULL::text "
+            "FROM account WHERE account_id IN ("
+            + list(keys.accounts) + ")");
+      }
+      if (not keys.assets.empty()) {
+        selects.push_back(
+            "SELECT 1, asset_id::text, NULL::text, precision::text "
+            "FROM asset WHERE asset_id IN ("
+            + list(keys.assets) + ")");
+      }
+      if (not keys.balances.empty()) {
+        selects.push_back(
+            "SELECT 2, account_id::text, asset_id::text, amount::text "
+            "FROM account_has_asset WHERE (account_id, asset_id) IN ("
+            + pair_list(keys.balances) + ")");
+      }
+      if (not keys.roles.empty()) {
+        selects.push_back(
+            "SELECT 3, ar.account_id::text, NULL::text, "
+            "bit_or(rp.permission)::text FROM role_has_permissions AS rp "
+            "JOIN account_has_roles AS ar ON ar.role_id = rp.role_id "
+            "WHERE ar.account_id IN ("
+            + list(keys.roles) + ") GROUP BY ar.account_id");
+      }
+      if (not keys.grantable.empty()) {
+        selects.push_back(
+            "SELECT 4, permittee_account_id::text, account_id::text, "
+            "bit_or(permission)::text FROM account_has_grantable_permissions "
+            "WHERE (permittee_account_id, account_id) IN ("
+            + pair_list(keys.grantable)
+            + ") GROUP BY permittee_account_id, account_id");
+      }
+      if (selects.empty()) {
+        return;
+      }
+      std::string query = selects.front();
+      for (auto it = std::next(selects.begin()); it != selects.end(); ++it) {
+        query += " UNION ALL " + *it;
+      }
+
+      using RowType = boost::tuple<int,
+                                   std::string,
+                                   boost::optional<std::string>,
+                                   boost::optional<std::string>>;
+      soci::rowset<RowType> rows = (sql_.prepare << query);
+
+      // the keys, which are not in the result, have no rows in the tables
+      for (const auto &account_id : keys.accounts) {
+        accounts_.emplace(account_id, false);
+      }
+      for (const auto &asset_id : keys.assets) {
+        assets_.emplace(asset_id, boost::none);
+      }
+      for (const auto &key : keys.balances) {
+        balances_.emplace(key, Balance{boost::none, false});
+      }
+      for (const auto &account_id : keys.roles) {
+        role_permissions_.emplace(account_id,
+                                  shared_model::interface::RolePermissionSet{});
+      }
+      for (const auto &key : keys.grantable) {
+        grantable_permissions_.emplace(
+            key, shared_model::interface::GrantablePermissionSet{});
+      }
+
+      for (const auto &row : rows) {
+        const auto &key = row.get<1>();
+        const auto &second_key = row.get<2>();
+        const auto &value = row.get<3>();
+        switch (row.get<0>()) {
+          case 0:
+            accounts_[key] = true;
+            break;
+          case 1:
+            assets_[key] =
+                static_cast<shared_model::interface::types::PrecisionType>(
+                    std::stoi(value.value()));
+            break;
+          case 2: {
+            auto &balance = balances_[{key, second_key.value()}];
+            if (not balance.dirty) {
+              balance.amount = parseDecimal(value.value());
+              if (not balance.amount) {
+                throw std::runtime_error("Unexpected amount " + value.value());
+              }
+            }
+            break;
+          }
+          case 3:
+            role_permissions_[key] =
+                shared_model::interface::RolePermissionSet{value.value()};
+            break;
+          case 4:
+            grantable_permissions_[{key, second_key.value()}] =
+                shared_model::interface::GrantablePermissionSet{value.value()};
+            break;
+        }
+      }
+    }
+
+    bool OverlayCommandExecutor::accountExists(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      if (accounts_.count(account_id) == 0) {
+        Keys keys;
+        keys.accounts.insert(account_id);
+        load(keys);
+      }
+      return accounts_.at(account_id);
+    }
+
+    boost::optional<shared_model::interface::types::PrecisionType>
+    OverlayCommandExecutor::assetPrecision(
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      if (assets_.count(asset_id) == 0) {
+        Keys keys;
+        keys.assets.insert(asset_id);
+        load(keys);
+      }
+      return assets_.at(asset_id);
+    }
+
+    OverlayCommandExecutor::Balance &OverlayCommandExecutor::balance(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      AccountAsset key{account_id, asset_id};
+      if (balances_.count(key) == 0) {
+        Keys keys;
+        keys.balances.insert(key);
+        load(keys);
+      }
+      return balances_.at(key);
+    }
+
+    const shared_model::interface::RolePermissionSet &
+    OverlayCommandExecutor::rolePermissions(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      if (role_permissions_.count(account_id) == 0) {
+        Keys keys;
+        keys.roles.insert(account_id);
+        load(keys);
+      }
+      return role_permissions_.at(account_id);
+    }
+
+    const shared_model::interface::GrantablePermissionSet &
+    OverlayCommandExecutor::grantablePermissions(
+        const shared_model::interface::types::AccountIdType &permittee_id,
+        const shared_model::interface::types::AccountIdType &account_id) {
+      AccountPair key{permittee_id, account_id};
+      if (grantable_permissions_.count(key) == 0) {
+        Keys keys;
+        keys.grantable.insert(key);
+        load(keys);
+      }
+      return grantable_permissions_.at(key);
+    }
+
+    bool OverlayCommandExecutor::hasDomainOrGlobalPermission(
+        shared_model::interface::permissions::Role global_permission,
+        shared_model::interface::permissions::Role domain_permission,
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      const auto &permissions = rolePermissions(creator_account_id_);
+      if (permissions.test(global_permission)) {
+        return true;
+      }
+      return secondPart(creator_account_id_, '@') == secondPart(asset_id, '#')
+          and permissions.test(domain_permission);
+    }
+
+    void OverlayCommandExecutor::setBalance(Balance &balance,
+                                            Decimal amount,
+                                            const AccountAsset &key) {
+      if (transaction_started_) {
+        undo_log_.emplace_back(key, balance);
+      }
+      balance.amount = std::move(amount);
+      balance.dirty = true;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
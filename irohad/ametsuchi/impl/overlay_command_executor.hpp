@@ -0,0 +1,306 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_OVERLAY_COMMAND_EXECUTOR_HPP
+#define IROHA_OVERLAY_COMMAND_EXECUTOR_HPP
+
+#include "ametsuchi/command_executor.hpp"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <soci/soci.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/optional.hpp>
+#include "interfaces/permissions.hpp"
+#include "logger/logger_fwd.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Command;
+    class Transaction;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Command executor, which applies asset quantity commands and transfers
+     * to a copy of the state in memory. The state is read from the database
+     * on the first use, and the changes are kept in memory until they are
+     * written with the statement returned by flush. Other commands are
+     * executed by the fallback executor on top of the written changes.
+     *
+     * Changes of the in-memory commands of a transaction can be rolled back
+     * in memory. Changes of the fallback commands are not, so transactions
+     * with them have to be applied under a savepoint of the database
+     */
+    class OverlayCommandExecutor : public CommandExecutor {
+     public:
+      /**
+       * @param sql - session, which the state is read from, and the fallback
+       * executor executes the commands in
+       * @param fallback - executor of the commands, which are not applied in
+       * memory
+       * @param log - logger
+       */
+      OverlayCommandExecutor(soci::session &sql,
+                             CommandExecutor &fallback,
+                             logger::LoggerPtr log);
+
+      void setCreatorAccountId(
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id) override;
+
+      void doValidation(bool do_validation) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddAssetQuantity &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddPeer &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AppendRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAccount &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAsset &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateDomain &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::DetachRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::GrantPermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RemoveSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RevokePermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetAccountDetail &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetQuorum &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SubtractAssetQuantity &command)
+          override;
+
+      CommandResult operator()(
+          const shared_model::interface::TransferAsset &command) override;
+
+      /**
+       * Check whether all commands of the transaction are applied in memory
+       * @param transaction - transaction to check
+       * @return true if the transaction does not need the fallback executor
+       */
+      bool appliesInMemory(
+          const shared_model::interface::Transaction &transaction);
+
+      /**
+       * Read the state used by the transactions, which are applied in
+       * memory, in a single round trip to the database
+       * @param transactions - transactions to be applied
+       * @throws soci::soci_error if the database query fails
+       */
+      void prefetch(
+          const std::vector<std::reference_wrapper<
+              const shared_model::interface::Transaction>> &transactions);
+
+      /**
+       * Start a transaction, whose changes can be rolled back in memory
+       */
+      void beginTransaction();
+
+      /**
+       * Keep the changes of the started transaction
+       */
+      void commitTransaction();
+
+      /**
+       * Undo the in-memory changes of the started transaction
+       */
+      void rollbackTransaction();
+
+      /**
+       * Make the statement, which writes the changes kept in memory, and
+       * consider them written
+       * @return statements terminated with semicolons, or empty string if
+       * there are no changes to write
+       */
+      std::string flush();
+
+      /**
+       * Forget the state read from the database, since it may have been
+       * changed by statements executed without the overlay. The changes,
+       * which are not written yet, are kept
+       */
+      void dropCache();
+
+      /**
+       * Forget all the state including the changes, which are not written,
+       * such as after a rollback of the database to an earlier savepoint
+       */
+      void discard();
+
+     private:
+      /// fixed point number with arbitrary scale, like numeric of PostgreSQL
+      struct Decimal {
+        boost::multiprecision::cpp_int value;
+        size_t scale;
+      };
+
+      /// amount of the asset of the account, none if there is no such row
+      struct Balance {
+        boost::optional<Decimal> amount;
+        /// whether the amount differs from the database
+        bool dirty;
+      };
+
+      using AccountAsset =
+          std::pair<shared_model::interface::types::AccountIdType,
+                    shared_model::interface::types::AssetIdType>;
+      using AccountPair =
+          std::pair<shared_model::interface::types::AccountIdType,
+                    shared_model::interface::types::AccountIdType>;
+
+      /// keys of the state, which is read from the database
+      struct Keys {
+        std::set<shared_model::interface::types::AccountIdType> accounts;
+        std::set<shared_model::interface::types::AssetIdType> assets;
+        std::set<AccountAsset> balances;
+        std::set<shared_model::interface::types::AccountIdType> roles;
+        std::set<AccountPair> grantable;
+      };
+
+      /**
+       * Parse the decimal in the format of amounts and numeric columns
+       * @return decimal, or none if the string is not a non-negative decimal
+       */
+      static boost::optional<Decimal> parseDecimal(const std::string &str);
+
+      static std::string toString(const Decimal &decimal);
+
+      /// sum of the decimals with the larger of their scales
+      static Decimal add(const Decimal &lhs, const Decimal &rhs);
+
+      /// difference of the decimals with the larger of their scales
+      static Decimal subtract(const Decimal &lhs, const Decimal &rhs);
+
+      /**
+       * Check whether the value fits into the asset amount of the precision,
+       * as checked by the prepared statements
+       */
+      static bool fits(const Decimal &decimal,
+                       shared_model::interface::types::PrecisionType precision);
+
+      /**
+       * Get the id quoted as a literal of the session
+       * @return literal, or nullptr if the id can not be quoted
+       */
+      const std::string *literal(const std::string &id);
+
+      /// add keys used by the command to the keys, which are not read yet
+      void collectKeys(const shared_model::interface::Command &command,
+                       const shared_model::interface::types::AccountIdType
+                           &creator_account_id,
+                       Keys &keys) const;
+
+      /**
+       * Read the state of the keys from the database in a single query
+       * @throws soci::soci_error if the database query fails
+       */
+      void load(const Keys &keys);
+
+      bool accountExists(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      boost::optional<shared_model::interface::types::PrecisionType>
+      assetPrecision(
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      Balance &balance(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      const shared_model::interface::RolePermissionSet &rolePermissions(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      const shared_model::interface::GrantablePermissionSet &
+      grantablePermissions(
+          const shared_model::interface::types::AccountIdType &permittee_id,
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /// whether the creator has the permission for an asset of the domain
+      bool hasDomainOrGlobalPermission(
+          shared_model::interface::permissions::Role global_permission,
+          shared_model::interface::permissions::Role domain_permission,
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      /// set the balance, remembering the previous one in the started
+      /// transaction
+      void setBalance(Balance &balance,
+                      Decimal amount,
+                      const AccountAsset &key);
+
+      /**
+       * Execute the command with the fallback executor after the changes are
+       * written, and forget the state, which the command may have changed
+       */
+      template <typename CommandType>
+      CommandResult executeFallback(const CommandType &command,
+                                    const std::string &command_name);
+
+      soci::session &sql_;
+      CommandExecutor &fallback_;
+      shared_model::interface::types::AccountIdType creator_account_id_;
+      bool do_validation_;
+
+      /// quoted literals of the ids, which are used in the statements
+      std::unordered_map<std::string, std::string> literals_;
+
+      std::unordered_map<shared_model::interface::types::AccountIdType, bool>
+          accounts_;
+      std::unordered_map<
+          shared_model::interface::types::AssetIdType,
+          boost::optional<shared_model::interface::types::PrecisionType>>
+          assets_;
+      std::map<AccountAsset, Balance> balances_;
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         shared_model::interface::RolePermissionSet>
+          role_permissions_;
+      std::map<AccountPair, shared_model::interface::GrantablePermissionSet>
+          grantable_permissions_;
+
+      /// previous balances changed by the started transaction
+      std::vector<std::pair<AccountAsset, Balance>> undo_log_;
+      bool transaction_started_;
+      /// whether the changes were written during the started transaction
+      bool flushed_in_transaction_;
+
+      logger::LoggerPtr log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_OVERLAY_COMMAND_EXECUTOR_HPP
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/permission_cache.hpp"
+
+#include <vector>
+
+#include "common/visitor.hpp"
+#include "interfaces/commands/append_role.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/detach_role.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    PermissionCache::PermissionCache(size_t capacity)
+        : capacity_(capacity), version_(0) {}
+
+    PermissionCache::VersionType PermissionCache::version() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return version_;
+    }
+
+    boost::optional<shared_model::interface::RolePermissionSet>
+    PermissionCache::get(
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto found = permissions_.find(account_id);
+      if (found == permissions_.end()) {
+        return boost::none;
+      }
+      return found->second;
+    }
+
+    void PermissionCache::insert(
+        const shared_model::interface::types::AccountIdType &account_id,
+        const shared_model::interface::RolePermissionSet &permissions,
+        VersionType version) {
+      if (capacity_ == 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (version != version_) {
+        return;
+      }
+      if (permissions_.size() >= capacity_
+          and permissions_.find(account_id) == permissions_.end()) {
+        permissions_.erase(permissions_.begin());
+      }
+      permissions_[account_id] = permissions;
+    }
+
+    void PermissionCache::invalidate(
+        const shared_model::interface::Block &block) {
+      // role permissions of an account are changed only by changing the set
+      // of its roles, since permissions of a role cannot be changed after it
+      // is created
+      std::vector<shared_model::interface::types::AccountIdType> accounts;
+      for (const auto &tx : block.transactions()) {
+        for (const auto &command : tx.commands()) {
+          iroha::visit_in_place(
+              command.get(),
+              [&accounts](const shared_model::interface::AppendRole &c) {
+                accounts.push_back(c.accountId());
+              },
+              [&accounts](const shared_model::interface::DetachRole &c) {
+                accounts.push_back(c.accountId());
+              },
+              [&accounts](const shared_model::interface::CreateAccount &c) {
+                accounts.push_back(c.accountName() + "@" + c.domainId());
+              },
+              [](const auto &) {});
+        }
+      }
+      if (accounts.empty()) {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++version_;
+      for (const auto &account_id : accounts) {
+        permissions_.erase(account_id);
+      }
+    }
+
+    void PermissionCache::clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++version_;
+      permissions_.clear();
+    }
+
+    size_t PermissionCache::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return permissions_.size();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_PERMISSION_CACHE_HPP
+#define IROHA_PERMISSION_CACHE_HPP
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/types.hpp"
+#include "interfaces/permissions.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Cache of role permissions of accounts in the committed WSV. Permissions
+     * of an account are forgotten when a block with commands, which can
+     * change them, is committed.
+     * Every invalidation increments version of the cache, and permissions
+     * are cached only if the version did not change since they were read
+     * from the WSV, so that a reader which races with a commit does not put
+     * outdated permissions to the cache.
+     * Only queries may use the cache. It is invalidated after a block is
+     * committed, so it does not reflect CreateRole, AppendRole, DetachRole,
+     * GrantPermission or RevokePermission of earlier transactions of the
+     * block being validated; command validation must read permissions from
+     * the temporary WSV instead.
+     */
+    class PermissionCache {
+     public:
+      using VersionType = uint64_t;
+
+      /// Number of accounts kept by default
+      static const size_t kDefaultCapacity = 1 << 16;
+
+      /**
+       * @param capacity - maximum number of cached accounts
+       */
+      explicit PermissionCache(size_t capacity = kDefaultCapacity);
+
+      /**
+       * @return current version of the cache, which is to be taken before
+       * permissions are read from the WSV
+       */
+      VersionType version() const;
+
+      /**
+       * Get cached permissions of the account
+       * @param account_id - id of the account
+       * @return permissions, if they are cached
+       */
+      boost::optional<shared_model::interface::RolePermissionSet> get(
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      /**
+       * Cache permissions of the account. An arbitrary account is evicted if
+       * the cache is full
+       * @param account_id - id of the account
+       * @param permissions - permissions read from the WSV
+       * @param version - version of the cache taken before the permissions
+       * were read; permissions are not cached if it is outdated
+       */
+      void insert(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::RolePermissionSet &permissions,
+          VersionType version);
+
+      /**
+       * Forget permissions of the accounts, whose roles are changed by
+       * commands of the block
+       * @param block - committed block
+       */
+      void invalidate(const shared_model::interface::Block &block);
+
+      /**
+       * Forget permissions of all accounts
+       */
+      void clear();
+
+      /**
+       * @return number of cached accounts
+       */
+      size_t size() const;
+
+     private:
+      const size_t capacity_;
+
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         shared_model::interface::RolePermissionSet>
+          permissions_;
+      VersionType version_;
+      mutable std::mutex mutex_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_PERMISSION_CACHE_HPP
@@ -28,133 +28,110 @@ namespace {
         [](const auto &) -> ReturnType { return boost::none; });
   }
 
-  // make index tx hash -> block where hash is stored
-  std::string makeHashIndex(
-      const shared_model::interface::types::HashType &hash,
-      shared_model::interface::types::HeightType height,
-      size_t index) {
-    boost::format base(
-        "INSERT INTO position_by_hash(hash, height, index) VALUES ('%s', "
-        "'%s', '%s');");
-    return (base % hash.hex() % height % index).str();
-  }
-
-  std::string makeCommittedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "TRUE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
+  /**
+   * Accumulates rows of a single table to insert them with one multi-row
+   * statement
+   */
+  class MultiRowInsert {
+   public:
+    MultiRowInsert(std::string table, std::string columns)
+        : table_(std::move(table)), columns_(std::move(columns)) {}
+
+    /**
+     * Add row to the statement
+     * @param values - formatted values of the row, enclosed in parentheses
+     */
+    void add(const boost::format &values) {
+      values_ += (values_.empty() ? "" : ", ") + values.str();
+    }
 
-  std::string makeRejectedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "FALSE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
+    /**
+     * @return insert statement or empty string if no rows were added
+     */
+    std::string str() const {
+      if (values_.empty()) {
+        return {};
+      }
+      return "INSERT INTO " + table_ + "(" + columns_ + ") VALUES " + values_
+          + ";";
+    }
 
-  // make index account_id:height -> list of tx indexes
-  // (where tx is placed in the block)
-  std::string makeCreatorHeightIndex(
-      const shared_model::interface::types::AccountIdType creator,
-      shared_model::interface::types::HeightType height,
-      size_t tx_index) {
-    boost::format base(
-        "INSERT INTO index_by_creator_height(creator_id, height, index) VALUES "
-        "('%s', '%s', '%s');");
-    return (base % creator % height % tx_index).str();
-  }
+   private:
+    const std::string table_;
+    const std::string columns_;
+    std::string values_;
+  };
+}  // namespace
 
-  // Make index account_id -> list of blocks where his txs exist
-  std::string makeAccountHeightIndex(
-      const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height) {
-    boost::format base(
-        "INSERT INTO height_by_account_set(account_id, "
-        "height) VALUES "
-        "('%s', '%s');");
-    return (base % account_id % height).str();
-  }
+namespace iroha {
+  namespace ametsuchi {
+    PostgresBlockIndex::PostgresBlockIndex(soci::session &sql,
+                                           logger::LoggerPtr log)
+        : sql_(sql), log_(std::move(log)) {}
 
-  // Collect all assets belonging to creator, sender, and receiver
-  // to make account_id:height:asset_id -> list of tx indexes
-  // for transfer asset in command
-  std::string makeAccountAssetIndex(
-      const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height,
-      size_t index,
-      const shared_model::interface::Transaction::CommandsType &commands) {
-    return std::accumulate(
-        commands.begin(),
-        commands.end(),
-        std::string{},
-        [&](auto query, const auto &cmd) {
+    void PostgresBlockIndex::index(
+        const shared_model::interface::Block &block) {
+      const auto height = block.height();
+
+      // block hash -> height of the block
+      MultiRowInsert block_hashes("height_by_block_hash", "hash, height");
+      // tx hash -> position of the tx in the chain
+      MultiRowInsert tx_positions("position_by_hash", "hash, height, index");
+      // tx hash -> whether tx was committed or rejected
+      MultiRowInsert tx_statuses("tx_status_by_hash", "hash, status");
+      // account_id:height -> list of tx indexes, where account is creator
+      MultiRowInsert creator_heights("index_by_creator_height",
+                                     "creator_id, height, index");
+      // account_id -> list of blocks where his txs exist
+      MultiRowInsert account_heights("height_by_account_set",
+                                     "account_id, height");
+      // account_id:height:asset_id -> list of tx indexes of transfer asset
+      // commands, where account is creator, sender or receiver
+      MultiRowInsert account_assets("position_by_account_asset",
+                                    "account_id, height, asset_id, index");
+
+      block_hashes.add(boost::format("('%s', %d)") % block.hash().hex()
+                       % height);
+
+      for (const auto &tx :
+           block.transactions() | boost::adaptors::indexed(0)) {
+        const auto &creator_id = tx.value().creatorAccountId();
+        const auto &hash = tx.value().hash().hex();
+        const auto index = tx.index();
+
+        account_heights.add(boost::format("('%s', %d)") % creator_id % height);
+        for (const auto &cmd : tx.value().commands()) {
           auto transfer = getTransferAsset(cmd);
           if (not transfer) {
-            return query;
+            continue;
           }
           const auto &src_id = transfer.value().srcAccountId();
           const auto &dest_id = transfer.value().destAccountId();
-
-          query += makeAccountHeightIndex(src_id, height);
-          query += makeAccountHeightIndex(dest_id, height);
-
-          const auto ids = {account_id, src_id, dest_id};
           const auto &asset_id = transfer.value().assetId();
-          // flat map accounts to unindexed keys
-          for (const auto &id : ids) {
-            boost::format base(
-                "INSERT INTO position_by_account_asset(account_id, "
-                "height, asset_id, "
-                "index) "
-                "VALUES ('%s', '%s', '%s', '%s');");
-            query += (base % id % height % asset_id % index).str();
+
+          account_heights.add(boost::format("('%s', %d)") % src_id % height);
+          account_heights.add(boost::format("('%s', %d)") % dest_id % height);
+          for (const auto &id : {creator_id, src_id, dest_id}) {
+            account_assets.add(boost::format("('%s', %d, '%s', %d)") % id
+                               % height % asset_id % index);
           }
-          return query;
-        });
-  }
-}  // namespace
+        }
+        tx_positions.add(boost::format("('%s', %d, %d)") % hash % height
+                         % index);
+        tx_statuses.add(boost::format("('%s', TRUE)") % hash);
+        creator_heights.add(boost::format("('%s', %d, %d)") % creator_id
+                            % height % index);
+      }
 
-namespace iroha {
-  namespace ametsuchi {
-    PostgresBlockIndex::PostgresBlockIndex(soci::session &sql,
-                                           logger::LoggerPtr log)
-        : sql_(sql), log_(std::move(log)) {}
+      for (const auto &rejected_tx_hash :
+           block.rejected_transactions_hashes()) {
+        tx_statuses.add(boost::format("('%s', FALSE)")
+                        % rejected_tx_hash.hex());
+      }
 
-    void PostgresBlockIndex::index(
-        const shared_model::interface::Block &block) {
-      auto height = block.height();
-      auto indexed_txs = block.transactions() | boost::adaptors::indexed(0);
-      auto rejected_txs_hashes = block.rejected_transactions_hashes();
-      std::string tx_index_query = std::accumulate(
-          indexed_txs.begin(),
-          indexed_txs.end(),
-          std::string{},
-          [height](auto query, const auto &tx) {
-            const auto &creator_id = tx.value().creatorAccountId();
-            const auto index = tx.index();
-
-            query += makeAccountHeightIndex(creator_id, height);
-            query += makeAccountAssetIndex(
-                creator_id, height, index, tx.value().commands());
-            query += makeHashIndex(tx.value().hash(), height, index);
-            query += makeCommittedTxHashIndex(tx.value().hash());
-            query += makeCreatorHeightIndex(creator_id, height, index);
-            return query;
-          });
-
-      std::string rejected_tx_index_query =
-          std::accumulate(rejected_txs_hashes.begin(),
-                          rejected_txs_hashes.end(),
-                          std::string{},
-                          [](auto query, const auto &rejected_tx_hash) {
-                            query += makeRejectedTxHashIndex(rejected_tx_hash);
-                            return query;
-                          });
-
-      auto index_query = tx_index_query + rejected_tx_index_query;
+      auto index_query = block_hashes.str() + tx_positions.str()
+          + tx_statuses.str() + creator_heights.str() + account_heights.str()
+          + account_assets.str();
       try {
         sql_ << index_query;
       } catch (const std::exception &e) {
@@ -21,6 +21,7 @@ namespace iroha {
 
       /**
        * Create several indices for block. Namely:
+       * block hash -> height of the block
        * transaction hash -> block, where this transaction is stored
        * transaction creator -> block where his transaction is located
        *
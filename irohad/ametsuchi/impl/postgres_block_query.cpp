@@ -5,37 +5,61 @@
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <boost/format.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/for_each.hpp>
+#include <soci/boost-tuple.h>
 
 #include "ametsuchi/impl/soci_utils.hpp"
-#include "common/byteutils.hpp"
 #include "logger/logger.hpp"
 
+namespace {
+  /**
+   * Status of the transaction from the value of tx_status_by_hash.status
+   * column: res > 0 => Committed, res == 0 => Rejected, res < 0 => Missing
+   */
+  iroha::ametsuchi::TxCacheStatusType makeTxCacheStatus(
+      int res, const shared_model::crypto::Hash &hash) {
+    using namespace iroha::ametsuchi::tx_cache_status_responses;
+    if (res > 0) {
+      return Committed{hash};
+    } else if (res == 0) {
+      return Rejected{hash};
+    }
+    return Missing{hash};
+  }
+}  // namespace
+
 namespace iroha {
   namespace ametsuchi {
     PostgresBlockQuery::PostgresBlockQuery(
         soci::session &sql,
         KeyValueStorage &file_store,
-        std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+        std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
             converter,
+        std::shared_ptr<BlockCache> block_cache,
         logger::LoggerPtr log)
         : sql_(sql),
           block_store_(file_store),
           converter_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
           log_(std::move(log)) {}
 
     PostgresBlockQuery::PostgresBlockQuery(
         std::unique_ptr<soci::session> sql,
         KeyValueStorage &file_store,
-        std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+        std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
             converter,
+        std::shared_ptr<BlockCache> block_cache,
         logger::LoggerPtr log)
         : psql_(std::move(sql)),
           sql_(*psql_),
           block_store_(file_store),
           converter_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
           log_(std::move(log)) {}
 
     std::vector<BlockQuery::wBlock> PostgresBlockQuery::getBlocks(
@@ -50,9 +74,9 @@ namespace iroha {
       for (auto i = height; i <= to; i++) {
         auto block = getBlock(i);
         block.match(
-            [&result](
-                expected::Value<std::unique_ptr<shared_model::interface::Block>>
-                    &v) { result.emplace_back(std::move(v.value)); },
+            [&result](expected::Value<BlockQuery::wBlock> &v) {
+              result.emplace_back(std::move(v.value));
+            },
             [this](const expected::Error<std::string> &e) {
               log_->error(e.error);
             });
@@ -85,18 +109,57 @@ namespace iroha {
         return boost::none;
       }
 
-      // res > 0 => Committed
-      // res == 0 => Rejected
-      // res < 0 => Missing
-      if (res > 0) {
-        return boost::make_optional<TxCacheStatusType>(
-            tx_cache_status_responses::Committed{hash});
-      } else if (res == 0) {
-        return boost::make_optional<TxCacheStatusType>(
-            tx_cache_status_responses::Rejected{hash});
+      return makeTxCacheStatus(res, hash);
+    }
+
+    boost::optional<std::vector<TxCacheStatusType>>
+    PostgresBlockQuery::checkTxsPresence(
+        const std::vector<shared_model::crypto::Hash> &hashes) {
+      if (hashes.empty()) {
+        return std::vector<TxCacheStatusType>{};
+      }
+
+      // hashes are hex strings, so they are passed as an array literal. An
+      // empty element would make the literal malformed, and such a hash is
+      // never stored anyway, so empty hashes are reported missing
+      std::string hashes_array = "{";
+      for (const auto &hash : hashes) {
+        if (hash.blob().empty()) {
+          continue;
+        }
+        if (hashes_array.size() > 1) {
+          hashes_array += ',';
+        }
+        hashes_array += hash.hex();
+      }
+      hashes_array += '}';
+
+      // a hash may be indexed both as rejected and as committed, the latter
+      // takes precedence as in checkTxPresence
+      std::unordered_map<std::string, int> statuses;
+      try {
+        soci::rowset<boost::tuple<std::string, int>> rows =
+            (sql_.prepare << "SELECT hash, CAST(status AS integer) "
+                             "FROM tx_status_by_hash "
+                             "WHERE hash = ANY(CAST(:hashes AS varchar[]))",
+             soci::use(hashes_array));
+        for (const auto &row : rows) {
+          auto &status = statuses.emplace(row.get<0>(), -1).first->second;
+          status = std::max(status, row.get<1>());
+        }
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        return boost::none;
+      }
+
+      std::vector<TxCacheStatusType> result;
+      result.reserve(hashes.size());
+      for (const auto &hash : hashes) {
+        auto it = statuses.find(hash.hex());
+        result.push_back(
+            makeTxCacheStatus(it == statuses.end() ? -1 : it->second, hash));
       }
-      return boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Missing{hash});
+      return result;
     }
 
     uint32_t PostgresBlockQuery::getTopBlockHeight() {
@@ -105,30 +168,74 @@ namespace iroha {
 
     expected::Result<BlockQuery::wBlock, std::string>
     PostgresBlockQuery::getTopBlock() {
-      return getBlock(block_store_.last_id())
-          .match(
-              [](expected::Value<
-                  std::unique_ptr<shared_model::interface::Block>> &v)
-                  -> expected::Result<BlockQuery::wBlock, std::string> {
-                return expected::makeValue<BlockQuery::wBlock>(
-                    std::move(v.value));
-              },
-              [](expected::Error<std::string> &e)
-                  -> expected::Result<BlockQuery::wBlock, std::string> {
-                return expected::makeError(std::move(e.error));
-              });
+      return getBlock(block_store_.last_id());
     }
 
-    expected::Result<std::unique_ptr<shared_model::interface::Block>,
-                     std::string>
+    expected::Result<BlockQuery::wBlock, BlockQuery::GetBlockError>
+    PostgresBlockQuery::getBlockByHash(const shared_model::crypto::Hash &hash) {
+      using ResultType = expected::Result<wBlock, GetBlockError>;
+      boost::optional<shared_model::interface::types::HeightType> height;
+      const auto &hash_str = hash.hex();
+      try {
+        sql_ << "SELECT height FROM height_by_block_hash WHERE hash = :hash",
+            soci::into(height), soci::use(hash_str);
+      } catch (const std::exception &e) {
+        return expected::makeError(GetBlockError{
+            GetBlockError::Code::kInternalError,
+            (boost::format("Failed to execute query: %s") % e.what()).str()});
+      }
+      if (not height) {
+        return expected::makeError(GetBlockError{
+            GetBlockError::Code::kNoBlock,
+            (boost::format("Block with hash %s is not found") % hash_str)
+                .str()});
+      }
+      // the block is indexed, so failure to read it is a storage failure
+      return getBlock(*height).match(
+          [&hash](expected::Value<wBlock> &block) -> ResultType {
+            if (block.value->hash() != hash) {
+              return expected::makeError(GetBlockError{
+                  GetBlockError::Code::kInternalError,
+                  (boost::format("Block with height %d has hash %s, "
+                                 "expected %s")
+                   % block.value->height() % block.value->hash().hex()
+                   % hash.hex())
+                      .str()});
+            }
+            return expected::makeValue(std::move(block.value));
+          },
+          [](expected::Error<std::string> &error) -> ResultType {
+            return expected::makeError(
+                GetBlockError{GetBlockError::Code::kInternalError,
+                              std::move(error.error)});
+          });
+    }
+
+    expected::Result<BlockQuery::wBlock, std::string>
     PostgresBlockQuery::getBlock(
         shared_model::interface::types::HeightType id) const {
-      auto serialized_block = block_store_.get(id);
+      if (auto block = block_cache_->get(id)) {
+        return expected::makeValue(std::move(*block));
+      }
+      auto serialized_block = block_store_.getView(id);
       if (not serialized_block) {
         auto error = boost::format("Failed to retrieve block with id %d") % id;
         return expected::makeError(error.str());
       }
-      return converter_->deserialize(bytesToString(*serialized_block));
+      return converter_
+          ->deserialize(serialized_block->data(), serialized_block->size())
+          .match(
+              [this](expected::Value<
+                     std::unique_ptr<shared_model::interface::Block>> &v)
+                  -> expected::Result<wBlock, std::string> {
+                wBlock block = std::move(v.value);
+                block_cache_->insert(block);
+                return expected::makeValue(std::move(block));
+              },
+              [](expected::Error<std::string> &e)
+                  -> expected::Result<wBlock, std::string> {
+                return expected::makeError(std::move(e.error));
+              });
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -10,15 +10,14 @@
 
 #include <soci/soci.h>
 #include <boost/optional.hpp>
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
-#include "interfaces/iroha_internal/block_json_deserializer.hpp"
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/key_value_storage.hpp"
+#include "interfaces/iroha_internal/block_binary_deserializer.hpp"
 #include "logger/logger_fwd.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
-    class FlatFile;
-
     /**
      * Class which implements BlockQuery with a Postgres backend.
      */
@@ -27,15 +26,17 @@ namespace iroha {
       PostgresBlockQuery(
           soci::session &sql,
           KeyValueStorage &file_store,
-          std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+          std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
               converter,
+          std::shared_ptr<BlockCache> block_cache,
           logger::LoggerPtr log);
 
       PostgresBlockQuery(
           std::unique_ptr<soci::session> sql,
           KeyValueStorage &file_store,
-          std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+          std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
               converter,
+          std::shared_ptr<BlockCache> block_cache,
           logger::LoggerPtr log);
 
       std::vector<wBlock> getBlocks(
@@ -52,24 +53,31 @@ namespace iroha {
       boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) override;
 
+      boost::optional<std::vector<TxCacheStatusType>> checkTxsPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) override;
+
       expected::Result<wBlock, std::string> getTopBlock() override;
 
+      expected::Result<wBlock, GetBlockError> getBlockByHash(
+          const shared_model::crypto::Hash &hash) override;
+
      private:
       /**
-       * Retrieve block with given id from block storage
+       * Retrieve block with given id from the block cache or, if it is not
+       * cached, from block storage
        * @param id - height of a block to retrieve
        * @return block with given height
        */
-      expected::Result<std::unique_ptr<shared_model::interface::Block>,
-                       std::string>
-      getBlock(shared_model::interface::types::HeightType id) const;
+      expected::Result<wBlock, std::string> getBlock(
+          shared_model::interface::types::HeightType id) const;
 
       std::unique_ptr<soci::session> psql_;
       soci::session &sql_;
 
       KeyValueStorage &block_store_;
-      std::shared_ptr<shared_model::interface::BlockJsonDeserializer>
+      std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
           converter_;
+      std::shared_ptr<BlockCache> block_cache_;
 
       logger::LoggerPtr log_;
     };
@@ -5,9 +5,11 @@
 
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 
-#include <soci/postgresql/soci-postgresql.h>
+#include <algorithm>
+#include <cstdlib>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
+#include "ametsuchi/impl/postgres_connection.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/commands/add_asset_quantity.hpp"
@@ -313,14 +315,71 @@ namespace {
         .str();
   }
 
-  template <typename Format>
-  void appendCommandName(const std::string &name,
-                         Format &cmd,
-                         bool do_validation) {
-    auto command_name = name
+  /**
+   * Append a string argument of a prepared statement call as a literal,
+   * quoted according to the settings of the connection
+   * @return false if the argument can not be quoted
+   */
+  bool appendArgument(std::string &query,
+                      PGconn *connection,
+                      const std::string &value) {
+    return iroha::ametsuchi::quoteLiteral(connection, value)
+        .match(
+            [&query](iroha::expected::Value<std::string> &literal) {
+              query += literal.value;
+              return true;
+            },
+            [](iroha::expected::Error<std::string> &) { return false; });
+  }
+
+  /**
+   * Append a numeric argument of a prepared statement call
+   */
+  template <typename T,
+            typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  bool appendArgument(std::string &query, PGconn *, T value) {
+    query += std::to_string(value);
+    return true;
+  }
+
+  /**
+   * Make a call of the prepared statement of a command
+   * @param sql - session, which the call is made in
+   * @param name - name of the command statement
+   * @param do_validation - whether the statement with validation is called
+   * @param args - arguments of the statement
+   * @return EXECUTE query, or error if the arguments can not be quoted
+   */
+  template <typename... Args>
+  iroha::expected::Result<std::string, std::string> makeExecuteStatement(
+      soci::session &sql,
+      const std::string &name,
+      bool do_validation,
+      const Args &... args) {
+    auto *connection = iroha::ametsuchi::getPostgresConnection(sql);
+    if (connection == nullptr) {
+      return iroha::expected::makeError(
+          "Commands require PostgreSQL backend");
+    }
+    std::string query = "EXECUTE " + name
         + (do_validation ? PreparedStatement::validationPrefix
-                         : PreparedStatement::noValidationPrefix);
-    cmd % command_name;
+                         : PreparedStatement::noValidationPrefix)
+        + " (";
+    const char *separator = "";
+    bool quoted = true;
+    using expand = int[];
+    (void)expand{0,
+                 (query += separator,
+                  quoted = quoted and appendArgument(query, connection, args),
+                  separator = ", ",
+                  0)...};
+    if (not quoted) {
+      return iroha::expected::makeError(
+          std::string("Failed to quote arguments: ")
+          + PQerrorMessage(connection));
+    }
+    query += ')';
+    return iroha::expected::makeValue(std::move(query));
   }
 
   /**
@@ -795,6 +854,7 @@ namespace iroha {
             perm_converter)
         : sql_(sql),
           do_validation_(true),
+          batch_started_(false),
           perm_converter_{std::move(perm_converter)} {}
 
     void PostgresCommandExecutor::setCreatorAccountId(
@@ -807,6 +867,162 @@ namespace iroha {
       do_validation_ = do_validation;
     }
 
+    void PostgresCommandExecutor::startBatch() {
+      batch_started_ = true;
+      batch_.clear();
+      batch_query_.clear();
+      batch_statements_.clear();
+    }
+
+    void PostgresCommandExecutor::queueStatement(std::string statement) {
+      if (statement.empty()) {
+        return;
+      }
+      if (statement.back() != ';') {
+        statement += ";";
+      }
+      batch_query_ += statement;
+      batch_statements_[batch_.size()] += statement;
+    }
+
+    expected::Result<void, BatchCommandError>
+    PostgresCommandExecutor::executeBatch() {
+      batch_started_ = false;
+      auto batch = std::move(batch_);
+      batch_.clear();
+      auto query = std::move(batch_query_);
+      batch_query_.clear();
+      auto statements = std::move(batch_statements_);
+      batch_statements_.clear();
+      if (query.empty()) {
+        return {};
+      }
+
+      // errors of queued statements are reported for the command, which
+      // follows them, with the text of the statements
+      auto statement_error = [&statements](size_t index, std::string error) {
+        auto queued = statements.find(index);
+        if (queued != statements.end()) {
+          error += " in statements: " + queued->second;
+        }
+        return BatchCommandError{
+            index,
+            false,
+            CommandError{"QueuedStatements", 1, std::move(error)}};
+      };
+
+      // queries of commands are sent as a single multi-statement query. The
+      // server returns a result for each of them, and stops on the first
+      // statement which raises an error
+      auto *conn = getPostgresConnection(sql_);
+      if (conn == nullptr) {
+        return expected::makeError(
+            statement_error(0, "Batches require PostgreSQL backend"));
+      }
+      if (PQstatus(conn) != CONNECTION_OK or PQisBusy(conn) != 0) {
+        return expected::makeError(statement_error(
+            0,
+            std::string("Connection is not ready: ") + PQerrorMessage(conn)));
+      }
+      if (PQsendQuery(conn, query.c_str()) == 0) {
+        // no results are expected, if the query is not sent
+        return expected::makeError(statement_error(
+            0,
+            std::string("Failed to send the batch: ") + PQerrorMessage(conn)));
+      }
+
+      // number of statements queued before the command with the index
+      auto statements_count = [&statements](size_t index) {
+        auto queued = statements.find(index);
+        return queued == statements.end()
+            ? 0
+            : std::count(queued->second.begin(), queued->second.end(), ';');
+      };
+
+      boost::optional<BatchCommandError> error;
+      // all results have to be read before the connection can be used again.
+      // Only commands return rows, and results of other statements are
+      // counted to find out whether a failed statement is a command
+      size_t index = 0;
+      std::ptrdiff_t statements_executed = 0;
+      while (auto result = PQgetResult(conn)) {
+        const auto status = PQresultStatus(result);
+        if (error) {
+          // nothing to check
+        } else if (status == PGRES_COMMAND_OK) {
+          ++statements_executed;
+        } else if (status != PGRES_TUPLES_OK) {
+          const bool is_command = index < batch.size()
+              and statements_executed >= statements_count(index);
+          if (is_command) {
+            getCommandError(std::string(batch[index].command_name),
+                            PQresultErrorMessage(result),
+                            [&batch, index] { return batch[index].query_args; })
+                .match([](expected::Value<void> &) {},
+                       [&error, index](expected::Error<CommandError> &e) {
+                         error =
+                             BatchCommandError{index, true, std::move(e.error)};
+                       });
+          } else {
+            error = statement_error(index, PQresultErrorMessage(result));
+          }
+        } else if (index < batch.size()) {
+          // the statement returns 0 in case of success, error code otherwise
+          CommandError::ErrorCodeType code = PQntuples(result) == 0
+              ? 1
+              : std::strtoul(PQgetvalue(result, 0, 0), nullptr, 10);
+          if (code != 0) {
+            error = BatchCommandError{index,
+                                      true,
+                                      CommandError{batch[index].command_name,
+                                                   code,
+                                                   batch[index].query_args}};
+          }
+        }
+        if (status == PGRES_TUPLES_OK) {
+          ++index;
+          statements_executed = 0;
+        }
+        PQclear(result);
+      }
+
+      if (error) {
+        return expected::makeError(std::move(*error));
+      }
+      return {};
+    }
+
+    template <typename QueryArgsCallable>
+    CommandResult PostgresCommandExecutor::execute(
+        expected::Result<std::string, std::string> statement,
+        std::string command_name,
+        QueryArgsCallable &&query_args) {
+      if (auto e = boost::get<expected::Error<std::string>>(&statement)) {
+        auto error_args = [&] { return e->error + ", " + query_args(); };
+        if (batch_started_) {
+          // the command is queued as a statement, which returns the general
+          // error code, so that the following commands keep their indices
+          batch_query_ += "SELECT 1 AS result;";
+          batch_.push_back(
+              QueuedCommand{std::move(command_name), error_args()});
+          return {};
+        }
+        return makeCommandError(std::move(command_name), 1, error_args);
+      }
+      auto &query = boost::get<expected::Value<std::string>>(statement).value;
+      if (batch_started_) {
+        // the result is known only after the batch is executed
+        batch_query_ += query + ";";
+        batch_.push_back(
+            QueuedCommand{std::move(command_name), query_args()});
+        return {};
+      }
+      return executeQuery(sql_,
+                          query,
+                          std::move(command_name),
+                          std::forward<QueryArgsCallable>(query_args));
+    }
+
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddAssetQuantity &command) {
       auto &account_id = creator_account_id_;
@@ -814,12 +1030,13 @@ namespace iroha {
       auto amount = command.amount().toStringRepr();
       int precision = command.amount().precision();
 
-      // 14.09.2018 nickaleks: IR-1707 move common logic to separate function
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("addAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % account_id % asset_id % precision % amount);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "addAssetQuantity",
+                                      do_validation_,
+                                      account_id,
+                                      asset_id,
+                                      precision,
+                                      amount);
 
       auto str_args = [&account_id, &asset_id, &amount, precision] {
         return getQueryArgsStringBuilder()
@@ -830,19 +1047,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "AddAssetQuantity", std::move(str_args));
+      return execute(std::move(cmd), "AddAssetQuantity", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddPeer &command) {
       auto &peer = command.peer();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addPeer", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % peer.pubkey().hex() % peer.address());
+      auto cmd = makeExecuteStatement(sql_,
+                                      "addPeer",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      peer.pubkey().hex(),
+                                      peer.address());
 
       auto str_args = [&peer] {
         return getQueryArgsStringBuilder()
@@ -850,18 +1067,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddPeer", std::move(str_args));
+      return execute(std::move(cmd), "AddPeer", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddSignatory &command) {
       auto &account_id = command.accountId();
       auto pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "addSignatory",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      pubkey);
 
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -870,18 +1088,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddSignatory", std::move(str_args));
+      return execute(std::move(cmd), "AddSignatory", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AppendRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("appendRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "appendRole",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      role_name);
 
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
@@ -890,7 +1109,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AppendRole", std::move(str_args));
+      return execute(std::move(cmd), "AppendRole", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -901,11 +1120,13 @@ namespace iroha {
       shared_model::interface::types::AccountIdType account_id =
           account_name + "@" + domain_id;
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("createAccount", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % domain_id % pubkey);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "createAccount",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      domain_id,
+                                      pubkey);
 
       auto str_args = [&account_id, &domain_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -915,8 +1136,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "CreateAccount", std::move(str_args));
+      return execute(std::move(cmd), "CreateAccount", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -924,11 +1144,13 @@ namespace iroha {
       auto &domain_id = command.domainId();
       auto asset_id = command.assetName() + "#" + domain_id;
       int precision = command.precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', %5%)");
-
-      appendCommandName("createAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % domain_id % precision);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "createAsset",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      asset_id,
+                                      domain_id,
+                                      precision);
 
       auto str_args = [&domain_id, &asset_id, precision] {
         return getQueryArgsStringBuilder()
@@ -938,18 +1160,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateAsset", std::move(str_args));
+      return execute(std::move(cmd), "CreateAsset", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::CreateDomain &command) {
       auto &domain_id = command.domainId();
       auto &default_role = command.userDefaultRole();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createDomain", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % domain_id % default_role);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "createDomain",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      domain_id,
+                                      default_role);
 
       auto str_args = [&domain_id, &default_role] {
         return getQueryArgsStringBuilder()
@@ -958,7 +1181,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateDomain", std::move(str_args));
+      return execute(std::move(cmd), "CreateDomain", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -966,11 +1189,12 @@ namespace iroha {
       auto &role_id = command.roleName();
       auto &permissions = command.rolePermissions();
       auto perm_str = permissions.toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % role_id % perm_str);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "createRole",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      role_id,
+                                      perm_str);
 
       auto str_args = [&role_id, &perm_str] {
         // TODO [IR-1889] Akvinikym 21.11.18: integrate
@@ -981,18 +1205,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateRole", std::move(str_args));
+      return execute(std::move(cmd), "CreateRole", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::DetachRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("detachRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "detachRole",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      role_name);
 
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
@@ -1001,7 +1226,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "DetachRole", std::move(str_args));
+      return execute(std::move(cmd), "DetachRole", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1015,12 +1240,13 @@ namespace iroha {
       const auto perm_str =
           shared_model::interface::GrantablePermissionSet({permission})
               .toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("grantPermission", cmd, do_validation_);
-
-      cmd =
-          (cmd % creator_account_id_ % permittee_account_id % perm_str % perm);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "grantPermission",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      permittee_account_id,
+                                      perm_str,
+                                      perm);
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
@@ -1032,19 +1258,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "GrantPermission", std::move(str_args));
+      return execute(std::move(cmd), "GrantPermission", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::RemoveSignatory &command) {
       auto &account_id = command.accountId();
       auto &pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("removeSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "removeSignatory",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      pubkey);
 
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
@@ -1053,8 +1279,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RemoveSignatory", std::move(str_args));
+      return execute(std::move(cmd), "RemoveSignatory", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1070,12 +1295,13 @@ namespace iroha {
                              .set(permission)
                              .toBitstring();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("revokePermission", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % permittee_account_id % perms
-             % without_perm_str);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "revokePermission",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      permittee_account_id,
+                                      perms,
+                                      without_perm_str);
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
@@ -1087,8 +1313,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RevokePermission", std::move(str_args));
+      return execute(std::move(cmd), "RevokePermission", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1105,13 +1330,15 @@ namespace iroha {
       std::string filled_json = "{" + creator_account_id_ + ", " + key + "}";
       std::string val = "\"" + value + "\"";
 
-      auto cmd = boost::format(
-          "EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', '%6%', '%7%')");
-
-      appendCommandName("setAccountDetail", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % json % filled_json % val
-             % empty_json);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "setAccountDetail",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      json,
+                                      filled_json,
+                                      val,
+                                      empty_json);
 
       auto str_args = [&account_id, &key, &value] {
         return getQueryArgsStringBuilder()
@@ -1121,19 +1348,19 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SetAccountDetail", std::move(str_args));
+      return execute(std::move(cmd), "SetAccountDetail", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::SetQuorum &command) {
       auto &account_id = command.accountId();
       int quorum = command.newQuorum();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%)");
-
-      appendCommandName("setQuorum", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % quorum);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "setQuorum",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      account_id,
+                                      quorum);
 
       auto str_args = [&account_id, quorum] {
         return getQueryArgsStringBuilder()
@@ -1142,7 +1369,7 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "SetQuorum", std::move(str_args));
+      return execute(std::move(cmd), "SetQuorum", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1150,11 +1377,13 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("subtractAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % precision % amount);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "subtractAssetQuantity",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      asset_id,
+                                      precision,
+                                      amount);
 
       auto str_args = [&creator_account_id = creator_account_id_,
                        &asset_id,
@@ -1168,8 +1397,8 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SubtractAssetQuantity", std::move(str_args));
+      return execute(
+          std::move(cmd), "SubtractAssetQuantity", std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1179,13 +1408,15 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd =
-          boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', %6%, '%7%')");
-
-      appendCommandName("transferAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % src_account_id % dest_account_id
-             % asset_id % precision % amount);
+      auto cmd = makeExecuteStatement(sql_,
+                                      "transferAsset",
+                                      do_validation_,
+                                      creator_account_id_,
+                                      src_account_id,
+                                      dest_account_id,
+                                      asset_id,
+                                      precision,
+                                      amount);
 
       auto str_args =
           [&src_account_id, &dest_account_id, &asset_id, &amount, precision] {
@@ -1198,8 +1429,7 @@ namespace iroha {
                 .finalize();
           };
 
-      return executeQuery(
-          sql_, cmd.str(), "TransferAsset", std::move(str_args));
+      return execute(std::move(cmd), "TransferAsset", std::move(str_args));
     }
 
     void PostgresCommandExecutor::prepareStatements(soci::session &sql) {
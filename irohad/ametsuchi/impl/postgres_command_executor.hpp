@@ -6,6 +6,8 @@
 #ifndef IROHA_POSTGRES_COMMAND_EXECUTOR_HPP
 #define IROHA_POSTGRES_COMMAND_EXECUTOR_HPP
 
+#include <map>
+
 #include "ametsuchi/command_executor.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
 
@@ -18,6 +20,20 @@ namespace shared_model {
 namespace iroha {
   namespace ametsuchi {
 
+    /**
+     * Error of a command executed in a batch, or of a statement queued in it
+     */
+    struct BatchCommandError {
+      /// index of the failed command in the batch. For a failed statement,
+      /// index of the command which follows it, or the number of commands if
+      /// there is no such command
+      size_t command_index;
+      /// whether the error is of a command, or of a queued statement or the
+      /// database connection otherwise
+      bool is_command_error;
+      CommandError error;
+    };
+
     class PostgresCommandExecutor : public CommandExecutor {
      public:
       PostgresCommandExecutor(
@@ -80,11 +96,61 @@ namespace iroha {
       CommandResult operator()(
           const shared_model::interface::TransferAsset &command) override;
 
+      /**
+       * Queue subsequent commands instead of executing them one by one. The
+       * commands are considered successful until the batch is executed
+       */
+      void startBatch();
+
+      /**
+       * Queue a statement, which does not return rows, such as a savepoint,
+       * to be executed in the batch after the commands queued so far. The
+       * statement is not counted in indices of the batch commands
+       * @param statement - one or several statements separated by semicolons,
+       * which do not contain semicolons otherwise, since they are counted to
+       * tell errors of the statements from errors of the commands
+       */
+      void queueStatement(std::string statement);
+
+      /**
+       * Execute the queued commands in a single round trip to the database,
+       * in the order they were queued. Commands after the first failed one
+       * may be executed as well, so the caller is expected to roll back the
+       * changes in case of error. Queued statements are executed even if
+       * there are no queued commands
+       * @return void on success, otherwise error of the first failed command
+       * or statement
+       */
+      expected::Result<void, BatchCommandError> executeBatch();
+
       static void prepareStatements(soci::session &sql);
 
      private:
+      /// command, queued to be executed in a batch
+      struct QueuedCommand {
+        std::string command_name;
+        std::string query_args;
+      };
+
+      /**
+       * Execute the command query, or queue it if a batch is started. If
+       * the query could not be made, the command fails with the general
+       * error
+       */
+      template <typename QueryArgsCallable>
+      CommandResult execute(expected::Result<std::string, std::string> query,
+                            std::string command_name,
+                            QueryArgsCallable &&query_args);
+
       soci::session &sql_;
       bool do_validation_;
+      bool batch_started_;
+      std::vector<QueuedCommand> batch_;
+      /// statements of the queued commands and other statements in the order
+      /// they were queued
+      std::string batch_query_;
+      /// queued statements by the index of the command, which follows them
+      std::map<size_t, std::string> batch_statements_;
 
       shared_model::interface::types::AccountIdType creator_account_id_;
       std::shared_ptr<shared_model::interface::PermissionToString>
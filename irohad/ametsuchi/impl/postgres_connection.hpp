@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_POSTGRES_CONNECTION_HPP
+#define IROHA_POSTGRES_CONNECTION_HPP
+
+#include <soci/postgresql/soci-postgresql.h>
+#include <soci/soci.h>
+#include "common/result.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Get libpq connection of the session, to use the functions of libpq,
+     * which are not available through soci
+     * @param sql - session to get the connection of
+     * @return connection, or nullptr if the session does not use PostgreSQL
+     * backend
+     */
+    inline PGconn *getPostgresConnection(soci::session &sql) {
+      if (sql.get_backend_name() != "postgresql") {
+        return nullptr;
+      }
+      return static_cast<soci::postgresql_session_backend *>(
+                 sql.get_backend())
+          ->conn_;
+    }
+
+    /**
+     * Quote the string as an SQL literal according to the settings of the
+     * connection, such as standard_conforming_strings and client encoding
+     * @param connection - connection, which the literal is sent with
+     * @param value - string to quote
+     * @return quoted literal, or error message of the connection if the
+     * string can not be quoted, such as if it is not valid in the encoding
+     */
+    inline expected::Result<std::string, std::string> quoteLiteral(
+        PGconn *connection, const std::string &value) {
+      auto *literal = PQescapeLiteral(connection, value.data(), value.size());
+      if (literal == nullptr) {
+        return expected::makeError(std::string(PQerrorMessage(connection)));
+      }
+      std::string result(literal);
+      PQfreemem(literal);
+      return expected::makeValue(std::move(result));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_CONNECTION_HPP
@@ -17,7 +17,6 @@
 #include <boost/range/irange.hpp>
 
 #include "ametsuchi/impl/soci_utils.hpp"
-#include "common/byteutils.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/queries/blocks_query.hpp"
 #include "interfaces/queries/get_account.hpp"
@@ -51,21 +50,24 @@ namespace {
     return res.at(1);
   }
 
+  /**
+   * Generate an SQL subquery which returns the result of a permission check
+   * performed in advance
+   * @param has_permission - result of the check
+   */
+  std::string permissionCheckSql(bool has_permission) {
+    return has_permission ? "SELECT true AS perm" : "SELECT false AS perm";
+  }
+
+  /**
+   * Generate an SQL subquery which checks if the account has the permission
+   * @param permissions - role permissions of the account
+   * @param permission - permission to check
+   */
   std::string getAccountRolePermissionCheckSql(
-      shared_model::interface::permissions::Role permission,
-      const std::string &account_alias = "role_account_id") {
-    const auto perm_str =
-        shared_model::interface::RolePermissionSet({permission}).toBitstring();
-    const auto bits = shared_model::interface::RolePermissionSet::size();
-    // TODO 14.09.18 andrei: IR-1708 Load SQL from separate files
-    std::string query = (boost::format(R"(
-          SELECT (COALESCE(bit_or(rp.permission), '0'::bit(%1%))
-          & '%2%') = '%2%' AS perm FROM role_has_permissions AS rp
-              JOIN account_has_roles AS ar on ar.role_id = rp.role_id
-              WHERE ar.account_id = :%3%)")
-                         % bits % perm_str % account_alias)
-                            .str();
-    return query;
+      const shared_model::interface::RolePermissionSet &permissions,
+      shared_model::interface::permissions::Role permission) {
+    return permissionCheckSql(permissions.test(permission));
   }
 
   /**
@@ -74,52 +76,19 @@ namespace {
    * It verifies individual, domain, and global permissions, and returns true if
    * any of listed permissions is present
    */
-  auto hasQueryPermission(
+  std::string hasQueryPermission(
+      const shared_model::interface::RolePermissionSet &creator_permissions,
       const shared_model::interface::types::AccountIdType &creator,
       const shared_model::interface::types::AccountIdType &target_account,
       Role indiv_permission_id,
       Role all_permission_id,
       Role domain_permission_id) {
-    const auto bits = shared_model::interface::RolePermissionSet::size();
-    const auto perm_str =
-        shared_model::interface::RolePermissionSet({indiv_permission_id})
-            .toBitstring();
-    const auto all_perm_str =
-        shared_model::interface::RolePermissionSet({all_permission_id})
-            .toBitstring();
-    const auto domain_perm_str =
-        shared_model::interface::RolePermissionSet({domain_permission_id})
-            .toBitstring();
-
-    boost::format cmd(R"(
-    WITH
-        has_indiv_perm AS (
-          SELECT (COALESCE(bit_or(rp.permission), '0'::bit(%1%))
-          & '%3%') = '%3%' FROM role_has_permissions AS rp
-              JOIN account_has_roles AS ar on ar.role_id = rp.role_id
-              WHERE ar.account_id = '%2%'
-        ),
-        has_all_perm AS (
-          SELECT (COALESCE(bit_or(rp.permission), '0'::bit(%1%))
-          & '%4%') = '%4%' FROM role_has_permissions AS rp
-              JOIN account_has_roles AS ar on ar.role_id = rp.role_id
-              WHERE ar.account_id = '%2%'
-        ),
-        has_domain_perm AS (
-          SELECT (COALESCE(bit_or(rp.permission), '0'::bit(%1%))
-          & '%5%') = '%5%' FROM role_has_permissions AS rp
-              JOIN account_has_roles AS ar on ar.role_id = rp.role_id
-              WHERE ar.account_id = '%2%'
-        )
-    SELECT ('%2%' = '%6%' AND (SELECT * FROM has_indiv_perm))
-        OR (SELECT * FROM has_all_perm)
-        OR ('%7%' = '%8%' AND (SELECT * FROM has_domain_perm)) AS perm
-    )");
-
-    return (cmd % bits % creator % perm_str % all_perm_str % domain_perm_str
-            % target_account % getDomainFromName(creator)
-            % getDomainFromName(target_account))
-        .str();
+    return permissionCheckSql(
+        (creator == target_account
+         and creator_permissions.test(indiv_permission_id))
+        or creator_permissions.test(all_permission_id)
+        or (getDomainFromName(creator) == getDomainFromName(target_account)
+            and creator_permissions.test(domain_permission_id)));
   }
 
   /// Query result is a tuple of optionals, since there could be no entry
@@ -152,30 +121,54 @@ namespace {
 namespace iroha {
   namespace ametsuchi {
 
+    expected::Result<std::shared_ptr<shared_model::interface::Block>,
+                     std::string>
+    PostgresQueryExecutorVisitor::getBlock(
+        shared_model::interface::types::HeightType height) const {
+      using ReturnType =
+          expected::Result<std::shared_ptr<shared_model::interface::Block>,
+                           std::string>;
+      if (auto block = block_cache_->get(height)) {
+        return expected::makeValue(std::move(*block));
+      }
+      auto serialized_block = block_store_.getView(height);
+      if (not serialized_block) {
+        return expected::makeError(
+            (boost::format("Failed to retrieve block with id %d") % height)
+                .str());
+      }
+      return converter_
+          ->deserialize(serialized_block->data(), serialized_block->size())
+          .match(
+              [this](expected::Value<
+                     std::unique_ptr<shared_model::interface::Block>> &v)
+                  -> ReturnType {
+                std::shared_ptr<shared_model::interface::Block> block =
+                    std::move(v.value);
+                block_cache_->insert(block);
+                return expected::makeValue(std::move(block));
+              },
+              [](expected::Error<std::string> &e) -> ReturnType {
+                return expected::makeError(std::move(e.error));
+              });
+    }
+
     template <typename RangeGen, typename Pred>
     std::vector<std::unique_ptr<shared_model::interface::Transaction>>
     PostgresQueryExecutorVisitor::getTransactionsFromBlock(uint64_t block_id,
                                                            RangeGen &&range_gen,
                                                            Pred &&pred) {
       std::vector<std::unique_ptr<shared_model::interface::Transaction>> result;
-      auto serialized_block = block_store_.get(block_id);
-      if (not serialized_block) {
-        log_->error("Failed to retrieve block with id {}", block_id);
-        return result;
-      }
-      auto deserialized_block =
-          converter_->deserialize(bytesToString(*serialized_block));
+      auto block_result = getBlock(block_id);
       // boost::get of pointer returns pointer to requested type, or nullptr
-      if (auto e =
-              boost::get<expected::Error<std::string>>(&deserialized_block)) {
+      if (auto e = boost::get<expected::Error<std::string>>(&block_result)) {
         log_->error(e->error);
         return result;
       }
 
-      auto &block =
-          boost::get<
-              expected::Value<std::unique_ptr<shared_model::interface::Block>>>(
-              deserialized_block)
+      const auto &block =
+          boost::get<expected::Value<
+              std::shared_ptr<shared_model::interface::Block>>>(block_result)
               .value;
 
       boost::transform(range_gen(boost::size(block->transactions()))
@@ -272,7 +265,10 @@ namespace iroha {
         std::unique_ptr<soci::session> sql,
         KeyValueStorage &block_store,
         std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
-        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
+            converter,
+        std::shared_ptr<BlockCache> block_cache,
+        std::shared_ptr<PermissionCache> permission_cache,
         std::shared_ptr<shared_model::interface::QueryResponseFactory>
             response_factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
@@ -285,6 +281,8 @@ namespace iroha {
                    block_store_,
                    pending_txs_storage_,
                    std::move(converter),
+                   std::move(block_cache),
+                   std::move(permission_cache),
                    response_factory,
                    perm_converter,
                    log_manager->getChild("Visitor")->getLogger()),
@@ -328,25 +326,55 @@ namespace iroha {
     bool PostgresQueryExecutorVisitor::hasAccountRolePermission(
         shared_model::interface::permissions::Role permission,
         const std::string &account_id) const {
-      using T = boost::tuple<int>;
-      boost::format cmd(R"(%s)");
+      return getAccountPermissions(account_id).test(permission);
+    }
+
+    shared_model::interface::RolePermissionSet
+    PostgresQueryExecutorVisitor::getAccountPermissions(
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      if (auto permissions = permission_cache_->get(account_id)) {
+        return *permissions;
+      }
+
+      // taken before reading, so that permissions are not cached if a block
+      // which changes them is committed meanwhile
+      const auto version = permission_cache_->version();
+      const auto bits = shared_model::interface::RolePermissionSet::size();
+      std::string permissions_str;
       try {
-        soci::rowset<T> st =
-            (sql_.prepare
-                 << (cmd % getAccountRolePermissionCheckSql(permission)).str(),
-             soci::use(account_id, "role_account_id"));
-        return st.begin()->get<0>();
+        sql_ << (boost::format(R"(
+            SELECT COALESCE(bit_or(rp.permission), '0'::bit(%1%))
+            FROM role_has_permissions AS rp
+                JOIN account_has_roles AS ar on ar.role_id = rp.role_id
+                WHERE ar.account_id = :account_id)")
+                 % bits)
+                    .str(),
+            soci::into(permissions_str), soci::use(account_id, "account_id");
       } catch (const std::exception &e) {
-        log_->error("Failed to validate query: {}", e.what());
-        return false;
+        log_->error(
+            "Failed to get permissions of {}: {}", account_id, e.what());
+        return {};
       }
+
+      shared_model::interface::RolePermissionSet permissions(permissions_str);
+      permission_cache_->insert(account_id, permissions, version);
+      return permissions;
+    }
+
+    shared_model::interface::RolePermissionSet
+    PostgresQueryExecutorVisitor::getCreatorPermissions() const {
+      return getAccountPermissions(creator_id_);
     }
 
     PostgresQueryExecutorVisitor::PostgresQueryExecutorVisitor(
         soci::session &sql,
         KeyValueStorage &block_store,
         std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
-        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
+            converter,
+        std::shared_ptr<BlockCache> block_cache,
+        std::shared_ptr<PermissionCache> permission_cache,
         std::shared_ptr<shared_model::interface::QueryResponseFactory>
             response_factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
@@ -356,6 +384,8 @@ namespace iroha {
           block_store_(block_store),
           pending_txs_storage_(std::move(pending_txs_storage)),
           converter_(std::move(converter)),
+          block_cache_(std::move(block_cache)),
+          permission_cache_(std::move(permission_cache)),
           query_response_factory_{std::move(response_factory)},
           perm_converter_(std::move(perm_converter)),
           log_(std::move(log)) {}
@@ -452,7 +482,11 @@ namespace iroha {
       auto first_tx = R"(SELECT height, index FROM position_by_hash
       ORDER BY height, index ASC LIMIT 1)";
 
-      auto cmd = base % hasQueryPermission(creator_id_, q.accountId(), perms...)
+      auto cmd = base
+          % hasQueryPermission(getCreatorPermissions(),
+                               creator_id_,
+                               q.accountId(),
+                               perms...)
           % related_txs;
       if (first_hash) {
         cmd = base % first_by_hash;
@@ -552,7 +586,8 @@ namespace iroha {
       SELECT account_id, domain_id, quorum, data, roles, perm
       FROM t RIGHT OUTER JOIN has_perms AS p ON TRUE
       )")
-                  % hasQueryPermission(creator_id_,
+                  % hasQueryPermission(getCreatorPermissions(),
+                                       creator_id_,
                                        q.accountId(),
                                        Role::kGetMyAccount,
                                        Role::kGetAllAccounts,
@@ -618,14 +653,20 @@ namespace iroha {
         return "could not retrieve block with given height: "
             + std::to_string(height);
       };
-      auto serialized_block = block_store_.get(q.height());
+      if (auto block = block_cache_->get(q.height())) {
+        // the response takes ownership of the block, while cached one is shared
+        return query_response_factory_->createBlockResponse(clone(**block),
+                                                            query_hash_);
+      }
+      auto serialized_block = block_store_.getView(q.height());
       if (not serialized_block) {
         // for some reason, block with such height was not retrieved
         return logAndReturnErrorResponse(
             QueryErrorType::kStatefulFailed, block_deserialization_msg(), 1);
       }
 
-      return converter_->deserialize(bytesToString(*serialized_block))
+      return converter_->deserialize(serialized_block->data(),
+                                     serialized_block->size())
           .match(
               [this](iroha::expected::Value<
                      std::unique_ptr<shared_model::interface::Block>> &block) {
@@ -655,7 +696,8 @@ namespace iroha {
       SELECT public_key, perm FROM t
       RIGHT OUTER JOIN has_perms ON TRUE
       )")
-                  % hasQueryPermission(creator_id_,
+                  % hasQueryPermission(getCreatorPermissions(),
+                                       creator_id_,
                                        q.accountId(),
                                        Role::kGetMySignatories,
                                        Role::kGetAllSignatories,
@@ -746,6 +788,7 @@ namespace iroha {
           QueryType<shared_model::interface::types::HeightType, std::string>;
       using PermissionTuple = boost::tuple<int, int>;
 
+      const auto creator_permissions = getCreatorPermissions();
       auto cmd =
           (boost::format(R"(WITH has_my_perm AS (%s),
       has_all_perm AS (%s),
@@ -755,14 +798,16 @@ namespace iroha {
       SELECT height, hash, has_my_perm.perm, has_all_perm.perm FROM t
       RIGHT OUTER JOIN has_my_perm ON TRUE
       RIGHT OUTER JOIN has_all_perm ON TRUE
-      )") % getAccountRolePermissionCheckSql(Role::kGetMyTxs, "account_id")
-           % getAccountRolePermissionCheckSql(Role::kGetAllTxs, "account_id")
+      )") % getAccountRolePermissionCheckSql(creator_permissions,
+                                              Role::kGetMyTxs)
+           % getAccountRolePermissionCheckSql(creator_permissions,
+                                              Role::kGetAllTxs)
            % hash_str)
               .str();
 
       return executeQuery<QueryTuple, PermissionTuple>(
           [&] {
-            return (sql_.prepare << cmd, soci::use(creator_id_, "account_id"));
+            return (sql_.prepare << cmd);
           },
           [&](auto range, auto &my_perm, auto &all_perm) {
             if (boost::size(range) != q.transactionHashes().size()) {
@@ -877,7 +922,8 @@ namespace iroha {
       SELECT account_id, asset_id, amount, perm FROM t
       RIGHT OUTER JOIN has_perms ON TRUE
       )")
-                  % hasQueryPermission(creator_id_,
+                  % hasQueryPermission(getCreatorPermissions(),
+                                       creator_id_,
                                        q.accountId(),
                                        Role::kGetMyAccAst,
                                        Role::kGetAllAccAst,
@@ -950,7 +996,8 @@ namespace iroha {
       SELECT json, perm FROM detail
       RIGHT OUTER JOIN has_perms ON TRUE
       )")
-                  % hasQueryPermission(creator_id_,
+                  % hasQueryPermission(getCreatorPermissions(),
+                                       creator_id_,
                                        q.accountId(),
                                        Role::kGetMyAccDetail,
                                        Role::kGetAllAccDetail,
@@ -989,13 +1036,13 @@ namespace iroha {
                       R"(WITH has_perms AS (%s)
       SELECT role_id, perm FROM role
       RIGHT OUTER JOIN has_perms ON TRUE
-      )") % getAccountRolePermissionCheckSql(Role::kGetRoles))
+      )") % getAccountRolePermissionCheckSql(getCreatorPermissions(),
+                                              Role::kGetRoles))
                      .str();
 
       return executeQuery<QueryTuple, PermissionTuple>(
           [&] {
-            return (sql_.prepare << cmd,
-                    soci::use(creator_id_, "role_account_id"));
+            return (sql_.prepare << cmd);
           },
           [&](auto range, auto &) {
             auto roles = boost::copy_range<
@@ -1021,14 +1068,13 @@ namespace iroha {
                 WHERE role_id = :role_name)
       SELECT permission, perm FROM perms
       RIGHT OUTER JOIN has_perms ON TRUE
-      )") % getAccountRolePermissionCheckSql(Role::kGetRoles))
+      )") % getAccountRolePermissionCheckSql(getCreatorPermissions(),
+                                              Role::kGetRoles))
                      .str();
 
       return executeQuery<QueryTuple, PermissionTuple>(
           [&] {
-            return (sql_.prepare << cmd,
-                    soci::use(creator_id_, "role_account_id"),
-                    soci::use(q.roleId(), "role_name"));
+            return (sql_.prepare << cmd, soci::use(q.roleId(), "role_name"));
           },
           [this, &q](auto range, auto &) {
             if (range.empty()) {
@@ -1059,14 +1105,13 @@ namespace iroha {
                 WHERE asset_id = :asset_id)
       SELECT domain_id, precision, perm FROM perms
       RIGHT OUTER JOIN has_perms ON TRUE
-      )") % getAccountRolePermissionCheckSql(Role::kReadAssets))
+      )") % getAccountRolePermissionCheckSql(getCreatorPermissions(),
+                                              Role::kReadAssets))
                      .str();
 
       return executeQuery<QueryTuple, PermissionTuple>(
           [&] {
-            return (sql_.prepare << cmd,
-                    soci::use(creator_id_, "role_account_id"),
-                    soci::use(q.assetId(), "asset_id"));
+            return (sql_.prepare << cmd, soci::use(q.assetId(), "asset_id"));
           },
           [this, &q](auto range, auto &) {
             if (range.empty()) {
@@ -8,6 +8,8 @@
 
 #include "ametsuchi/query_executor.hpp"
 
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/permission_cache.hpp"
 #include "ametsuchi/impl/soci_utils.hpp"
 #include "ametsuchi/key_value_storage.hpp"
 #include "ametsuchi/storage.hpp"
@@ -27,7 +29,7 @@
 #include "interfaces/commands/set_quorum.hpp"
 #include "interfaces/commands/subtract_asset_quantity.hpp"
 #include "interfaces/commands/transfer_asset.hpp"
-#include "interfaces/iroha_internal/block_json_converter.hpp"
+#include "interfaces/iroha_internal/block_binary_deserializer.hpp"
 #include "interfaces/iroha_internal/query_response_factory.hpp"
 #include "interfaces/permission_to_string.hpp"
 #include "interfaces/queries/blocks_query.hpp"
@@ -53,8 +55,10 @@ namespace iroha {
           soci::session &sql,
           KeyValueStorage &block_store,
           std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
-          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+          std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
               converter,
+          std::shared_ptr<BlockCache> block_cache,
+          std::shared_ptr<PermissionCache> permission_cache,
           std::shared_ptr<shared_model::interface::QueryResponseFactory>
               response_factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
@@ -113,6 +117,32 @@ namespace iroha {
           const shared_model::interface::GetPendingTransactions &q);
 
      private:
+      /**
+       * Get role permissions of the account from the permission cache or, if
+       * they are not cached, from the WSV
+       * @param account_id - id of the account
+       * @return permissions of the account, or empty set if they could not
+       * be read
+       */
+      shared_model::interface::RolePermissionSet getAccountPermissions(
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      /**
+       * @return role permissions of the creator of the current query
+       */
+      shared_model::interface::RolePermissionSet getCreatorPermissions() const;
+
+      /**
+       * Retrieve block with given height from the block cache or, if it is
+       * not cached, from block storage
+       * @param height - height of a block to retrieve
+       * @return shared block, which must not be modified, or an error
+       */
+      expected::Result<std::shared_ptr<shared_model::interface::Block>,
+                       std::string>
+      getBlock(shared_model::interface::types::HeightType height) const;
+
       /**
        * Get transactions from block using range from range_gen and filtered by
        * predicate pred
@@ -230,7 +260,10 @@ namespace iroha {
       shared_model::interface::types::AccountIdType creator_id_;
       shared_model::interface::types::HashType query_hash_;
       std::shared_ptr<PendingTransactionStorage> pending_txs_storage_;
-      std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
+      std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
+          converter_;
+      std::shared_ptr<BlockCache> block_cache_;
+      std::shared_ptr<PermissionCache> permission_cache_;
       std::shared_ptr<shared_model::interface::QueryResponseFactory>
           query_response_factory_;
       std::shared_ptr<shared_model::interface::PermissionToString>
@@ -244,8 +277,10 @@ namespace iroha {
           std::unique_ptr<soci::session> sql,
           KeyValueStorage &block_store,
           std::shared_ptr<PendingTransactionStorage> pending_txs_storage,
-          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+          std::shared_ptr<shared_model::interface::BlockBinaryDeserializer>
               converter,
+          std::shared_ptr<BlockCache> block_cache,
+          std::shared_ptr<PermissionCache> permission_cache,
           std::shared_ptr<shared_model::interface::QueryResponseFactory>
               response_factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
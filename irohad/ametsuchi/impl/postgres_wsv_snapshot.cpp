@@ -0,0 +1,194 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/postgres_wsv_snapshot.hpp"
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/format.hpp>
+#include "logger/logger.hpp"
+
+namespace {
+  const std::string kSnapshotSchema = "wsv_snapshot";
+
+  /// WSV tables, ordered so that referenced tables come first. The block
+  /// index is not a part of the snapshot, since it is kept up to date with
+  /// the block store regardless of the WSV
+  const std::vector<std::string> kSnapshotTables = {
+      "role",
+      "domain",
+      "signatory",
+      "account",
+      "account_has_signatory",
+      "peer",
+      "asset",
+      "account_has_asset",
+      "role_has_permissions",
+      "account_has_roles",
+      "account_has_grantable_permissions"};
+
+  /// truncation of the WSV tables, which are referenced only by each other
+  const std::string kTruncateTables = "TRUNCATE TABLE "
+      + boost::algorithm::join(kSnapshotTables, ", ") + " RESTART IDENTITY;";
+
+  void rollback(soci::session &sql) {
+    try {
+      sql << "ROLLBACK";
+    } catch (const std::exception &) {
+      // nothing to roll back
+    }
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    PostgresWsvSnapshot::PostgresWsvSnapshot(soci::session &sql,
+                                             logger::LoggerPtr log)
+        : sql_(sql), log_(std::move(log)) {}
+
+    expected::Result<WsvSnapshotInfo, std::string> PostgresWsvSnapshot::save() {
+      try {
+        sql_ << "BEGIN ISOLATION LEVEL REPEATABLE READ";
+
+        boost::optional<shared_model::interface::types::HeightType> height;
+        boost::optional<std::string> top_hash;
+        sql_ << "SELECT height, hash FROM height_by_block_hash "
+                "ORDER BY height DESC LIMIT 1",
+            soci::into(height), soci::into(top_hash);
+        if (not height or not top_hash) {
+          rollback(sql_);
+          return expected::makeError("There are no blocks in the WSV");
+        }
+
+        // only the tables of the snapshot are replaced, the schema itself
+        // is kept
+        std::string query = (boost::format("CREATE SCHEMA IF NOT EXISTS %1%;"
+                                           "DROP TABLE IF EXISTS "
+                                           "%1%.snapshot_info;")
+                             % kSnapshotSchema)
+                                .str();
+        for (const auto &table : kSnapshotTables) {
+          query += (boost::format("DROP TABLE IF EXISTS %1%.%2%;"
+                                  "CREATE TABLE %1%.%2% AS TABLE %2%;")
+                    % kSnapshotSchema % table)
+                       .str();
+        }
+        query += (boost::format("CREATE TABLE %s.snapshot_info ("
+                                "height bigint NOT NULL, "
+                                "top_hash varchar NOT NULL, "
+                                "checksum varchar NOT NULL);")
+                  % kSnapshotSchema)
+                     .str();
+        sql_ << query;
+
+        auto sum = checksum();
+        sql_ << "INSERT INTO " + kSnapshotSchema
+                + ".snapshot_info VALUES (:height, :top_hash, :checksum)",
+            soci::use(*height), soci::use(*top_hash), soci::use(sum);
+        sql_ << "COMMIT";
+
+        log_->info("saved WSV snapshot at height {}", *height);
+        return expected::makeValue(WsvSnapshotInfo{*height, *top_hash});
+      } catch (const std::exception &e) {
+        rollback(sql_);
+        return expected::makeError(
+            (boost::format("Failed to save WSV snapshot: %s") % e.what())
+                .str());
+      }
+    }
+
+    expected::Result<boost::optional<WsvSnapshotInfo>, std::string>
+    PostgresWsvSnapshot::info() {
+      try {
+        int exists = 0;
+        sql_ << "SELECT count(*) FROM information_schema.tables "
+                "WHERE table_schema = :schema "
+                "AND table_name = 'snapshot_info'",
+            soci::into(exists), soci::use(kSnapshotSchema);
+        if (exists == 0) {
+          return expected::makeValue(boost::optional<WsvSnapshotInfo>());
+        }
+
+        boost::optional<shared_model::interface::types::HeightType> height;
+        boost::optional<std::string> top_hash, stored_checksum;
+        sql_ << "SELECT height, top_hash, checksum FROM " + kSnapshotSchema
+                + ".snapshot_info",
+            soci::into(height), soci::into(top_hash),
+            soci::into(stored_checksum);
+        if (not height or not top_hash or not stored_checksum) {
+          log_->warn("WSV snapshot is incomplete");
+          return expected::makeValue(boost::optional<WsvSnapshotInfo>());
+        }
+        if (checksum() != *stored_checksum) {
+          log_->warn("WSV snapshot at height {} has invalid checksum", *height);
+          return expected::makeValue(boost::optional<WsvSnapshotInfo>());
+        }
+        return expected::makeValue(
+            boost::make_optional(WsvSnapshotInfo{*height, *top_hash}));
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            (boost::format("Failed to read WSV snapshot: %s") % e.what())
+                .str());
+      }
+    }
+
+    expected::Result<void, std::string> PostgresWsvSnapshot::load() {
+      std::string query = "BEGIN;" + kTruncateTables;
+      for (const auto &table : kSnapshotTables) {
+        query += (boost::format("INSERT INTO %2% SELECT * FROM %1%.%2%;")
+                  % kSnapshotSchema % table)
+                     .str();
+      }
+      query += "COMMIT;";
+      try {
+        sql_ << query;
+        return {};
+      } catch (const std::exception &e) {
+        rollback(sql_);
+        return expected::makeError(
+            (boost::format("Failed to load WSV snapshot: %s") % e.what())
+                .str());
+      }
+    }
+
+    expected::Result<void, std::string> PostgresWsvSnapshot::clear() {
+      try {
+        sql_ << kTruncateTables;
+        return {};
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            (boost::format("Failed to drop WSV: %s") % e.what()).str());
+      }
+    }
+
+    void PostgresWsvSnapshot::drop() {
+      try {
+        sql_ << "DROP SCHEMA IF EXISTS " + kSnapshotSchema + " CASCADE";
+      } catch (const std::exception &e) {
+        log_->warn("Failed to drop WSV snapshot: {}", e.what());
+      }
+    }
+
+    std::string PostgresWsvSnapshot::checksum() {
+      // sum of row hashes does not depend on the order of rows, and is
+      // computed without materializing the tables
+      std::vector<std::string> sums;
+      for (const auto &table : kSnapshotTables) {
+        sums.push_back(
+            (boost::format("(SELECT count(*) || ':' || coalesce(sum(('x' || "
+                           "substr(md5(r::text), 1, 16))::bit(64)::bigint), 0) "
+                           "FROM %s.%s r)")
+             % kSnapshotSchema % table)
+                .str());
+      }
+      std::string result;
+      sql_ << "SELECT concat_ws(';', " + boost::algorithm::join(sums, ", ")
+              + ")",
+          soci::into(result);
+      return result;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
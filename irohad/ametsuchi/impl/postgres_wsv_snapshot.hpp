@@ -0,0 +1,87 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_POSTGRES_WSV_SNAPSHOT_HPP
+#define IROHA_POSTGRES_WSV_SNAPSHOT_HPP
+
+#include <soci/soci.h>
+#include <boost/optional.hpp>
+#include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
+#include "logger/logger_fwd.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Description of a saved WSV snapshot
+     */
+    struct WsvSnapshotInfo {
+      /// height of the last block applied to the saved WSV
+      shared_model::interface::types::HeightType height;
+      /// hash of that block
+      std::string top_hash;
+    };
+
+    /**
+     * Copy of the WSV tables, kept in a separate schema of the same database.
+     * The block index tables are not copied, since they describe the block
+     * store rather than the state. The snapshot is tagged with the height and
+     * hash of the top block it reflects, and with a checksum of its contents,
+     * so that a snapshot which does not match the block store or has been
+     * modified is never loaded.
+     */
+    class PostgresWsvSnapshot {
+     public:
+      PostgresWsvSnapshot(soci::session &sql, logger::LoggerPtr log);
+
+      /**
+       * Replace the saved snapshot with the current WSV. The copy is made in
+       * a single repeatable read transaction, so it is consistent with the
+       * top block it is tagged with even if blocks are committed meanwhile
+       * @return info of the saved snapshot, or error message
+       */
+      expected::Result<WsvSnapshotInfo, std::string> save();
+
+      /**
+       * Read info of the saved snapshot and verify its checksum
+       * @return info of the saved snapshot, boost::none if there is no
+       * snapshot or its checksum does not match, or error message
+       */
+      expected::Result<boost::optional<WsvSnapshotInfo>, std::string> info();
+
+      /**
+       * Replace the contents of the WSV tables with the saved snapshot. The
+       * block index tables are not modified
+       * @return void on success, otherwise error message
+       */
+      expected::Result<void, std::string> load();
+
+      /**
+       * Remove the contents of the WSV tables, which the snapshot consists
+       * of. The block index tables are not modified
+       * @return void on success, otherwise error message
+       */
+      expected::Result<void, std::string> clear();
+
+      /**
+       * Remove the saved snapshot
+       */
+      void drop();
+
+     private:
+      /**
+       * @return checksum of the tables of the snapshot schema
+       */
+      std::string checksum();
+
+      soci::session &sql_;
+      logger::LoggerPtr log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_WSV_SNAPSHOT_HPP
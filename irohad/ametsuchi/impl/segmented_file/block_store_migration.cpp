@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/segmented_file/block_store_migration.hpp"
+
+#include <ciso646>
+#include <map>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/format.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "common/byteutils.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/iroha_internal/block_binary_serializer.hpp"
+#include "interfaces/iroha_internal/block_json_deserializer.hpp"
+#include "logger/logger.hpp"
+
+namespace {
+  /**
+   * Collect block files of FlatFile storage
+   * @param path - block store directory
+   * @return block files ordered by height
+   */
+  std::map<iroha::ametsuchi::KeyValueStorage::Identifier,
+           boost::filesystem::path>
+  flatFileBlocks(const std::string &path) {
+    std::map<iroha::ametsuchi::KeyValueStorage::Identifier,
+             boost::filesystem::path>
+        blocks;
+    boost::system::error_code err;
+    if (not boost::filesystem::is_directory(path, err)) {
+      return blocks;
+    }
+    for (auto it = boost::filesystem::directory_iterator{path};
+         it != boost::filesystem::directory_iterator{};
+         ++it) {
+      if (auto id = iroha::ametsuchi::FlatFile::name_to_id(
+              it->path().filename().string())) {
+        blocks.emplace(*id, it->path());
+      }
+    }
+    return blocks;
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    bool hasFlatFileBlocks(const std::string &path) {
+      return not flatFileBlocks(path).empty();
+    }
+
+    expected::Result<size_t, std::string> migrateFlatFileBlocks(
+        const std::string &path,
+        KeyValueStorage &storage,
+        const shared_model::interface::BlockJsonDeserializer
+            &json_deserializer,
+        const shared_model::interface::BlockBinarySerializer
+            &binary_serializer,
+        const logger::LoggerPtr &log) {
+      auto blocks = flatFileBlocks(path);
+      log->info("migrating {} blocks from {}", blocks.size(), path);
+
+      size_t migrated = 0;
+      for (const auto &block_file : blocks) {
+        const auto id = block_file.first;
+        if (not storage.get(id)) {
+          boost::filesystem::ifstream file(block_file.second,
+                                           std::ifstream::binary);
+          std::string json{std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>()};
+          if (not file.is_open() or file.bad()) {
+            return expected::makeError(
+                (boost::format("Cannot read block file %s")
+                 % block_file.second.string())
+                    .str());
+          }
+
+          auto blob = json_deserializer.deserialize(json) |
+              [&binary_serializer](const auto &block) {
+                return binary_serializer.serialize(*block);
+              };
+          if (auto e = boost::get<expected::Error<std::string>>(&blob)) {
+            return expected::makeError(
+                (boost::format("Cannot convert block %d: %s") % id % e->error)
+                    .str());
+          }
+          if (not storage.add(
+                  id,
+                  stringToBytes(
+                      boost::get<expected::Value<std::string>>(blob).value))) {
+            return expected::makeError(
+                (boost::format("Cannot store block %d") % id).str());
+          }
+          ++migrated;
+        }
+
+        boost::system::error_code err;
+        boost::filesystem::remove(block_file.second, err);
+        if (err) {
+          log->warn("Cannot remove block file {}: {}",
+                    block_file.second.string(),
+                    err.message());
+        }
+      }
+
+      log->info("migrated {} blocks", migrated);
+      return expected::makeValue(migrated);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
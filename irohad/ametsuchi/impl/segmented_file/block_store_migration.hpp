@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_STORE_MIGRATION_HPP
+#define IROHA_BLOCK_STORE_MIGRATION_HPP
+
+#include <memory>
+#include <string>
+
+#include "common/result.hpp"
+#include "logger/logger_fwd.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class BlockJsonDeserializer;
+    class BlockBinarySerializer;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class KeyValueStorage;
+
+    /**
+     * Check whether the directory contains blocks stored by FlatFile
+     * @param path - block store directory
+     * @return true if there is at least one block file
+     */
+    bool hasFlatFileBlocks(const std::string &path);
+
+    /**
+     * Move blocks stored by FlatFile as one json file per block to the given
+     * storage, converting them to the binary format. Every block file is
+     * removed after the block is added to the storage, and blocks which are
+     * already present in the storage are skipped, so an interrupted migration
+     * can be restarted.
+     * @param path - directory with block files
+     * @param storage - storage to move the blocks to
+     * @param json_deserializer - converter to read the blocks
+     * @param binary_serializer - converter to write the blocks
+     * @param log - logger
+     * @return number of migrated blocks or error message
+     */
+    expected::Result<size_t, std::string> migrateFlatFileBlocks(
+        const std::string &path,
+        KeyValueStorage &storage,
+        const shared_model::interface::BlockJsonDeserializer
+            &json_deserializer,
+        const shared_model::interface::BlockBinarySerializer
+            &binary_serializer,
+        const logger::LoggerPtr &log);
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_MIGRATION_HPP
@@ -0,0 +1,364 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+
+#include <algorithm>
+#include <ciso646>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "common/files.hpp"
+#include "logger/logger.hpp"
+
+using namespace iroha::ametsuchi;
+using Identifier = SegmentedFile::Identifier;
+using SegmentIdType = SegmentedFile::SegmentIdType;
+
+namespace {
+  const auto kNameWidth = 16;
+
+  bool compareIds(const SegmentedFile::IndexType::value_type &lhs,
+                  const SegmentedFile::IndexType::value_type &rhs) {
+    return lhs.first < rhs.first;
+  }
+}  // namespace
+
+const std::string SegmentedFile::kDataExtension = ".seg";
+const std::string SegmentedFile::kIndexExtension = ".idx";
+
+// ----------| public API |----------
+
+std::string SegmentedFile::segment_name(SegmentIdType id) {
+  std::ostringstream os;
+  os << std::setw(kNameWidth) << std::setfill('0') << id;
+  return os.str();
+}
+
+boost::optional<SegmentIdType> SegmentedFile::name_to_segment(
+    const std::string &name) {
+  if (name.size() != kNameWidth + kDataExtension.size()
+      or name.compare(kNameWidth, kDataExtension.size(), kDataExtension)
+          != 0) {
+    return boost::none;
+  }
+  try {
+    auto id = std::stoul(name.substr(0, kNameWidth));
+    return boost::make_optional<SegmentIdType>(id);
+  } catch (const std::exception &e) {
+    return boost::none;
+  }
+}
+
+boost::optional<std::unique_ptr<SegmentedFile>> SegmentedFile::create(
+    const std::string &path, logger::LoggerPtr log, uint64_t segment_size) {
+  boost::system::error_code err;
+  if (not boost::filesystem::is_directory(path, err)
+      and not boost::filesystem::create_directory(path, err)) {
+    log->error("Cannot create storage dir: {}\n{}", path, err.message());
+    return boost::none;
+  }
+
+  std::vector<SegmentIdType> segments;
+  for (auto it = boost::filesystem::directory_iterator{path};
+       it != boost::filesystem::directory_iterator{};
+       ++it) {
+    if (auto segment =
+            SegmentedFile::name_to_segment(it->path().filename().string())) {
+      segments.push_back(*segment);
+    }
+  }
+  std::sort(segments.begin(), segments.end());
+
+  IndexType index;
+  SegmentIdType last_segment = 0;
+  uint64_t last_segment_size = 0;
+  for (auto segment : segments) {
+    last_segment_size = loadSegment(path, segment, index, log);
+    last_segment = segment;
+  }
+  std::stable_sort(index.begin(), index.end(), compareIds);
+  index.erase(std::unique(index.begin(),
+                          index.end(),
+                          [](const auto &lhs, const auto &rhs) {
+                            return lhs.first == rhs.first;
+                          }),
+              index.end());
+  log->info(
+      "loaded {} entries from {} segments", index.size(), segments.size());
+
+  return std::make_unique<SegmentedFile>(path,
+                                         std::move(index),
+                                         last_segment,
+                                         last_segment_size,
+                                         segment_size,
+                                         private_tag{},
+                                         std::move(log));
+}
+
+bool SegmentedFile::add(Identifier id, const Bytes &blob) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+  auto position =
+      std::lower_bound(index_.begin(),
+                       index_.end(),
+                       IndexType::value_type{id, Location{}},
+                       compareIds);
+  if (position != index_.end() and position->first == id) {
+    log_->warn("insertion for {} failed, because entry already exists", id);
+    return false;
+  }
+
+  const uint64_t record_size = sizeof(RecordHeader) + blob.size();
+  if (current_segment_size_ > 0
+      and current_segment_size_ + record_size > segment_size_) {
+    data_stream_.close();
+    index_stream_.close();
+    ++current_segment_;
+    current_segment_size_ = 0;
+  }
+  if (not data_stream_.is_open() and not openSegment()) {
+    log_->warn("Cannot open segment {} for writing", current_segment_);
+    return false;
+  }
+
+  const RecordHeader header{id, static_cast<uint32_t>(blob.size())};
+  const IndexEntry entry{id, header.size, current_segment_size_};
+
+  data_stream_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  data_stream_.write(reinterpret_cast<const char *>(blob.data()), blob.size());
+  data_stream_.flush();
+  if (not data_stream_) {
+    log_->warn("Cannot write entry {} to segment {}", id, current_segment_);
+    // the torn record is truncated on the next load, and the stream is
+    // reopened on the next insertion
+    data_stream_.close();
+    index_stream_.close();
+    ++current_segment_;
+    current_segment_size_ = 0;
+    return false;
+  }
+  // index is written after the data, so that a record is never indexed before
+  // it is complete; a missing index entry is restored on load
+  index_stream_.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+  index_stream_.flush();
+
+  index_.emplace(
+      position,
+      id,
+      Location{current_segment_, header.size, current_segment_size_});
+  current_segment_size_ += record_size;
+  return true;
+}
+
+boost::optional<SegmentedFile::Bytes> SegmentedFile::get(Identifier id) const {
+  auto view = getView(id);
+  if (not view) {
+    return boost::none;
+  }
+  return Bytes(view->data(), view->data() + view->size());
+}
+
+boost::optional<SegmentedFile::BytesView> SegmentedFile::getView(
+    Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  auto position =
+      std::lower_bound(index_.begin(),
+                       index_.end(),
+                       IndexType::value_type{id, Location{}},
+                       compareIds);
+  if (position == index_.end() or position->first != id) {
+    log_->info("get({}) entry not found", id);
+    return boost::none;
+  }
+  const auto &location = position->second;
+
+  auto region = mapSegment(
+      location.segment,
+      location.offset + sizeof(RecordHeader) + location.size);
+  if (not region) {
+    log_->info("get({}) problem with mapping segment {}", id, location.segment);
+    return boost::none;
+  }
+  const auto *record =
+      static_cast<const uint8_t *>(region->get_address()) + location.offset;
+  RecordHeader header;
+  std::memcpy(&header, record, sizeof(header));
+  if (header.id != id or header.size != location.size) {
+    log_->error("get({}) segment {} is corrupted at offset {}",
+                id,
+                location.segment,
+                location.offset);
+    return boost::none;
+  }
+  return BytesView(region, record + sizeof(header), location.size);
+}
+
+std::string SegmentedFile::directory() const {
+  return dump_dir_;
+}
+
+Identifier SegmentedFile::last_id() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return index_.empty() ? 0 : index_.back().first;
+}
+
+void SegmentedFile::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  data_stream_.close();
+  index_stream_.close();
+  {
+    std::lock_guard<std::mutex> mappings_lock(mappings_mutex_);
+    mappings_.clear();
+  }
+  iroha::remove_dir_contents(dump_dir_, log_);
+  index_.clear();
+  current_segment_ = 0;
+  current_segment_size_ = 0;
+}
+
+// ----------| private API |----------
+
+SegmentedFile::SegmentedFile(std::string path,
+                             IndexType index,
+                             SegmentIdType last_segment,
+                             uint64_t last_segment_size,
+                             uint64_t segment_size,
+                             SegmentedFile::private_tag,
+                             logger::LoggerPtr log)
+    : dump_dir_(std::move(path)),
+      segment_size_(segment_size),
+      index_(std::move(index)),
+      current_segment_(last_segment),
+      current_segment_size_(last_segment_size),
+      log_{std::move(log)} {}
+
+SegmentedFile::~SegmentedFile() = default;
+
+uint64_t SegmentedFile::loadSegment(const std::string &path,
+                                    SegmentIdType segment,
+                                    IndexType &index,
+                                    const logger::LoggerPtr &log) {
+  const auto base = boost::filesystem::path{path} / segment_name(segment);
+  const auto data_path = base.string() + kDataExtension;
+  const auto index_path = base.string() + kIndexExtension;
+
+  boost::system::error_code err;
+  const uint64_t data_size = boost::filesystem::file_size(data_path, err);
+  if (err) {
+    log->error("Cannot read segment {}: {}", segment, err.message());
+    return 0;
+  }
+
+  uint64_t valid_size = 0;
+  uint64_t indexed_entries = 0;
+  {
+    std::ifstream index_file(index_path, std::ifstream::binary);
+    IndexEntry entry;
+    while (index_file.read(reinterpret_cast<char *>(&entry), sizeof(entry))) {
+      if (entry.offset != valid_size
+          or entry.offset + sizeof(RecordHeader) + entry.size > data_size) {
+        break;
+      }
+      index.emplace_back(entry.id,
+                         Location{segment, entry.size, entry.offset});
+      valid_size += sizeof(RecordHeader) + entry.size;
+      ++indexed_entries;
+    }
+  }
+
+  // records which were written to the data file, but not to the index file
+  std::vector<IndexEntry> restored;
+  {
+    std::ifstream data_file(data_path, std::ifstream::binary);
+    RecordHeader header;
+    while (valid_size + sizeof(header) <= data_size
+           and data_file.seekg(valid_size)
+           and data_file.read(reinterpret_cast<char *>(&header),
+                              sizeof(header))) {
+      if (valid_size + sizeof(header) + header.size > data_size) {
+        break;
+      }
+      restored.push_back(IndexEntry{header.id, header.size, valid_size});
+      index.emplace_back(header.id,
+                         Location{segment, header.size, valid_size});
+      valid_size += sizeof(header) + header.size;
+    }
+  }
+
+  if (valid_size != data_size) {
+    log->warn("Segment {} has a torn record, truncating from {} to {} bytes",
+              segment,
+              data_size,
+              valid_size);
+    boost::filesystem::resize_file(data_path, valid_size, err);
+  }
+  boost::filesystem::resize_file(
+      index_path, indexed_entries * sizeof(IndexEntry), err);
+  if (not restored.empty()) {
+    log->warn("Restoring {} index entries of segment {}",
+              restored.size(),
+              segment);
+    std::ofstream index_file(index_path,
+                             std::ofstream::binary | std::ofstream::app);
+    index_file.write(reinterpret_cast<const char *>(restored.data()),
+                     restored.size() * sizeof(IndexEntry));
+  }
+  return valid_size;
+}
+
+bool SegmentedFile::openSegment() {
+  data_stream_.open(dataPath(current_segment_),
+                    std::ofstream::binary | std::ofstream::app);
+  index_stream_.open(indexPath(current_segment_),
+                     std::ofstream::binary | std::ofstream::app);
+  if (data_stream_.is_open() and index_stream_.is_open()) {
+    return true;
+  }
+  data_stream_.close();
+  index_stream_.close();
+  return false;
+}
+
+std::shared_ptr<const boost::interprocess::mapped_region>
+SegmentedFile::mapSegment(SegmentIdType segment, uint64_t size) const {
+  std::lock_guard<std::mutex> lock(mappings_mutex_);
+  auto &region = mappings_[segment];
+  if (region and region->get_size() >= size) {
+    return region;
+  }
+  // the segment has grown since it was mapped, views of the previous mapping
+  // stay valid as long as they are alive
+  try {
+    boost::interprocess::file_mapping file(dataPath(segment).c_str(),
+                                           boost::interprocess::read_only);
+    region = std::make_shared<const boost::interprocess::mapped_region>(
+        file, boost::interprocess::read_only);
+  } catch (const std::exception &e) {
+    log_->error("Cannot map segment {}: {}", segment, e.what());
+    region.reset();
+    return nullptr;
+  }
+  if (region->get_size() < size) {
+    log_->error("Segment {} is shorter than expected", segment);
+    return nullptr;
+  }
+  return region;
+}
+
+std::string SegmentedFile::dataPath(SegmentIdType segment) const {
+  return (boost::filesystem::path{dump_dir_} / segment_name(segment)).string()
+      + kDataExtension;
+}
+
+std::string SegmentedFile::indexPath(SegmentIdType segment) const {
+  return (boost::filesystem::path{dump_dir_} / segment_name(segment)).string()
+      + kIndexExtension;
+}
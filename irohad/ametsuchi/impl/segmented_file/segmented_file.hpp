@@ -0,0 +1,222 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SEGMENTED_FILE_HPP
+#define IROHA_SEGMENTED_FILE_HPP
+
+#include "ametsuchi/key_value_storage.hpp"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "logger/logger_fwd.hpp"
+
+namespace boost {
+  namespace interprocess {
+    class mapped_region;
+  }
+}  // namespace boost
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Solid storage which appends entries to large segment files.
+     *
+     * Every segment consists of two files: a data file with a sequence of
+     * records (entry header followed by the blob) and an index file with the
+     * offsets of these records. A new segment is started when the current one
+     * exceeds the configured size, so the number of files stays proportional
+     * to the ledger size in bytes instead of the number of entries.
+     *
+     * Segments are read through read-only memory mappings, so views returned
+     * by getView point directly to the mapped data.
+     */
+    class SegmentedFile : public KeyValueStorage {
+      /**
+       * Private tag used to construct unique and shared pointers
+       * without new operator
+       */
+      struct private_tag {};
+
+     public:
+      // ----------| public API |----------
+
+      using SegmentIdType = uint32_t;
+
+      /// Size after which a new segment is started
+      static const uint64_t kDefaultSegmentSize = 64 * 1024 * 1024;
+
+      static const std::string kDataExtension;
+      static const std::string kIndexExtension;
+
+      /**
+       * Location of a stored entry
+       */
+      struct Location {
+        SegmentIdType segment;
+        uint32_t size;
+        uint64_t offset;
+      };
+
+      /**
+       * Record header preceding each blob in a data file
+       */
+      struct RecordHeader {
+        Identifier id;
+        uint32_t size;
+      };
+
+      /**
+       * Entry of a segment index file
+       */
+      struct IndexEntry {
+        Identifier id;
+        uint32_t size;
+        uint64_t offset;
+      };
+
+      /**
+       * Convert segment id to a file name without extension. The name is
+       * always 16 characters wide and filled with leading zeros.
+       * @param id - segment id
+       * @return segment file name
+       */
+      static std::string segment_name(SegmentIdType id);
+
+      /**
+       * Converts segment file name (see above) to its id
+       * @param name - file name to convert, including extension
+       * @return segment id or boost::none if name is not a data file name
+       */
+      static boost::optional<SegmentIdType> name_to_segment(
+          const std::string &name);
+
+      /**
+       * Create storage in path. Segments found in the path are loaded, torn
+       * records left by an interrupted write are truncated.
+       * @param path - target path for creating
+       * @param log - logger
+       * @param segment_size - size in bytes after which a new segment is
+       * started
+       * @return created storage
+       */
+      static boost::optional<std::unique_ptr<SegmentedFile>> create(
+          const std::string &path,
+          logger::LoggerPtr log,
+          uint64_t segment_size = kDefaultSegmentSize);
+
+      bool add(Identifier id, const Bytes &blob) override;
+
+      boost::optional<Bytes> get(Identifier id) const override;
+
+      boost::optional<BytesView> getView(Identifier id) const override;
+
+      std::string directory() const override;
+
+      Identifier last_id() const override;
+
+      void dropAll() override;
+
+      // ----------| modify operations |----------
+
+      SegmentedFile(const SegmentedFile &rhs) = delete;
+
+      SegmentedFile(SegmentedFile &&rhs) = delete;
+
+      SegmentedFile &operator=(const SegmentedFile &rhs) = delete;
+
+      SegmentedFile &operator=(SegmentedFile &&rhs) = delete;
+
+      // ----------| private API |----------
+
+      using IndexType = std::vector<std::pair<Identifier, Location>>;
+
+      /**
+       * Create storage in path
+       * @param path - folder of storage
+       * @param index - locations of existing entries sorted by id
+       * @param last_segment - id of the segment to append to
+       * @param last_segment_size - current size of the last segment
+       * @param segment_size - size after which a new segment is started
+       * @param log to print progress
+       */
+      SegmentedFile(std::string path,
+                    IndexType index,
+                    SegmentIdType last_segment,
+                    uint64_t last_segment_size,
+                    uint64_t segment_size,
+                    SegmentedFile::private_tag,
+                    logger::LoggerPtr log);
+
+      ~SegmentedFile() override;
+
+     private:
+      /**
+       * Load index of a single segment, restoring entries which are present
+       * in the data file but absent in the index file
+       * @param path - folder of storage
+       * @param segment - segment id
+       * @param index - index to append found entries to
+       * @param log - logger
+       * @return size of valid data in the segment
+       */
+      static uint64_t loadSegment(const std::string &path,
+                                  SegmentIdType segment,
+                                  IndexType &index,
+                                  const logger::LoggerPtr &log);
+
+      /**
+       * Open streams for appending to the current segment
+       * @return true if both streams were opened
+       */
+      bool openSegment();
+
+      /**
+       * Get read-only mapping of a segment data file, which covers at least
+       * the given size. Mapping is reused until the segment outgrows it
+       * @param segment - segment id
+       * @param size - required size of the mapping
+       * @return mapping or nullptr if the segment cannot be mapped
+       */
+      std::shared_ptr<const boost::interprocess::mapped_region> mapSegment(
+          SegmentIdType segment, uint64_t size) const;
+
+      std::string dataPath(SegmentIdType segment) const;
+
+      std::string indexPath(SegmentIdType segment) const;
+
+      /**
+       * Folder of storage
+       */
+      const std::string dump_dir_;
+
+      const uint64_t segment_size_;
+
+      IndexType index_;
+
+      SegmentIdType current_segment_;
+      uint64_t current_segment_size_;
+
+      std::ofstream data_stream_;
+      std::ofstream index_stream_;
+
+      mutable std::shared_timed_mutex mutex_;
+
+      mutable std::unordered_map<
+          SegmentIdType,
+          std::shared_ptr<const boost::interprocess::mapped_region>>
+          mappings_;
+      mutable std::mutex mappings_mutex_;
+
+      logger::LoggerPtr log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SEGMENTED_FILE_HPP
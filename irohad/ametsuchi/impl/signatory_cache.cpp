@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/signatory_cache.hpp"
+
+#include <iterator>
+
+#include "common/visitor.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    SignatoryCache::SignatoryCache(size_t capacity)
+        : capacity_(capacity), version_(0) {}
+
+    SignatoryCache::VersionType SignatoryCache::version() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return version_;
+    }
+
+    SignatoryCache::EntryType SignatoryCache::get(
+        const shared_model::interface::types::AccountIdType &account_id)
+        const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto found = entries_.find(account_id);
+      if (found == entries_.end()) {
+        return nullptr;
+      }
+      return found->second;
+    }
+
+    void SignatoryCache::insert(
+        const shared_model::interface::types::AccountIdType &account_id,
+        EntryType entry,
+        VersionType version) {
+      if (capacity_ == 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (version != version_) {
+        return;
+      }
+      if (entries_.size() >= capacity_
+          and entries_.find(account_id) == entries_.end()) {
+        entries_.erase(entries_.begin());
+      }
+      entries_[account_id] = std::move(entry);
+    }
+
+    void SignatoryCache::invalidate(
+        const shared_model::interface::Block &block) {
+      std::vector<shared_model::interface::types::AccountIdType> accounts;
+      for (const auto &tx : block.transactions()) {
+        auto tx_accounts = affectedAccounts(tx);
+        std::move(tx_accounts.begin(),
+                  tx_accounts.end(),
+                  std::back_inserter(accounts));
+      }
+      if (accounts.empty()) {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++version_;
+      for (const auto &account_id : accounts) {
+        entries_.erase(account_id);
+      }
+    }
+
+    std::vector<shared_model::interface::types::AccountIdType>
+    SignatoryCache::affectedAccounts(
+        const shared_model::interface::Transaction &transaction) {
+      std::vector<shared_model::interface::types::AccountIdType> accounts;
+      for (const auto &command : transaction.commands()) {
+        iroha::visit_in_place(
+            command.get(),
+            [&accounts](const shared_model::interface::AddSignatory &c) {
+              accounts.push_back(c.accountId());
+            },
+            [&accounts](const shared_model::interface::RemoveSignatory &c) {
+              accounts.push_back(c.accountId());
+            },
+            [&accounts](const shared_model::interface::SetQuorum &c) {
+              accounts.push_back(c.accountId());
+            },
+            [&accounts](const shared_model::interface::CreateAccount &c) {
+              accounts.push_back(c.accountName() + "@" + c.domainId());
+            },
+            [](const auto &) {});
+      }
+      return accounts;
+    }
+
+    void SignatoryCache::clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++version_;
+      entries_.clear();
+    }
+
+    size_t SignatoryCache::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return entries_.size();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
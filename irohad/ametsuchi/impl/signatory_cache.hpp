@@ -0,0 +1,123 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SIGNATORY_CACHE_HPP
+#define IROHA_SIGNATORY_CACHE_HPP
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "interfaces/common_objects/types.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+    class Transaction;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Signatories and quorum of an account
+     */
+    struct AccountSignatories {
+      /// hex representations of public keys of the signatories
+      std::unordered_set<std::string> signatories;
+      shared_model::interface::types::QuorumType quorum;
+    };
+
+    /**
+     * Cache of signatories and quorums of accounts in the committed WSV.
+     * Entries of accounts are forgotten when a block with commands, which can
+     * change them, is committed.
+     * Like in PermissionCache, every invalidation increments version of the
+     * cache, and entries read from the WSV before the invalidation are not
+     * cached.
+     */
+    class SignatoryCache {
+     public:
+      using VersionType = uint64_t;
+      using EntryType = std::shared_ptr<const AccountSignatories>;
+
+      /// Number of accounts kept by default
+      static const size_t kDefaultCapacity = 1 << 16;
+
+      /**
+       * @param capacity - maximum number of cached accounts
+       */
+      explicit SignatoryCache(size_t capacity = kDefaultCapacity);
+
+      /**
+       * @return current version of the cache, which is to be taken before
+       * signatories are read from the WSV
+       */
+      VersionType version() const;
+
+      /**
+       * Get cached signatories of the account
+       * @param account_id - id of the account
+       * @return signatories and quorum, or nullptr if they are not cached
+       */
+      EntryType get(
+          const shared_model::interface::types::AccountIdType &account_id)
+          const;
+
+      /**
+       * Cache signatories of the account. An arbitrary account is evicted if
+       * the cache is full
+       * @param account_id - id of the account
+       * @param entry - signatories and quorum read from the WSV
+       * @param version - version of the cache taken before the entry was
+       * read; the entry is not cached if it is outdated
+       */
+      void insert(
+          const shared_model::interface::types::AccountIdType &account_id,
+          EntryType entry,
+          VersionType version);
+
+      /**
+       * Forget signatories of the accounts, which are changed by commands of
+       * the block
+       * @param block - committed block
+       */
+      void invalidate(const shared_model::interface::Block &block);
+
+      /**
+       * @param transaction - transaction to inspect
+       * @return ids of accounts, whose signatories or quorum can be changed by
+       * commands of the transaction
+       */
+      static std::vector<shared_model::interface::types::AccountIdType>
+      affectedAccounts(const shared_model::interface::Transaction &transaction);
+
+      /**
+       * Forget signatories of all accounts
+       */
+      void clear();
+
+      /**
+       * @return number of cached accounts
+       */
+      size_t size() const;
+
+     private:
+      const size_t capacity_;
+
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         EntryType>
+          entries_;
+      VersionType version_;
+      mutable std::mutex mutex_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SIGNATORY_CACHE_HPP
@@ -5,9 +5,11 @@
 
 #include "ametsuchi/impl/storage_impl.hpp"
 
+#include <thread>
+
 #include <soci/postgresql/soci-postgresql.h>
 #include <boost/format.hpp>
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/block_cursor.hpp"
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
 #include "ametsuchi/impl/peer_query_wsv.hpp"
 #include "ametsuchi/impl/postgres_block_index.hpp"
@@ -15,11 +17,12 @@
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 #include "ametsuchi/impl/postgres_query_executor.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_snapshot.hpp"
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 #include "backend/protobuf/permissions.hpp"
 #include "common/bind.hpp"
 #include "common/byteutils.hpp"
-#include "converters/protobuf/json_proto_converter.hpp"
 #include "logger/logger.hpp"
 #include "logger/logger_manager.hpp"
 
@@ -51,6 +54,10 @@ namespace iroha {
     const char *kCommandExecutorError = "Cannot create CommandExecutorFactory";
     const char *kPsqlBroken = "Connection to PostgreSQL broken: %s";
     const char *kTmpWsv = "TemporaryWsv";
+    /// number of decoded blocks waiting to be replayed
+    const size_t kReplayQueueSize = 64;
+    /// number of blocks added to the block index in one transaction
+    const size_t kIndexChunkSize = 1000;
 
     ConnectionContext::ConnectionContext(
         std::unique_ptr<KeyValueStorage> block_store)
@@ -62,7 +69,8 @@ namespace iroha {
         std::unique_ptr<KeyValueStorage> block_store,
         std::shared_ptr<soci::connection_pool> connection,
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
-        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::BlockBinaryConverter>
+            converter,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
         std::unique_ptr<BlockStorageFactory> block_storage_factory,
@@ -77,6 +85,9 @@ namespace iroha {
           converter_(std::move(converter)),
           perm_converter_(std::move(perm_converter)),
           block_storage_factory_(std::move(block_storage_factory)),
+          block_cache_(std::make_shared<BlockCache>()),
+          permission_cache_(std::make_shared<PermissionCache>()),
+          signatory_cache_(std::make_shared<SignatoryCache>()),
           log_manager_(std::move(log_manager)),
           log_(log_manager_->getLogger()),
           pool_size_(pool_size),
@@ -84,6 +95,16 @@ namespace iroha {
           block_is_prepared(false) {
       prepared_block_name_ =
           "prepared_block" + postgres_options_.dbname().value_or("");
+      // committed blocks are cached as copies, so that readers do not share
+      // the object with the committer
+      notifier_.get_observable().subscribe(
+          [block_cache = block_cache_, log = log_](const auto &block) {
+            block_cache->insert(clone(*block));
+            log->debug("block cache: {} hits, {} misses",
+                       block_cache->hits(),
+                       block_cache->misses());
+          });
+
       soci::session sql(*connection_);
       // rollback current prepared transaction
       // if there exists any since last session
@@ -117,6 +138,7 @@ namespace iroha {
               std::move(sql),
               factory_,
               perm_converter_,
+              signatory_cache_,
               log_manager_->getChild("TemporaryWorldStateView")));
     }
 
@@ -189,6 +211,8 @@ namespace iroha {
               *block_store_,
               std::move(pending_txs_storage),
               converter_,
+              block_cache_,
+              permission_cache_,
               std::move(response_factory),
               perm_converter_,
               log_manager_->getChild("QueryExecutor")));
@@ -236,6 +260,149 @@ namespace iroha {
       return inserted;
     }
 
+    expected::Result<shared_model::interface::types::HeightType, std::string>
+    StorageImpl::createWsvSnapshot() {
+      std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+      if (not connection_) {
+        return expected::makeError("Connection was closed");
+      }
+      soci::session sql(*connection_);
+      return PostgresWsvSnapshot(
+                 sql, log_manager_->getChild("WsvSnapshot")->getLogger())
+                 .save()
+          | [](const auto &info)
+                 -> expected::Result<shared_model::interface::types::HeightType,
+                                     std::string> {
+        return expected::makeValue(
+            shared_model::interface::types::HeightType{info.height});
+      };
+    }
+
+    expected::Result<shared_model::interface::types::HeightType, std::string>
+    StorageImpl::restoreWsvSnapshot() {
+      using shared_model::interface::types::HeightType;
+      auto block_query = getBlockQuery();
+
+      boost::optional<HeightType> snapshot_height;
+      {
+        std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+        if (not connection_ or not block_query) {
+          return expected::makeError("Connection was closed");
+        }
+        soci::session sql(*connection_);
+        if (block_is_prepared) {
+          rollbackPrepared(sql);
+        }
+
+        PostgresWsvSnapshot snapshot(
+            sql, log_manager_->getChild("WsvSnapshot")->getLogger());
+        // the WSV is replaced, so none of the cached permissions are valid
+        permission_cache_->clear();
+        signatory_cache_->clear();
+        snapshot_height = snapshot.info().match(
+            [&](expected::Value<boost::optional<WsvSnapshotInfo>> &info)
+                -> boost::optional<HeightType> {
+              if (not info.value) {
+                return boost::none;
+              }
+              // the snapshot is usable only if the block it was taken at is
+              // still in the block store
+              auto blocks = block_query->getBlocks(info.value->height, 1);
+              if (blocks.empty()
+                  or blocks.front()->hash().hex() != info.value->top_hash) {
+                log_->warn("WSV snapshot at height {} does not match blocks",
+                           info.value->height);
+                return boost::none;
+              }
+              return snapshot.load().match(
+                  [&](expected::Value<void> &) -> boost::optional<HeightType> {
+                    return info.value->height;
+                  },
+                  [&](expected::Error<std::string> &error)
+                      -> boost::optional<HeightType> {
+                    log_->warn(error.error);
+                    return boost::none;
+                  });
+            },
+            [&](expected::Error<std::string> &error)
+                -> boost::optional<HeightType> {
+              log_->warn(error.error);
+              return boost::none;
+            });
+
+        if (snapshot_height) {
+          log_->info("restored WSV snapshot at height {}", *snapshot_height);
+        } else {
+          log_->info("drop wsv records from db tables");
+          auto clear_result = snapshot.clear();
+          if (auto e =
+                  boost::get<expected::Error<std::string>>(&clear_result)) {
+            return *e;
+          }
+        }
+      }
+
+      // the block index is not a part of the snapshot, so it is completed up
+      // to the snapshot height, and the rest is indexed on replay
+      const HeightType restored_height = snapshot_height.value_or(0);
+      auto index_var = blockIndexHeight();
+      if (auto e = boost::get<expected::Error<std::string>>(&index_var)) {
+        return *e;
+      }
+      auto indexed_height =
+          boost::get<expected::Value<HeightType>>(&index_var)->value;
+      if (indexed_height < restored_height) {
+        auto index_result = indexBlocks(indexed_height + 1, restored_height);
+        if (auto e = boost::get<expected::Error<std::string>>(&index_result)) {
+          return *e;
+        }
+      }
+      return expected::makeValue(HeightType{restored_height});
+    }
+
+    expected::Result<void, std::string> StorageImpl::replayBlocks(
+        BlockCursor &blocks, size_t chunk_size) {
+      // blocks, which are already in the block index, are not indexed again
+      auto index_var = blockIndexHeight();
+      if (auto e = boost::get<expected::Error<std::string>>(&index_var)) {
+        return *e;
+      }
+      auto indexed_height =
+          boost::get<
+              expected::Value<shared_model::interface::types::HeightType>>(
+              &index_var)
+              ->value;
+
+      BoundedQueue<std::shared_ptr<shared_model::interface::Block>> queue(
+          kReplayQueueSize);
+      // blocks are read and decoded on a separate thread, while the previous
+      // ones are applied
+      std::thread loader([&blocks, &queue] {
+        while (auto block = blocks.next()) {
+          // hashes are evaluated lazily, so they are computed before the
+          // block is passed to the applying thread
+          (*block)->hash();
+          for (const auto &tx : (*block)->transactions()) {
+            tx.hash();
+          }
+          if (not queue.push(std::move(*block))) {
+            break;
+          }
+        }
+        queue.close();
+      });
+
+      auto result =
+          applyBlocks(queue, std::max<size_t>(chunk_size, 1), indexed_height);
+      // stop the loader if the blocks were not applied
+      queue.close();
+      loader.join();
+      // replayed blocks are not passed to storeBlock
+      permission_cache_->clear();
+      signatory_cache_->clear();
+      return result;
+    }
+
     void StorageImpl::reset() {
       log_->info("drop wsv records from db tables");
       try {
@@ -245,8 +412,14 @@ namespace iroha {
           rollbackPrepared(sql);
         }
         sql << reset_;
+        PostgresWsvSnapshot(
+            sql, log_manager_->getChild("WsvSnapshot")->getLogger())
+            .drop();
         log_->info("drop blocks from disk");
         block_store_->dropAll();
+        block_cache_->clear();
+        permission_cache_->clear();
+        signatory_cache_->clear();
       } catch (std::exception &e) {
         log_->warn("Drop wsv was failed. Reason: {}", e.what());
       }
@@ -278,11 +451,18 @@ namespace iroha {
         soci::session(*connection_) << reset_;
         // Empty tables can now be dropped very fast.
         soci::session(*connection_) << drop_;
+        soci::session sql(*connection_);
+        PostgresWsvSnapshot(
+            sql, log_manager_->getChild("WsvSnapshot")->getLogger())
+            .drop();
       }
 
       // erase blocks
       log_->info("drop block store");
       block_store_->dropAll();
+      block_cache_->clear();
+      permission_cache_->clear();
+      signatory_cache_->clear();
     }
 
     void StorageImpl::freeConnections() {
@@ -337,7 +517,7 @@ namespace iroha {
                                  logger::LoggerPtr log) {
       log->info("Start storage creation");
 
-      auto block_store = FlatFile::create(block_store_dir, log);
+      auto block_store = SegmentedFile::create(block_store_dir, log);
       if (not block_store) {
         return expected::makeError(
             (boost::format("Cannot create block store in %s") % block_store_dir)
@@ -369,7 +549,8 @@ namespace iroha {
         std::string block_store_dir,
         std::string postgres_options,
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
-        std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
+        std::shared_ptr<shared_model::interface::BlockBinaryConverter>
+            converter,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
         std::unique_ptr<BlockStorageFactory> block_storage_factory,
@@ -518,6 +699,7 @@ namespace iroha {
           std::make_unique<soci::session>(*connection_),
           *block_store_,
           converter_,
+          block_cache_,
           log_manager_->getChild("PostgresBlockQuery")->getLogger());
     }
 
@@ -533,9 +715,9 @@ namespace iroha {
         return;
       }
       if (not block_is_prepared) {
-        soci::session &sql = *wsv_impl.sql_;
         try {
-          sql << "PREPARE TRANSACTION '" + prepared_block_name_ + "';";
+          wsv_impl.executeWithDeferred("PREPARE TRANSACTION '"
+                                       + prepared_block_name_ + "';");
           block_is_prepared = true;
         } catch (const std::exception &e) {
           log_->warn("failed to prepare state: {}", e.what());
@@ -558,11 +740,147 @@ namespace iroha {
       }
     }
 
+    expected::Result<std::unique_ptr<MutableStorageImpl>, std::string>
+    StorageImpl::createReplayStorage() {
+      return createMutableStorage().match(
+          [](expected::Value<std::unique_ptr<MutableStorage>> &storage)
+              -> expected::Result<std::unique_ptr<MutableStorageImpl>,
+                                  std::string> {
+            // mutable storages of the storage are always MutableStorageImpl
+            return expected::makeValue(std::unique_ptr<MutableStorageImpl>(
+                static_cast<MutableStorageImpl *>(storage.value.release())));
+          },
+          [](expected::Error<std::string> &error)
+              -> expected::Result<std::unique_ptr<MutableStorageImpl>,
+                                  std::string> {
+            return expected::makeError(error.error);
+          });
+    }
+
+    expected::Result<shared_model::interface::types::HeightType, std::string>
+    StorageImpl::blockIndexHeight() {
+      using shared_model::interface::types::HeightType;
+      auto block_query = getBlockQuery();
+
+      std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+      if (not connection_ or not block_query) {
+        return expected::makeError("Connection was closed");
+      }
+      try {
+        soci::session sql(*connection_);
+        boost::optional<HeightType> height;
+        boost::optional<std::string> hash;
+        sql << "SELECT height, hash FROM height_by_block_hash "
+               "ORDER BY height DESC LIMIT 1",
+            soci::into(height), soci::into(hash);
+        if (height and hash) {
+          auto blocks = block_query->getBlocks(*height, 1);
+          if (not blocks.empty() and blocks.front()->hash().hex() == *hash) {
+            return expected::makeValue(HeightType{*height});
+          }
+          log_->warn("block index at height {} does not match blocks",
+                     *height);
+        }
+        // remaining rows of a partial index would conflict with the rebuilt
+        // one
+        sql << reset_block_index_;
+        return expected::makeValue(HeightType{0});
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            (boost::format("Failed to check block index: %s") % e.what())
+                .str());
+      }
+    }
+
+    expected::Result<void, std::string> StorageImpl::indexBlocks(
+        shared_model::interface::types::HeightType from,
+        shared_model::interface::types::HeightType to) {
+      log_->info("index blocks from height {} to {}", from, to);
+      auto block_query = getBlockQuery();
+      if (not block_query) {
+        return expected::makeError("Connection was closed");
+      }
+      BlockCursor blocks(*block_query, from);
+      auto block = blocks.next();
+      while (block and (*block)->height() <= to) {
+        auto storage_var = createReplayStorage();
+        if (auto e = boost::get<expected::Error<std::string>>(&storage_var)) {
+          return *e;
+        }
+        auto storage = std::move(
+            boost::get<expected::Value<std::unique_ptr<MutableStorageImpl>>>(
+                &storage_var)
+                ->value);
+
+        for (size_t indexed = 0;
+             block and (*block)->height() <= to and indexed < kIndexChunkSize;
+             ++indexed, block = blocks.next()) {
+          storage->index(**block);
+        }
+        auto commit_result = storage->commitReplayed();
+        if (auto e = boost::get<expected::Error<std::string>>(&commit_result)) {
+          return *e;
+        }
+      }
+      return {};
+    }
+
+    expected::Result<void, std::string> StorageImpl::applyBlocks(
+        BoundedQueue<std::shared_ptr<shared_model::interface::Block>> &blocks,
+        size_t chunk_size,
+        shared_model::interface::types::HeightType indexed_height) {
+      // chunks before a failed one stay committed, so the error tells how
+      // far the WSV is replayed
+      boost::optional<shared_model::interface::types::HeightType>
+          replayed_height;
+      auto replay_error = [&replayed_height](const std::string &error) {
+        return expected::makeError(
+            replayed_height
+                ? (boost::format("%s, WSV is replayed up to height %d") % error
+                   % *replayed_height)
+                      .str()
+                : error + ", no blocks are replayed");
+      };
+
+      auto block = blocks.pop();
+      while (block) {
+        auto storage_var = createReplayStorage();
+        if (auto e = boost::get<expected::Error<std::string>>(&storage_var)) {
+          return replay_error(e->error);
+        }
+        auto storage = std::move(
+            boost::get<expected::Value<std::unique_ptr<MutableStorageImpl>>>(
+                &storage_var)
+                ->value);
+
+        auto height = (*block)->height();
+        for (size_t applied = 0; block and applied < chunk_size;
+             ++applied, block = blocks.pop()) {
+          height = (*block)->height();
+          if (not storage->replay(**block, height > indexed_height)) {
+            return replay_error(
+                (boost::format("Failed to apply block %d") % height).str());
+          }
+        }
+        auto commit_result = storage->commitReplayed();
+        if (auto e = boost::get<expected::Error<std::string>>(&commit_result)) {
+          return replay_error(e->error);
+        }
+        replayed_height = height;
+        log_->info("replayed blocks up to height {}", height);
+      }
+      return {};
+    }
+
     bool StorageImpl::storeBlock(
         std::shared_ptr<const shared_model::interface::Block> block) {
-      auto json_result = converter_->serialize(*block);
-      return json_result.match(
+      auto serialized_block = converter_->serialize(*block);
+      return serialized_block.match(
           [this, &block](const expected::Value<std::string> &v) {
+            // the block is already committed to the WSV, so permissions read
+            // after the invalidation are up to date
+            permission_cache_->invalidate(*block);
+            signatory_cache_->invalidate(*block);
             block_store_->add(block->height(), stringToBytes(v.value));
             notifier_.get_subscriber().on_next(block);
             return true;
@@ -586,6 +904,7 @@ DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
 DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS height_by_block_hash;
 DROP INDEX IF EXISTS tx_status_by_hash_hash_index;
 DROP TABLE IF EXISTS tx_status_by_hash;
 DROP TABLE IF EXISTS height_by_account_set;
@@ -606,6 +925,16 @@ TRUNCATE TABLE domain RESTART IDENTITY CASCADE;
 TRUNCATE TABLE signatory RESTART IDENTITY CASCADE;
 TRUNCATE TABLE peer RESTART IDENTITY CASCADE;
 TRUNCATE TABLE role RESTART IDENTITY CASCADE;
+TRUNCATE TABLE height_by_block_hash RESTART IDENTITY CASCADE;
+TRUNCATE TABLE position_by_hash RESTART IDENTITY CASCADE;
+TRUNCATE TABLE tx_status_by_hash RESTART IDENTITY CASCADE;
+TRUNCATE TABLE height_by_account_set RESTART IDENTITY CASCADE;
+TRUNCATE TABLE index_by_creator_height RESTART IDENTITY CASCADE;
+TRUNCATE TABLE position_by_account_asset RESTART IDENTITY CASCADE;
+)";
+
+    const std::string &StorageImpl::reset_block_index_ = R"(
+TRUNCATE TABLE height_by_block_hash RESTART IDENTITY CASCADE;
 TRUNCATE TABLE position_by_hash RESTART IDENTITY CASCADE;
 TRUNCATE TABLE tx_status_by_hash RESTART IDENTITY CASCADE;
 TRUNCATE TABLE height_by_account_set RESTART IDENTITY CASCADE;
@@ -679,10 +1008,15 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
         + R"() NOT NULL,
     PRIMARY KEY (permittee_account_id, account_id)
 );
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash varchar PRIMARY KEY,
+    height bigint NOT NULL
+);
+
 CREATE TABLE IF NOT EXISTS position_by_hash (
     hash varchar,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
 
 CREATE TABLE IF NOT EXISTS tx_status_by_hash (
@@ -693,20 +1027,44 @@ CREATE INDEX IF NOT EXISTS tx_status_by_hash_hash_index ON tx_status_by_hash USI
 
 CREATE TABLE IF NOT EXISTS height_by_account_set (
     account_id text,
-    height text
+    height bigint
 );
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
     creator_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
 CREATE TABLE IF NOT EXISTS position_by_account_asset (
     account_id text,
     asset_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
+
+DO $$
+DECLARE
+    col record;
+BEGIN
+    -- index tables of earlier versions store heights and indexes as text
+    FOR col IN
+        SELECT table_name, column_name FROM information_schema.columns
+        WHERE table_schema = current_schema()
+            AND table_name IN ('position_by_hash', 'height_by_account_set',
+                'index_by_creator_height', 'position_by_account_asset')
+            AND column_name IN ('height', 'index')
+            AND data_type = 'text'
+    LOOP
+        EXECUTE format('ALTER TABLE %I ALTER COLUMN %I TYPE bigint USING %I::bigint',
+            col.table_name, col.column_name, col.column_name);
+    END LOOP;
+END $$;
+
+CREATE INDEX IF NOT EXISTS position_by_hash_hash_index ON position_by_hash (hash);
+CREATE INDEX IF NOT EXISTS position_by_hash_height_index ON position_by_hash (height, index);
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_index ON height_by_account_set (account_id, height);
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_index ON index_by_creator_height (creator_id, height, index);
+CREATE INDEX IF NOT EXISTS position_by_account_asset_account_id_index ON position_by_account_asset (account_id, asset_id, height, index);
 )";
   }  // namespace ametsuchi
 }  // namespace iroha
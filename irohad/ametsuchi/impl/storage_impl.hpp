@@ -15,10 +15,14 @@
 #include <soci/soci.h>
 #include <boost/optional.hpp>
 #include "ametsuchi/block_storage_factory.hpp"
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/permission_cache.hpp"
+#include "ametsuchi/impl/signatory_cache.hpp"
 #include "ametsuchi/impl/postgres_options.hpp"
 #include "ametsuchi/key_value_storage.hpp"
+#include "common/bounded_queue.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
-#include "interfaces/iroha_internal/block_json_converter.hpp"
+#include "interfaces/iroha_internal/block_binary_converter.hpp"
 #include "interfaces/permission_to_string.hpp"
 #include "logger/logger_fwd.hpp"
 #include "logger/logger_manager_fwd.hpp"
@@ -26,7 +30,7 @@
 namespace iroha {
   namespace ametsuchi {
 
-    class FlatFile;
+    class MutableStorageImpl;
 
     struct ConnectionContext {
       explicit ConnectionContext(std::unique_ptr<KeyValueStorage> block_store);
@@ -53,7 +57,7 @@ namespace iroha {
           std::string postgres_connection,
           std::shared_ptr<shared_model::interface::CommonObjectsFactory>
               factory,
-          std::shared_ptr<shared_model::interface::BlockJsonConverter>
+          std::shared_ptr<shared_model::interface::BlockBinaryConverter>
               converter,
           std::shared_ptr<shared_model::interface::PermissionToString>
               perm_converter,
@@ -95,6 +99,17 @@ namespace iroha {
           const std::vector<std::shared_ptr<shared_model::interface::Block>>
               &blocks) override;
 
+      expected::Result<shared_model::interface::types::HeightType,
+                       std::string>
+      createWsvSnapshot() override;
+
+      expected::Result<shared_model::interface::types::HeightType,
+                       std::string>
+      restoreWsvSnapshot() override;
+
+      expected::Result<void, std::string> replayBlocks(
+          BlockCursor &blocks, size_t chunk_size) override;
+
       void reset() override;
 
       void dropStorage() override;
@@ -125,7 +140,7 @@ namespace iroha {
                   std::shared_ptr<soci::connection_pool> connection,
                   std::shared_ptr<shared_model::interface::CommonObjectsFactory>
                       factory,
-                  std::shared_ptr<shared_model::interface::BlockJsonConverter>
+                  std::shared_ptr<shared_model::interface::BlockBinaryConverter>
                       converter,
                   std::shared_ptr<shared_model::interface::PermissionToString>
                       perm_converter,
@@ -148,6 +163,43 @@ namespace iroha {
        */
       void rollbackPrepared(soci::session &sql);
 
+      /**
+       * Create a mutable storage for blocks, which are already in the block
+       * store
+       */
+      expected::Result<std::unique_ptr<MutableStorageImpl>, std::string>
+      createReplayStorage();
+
+      /**
+       * Check that the top block of the block index is the one in the block
+       * store, and empty the index otherwise
+       * @return height of the top indexed block, 0 if the index is empty
+       */
+      expected::Result<shared_model::interface::types::HeightType,
+                       std::string>
+      blockIndexHeight();
+
+      /**
+       * Add blocks from the block store to the block index without applying
+       * them to the WSV
+       * @param from - height of the first block to index
+       * @param to - height of the last block to index
+       */
+      expected::Result<void, std::string> indexBlocks(
+          shared_model::interface::types::HeightType from,
+          shared_model::interface::types::HeightType to);
+
+      /**
+       * Apply blocks from the queue to the WSV, committing every chunk_size
+       * blocks. Blocks up to indexed_height are already in the block index,
+       * so only the rest are indexed
+       */
+      expected::Result<void, std::string> applyBlocks(
+          BoundedQueue<std::shared_ptr<shared_model::interface::Block>>
+              &blocks,
+          size_t chunk_size,
+          shared_model::interface::types::HeightType indexed_height);
+
       /**
        * add block to block storage
        */
@@ -164,13 +216,24 @@ namespace iroha {
           std::shared_ptr<const shared_model::interface::Block>>
           notifier_;
 
-      std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
+      std::shared_ptr<shared_model::interface::BlockBinaryConverter> converter_;
 
       std::shared_ptr<shared_model::interface::PermissionToString>
           perm_converter_;
 
       std::unique_ptr<BlockStorageFactory> block_storage_factory_;
 
+      /// blocks shared by block queries and query executors of the storage
+      std::shared_ptr<BlockCache> block_cache_;
+
+      /// role permissions of accounts shared by query executors of the
+      /// storage. Reflects the committed WSV only, so it must not be used on
+      /// the command path, which sees uncommitted role and grant changes
+      std::shared_ptr<PermissionCache> permission_cache_;
+
+      /// signatories of accounts shared by temporary WSVs of the storage
+      std::shared_ptr<SignatoryCache> signatory_cache_;
+
       logger::LoggerManagerTreePtr log_manager_;
       logger::LoggerPtr log_;
 
@@ -187,6 +250,7 @@ namespace iroha {
      protected:
       static const std::string &drop_;
       static const std::string &reset_;
+      static const std::string &reset_block_index_;
       static const std::string &init_;
     };
   }  // namespace ametsuchi
@@ -5,7 +5,10 @@
 
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 
-#include <boost/format.hpp>
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+#include "ametsuchi/impl/overlay_command_executor.hpp"
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/commands/command.hpp"
@@ -21,46 +24,69 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
+        std::shared_ptr<SignatoryCache> signatory_cache,
         logger::LoggerManagerTreePtr log_manager)
         : sql_(std::move(sql)),
           command_executor_(std::make_unique<PostgresCommandExecutor>(
               *sql_, std::move(perm_converter))),
+          overlay_executor_(std::make_unique<OverlayCommandExecutor>(
+              *sql_,
+              *command_executor_,
+              log_manager->getChild("OverlayCommandExecutor")->getLogger())),
+          signatory_cache_(std::move(signatory_cache)),
           log_manager_(std::move(log_manager)),
           log_(log_manager_->getLogger()) {
       *sql_ << "BEGIN";
     }
 
+    SignatoryCache::EntryType TemporaryWsvImpl::getSignatories(
+        const shared_model::interface::types::AccountIdType &account_id) {
+      // signatories of accounts changed by the applied transactions differ
+      // from the committed ones, which are cached
+      const bool is_modified = modified_accounts_.count(account_id) != 0;
+      if (not is_modified) {
+        if (auto entry = signatory_cache_->get(account_id)) {
+          return entry;
+        }
+      }
+
+      // rollbacks of failed transactions have to be executed before the
+      // state is read
+      if (not deferred_statements_.empty()) {
+        executeWithDeferred("");
+      }
+      const auto version = signatory_cache_->version();
+      boost::optional<int> quorum;
+      boost::optional<std::string> keys;
+      *sql_ << R"(SELECT quorum,
+                      (SELECT string_agg(public_key, ',')
+                      FROM account_has_signatory
+                      WHERE account_id = :account_id)
+                  FROM account
+                  WHERE account_id = :account_id)",
+          soci::into(quorum), soci::into(keys),
+          soci::use(account_id, "account_id");
+      if (not quorum) {
+        return nullptr;
+      }
+
+      auto entry = std::make_shared<AccountSignatories>();
+      entry->quorum = *quorum;
+      if (keys) {
+        boost::split(entry->signatories, *keys, boost::is_any_of(","));
+      }
+      if (not is_modified) {
+        signatory_cache_->insert(account_id, entry, version);
+      }
+      return entry;
+    }
+
     expected::Result<void, validation::CommandError>
     TemporaryWsvImpl::validateSignatures(
         const shared_model::interface::Transaction &transaction) {
-      auto keys_range = transaction.signatures()
-          | boost::adaptors::transformed(
-                            [](const auto &s) { return s.publicKey().hex(); });
-      auto keys = std::accumulate(
-          std::next(std::begin(keys_range)),
-          std::end(keys_range),
-          keys_range.front(),
-          [](auto acc, const auto &val) { return acc + "'), ('" + val; });
-      // not using bool since it is not supported by SOCI
-      boost::optional<uint8_t> signatories_valid;
-
-      boost::format query(R"(SELECT sum(count) = :signatures_count
-                          AND sum(quorum) <= :signatures_count
-                  FROM
-                      (SELECT count(public_key)
-                      FROM ( VALUES ('%s') ) AS CTE1(public_key)
-                      WHERE public_key IN
-                          (SELECT public_key
-                          FROM account_has_signatory
-                          WHERE account_id = :account_id ) ) AS CTE2(count),
-                          (SELECT quorum
-                          FROM account
-                          WHERE account_id = :account_id) AS CTE3(quorum))");
-
+      SignatoryCache::EntryType account_signatories;
       try {
-        *sql_ << (query % keys).str(), soci::into(signatories_valid),
-            soci::use(boost::size(keys_range), "signatures_count"),
-            soci::use(transaction.creatorAccountId(), "account_id");
+        account_signatories = getSignatories(transaction.creatorAccountId());
       } catch (const std::exception &e) {
         auto error_str = "Transaction " + transaction.toString()
             + " failed signatures validation with db error: " + e.what();
@@ -70,7 +96,20 @@ namespace iroha {
             "signatures validation", 1, error_str, false});
       }
 
-      if (signatories_valid and *signatories_valid) {
+      // every signature has to belong to a signatory of the creator, and
+      // there have to be at least quorum of them
+      const auto signatures_count = boost::size(transaction.signatures());
+      const bool signatories_valid = account_signatories
+          and signatures_count >= account_signatories->quorum
+          and std::all_of(transaction.signatures().begin(),
+                          transaction.signatures().end(),
+                          [&account_signatories](const auto &signature) {
+                            return account_signatories->signatories.count(
+                                       signature.publicKey().hex())
+                                != 0;
+                          });
+
+      if (signatories_valid) {
         return {};
       } else {
         auto error_str = "Transaction " + transaction.toString()
@@ -84,55 +123,271 @@ namespace iroha {
 
     expected::Result<void, validation::CommandError> TemporaryWsvImpl::apply(
         const shared_model::interface::Transaction &transaction) {
-      const auto &tx_creator = transaction.creatorAccountId();
-      command_executor_->setCreatorAccountId(tx_creator);
-      command_executor_->doValidation(true);
-      auto execute_command =
-          [this](auto &command) -> expected::Result<void, CommandError> {
-        // Validate and execute command
-        return boost::apply_visitor(*command_executor_, command.get());
-      };
+      return std::move(applyTransactions({std::cref(transaction)}).front());
+    }
 
-      auto savepoint_wrapper = createSavepoint("savepoint_temp_wsv");
-
-      return validateSignatures(transaction) |
-                 [savepoint = std::move(savepoint_wrapper),
-                  &execute_command,
-                  &transaction]()
-                 -> expected::Result<void, validation::CommandError> {
-        // check transaction's commands validity
-        const auto &commands = transaction.commands();
-        validation::CommandError cmd_error;
-        for (size_t i = 0; i < commands.size(); ++i) {
-          // in case of failed command, rollback and return
-          auto cmd_is_valid =
-              execute_command(commands[i])
-                  .match([](expected::Value<void> &) { return true; },
-                         [i, &cmd_error](expected::Error<CommandError> &error) {
-                           cmd_error = {error.error.command_name,
-                                        error.error.error_code,
-                                        error.error.error_extra,
-                                        true,
-                                        i};
-                           return false;
-                         });
-          if (not cmd_is_valid) {
-            return expected::makeError(cmd_error);
-          }
+    std::vector<expected::Result<void, validation::CommandError>>
+    TemporaryWsvImpl::applyTransactions(const TransactionRefs &transactions) {
+      std::vector<expected::Result<void, validation::CommandError>> results;
+      results.reserve(transactions.size());
+      std::vector<bool> in_memory;
+      in_memory.reserve(transactions.size());
+      for (const auto &transaction : transactions) {
+        in_memory.push_back(overlay_executor_->appliesInMemory(transaction));
+      }
+
+      while (results.size() < transactions.size()) {
+        auto begin = results.size();
+        if (not in_memory[begin]) {
+          applyGroup(transactions,
+                     begin,
+                     independentGroupEnd(transactions, in_memory, begin),
+                     results);
+          continue;
         }
-        // success
-        savepoint->release();
-        return {};
+        auto end = begin;
+        while (end < transactions.size() and in_memory[end]
+               and end - begin < kMaxInMemoryGroupSize) {
+          ++end;
+        }
+        applyInMemory(transactions, begin, end, results);
+      }
+      return results;
+    }
+
+    expected::Result<void, std::string> TemporaryWsvImpl::applyVerified(
+        const TransactionRefs &transactions) {
+      command_executor_->doValidation(false);
+      command_executor_->startBatch();
+      command_executor_->queueStatement(takeDeferred());
+      for (const auto &transaction_ref : transactions) {
+        const auto &transaction = transaction_ref.get();
+        command_executor_->setCreatorAccountId(transaction.creatorAccountId());
+        for (const auto &command : transaction.commands()) {
+          // the command is queued, and its result is checked with the batch
+          boost::apply_visitor(*command_executor_, command.get());
+        }
+        for (auto &account_id : SignatoryCache::affectedAccounts(transaction)) {
+          modified_accounts_.insert(std::move(account_id));
+        }
+      }
+
+      auto result = command_executor_->executeBatch();
+      // the state kept in memory may have been changed by the commands
+      overlay_executor_->dropCache();
+      return result.match(
+          [](expected::Value<void> &) -> expected::Result<void, std::string> {
+            return {};
+          },
+          [](expected::Error<BatchCommandError> &e)
+              -> expected::Result<void, std::string> {
+            return expected::makeError(
+                (e.error.is_command_error ? "Command "
+                                          : "Statement before command ")
+                + std::to_string(e.error.command_index)
+                + " failed: " + e.error.error.toString());
+          });
+    }
+
+    size_t TemporaryWsvImpl::independentGroupEnd(
+        const TransactionRefs &transactions,
+        const std::vector<bool> &in_memory,
+        size_t begin) const {
+      // signatories of a transaction creator are checked before the
+      // preceding transactions of the group are applied, so they must not
+      // be changed by these transactions
+      std::unordered_set<shared_model::interface::types::AccountIdType>
+          affected_accounts;
+      auto end = begin;
+      while (end < transactions.size() and end - begin < kMaxGroupSize) {
+        const auto &transaction = transactions[end].get();
+        if (affected_accounts.count(transaction.creatorAccountId()) != 0
+            or (end != begin and in_memory[end])) {
+          break;
+        }
+        for (auto &account_id :
+             SignatoryCache::affectedAccounts(transaction)) {
+          affected_accounts.insert(std::move(account_id));
+        }
+        ++end;
+      }
+      return end;
+    }
+
+    void TemporaryWsvImpl::applyGroup(
+        const TransactionRefs &transactions,
+        size_t begin,
+        size_t end,
+        std::vector<expected::Result<void, validation::CommandError>>
+            &results) {
+      using ResultType = expected::Result<void, validation::CommandError>;
+      auto savepoint_name = [](size_t index) {
+        return "savepoint_temp_wsv_" + std::to_string(index);
       };
+
+      // results of the group; signatures are checked before any command is
+      // queued, as the check may need to read the state
+      std::vector<boost::optional<ResultType>> group_results(end - begin);
+      for (auto i = begin; i < end; ++i) {
+        validateSignatures(transactions[i].get())
+            .match([](expected::Value<void> &) {},
+                   [&](expected::Error<validation::CommandError> &e) {
+                     group_results[i - begin] = ResultType(std::move(e));
+                   });
+      }
+
+      // indices of transactions, which are sent to the database, and indices
+      // of their first commands in the batch
+      std::vector<size_t> sent, first_commands;
+      size_t commands_count = 0;
+      for (auto i = begin; i < end; ++i) {
+        if (group_results[i - begin]) {
+          continue;
+        }
+        const auto &transaction = transactions[i].get();
+        if (sent.empty()) {
+          command_executor_->doValidation(true);
+          command_executor_->startBatch();
+          command_executor_->queueStatement(takeDeferred());
+        }
+        // every transaction is preceded by a savepoint, so that it can be
+        // rolled back without the preceding ones
+        command_executor_->queueStatement("SAVEPOINT "
+                                          + savepoint_name(sent.size()));
+        command_executor_->setCreatorAccountId(transaction.creatorAccountId());
+        for (const auto &command : transaction.commands()) {
+          boost::apply_visitor(*command_executor_, command.get());
+        }
+        sent.push_back(i);
+        first_commands.push_back(commands_count);
+        commands_count += boost::size(transaction.commands());
+      }
+
+      // position in sent of the failed transaction
+      auto failed = sent.size();
+      if (not sent.empty()) {
+        command_executor_->executeBatch().match(
+            [](expected::Value<void> &) {},
+            [&](expected::Error<BatchCommandError> &e) {
+              failed = std::upper_bound(first_commands.begin(),
+                                        first_commands.end(),
+                                        e.error.command_index)
+                  - first_commands.begin() - 1;
+              if (e.error.is_command_error) {
+                group_results[sent[failed] - begin] =
+                    expected::makeError(validation::CommandError{
+                        e.error.error.command_name,
+                        e.error.error.error_code,
+                        e.error.error.error_extra,
+                        true,
+                        e.error.command_index - first_commands[failed]});
+                return;
+              }
+              // savepoints and other statements queued before the commands of
+              // the transaction failed, not the transaction itself
+              auto error_str = "Transaction "
+                  + transactions[sent[failed]].get().toString()
+                  + " failed with db error: " + e.error.error.error_extra;
+              // TODO [IR-1816] Akvinikym 29.10.18: substitute error code magic
+              // number with named constant
+              group_results[sent[failed] - begin] = expected::makeError(
+                  validation::CommandError{e.error.error.command_name,
+                                           1,
+                                           std::move(error_str),
+                                           false});
+            });
+        // the state kept in memory may have been changed by the commands
+        overlay_executor_->dropCache();
+        // like savepoints of single transactions, these are released with
+        // the next statement sent to the database
+        if (failed < sent.size()) {
+          deferred_statements_ +=
+              "ROLLBACK TO SAVEPOINT " + savepoint_name(failed) + ";";
+        }
+        deferred_statements_ += "RELEASE SAVEPOINT " + savepoint_name(0) + ";";
+      }
+
+      // transactions after the failed one were applied on top of its changes,
+      // so they are applied again with the next group
+      const auto processed_end = failed < sent.size() ? sent[failed] + 1 : end;
+      for (size_t i = 0; i < failed; ++i) {
+        group_results[sent[i] - begin] = ResultType(expected::Value<void>{});
+        for (auto &account_id :
+             SignatoryCache::affectedAccounts(transactions[sent[i]].get())) {
+          modified_accounts_.insert(std::move(account_id));
+        }
+      }
+      for (auto i = begin; i < processed_end; ++i) {
+        results.push_back(std::move(*group_results[i - begin]));
+      }
+    }
+
+    void TemporaryWsvImpl::applyInMemory(
+        const TransactionRefs &transactions,
+        size_t begin,
+        size_t end,
+        std::vector<expected::Result<void, validation::CommandError>>
+            &results) {
+      try {
+        // rollbacks of failed transactions have to be executed before the
+        // state is read
+        if (not deferred_statements_.empty()) {
+          executeWithDeferred("");
+        }
+        overlay_executor_->prefetch(TransactionRefs(
+            transactions.begin() + begin, transactions.begin() + end));
+      } catch (const std::exception &e) {
+        // the state is read by the commands, which report the errors
+        log_->warn("Failed to prefetch state of transactions: {}", e.what());
+      }
+
+      overlay_executor_->doValidation(true);
+      for (auto i = begin; i < end; ++i) {
+        const auto &transaction = transactions[i].get();
+        auto apply_commands = [this, &transaction]()
+            -> expected::Result<void, validation::CommandError> {
+          overlay_executor_->setCreatorAccountId(
+              transaction.creatorAccountId());
+          overlay_executor_->beginTransaction();
+          const auto &commands = transaction.commands();
+          for (size_t j = 0; j < commands.size(); ++j) {
+            auto result =
+                boost::apply_visitor(*overlay_executor_, commands[j].get());
+            if (auto e = boost::get<expected::Error<CommandError>>(&result)) {
+              // the changes are undone in memory, as none of them is written
+              overlay_executor_->rollbackTransaction();
+              return expected::makeError(
+                  validation::CommandError{e->error.command_name,
+                                           e->error.error_code,
+                                           e->error.error_extra,
+                                           true,
+                                           j});
+            }
+          }
+          overlay_executor_->commitTransaction();
+          return {};
+        };
+        results.push_back(validateSignatures(transaction) | apply_commands);
+      }
+    }
+
+    std::string TemporaryWsvImpl::takeDeferred() {
+      auto statements =
+          std::move(deferred_statements_) + overlay_executor_->flush();
+      deferred_statements_.clear();
+      return statements;
+    }
+
+    void TemporaryWsvImpl::executeWithDeferred(const std::string &statement) {
+      *sql_ << takeDeferred() + statement;
     }
 
     std::unique_ptr<TemporaryWsv::SavepointWrapper>
     TemporaryWsvImpl::createSavepoint(const std::string &name) {
       return std::make_unique<TemporaryWsvImpl::SavepointWrapperImpl>(
-          SavepointWrapperImpl(
-              *this,
-              name,
-              log_manager_->getChild("SavepointWrapper")->getLogger()));
+          *this,
+          name,
+          log_manager_->getChild("SavepointWrapper")->getLogger());
     }
 
     TemporaryWsvImpl::~TemporaryWsvImpl() {
@@ -144,14 +399,14 @@ namespace iroha {
     }
 
     TemporaryWsvImpl::SavepointWrapperImpl::SavepointWrapperImpl(
-        const iroha::ametsuchi::TemporaryWsvImpl &wsv,
+        iroha::ametsuchi::TemporaryWsvImpl &wsv,
         std::string savepoint_name,
         logger::LoggerPtr log)
-        : sql_{*wsv.sql_},
+        : wsv_{wsv},
           savepoint_name_{std::move(savepoint_name)},
           is_released_{false},
           log_(std::move(log)) {
-      sql_ << "SAVEPOINT " + savepoint_name_ + ";";
+      wsv_.executeWithDeferred("SAVEPOINT " + savepoint_name_ + ";");
     }
 
     void TemporaryWsvImpl::SavepointWrapperImpl::release() {
@@ -159,11 +414,18 @@ namespace iroha {
     }
 
     TemporaryWsvImpl::SavepointWrapperImpl::~SavepointWrapperImpl() {
+      // statements deferred by the transactions applied after the savepoint
+      // have to be executed before it is released or rolled back
       try {
         if (not is_released_) {
-          sql_ << "ROLLBACK TO SAVEPOINT " + savepoint_name_ + ";";
+          // the changes kept in memory were written when the savepoint was
+          // created, so the ones kept now are made after it
+          wsv_.overlay_executor_->discard();
+          wsv_.executeWithDeferred("ROLLBACK TO SAVEPOINT " + savepoint_name_
+                                   + ";");
         } else {
-          sql_ << "RELEASE SAVEPOINT " + savepoint_name_ + ";";
+          wsv_.executeWithDeferred("RELEASE SAVEPOINT " + savepoint_name_
+                                   + ";");
         }
       } catch (std::exception &e) {
         log_->error("SQL error. Reason: {}", e.what());
@@ -8,8 +8,11 @@
 
 #include "ametsuchi/temporary_wsv.hpp"
 
+#include <unordered_set>
+
 #include <soci/soci.h>
 #include "ametsuchi/command_executor.hpp"
+#include "ametsuchi/impl/signatory_cache.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "logger/logger_fwd.hpp"
 #include "logger/logger_manager_fwd.hpp"
@@ -23,12 +26,15 @@ namespace shared_model {
 namespace iroha {
 
   namespace ametsuchi {
+    class OverlayCommandExecutor;
+    class PostgresCommandExecutor;
+
     class TemporaryWsvImpl : public TemporaryWsv {
       friend class StorageImpl;
 
      public:
       struct SavepointWrapperImpl : public TemporaryWsv::SavepointWrapper {
-        SavepointWrapperImpl(const TemporaryWsvImpl &wsv,
+        SavepointWrapperImpl(TemporaryWsvImpl &wsv,
                              std::string savepoint_name,
                              logger::LoggerPtr log);
 
@@ -37,7 +43,7 @@ namespace iroha {
         ~SavepointWrapperImpl() override;
 
        private:
-        soci::session &sql_;
+        TemporaryWsvImpl &wsv_;
         std::string savepoint_name_;
         bool is_released_;
         logger::LoggerPtr log_;
@@ -49,17 +55,101 @@ namespace iroha {
               factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
               perm_converter,
+          std::shared_ptr<SignatoryCache> signatory_cache,
           logger::LoggerManagerTreePtr log_manager);
 
       expected::Result<void, validation::CommandError> apply(
           const shared_model::interface::Transaction &transaction) override;
 
+      /**
+       * Transactions, which only change asset quantities, are applied in
+       * memory, and their changes are written to the database with the next
+       * statement sent to it, at the latest with the preparation of the
+       * block. Other transactions are applied in groups, in which no
+       * transaction changes signatories of creators of the following ones.
+       * Commands of a group are sent to the database in a single round trip,
+       * each transaction after its own savepoint. If a transaction fails, the
+       * changes are rolled back to its savepoint, and the following
+       * transactions are applied again with the next group, so the results
+       * are the same as if the transactions were applied one by one
+       */
+      std::vector<expected::Result<void, validation::CommandError>>
+      applyTransactions(const TransactionRefs &transactions) override;
+
+      /**
+       * Commands of all the transactions are sent to the database in a single
+       * round trip, after the changes kept in memory
+       */
+      expected::Result<void, std::string> applyVerified(
+          const TransactionRefs &transactions) override;
+
       std::unique_ptr<TemporaryWsv::SavepointWrapper> createSavepoint(
           const std::string &name) override;
 
       ~TemporaryWsvImpl() override;
 
      private:
+      /// maximum number of transactions applied in a single round trip
+      static const size_t kMaxGroupSize = 64;
+
+      /// maximum number of transactions applied in memory, whose state is
+      /// read in a single round trip
+      static const size_t kMaxInMemoryGroupSize = 1024;
+
+      /**
+       * Find the end of a group of transactions, which can be applied in a
+       * single round trip
+       * @param transactions - transactions to apply
+       * @param in_memory - whether each of the transactions is applied in
+       * memory, which ends the group
+       * @param begin - index of the first transaction of the group
+       * @return index after the last transaction of the group
+       */
+      size_t independentGroupEnd(const TransactionRefs &transactions,
+                                 const std::vector<bool> &in_memory,
+                                 size_t begin) const;
+
+      /**
+       * Apply transactions in memory and append their results
+       * @param transactions - transactions to apply
+       * @param begin - index of the first transaction to apply
+       * @param end - index after the last transaction to apply
+       * @param results - results of the transactions
+       */
+      void applyInMemory(
+          const TransactionRefs &transactions,
+          size_t begin,
+          size_t end,
+          std::vector<expected::Result<void, validation::CommandError>>
+              &results);
+
+      /**
+       * Apply a group of transactions and append results of the processed
+       * ones. If a transaction of the group fails, the following transactions
+       * are not processed
+       * @param transactions - transactions to apply
+       * @param begin - index of the first transaction of the group
+       * @param end - index after the last transaction of the group
+       * @param results - results of the processed transactions
+       */
+      void applyGroup(
+          const TransactionRefs &transactions,
+          size_t begin,
+          size_t end,
+          std::vector<expected::Result<void, validation::CommandError>>
+              &results);
+
+      /**
+       * Get signatories and quorum of the account from the signatory cache or,
+       * if they are not cached or could have been changed by the applied
+       * transactions, from the database
+       * @param account_id - id of the account
+       * @return signatories and quorum, or nullptr if there is no such account
+       * @throws soci::soci_error if the database query fails
+       */
+      SignatoryCache::EntryType getSignatories(
+          const shared_model::interface::types::AccountIdType &account_id);
+
       /**
        * Verifies whether transaction has at least quorum signatures and they
        * are a subset of creator account signatories
@@ -67,8 +157,33 @@ namespace iroha {
       expected::Result<void, validation::CommandError> validateSignatures(
           const shared_model::interface::Transaction &transaction);
 
+      /**
+       * Take the deferred statements and the statement, which writes the
+       * changes of the transactions applied in memory
+       * @return statements to execute before any other one
+       */
+      std::string takeDeferred();
+
+      /**
+       * Execute the statement together with the deferred statements and the
+       * changes of the transactions applied in memory, which precede it, in a
+       * single round trip to the database
+       * @param statement - statement to execute
+       */
+      void executeWithDeferred(const std::string &statement);
+
       std::unique_ptr<soci::session> sql_;
-      std::unique_ptr<CommandExecutor> command_executor_;
+      /// releases and rollbacks of savepoints of applied transactions, which
+      /// are not yet sent
+      std::string deferred_statements_;
+      std::unique_ptr<PostgresCommandExecutor> command_executor_;
+      /// applies transactions, which only change asset quantities, in memory
+      std::unique_ptr<OverlayCommandExecutor> overlay_executor_;
+      std::shared_ptr<SignatoryCache> signatory_cache_;
+      /// accounts, whose signatories or quorum the applied transactions could
+      /// have changed
+      std::unordered_set<shared_model::interface::types::AccountIdType>
+          modified_accounts_;
 
       logger::LoggerManagerTreePtr log_manager_;
       logger::LoggerPtr log_;
@@ -38,6 +38,48 @@ namespace iroha {
       return batch_statuses;
     }
 
+    boost::optional<std::vector<TxCacheStatusType>> TxPresenceCacheImpl::check(
+        const std::vector<shared_model::crypto::Hash> &hashes) const {
+      std::vector<TxCacheStatusType> statuses(
+          hashes.size(), tx_cache_status_responses::Missing());
+      // positions of the hashes, which are absent in cache
+      std::vector<size_t> missed;
+      std::vector<shared_model::crypto::Hash> missed_hashes;
+      for (size_t i = 0; i < hashes.size(); ++i) {
+        if (auto cached = memory_cache_.findItem(hashes[i])) {
+          statuses[i] = *cached;
+        } else {
+          missed.push_back(i);
+          missed_hashes.push_back(hashes[i]);
+        }
+      }
+      if (missed.empty()) {
+        return statuses;
+      }
+
+      auto block_query = storage_->getBlockQuery();
+      if (not block_query) {
+        return boost::none;
+      }
+      auto stored = block_query->checkTxsPresence(missed_hashes);
+      if (not stored) {
+        return boost::none;
+      }
+      for (size_t i = 0; i < missed.size(); ++i) {
+        const auto &status = (*stored)[i];
+        visit_in_place(status,
+                       [](const tx_cache_status_responses::Missing &) {
+                         // don't put this hash into cache since "Missing"
+                         // can become "Committed" or "Rejected" later
+                       },
+                       [this, &hashes, &missed, i](const auto &status) {
+                         memory_cache_.addItem(hashes[missed[i]], status);
+                       });
+        statuses[missed[i]] = status;
+      }
+      return statuses;
+    }
+
     boost::optional<TxCacheStatusType> TxPresenceCacheImpl::checkInStorage(
         const shared_model::crypto::Hash &hash) const {
       auto block_query = storage_->getBlockQuery();
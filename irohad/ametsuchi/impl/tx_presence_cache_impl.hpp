@@ -24,6 +24,10 @@ namespace iroha {
           const shared_model::interface::TransactionBatch &batch)
           const override;
 
+      boost::optional<std::vector<TxCacheStatusType>> check(
+          const std::vector<shared_model::crypto::Hash> &hashes)
+          const override;
+
      private:
       /**
        * Performs an actual storage request about hash status
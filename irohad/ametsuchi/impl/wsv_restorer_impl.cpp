@@ -5,26 +5,39 @@
 
 #include "wsv_restorer_impl.hpp"
 
-#include <vector>
-
+#include "ametsuchi/block_cursor.hpp"
 #include "ametsuchi/block_query.hpp"
 #include "ametsuchi/storage.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 
 namespace iroha {
   namespace ametsuchi {
+    WsvRestorerImpl::WsvRestorerImpl(
+        shared_model::interface::types::HeightType snapshot_interval,
+        size_t replay_chunk_size)
+        : snapshot_interval_(snapshot_interval),
+          replay_chunk_size_(replay_chunk_size) {}
+
     expected::Result<void, std::string> WsvRestorerImpl::restoreWsv(
         Storage &storage) {
-      // get all blocks starting from the genesis
-      std::vector<std::shared_ptr<shared_model::interface::Block>> blocks=
-      storage.getBlockQuery()->getBlocksFrom(1);
-
-      storage.reset();
-
-      if (not storage.insertBlocks(blocks))
-        return expected::makeError("cannot insert blocks");
+      auto block_query = storage.getBlockQuery();
+      if (not block_query) {
+        return expected::makeError("cannot create block query");
+      }
 
-      return expected::Value<void>();
+      return storage.restoreWsvSnapshot() | [&](auto snapshot_height) {
+        // blocks after the snapshot are read lazily from the block store
+        BlockCursor blocks(*block_query, snapshot_height + 1);
+        const auto top_height = block_query->getTopBlockHeight();
+        return storage.replayBlocks(blocks, replay_chunk_size_) |
+            [&]() -> expected::Result<void, std::string> {
+          if (top_height >= snapshot_height + snapshot_interval_) {
+            // snapshot failure does not affect the restored WSV
+            storage.createWsvSnapshot();
+          }
+          return {};
+        };
+      };
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -8,6 +8,7 @@
 
 #include "ametsuchi/wsv_restorer.hpp"
 #include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -18,15 +19,38 @@ namespace iroha {
      */
     class WsvRestorerImpl : public WsvRestorer {
      public:
+      /// Number of blocks after which a new WSV snapshot is saved by default
+      static const shared_model::interface::types::HeightType
+          kDefaultSnapshotInterval = 10000;
+
+      /// Number of blocks replayed in one transaction by default
+      static const size_t kDefaultReplayChunkSize = 1000;
+
+      /**
+       * @param snapshot_interval - minimal number of replayed blocks, after
+       * which a new WSV snapshot is saved
+       * @param replay_chunk_size - number of blocks replayed in one
+       * transaction
+       */
+      explicit WsvRestorerImpl(
+          shared_model::interface::types::HeightType snapshot_interval =
+              kDefaultSnapshotInterval,
+          size_t replay_chunk_size = kDefaultReplayChunkSize);
+
       virtual ~WsvRestorerImpl() = default;
       /**
        * Recover WSV (World State View).
-       * Drop storage and apply blocks one by one.
+       * Load the latest WSV snapshot and apply the blocks after it one by
+       * one.
        * @param storage of blocks in ledger
        * @return void on success, otherwise error string
        */
       virtual expected::Result<void, std::string> restoreWsv(
           Storage &storage) override;
+
+     private:
+      const shared_model::interface::types::HeightType snapshot_interval_;
+      const size_t replay_chunk_size_;
     };
 
   }  // namespace ametsuchi
@@ -7,6 +7,7 @@
 #define IROHA_KV_STORAGE_HPP
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,31 @@ namespace iroha {
       using Identifier = uint32_t;
       using Bytes = std::vector<uint8_t>;
 
+      /**
+       * Read-only view of stored data. Keeps the memory it points to alive
+       * for the lifetime of the view
+       */
+      class BytesView {
+       public:
+        BytesView(std::shared_ptr<const void> holder,
+                  const uint8_t *data,
+                  size_t size)
+            : holder_(std::move(holder)), data_(data), size_(size) {}
+
+        const uint8_t *data() const {
+          return data_;
+        }
+
+        size_t size() const {
+          return size_;
+        }
+
+       private:
+        std::shared_ptr<const void> holder_;
+        const uint8_t *data_;
+        size_t size_;
+      };
+
       /**
        * Add entity with binary data
        * @param id - reference key
@@ -39,6 +65,22 @@ namespace iroha {
        */
       virtual boost::optional<Bytes> get(Identifier id) const = 0;
 
+      /**
+       * Get view of data associated with id. Storages which are able to
+       * provide the data without copying override this method, the default
+       * implementation owns a copy returned by get()
+       * @param id - reference key
+       * @return - view of blob, if exists
+       */
+      virtual boost::optional<BytesView> getView(Identifier id) const {
+        auto blob = get(id);
+        if (not blob) {
+          return boost::none;
+        }
+        auto holder = std::make_shared<const Bytes>(std::move(*blob));
+        return BytesView(holder, holder->data(), holder->size());
+      }
+
       /**
        * @return folder of storage
        */
@@ -15,6 +15,7 @@
 #include "ametsuchi/query_executor_factory.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -26,6 +27,7 @@ namespace iroha {
 
   namespace ametsuchi {
 
+    class BlockCursor;
     class BlockQuery;
     class WsvQuery;
 
@@ -60,6 +62,39 @@ namespace iroha {
           const std::vector<std::shared_ptr<shared_model::interface::Block>>
               &blocks) = 0;
 
+      /**
+       * Save a snapshot of the WSV at the current top block, replacing the
+       * previous snapshot
+       * @return height of the saved snapshot, otherwise error string
+       */
+      virtual expected::Result<shared_model::interface::types::HeightType,
+                               std::string>
+      createWsvSnapshot() = 0;
+
+      /**
+       * Replace the WSV with the latest snapshot, keeping the blocks. If there
+       * is no snapshot matching the blocks, the WSV is emptied. The block
+       * index is kept if it matches the blocks, otherwise it is rebuilt up to
+       * the height of the restored snapshot
+       * @return height of the restored snapshot, or 0 if the WSV is empty
+       */
+      virtual expected::Result<shared_model::interface::types::HeightType,
+                               std::string>
+      restoreWsvSnapshot() = 0;
+
+      /**
+       * Apply blocks, which are already in the block storage, to the WSV
+       * without validation. Blocks are read from the cursor while previous
+       * ones are applied, and are committed by chunks. If a block cannot be
+       * applied, the chunks before it stay committed
+       * @param blocks - cursor over the blocks to apply
+       * @param chunk_size - number of blocks applied in one transaction
+       * @return void on success, otherwise error string, which contains the
+       * height the WSV is replayed up to
+       */
+      virtual expected::Result<void, std::string> replayBlocks(
+          BlockCursor &blocks, size_t chunk_size) = 0;
+
       /**
        * method called when block is written to the storage
        * @return observable with the Block committed
@@ -7,6 +7,7 @@
 #define IROHA_TEMPORARYWSV_HPP
 
 #include <functional>
+#include <vector>
 
 #include "common/result.hpp"
 #include "validation/stateful_validator_common.hpp"
@@ -47,6 +48,48 @@ namespace iroha {
       virtual expected::Result<void, validation::CommandError> apply(
           const shared_model::interface::Transaction &transaction) = 0;
 
+      using TransactionRefs = std::vector<
+          std::reference_wrapper<const shared_model::interface::Transaction>>;
+
+      /**
+       * Applies transactions to current state in the given order. The result
+       * is the same as if apply was called for each of them, but an
+       * implementation may apply independent transactions together
+       * @param transactions to be applied
+       * @return result of application of each transaction
+       */
+      virtual std::vector<expected::Result<void, validation::CommandError>>
+      applyTransactions(const TransactionRefs &transactions) {
+        std::vector<expected::Result<void, validation::CommandError>> results;
+        results.reserve(transactions.size());
+        for (const auto &transaction : transactions) {
+          results.push_back(apply(transaction));
+        }
+        return results;
+      }
+
+      /**
+       * Applies transactions, which were already validated on the same state,
+       * such as transactions of a verified proposal, without checking their
+       * signatures and permissions
+       * @param transactions to be applied
+       * @return error message if a transaction could not be applied, in which
+       * case the state is undefined, and the wsv has to be dropped
+       */
+      virtual expected::Result<void, std::string> applyVerified(
+          const TransactionRefs &transactions) {
+        for (const auto &transaction : transactions) {
+          auto result = apply(transaction);
+          if (auto e =
+                  boost::get<expected::Error<validation::CommandError>>(
+                      &result)) {
+            return expected::makeError(e->error.name + " failed: "
+                                       + e->error.error_extra);
+          }
+        }
+        return {};
+      }
+
       /**
        * Create a savepoint for wsv state
        * @param name of savepoint to be created
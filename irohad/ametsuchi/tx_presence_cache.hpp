@@ -48,6 +48,16 @@ namespace iroha {
       virtual boost::optional<BatchStatusCollectionType> check(
           const shared_model::interface::TransactionBatch &batch) const = 0;
 
+      /**
+       * Check statuses of transactions, which are not cached, with a single
+       * storage query
+       * @param hashes - hashes of the transactions
+       * @return statuses of the transactions in the order of hashes if storage
+       * query was successful, boost::none otherwise
+       */
+      virtual boost::optional<std::vector<TxCacheStatusType>> check(
+          const std::vector<shared_model::crypto::Hash> &hashes) const = 0;
+
       // TODO: 09/11/2018 @muratovv add method for processing collection of
       // batches IR-1857
 
@@ -8,10 +8,13 @@
 #include <boost/filesystem.hpp>
 
 #include "ametsuchi/impl/flat_file_block_storage_factory.hpp"
+#include "ametsuchi/impl/segmented_file/block_store_migration.hpp"
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
 #include "ametsuchi/impl/storage_impl.hpp"
 #include "ametsuchi/impl/tx_presence_cache_impl.hpp"
 #include "ametsuchi/impl/wsv_restorer_impl.hpp"
 #include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
 #include "backend/protobuf/proto_block_json_converter.hpp"
 #include "backend/protobuf/proto_permission_to_string.hpp"
 #include "backend/protobuf/proto_proposal_factory.hpp"
@@ -87,7 +90,8 @@ Irohad::Irohad(const std::string &block_store_dir,
                size_t stale_stream_max_rounds,
                logger::LoggerManagerTreePtr logger_manager,
                const boost::optional<GossipPropagationStrategyParams>
-                   &opt_mst_gossip_params)
+                   &opt_mst_gossip_params,
+               bool group_conflicting_batches)
     : block_store_dir_(block_store_dir),
       pg_conn_(pg_conn),
       listen_ip_(listen_ip),
@@ -100,6 +104,7 @@ Irohad::Irohad(const std::string &block_store_dir,
       mst_expiration_time_(mst_expiration_time),
       max_rounds_delay_(max_rounds_delay),
       stale_stream_max_rounds_(stale_stream_max_rounds),
+      group_conflicting_batches_(group_conflicting_batches),
       opt_mst_gossip_params_(opt_mst_gossip_params),
       keypair(keypair),
       ordering_init(logger_manager->getLogger()),
@@ -113,6 +118,7 @@ Irohad::Irohad(const std::string &block_store_dir,
 
 Irohad::~Irohad() {
   consensus_gate_events_subscription.unsubscribe();
+  wsv_snapshot_subscription_.unsubscribe();
 }
 
 /**
@@ -163,18 +169,25 @@ void Irohad::initStorage() {
       std::make_shared<shared_model::proto::ProtoPermissionToString>();
   auto block_converter =
       std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+  auto binary_block_converter =
+      std::make_shared<shared_model::proto::ProtoBlockBinaryConverter>();
+
+  if (not migrateBlockStore(*block_converter, *binary_block_converter)) {
+    return;
+  }
+
   auto block_storage_factory = std::make_unique<FlatFileBlockStorageFactory>(
       []() {
         return (boost::filesystem::temp_directory_path()
                 / boost::filesystem::unique_path())
             .string();
       },
-      block_converter,
+      std::move(block_converter),
       log_manager_);
   auto storageResult = StorageImpl::create(block_store_dir_,
                                            pg_conn_,
                                            common_objects_factory_,
-                                           std::move(block_converter),
+                                           std::move(binary_block_converter),
                                            perm_converter,
                                            std::move(block_storage_factory),
                                            log_manager_->getChild("Storage"));
@@ -187,6 +200,35 @@ void Irohad::initStorage() {
   log_->info("[Init] => storage ({})", logger::logBool(storage));
 }
 
+/**
+ * Moving blocks of the previous one-file-per-block store into segments
+ */
+bool Irohad::migrateBlockStore(
+    const shared_model::interface::BlockJsonDeserializer &json_converter,
+    const shared_model::interface::BlockBinarySerializer &binary_converter) {
+  if (not hasFlatFileBlocks(block_store_dir_)) {
+    return true;
+  }
+  log_->info("[Init] => migrating block store {}", block_store_dir_);
+  auto block_store = SegmentedFile::create(
+      block_store_dir_,
+      log_manager_->getChild("BlockStoreMigration")->getLogger());
+  if (not block_store) {
+    log_->error("Cannot open block store {}", block_store_dir_);
+    return false;
+  }
+  return migrateFlatFileBlocks(block_store_dir_,
+                               **block_store,
+                               json_converter,
+                               binary_converter,
+                               log_)
+      .match([](const expected::Value<size_t> &) { return true; },
+             [this](const expected::Error<std::string> &error) {
+               log_->error("Block store migration failed: {}", error.error);
+               return false;
+             });
+}
+
 bool Irohad::restoreWsv() {
   return wsv_restorer_->restoreWsv(*storage).match(
       [](iroha::expected::Value<void> v) { return true; },
@@ -375,6 +417,7 @@ void Irohad::initOrderingGate() {
                                      proposal_factory,
                                      persistent_cache,
                                      delay,
+                                     group_conflicting_batches_,
                                      log_manager_->getChild("Ordering"));
   log_->info("[Init] => init ordering gate - [{}]",
              logger::logBool(ordering_gate));
@@ -394,8 +437,12 @@ void Irohad::initSimulator() {
       std::make_unique<
           shared_model::validation::DefaultUnsignedBlockValidator>(),
       std::make_unique<shared_model::validation::ProtoBlockValidator>());
+  // consensus gate objects are subscribed to the consensus gate before the
+  // synchronizer, so the simulator receives the outcomes before the
+  // synchronizer commits the prepared block
   simulator = std::make_shared<Simulator>(
       ordering_gate,
+      consensus_gate_objects.get_observable(),
       stateful_validator,
       storage,
       storage,
@@ -610,7 +657,25 @@ void Irohad::initQueryService() {
 }
 
 void Irohad::initWsvRestorer() {
-  wsv_restorer_ = std::make_shared<iroha::ametsuchi::WsvRestorerImpl>();
+  using iroha::ametsuchi::WsvRestorerImpl;
+  wsv_restorer_ = std::make_shared<WsvRestorerImpl>();
+
+  // snapshots are saved on a separate thread, so that commits are not delayed
+  wsv_snapshot_subscription_ =
+      storage->on_commit()
+          .filter([](const auto &block) {
+            return block->height() % WsvRestorerImpl::kDefaultSnapshotInterval
+                == 0;
+          })
+          .observe_on(rxcpp::observe_on_new_thread())
+          .subscribe([this](const auto &) {
+            storage->createWsvSnapshot().match(
+                [](const iroha::expected::Value<
+                    shared_model::interface::types::HeightType> &) {},
+                [this](const iroha::expected::Error<std::string> &error) {
+                  log_->warn(error.error);
+                });
+          });
 }
 
 /**
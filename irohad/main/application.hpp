@@ -55,6 +55,8 @@ namespace shared_model {
     class Keypair;
   }
   namespace interface {
+    class BlockBinarySerializer;
+    class BlockJsonDeserializer;
     class CommonObjectsFactory;
     class QueryResponseFactory;
     class TransactionBatchFactory;
@@ -89,6 +91,8 @@ class Irohad {
    * @param logger_manager - the logger manager to use
    * @param opt_mst_gossip_params - parameters for Gossip MST propagation
    * (optional). If not provided, disables mst processing support
+   * @param group_conflicting_batches - whether the ordering service places
+   * batches of the same creator next to each other in a proposal
    * TODO mboldyrev 03.11.2018 IR-1844 Refactor the constructor.
    */
   Irohad(const std::string &block_store_dir,
@@ -105,7 +109,8 @@ class Irohad {
          size_t stale_stream_max_rounds,
          logger::LoggerManagerTreePtr logger_manager,
          const boost::optional<iroha::GossipPropagationStrategyParams>
-             &opt_mst_gossip_params = boost::none);
+             &opt_mst_gossip_params = boost::none,
+         bool group_conflicting_batches = false);
 
   /**
    * Initialization of whole objects in system
@@ -136,6 +141,14 @@ class Irohad {
 
   virtual void initStorage();
 
+  /**
+   * Move blocks stored one file per block to the segmented block store
+   * @return true if there was nothing to migrate or migration succeeded
+   */
+  bool migrateBlockStore(
+      const shared_model::interface::BlockJsonDeserializer &json_converter,
+      const shared_model::interface::BlockBinarySerializer &binary_converter);
+
   virtual void initCryptoProvider();
 
   virtual void initBatchParser();
@@ -173,7 +186,7 @@ class Irohad {
   virtual void initQueryService();
 
   /**
-   * Initialize WSV restorer
+   * Initialize WSV restorer and periodic WSV snapshots
    */
   virtual void initWsvRestorer();
 
@@ -190,6 +203,7 @@ class Irohad {
   std::chrono::minutes mst_expiration_time_;
   std::chrono::milliseconds max_rounds_delay_;
   size_t stale_stream_max_rounds_;
+  bool group_conflicting_batches_;
   boost::optional<iroha::GossipPropagationStrategyParams>
       opt_mst_gossip_params_;
 
@@ -210,6 +224,7 @@ class Irohad {
 
   // WSV restorer
   std::shared_ptr<iroha::ametsuchi::WsvRestorer> wsv_restorer_;
+  rxcpp::composite_subscription wsv_snapshot_subscription_;
 
   // crypto provider
   std::shared_ptr<shared_model::crypto::AbstractCryptoModelSigner<
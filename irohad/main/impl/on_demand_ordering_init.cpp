@@ -54,6 +54,10 @@ namespace iroha {
         const logger::LoggerManagerTreePtr &ordering_log_manager) {
       return std::make_shared<ordering::transport::OnDemandOsClientGrpcFactory>(
           std::move(async_call),
+          std::make_shared<
+              network::AsyncGrpcClient<ordering::proto::ProposalResponse>>(
+              ordering_log_manager->getChild("AsyncProposalCall")
+                  ->getLogger()),
           std::move(proposal_transport_factory),
           [] { return std::chrono::system_clock::now(); },
           delay,
@@ -166,6 +170,13 @@ namespace iroha {
          * v, round 1 - kNextRoundRejectConsumer
          * v, round 2 - kNextRoundCommitConsumer
          * o, round 0 - kIssuer
+         * x, round 0 - kNextRejectRoundIssuer
+         * x, round 1 - kNextCommitRoundIssuer
+         *
+         * Issuer of the next commit round is selected with the current list
+         * of peers, so it is only a guess if the list is changed by the
+         * block. It is used only to prefetch the proposal, which the gate
+         * discards if the issuer selected for the round differs
          */
         peers.peers.at(OnDemandConnectionManager::kCurrentRoundRejectConsumer) =
             getOsPeer(kCurrentRound,
@@ -177,6 +188,12 @@ namespace iroha {
             getOsPeer(kRoundAfterNext, ordering::kNextCommitRoundConsumer);
         peers.peers.at(OnDemandConnectionManager::kIssuer) =
             getOsPeer(kCurrentRound, current_round.reject_round);
+        peers.peers.at(OnDemandConnectionManager::kNextRejectRoundIssuer) =
+            getOsPeer(kCurrentRound,
+                      ordering::nextRejectRound(current_round).reject_round);
+        peers.peers.at(OnDemandConnectionManager::kNextCommitRoundIssuer) =
+            getOsPeer(kNextRound, ordering::kFirstRejectRound);
+        peers.round = current_round;
         return peers;
       };
 
@@ -250,17 +267,25 @@ namespace iroha {
           ordering_log_manager->getChild("Gate")->getLogger());
     }
 
-    auto OnDemandOrderingInit::createService(
+    std::shared_ptr<ordering::OnDemandOrderingService>
+    OnDemandOrderingInit::createService(
         size_t max_number_of_transactions,
         std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
             proposal_factory,
         std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
+        bool group_conflicting_batches,
         const logger::LoggerManagerTreePtr &ordering_log_manager) {
+      // genesis block has height 1, so the first round is at height 2
+      const size_t kNumberOfProposals = 3;
+      const consensus::Round kInitialRound{2, ordering::kFirstRejectRound};
       return std::make_shared<ordering::OnDemandOrderingServiceImpl>(
           max_number_of_transactions,
           std::move(proposal_factory),
           std::move(tx_cache),
-          ordering_log_manager->getChild("Service")->getLogger());
+          ordering_log_manager->getChild("Service")->getLogger(),
+          kNumberOfProposals,
+          kInitialRound,
+          group_conflicting_batches);
     }
 
     OnDemandOrderingInit::~OnDemandOrderingInit() {
@@ -288,10 +313,12 @@ namespace iroha {
         std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
         std::function<std::chrono::milliseconds(
             const synchronizer::SynchronizationEvent &)> delay_func,
+        bool group_conflicting_batches,
         logger::LoggerManagerTreePtr ordering_log_manager) {
       auto ordering_service = createService(max_number_of_transactions,
                                             proposal_factory,
                                             tx_cache,
+                                            group_conflicting_batches,
                                             ordering_log_manager);
       service = std::make_shared<ordering::transport::OnDemandOsServerGrpc>(
           ordering_service,
@@ -77,17 +77,6 @@ namespace iroha {
           size_t max_number_of_transactions,
           const logger::LoggerManagerTreePtr &ordering_log_manager);
 
-      /**
-       * Creates on-demand ordering service. \see initOrderingGate for
-       * parameters
-       */
-      auto createService(
-          size_t max_number_of_transactions,
-          std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
-              proposal_factory,
-          std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
-          const logger::LoggerManagerTreePtr &ordering_log_manager);
-
      public:
       /// Constructor.
       /// @param log - the logger to use for internal messages.
@@ -114,6 +103,8 @@ namespace iroha {
        * requests to ordering service and processing responses
        * @param proposal_factory factory required by ordering service to produce
        * proposals
+       * @param group_conflicting_batches whether ordering service places
+       * batches of the same creator next to each other in a proposal
        * @return initialized ordering gate
        */
       std::shared_ptr<network::OrderingGate> initOrderingGate(
@@ -136,8 +127,21 @@ namespace iroha {
           std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
           std::function<std::chrono::milliseconds(
               const synchronizer::SynchronizationEvent &)> delay_func,
+          bool group_conflicting_batches,
           logger::LoggerManagerTreePtr ordering_log_manager);
 
+      /**
+       * Creates on-demand ordering service. \see initOrderingGate for
+       * parameters
+       */
+      std::shared_ptr<ordering::OnDemandOrderingService> createService(
+          size_t max_number_of_transactions,
+          std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
+              proposal_factory,
+          std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
+          bool group_conflicting_batches,
+          const logger::LoggerManagerTreePtr &ordering_log_manager);
+
       /// gRPC service for ordering service
       std::shared_ptr<ordering::proto::OnDemandOrdering::Service> service;
 
@@ -24,6 +24,7 @@ namespace config_members {
   extern const char *MstExpirationTime;
   extern const char *MaxRoundsDelay;
   extern const char *StaleStreamMaxRounds;
+  extern const char *GroupConflictingBatches;
   extern const char *LogSection;
   extern const char *LogLevel;
   extern const char *LogPatternsSection;
@@ -227,6 +227,10 @@ void getVal<IrohadConfig>(const std::string &path,
               dest.stale_stream_max_rounds,
               obj,
               config_members::StaleStreamMaxRounds);
+  getValByKey(path,
+              dest.group_conflicting_batches,
+              obj,
+              config_members::GroupConflictingBatches);
   getValByKey(path, dest.logger_manager, obj, config_members::LogSection);
 }
 
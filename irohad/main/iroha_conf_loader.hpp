@@ -23,6 +23,7 @@ struct IrohadConfig {
   boost::optional<uint32_t> mst_expiration_time;
   boost::optional<uint32_t> max_round_delay_ms;
   boost::optional<uint32_t> stale_stream_max_rounds;
+  boost::optional<bool> group_conflicting_batches;
   boost::optional<logger::LoggerManagerTreePtr> logger_manager;
 };
 
@@ -25,6 +25,7 @@ static const std::string kLogSettingsFromConfigFile = "config_file";
 static const uint32_t kMstExpirationTimeDefault = 1440;
 static const uint32_t kMaxRoundsDelayDefault = 3000;
 static const uint32_t kStaleStreamMaxRoundsDefault = 2;
+static const bool kGroupConflictingBatchesDefault = false;
 
 /**
  * Gflag validator.
@@ -165,7 +166,9 @@ int main(int argc, char *argv[]) {
       config.stale_stream_max_rounds.value_or(kStaleStreamMaxRoundsDefault),
       log_manager->getChild("Irohad"),
       boost::make_optional(config.mst_support,
-                           iroha::GossipPropagationStrategyParams{}));
+                           iroha::GossipPropagationStrategyParams{}),
+      config.group_conflicting_batches.value_or(
+          kGroupConflictingBatchesDefault));
 
   // Check if iroha daemon storage was successfully initialized
   if (not irohad.storage) {
@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gflags/gflags.h>
+#include "ametsuchi/impl/segmented_file/block_store_migration.hpp"
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_manager.hpp"
+
+/**
+ * Gflag validator.
+ * Block store path is considered to be valid if it is not empty.
+ * @param flag_name - flag name. Must be 'block_store_path' in this case
+ * @param path      - block store directory
+ * @return true if argument is valid
+ */
+bool validate_block_store_path(const char *flag_name,
+                               std::string const &path) {
+  return not path.empty();
+}
+
+/**
+ * Creating input argument for the block store location.
+ */
+DEFINE_string(block_store_path,
+              "",
+              "Specify block store directory with one file per block");
+DEFINE_validator(block_store_path, &validate_block_store_path);
+
+DEFINE_uint64(segment_size,
+              iroha::ametsuchi::SegmentedFile::kDefaultSegmentSize,
+              "Size of a block store segment in bytes");
+
+/**
+ * Offline migration of a block store directory written by FlatFile to the
+ * segmented block store. Irohad performs the same migration on startup, the
+ * tool allows to do it ahead of the upgrade.
+ */
+int main(int argc, char *argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  auto log_manager =
+      std::make_shared<logger::LoggerManagerTree>(logger::LoggerConfig{
+          logger::LogLevel::kInfo, logger::getDefaultLogPatterns()});
+  auto log = log_manager->getChild("Migration")->getLogger();
+
+  auto block_store = iroha::ametsuchi::SegmentedFile::create(
+      FLAGS_block_store_path,
+      log_manager->getChild("SegmentedFile")->getLogger(),
+      FLAGS_segment_size);
+  if (not block_store) {
+    log->error("Cannot open block store {}", FLAGS_block_store_path);
+    return EXIT_FAILURE;
+  }
+
+  return iroha::ametsuchi::migrateFlatFileBlocks(
+             FLAGS_block_store_path,
+             **block_store,
+             shared_model::proto::ProtoBlockJsonConverter{},
+             shared_model::proto::ProtoBlockBinaryConverter{},
+             log)
+      .match(
+          [](const iroha::expected::Value<size_t> &) { return EXIT_SUCCESS; },
+          [&log](const iroha::expected::Error<std::string> &error) {
+            log->error("Migration failed: {}", error.error);
+            return EXIT_FAILURE;
+          });
+}
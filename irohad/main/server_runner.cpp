@@ -7,13 +7,27 @@
 
 #include <boost/format.hpp>
 #include "logger/logger.hpp"
+#include "network/impl/async_grpc_server.hpp"
 
 const auto kPortBindError = "Cannot bind server to address %s";
 
 ServerRunner::ServerRunner(const std::string &address,
                            logger::LoggerPtr log,
-                           bool reuse)
-    : log_(std::move(log)), serverAddress_(address), reuse_(reuse) {}
+                           bool reuse,
+                           size_t async_threads)
+    : log_(std::move(log)),
+      serverAddress_(address),
+      reuse_(reuse),
+      async_threads_(async_threads) {}
+
+ServerRunner::~ServerRunner() {
+  if (serverInstance_) {
+    serverInstance_->Shutdown();
+  }
+  shutdownAsyncCalls();
+  // the server is destroyed before its completion queue
+  serverInstance_.reset();
+}
 
 ServerRunner &ServerRunner::append(std::shared_ptr<grpc::Service> service) {
   services_.push_back(service);
@@ -31,8 +45,17 @@ iroha::expected::Result<int, std::string> ServerRunner::run() {
   builder.AddListeningPort(
       serverAddress_, grpc::InsecureServerCredentials(), &selected_port);
 
+  std::vector<iroha::network::AsyncGrpcService *> async_services;
   for (auto &service : services_) {
     builder.RegisterService(service.get());
+    if (auto async_service =
+            dynamic_cast<iroha::network::AsyncGrpcService *>(service.get())) {
+      async_services.push_back(async_service);
+    }
+  }
+  if (not async_services.empty()) {
+    async_call_queue_ = std::make_unique<iroha::network::AsyncCallQueue>(
+        builder.AddCompletionQueue());
   }
 
   // in order to bypass built-it limitation of gRPC message size
@@ -40,6 +63,16 @@ iroha::expected::Result<int, std::string> ServerRunner::run() {
   builder.SetMaxSendMessageSize(INT_MAX);
 
   serverInstance_ = builder.BuildAndStart();
+
+  if (serverInstance_ and async_call_queue_) {
+    for (auto service : async_services) {
+      service->requestCalls(*async_call_queue_);
+    }
+    for (size_t i = 0; i < async_threads_; ++i) {
+      async_call_threads_.emplace_back(
+          [queue = async_call_queue_.get()] { queue->handleCalls(); });
+    }
+  }
   serverInstanceCV_.notify_one();
 
   if (selected_port == 0) {
@@ -60,6 +93,7 @@ void ServerRunner::waitForServersReady() {
 void ServerRunner::shutdown() {
   if (serverInstance_) {
     serverInstance_->Shutdown();
+    shutdownAsyncCalls();
   } else {
     log_->warn("Tried to shutdown without a server instance");
   }
@@ -69,7 +103,22 @@ void ServerRunner::shutdown(
     const std::chrono::system_clock::time_point &deadline) {
   if (serverInstance_) {
     serverInstance_->Shutdown(deadline);
+    shutdownAsyncCalls();
   } else {
     log_->warn("Tried to shutdown without a server instance");
   }
 }
+
+void ServerRunner::shutdownAsyncCalls() {
+  if (not async_call_queue_) {
+    return;
+  }
+  async_call_queue_->shutdown();
+  for (auto &thread : async_call_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  async_call_threads_.clear();
+  async_call_queue_->releaseRetained();
+}
@@ -6,11 +6,20 @@
 #ifndef MAIN_SERVER_RUNNER_HPP
 #define MAIN_SERVER_RUNNER_HPP
 
+#include <condition_variable>
+#include <thread>
+
 #include <grpc++/grpc++.h>
 #include <grpc++/impl/codegen/service_type.h>
 #include "common/result.hpp"
 #include "logger/logger_fwd.hpp"
 
+namespace iroha {
+  namespace network {
+    class AsyncCallQueue;
+  }  // namespace network
+}  // namespace iroha
+
 /**
  * Class runs Torii server for handling queries and commands.
  */
@@ -21,13 +30,20 @@ class ServerRunner {
    * @param address - the address the server will be bind to in URI form
    * @param log to print progress to
    * @param reuse - allow multiple sockets to bind to the same port
+   * @param async_threads - number of threads, which handle asynchronous calls
+   * of the services
    */
   explicit ServerRunner(const std::string &address,
                         logger::LoggerPtr log,
-                        bool reuse = true);
+                        bool reuse = true,
+                        size_t async_threads = 2);
+
+  ~ServerRunner();
 
   /**
-   * Adds a new grpc service to be run.
+   * Adds a new grpc service to be run. Asynchronous methods of services
+   * implementing iroha::network::AsyncGrpcService are handled on a completion
+   * queue of the server.
    * @param service - service to append.
    * @return reference to this with service appended
    */
@@ -55,6 +71,13 @@ class ServerRunner {
   void shutdown(const std::chrono::system_clock::time_point &deadline);
 
  private:
+  /**
+   * Shut down the completion queue, wait for its threads, and release the
+   * calls retained by the queue. Must be invoked after the server is shut
+   * down
+   */
+  void shutdownAsyncCalls();
+
   logger::LoggerPtr log_;
 
   std::unique_ptr<grpc::Server> serverInstance_;
@@ -64,6 +87,10 @@ class ServerRunner {
   std::string serverAddress_;
   bool reuse_;
   std::vector<std::shared_ptr<grpc::Service>> services_;
+
+  const size_t async_threads_;
+  std::unique_ptr<iroha::network::AsyncCallQueue> async_call_queue_;
+  std::vector<std::thread> async_call_threads_;
 };
 
 #endif  // MAIN_SERVER_RUNNER_HPP
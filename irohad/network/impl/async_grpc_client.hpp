@@ -7,6 +7,7 @@
 #define IROHA_ASYNC_GRPC_CLIENT_HPP
 
 #include <ciso646>
+#include <functional>
 #include <thread>
 
 #include <google/protobuf/empty.pb.h>
@@ -18,7 +19,8 @@ namespace iroha {
   namespace network {
 
     /**
-     * Asynchronous gRPC client which does no processing of server responses
+     * Asynchronous gRPC client which does no processing of server responses,
+     * unless a response callback is provided with the call
      * @tparam Response type of server response
      */
     template <typename Response>
@@ -39,6 +41,9 @@ namespace iroha {
           if (not call->status.ok()) {
             log_->warn("RPC failed: {}", call->status.error_message());
           }
+          if (call->on_response) {
+            call->on_response(call->status, call->reply);
+          }
           delete call;
         }
       }
@@ -53,6 +58,9 @@ namespace iroha {
       grpc::CompletionQueue cq_;
       std::thread thread_;
 
+      using ResponseCallbackType =
+          std::function<void(const grpc::Status &, const Response &)>;
+
       /**
        * State and data information of gRPC call
        */
@@ -65,6 +73,9 @@ namespace iroha {
 
         std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>>
             response_reader;
+
+        /// invoked from the completion queue thread when the call finishes
+        ResponseCallbackType on_response;
       };
 
       /**
@@ -74,7 +85,20 @@ namespace iroha {
        */
       template <typename F>
       void Call(F &&lambda) {
+        Call(std::forward<F>(lambda), ResponseCallbackType{});
+      }
+
+      /**
+       * Perform the call and process the server response
+       * @tparam lambda which must return unique pointer to
+       * ClientAsyncResponseReader<Response> object
+       * @param on_response - callback which receives status and reply of the
+       * call, invoked from the thread of the completion queue
+       */
+      template <typename F>
+      void Call(F &&lambda, ResponseCallbackType on_response) {
         auto call = new AsyncClientCall;
+        call->on_response = std::move(on_response);
         call->response_reader = lambda(&call->context, &cq_);
         call->response_reader->Finish(&call->reply, &call->status, call);
       }
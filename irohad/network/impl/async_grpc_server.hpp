@@ -0,0 +1,404 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_ASYNC_GRPC_SERVER_HPP
+#define IROHA_ASYNC_GRPC_SERVER_HPP
+
+#include <ciso646>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <grpc++/grpc++.h>
+#include <grpcpp/impl/codegen/async_stream.h>
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * State of an asynchronous gRPC server call. Pointer to it is used as a
+     * tag of the completion queue
+     */
+    class AsyncGrpcCall {
+     public:
+      virtual ~AsyncGrpcCall() = default;
+
+      /**
+       * Continue the call after its operation is completed. Invoked from a
+       * thread of the completion queue
+       * @param ok - whether the operation has succeeded
+       */
+      virtual void proceed(bool ok) = 0;
+    };
+
+    /**
+     * Completion queue of asynchronous calls of a server. Besides the queue,
+     * it keeps the calls, which cannot tell whether more of their tags are
+     * going to be delivered, until the queue is drained
+     */
+    class AsyncCallQueue {
+     public:
+      explicit AsyncCallQueue(std::unique_ptr<grpc::ServerCompletionQueue> cq)
+          : cq_(std::move(cq)) {}
+
+      grpc::ServerCompletionQueue *get() const {
+        return cq_.get();
+      }
+
+      /**
+       * Handle delivered tags until the queue is shut down and drained
+       */
+      void handleCalls() {
+        void *tag;
+        auto ok = false;
+        while (cq_->Next(&tag, &ok)) {
+          static_cast<AsyncGrpcCall *>(tag)->proceed(ok);
+        }
+      }
+
+      /**
+       * Keep the call until the queue is drained
+       */
+      void retain(std::shared_ptr<AsyncGrpcCall> call) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retained_.push_back(std::move(call));
+      }
+
+      /**
+       * Request a call on the queue, unless the queue is shut down. Calls
+       * are requested from the threads of the queue as well, and gRPC
+       * forbids requesting them after the queue is shut down, so the request
+       * is serialized with shutdown
+       * @param request_call - requests the call from the service
+       * @return whether the call is requested
+       */
+      template <typename RequestCall>
+      bool requestCall(RequestCall &&request_call) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shut_down_) {
+          return false;
+        }
+        std::forward<RequestCall>(request_call)();
+        return true;
+      }
+
+      /**
+       * Shut down the queue. It is drained by the threads handling the calls
+       */
+      void shutdown() {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          shut_down_ = true;
+        }
+        // no more calls are requested at this point
+        cq_->Shutdown();
+      }
+
+      /**
+       * Release the retained calls. Must be invoked after the queue is
+       * drained, when no more tags are delivered
+       */
+      void releaseRetained() {
+        std::vector<std::shared_ptr<AsyncGrpcCall>> retained;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          retained.swap(retained_);
+        }
+      }
+
+     private:
+      std::unique_ptr<grpc::ServerCompletionQueue> cq_;
+      std::vector<std::shared_ptr<AsyncGrpcCall>> retained_;
+      bool shut_down_ = false;
+      std::mutex mutex_;
+    };
+
+    /**
+     * gRPC service with methods, which are handled asynchronously on a
+     * completion queue of the server instead of occupying a server thread
+     * for the whole call
+     */
+    class AsyncGrpcService {
+     public:
+      virtual ~AsyncGrpcService() = default;
+
+      /**
+       * Start accepting the asynchronous calls of the service
+       * @param queue - completion queue, which delivers the calls. It is
+       * shut down after the server, so the requested calls are completed
+       * with failure on shutdown
+       */
+      virtual void requestCalls(AsyncCallQueue &queue) = 0;
+    };
+
+    /// behaviour of a stream, which has too many messages waiting to be sent
+    enum class StreamOverflowPolicy {
+      /// the oldest waiting message is dropped
+      kDropOldest,
+      /// the waiting messages are dropped, and the stream is finished with
+      /// RESOURCE_EXHAUSTED status, since the client is too slow
+      kFinish
+    };
+
+    /**
+     * Server streaming call handled on a completion queue. Messages can be
+     * written from any thread, they are queued and sent one by one, since
+     * gRPC allows only a single write in progress. The queue is bounded, its
+     * overflow is handled according to StreamOverflowPolicy
+     * @tparam Request type of the client request
+     * @tparam Response type of messages in the stream
+     */
+    template <typename Request, typename Response>
+    class AsyncServerStream
+        : public AsyncGrpcCall,
+          public std::enable_shared_from_this<
+              AsyncServerStream<Request, Response>> {
+     public:
+      using RequestCallType =
+          std::function<void(grpc::ServerContext *,
+                             Request *,
+                             grpc::ServerAsyncWriter<Response> *,
+                             void *)>;
+      using StartCallType =
+          std::function<void(std::shared_ptr<AsyncServerStream>)>;
+      using DoneCallType = std::function<void()>;
+
+      /**
+       * Wait for the next call of the method. Nothing is requested, if the
+       * queue is already shut down
+       * @param queue - completion queue of the call
+       * @param request_call - requests the call from the service, using the
+       * given context, request, writer and tag
+       * @param on_start - invoked, when the call is received
+       * @param max_queue_size - number of messages waiting to be sent
+       * @param overflow_policy - handling of a message, which does not fit
+       * into the queue
+       */
+      static void request(AsyncCallQueue &queue,
+                          const RequestCallType &request_call,
+                          StartCallType on_start,
+                          size_t max_queue_size,
+                          StreamOverflowPolicy overflow_policy) {
+        queue.requestCall([&] {
+          std::shared_ptr<AsyncServerStream> stream(
+              new AsyncServerStream(queue,
+                                    std::move(on_start),
+                                    max_queue_size,
+                                    overflow_policy));
+          // the stream is owned by the completion queue until both the tags
+          // of its operations and the done tag are delivered
+          stream->self_ = stream;
+          stream->context_.AsyncNotifyWhenDone(&stream->done_tag_);
+          request_call(&stream->context_,
+                       &stream->request_,
+                       &stream->writer_,
+                       stream.get());
+        });
+      }
+
+      const Request &request() const {
+        return request_;
+      }
+
+      const grpc::ServerContext &context() const {
+        return context_;
+      }
+
+      /**
+       * Set callback, which is invoked once the stream is finished or the
+       * client is disconnected. Producers of messages should stop there
+       */
+      void onDone(DoneCallType on_done) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (done_) {
+          lock.unlock();
+          on_done();
+          return;
+        }
+        on_done_ = std::move(on_done);
+      }
+
+      /**
+       * Queue the message to the stream
+       */
+      void write(Response response) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done_ or finish_status_) {
+          return;
+        }
+        if (in_progress_) {
+          if (queue_.size() >= max_queue_size_) {
+            ++dropped_;
+            if (overflow_policy_ == StreamOverflowPolicy::kFinish) {
+              // the stream is finished after the current write
+              dropped_ += queue_.size();
+              queue_.clear();
+              finish_status_ =
+                  grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                               "too many messages are waiting to be sent");
+              return;
+            }
+            queue_.pop_front();
+          }
+          queue_.push_back(std::move(response));
+          return;
+        }
+        startWrite(std::move(response));
+      }
+
+      /**
+       * Finish the stream after the queued messages are sent
+       */
+      void finish(grpc::Status status) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done_ or finish_status_) {
+          return;
+        }
+        finish_status_ = std::move(status);
+        if (not in_progress_) {
+          startFinish();
+        }
+      }
+
+      /**
+       * @return number of messages dropped due to the queue overflow,
+       * including the ones queued, when the stream is finished on overflow
+       */
+      size_t dropped() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+      }
+
+      void proceed(bool ok) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (not started_) {
+          if (not ok) {
+            // server is shut down before the call is received. gRPC does
+            // not guarantee, whether the done tag of such a call is
+            // delivered, so the stream is kept until the queue is drained
+            auto self = std::move(self_);
+            lock.unlock();
+            call_queue_.retain(std::move(self));
+            return;
+          }
+          started_ = true;
+          auto on_start = std::move(on_start_);
+          lock.unlock();
+          on_start(this->shared_from_this());
+          return;
+        }
+
+        in_progress_ = false;
+        if (finishing_ or not ok) {
+          // the stream is finished, or the client is disconnected
+          queue_.clear();
+          done_ = true;
+        }
+        if (not done_) {
+          if (not queue_.empty()) {
+            auto response = std::move(queue_.front());
+            queue_.pop_front();
+            startWrite(std::move(response));
+          } else if (finish_status_) {
+            startFinish();
+          }
+        }
+        complete(lock);
+      }
+
+     private:
+      /**
+       * Tag of the completion of the call, which is delivered after the call
+       * is finished or cancelled
+       */
+      struct DoneTag : public AsyncGrpcCall {
+        explicit DoneTag(AsyncServerStream &stream) : stream(stream) {}
+
+        void proceed(bool) override {
+          std::unique_lock<std::mutex> lock(stream.mutex_);
+          stream.done_ = true;
+          stream.done_tag_received_ = true;
+          stream.complete(lock);
+        }
+
+        AsyncServerStream &stream;
+      };
+
+      AsyncServerStream(AsyncCallQueue &queue,
+                        StartCallType on_start,
+                        size_t max_queue_size,
+                        StreamOverflowPolicy overflow_policy)
+          : call_queue_(queue),
+            writer_(&context_),
+            done_tag_(*this),
+            on_start_(std::move(on_start)),
+            max_queue_size_(max_queue_size),
+            overflow_policy_(overflow_policy) {}
+
+      void startWrite(Response response) {
+        in_progress_ = true;
+        current_ = std::move(response);
+        writer_.Write(current_, this);
+      }
+
+      void startFinish() {
+        in_progress_ = true;
+        finishing_ = true;
+        writer_.Finish(*finish_status_, this);
+      }
+
+      /**
+       * Notify the producers when the stream is done, and release the stream
+       * when no more tags of it are expected from the completion queue
+       * @param lock - acquired lock of mutex_, which is released
+       */
+      void complete(std::unique_lock<std::mutex> &lock) {
+        auto on_done = done_ ? std::move(on_done_) : DoneCallType{};
+        std::shared_ptr<AsyncServerStream> self;
+        if (done_tag_received_ and not in_progress_) {
+          self = std::move(self_);
+        }
+        lock.unlock();
+        if (on_done) {
+          on_done();
+        }
+      }
+
+      AsyncCallQueue &call_queue_;
+      grpc::ServerContext context_;
+      Request request_;
+      grpc::ServerAsyncWriter<Response> writer_;
+      DoneTag done_tag_;
+
+      StartCallType on_start_;
+      DoneCallType on_done_;
+      std::shared_ptr<AsyncServerStream> self_;
+
+      const size_t max_queue_size_;
+      const StreamOverflowPolicy overflow_policy_;
+      /// message, which is being written
+      Response current_;
+      std::deque<Response> queue_;
+      boost::optional<grpc::Status> finish_status_;
+      size_t dropped_ = 0;
+
+      bool started_ = false;
+      /// write or finish operation is in progress
+      bool in_progress_ = false;
+      bool finishing_ = false;
+      /// no more messages are sent
+      bool done_ = false;
+      bool done_tag_received_ = false;
+      mutable std::mutex mutex_;
+    };
+
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_ASYNC_GRPC_SERVER_HPP
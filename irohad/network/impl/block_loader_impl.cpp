@@ -7,10 +7,12 @@
 
 #include <grpc++/create_channel.h>
 #include <chrono>
+#include <thread>
 
 #include "backend/protobuf/block.hpp"
 #include "builders/protobuf/transport_builder.hpp"
 #include "common/bind.hpp"
+#include "common/bounded_queue.hpp"
 #include "interfaces/common_objects/peer.hpp"
 #include "logger/logger.hpp"
 #include "network/impl/grpc_channel_builder.hpp"
@@ -25,6 +27,8 @@ namespace {
   const char *kPeerRetrieveFail = "Failed to retrieve peers";
   const char *kPeerFindFail = "Failed to find requested peer";
   const std::chrono::seconds kBlocksRequestTimeout{5};
+  /// number of received blocks waiting for stateless validation
+  const size_t kReceivedBlocksQueueSize = 16;
 }  // namespace
 
 BlockLoaderImpl::BlockLoaderImpl(
@@ -49,7 +53,6 @@ rxcpp::observable<std::shared_ptr<Block>> BlockLoaderImpl::retrieveBlocks(
 
         proto::BlocksRequest request;
         grpc::ClientContext context;
-        protocol::Block block;
 
         // set a timeout to avoid being hung
         context.set_deadline(std::chrono::system_clock::now()
@@ -60,19 +63,43 @@ rxcpp::observable<std::shared_ptr<Block>> BlockLoaderImpl::retrieveBlocks(
 
         auto reader =
             this->getPeerStub(**peer).retrieveBlocks(&context, request);
-        while (subscriber.is_subscribed() and reader->Read(&block)) {
-          auto proto_block = block_factory_.createBlock(std::move(block));
-          proto_block.match(
-              [&subscriber](
-                  iroha::expected::Value<std::unique_ptr<Block>> &result) {
-                subscriber.on_next(std::move(result.value));
-              },
-              [this,
-               &context](const iroha::expected::Error<std::string> &error) {
-                log_->error(error.error);
-                context.TryCancel();
-              });
+        // blocks are received on a separate thread, while the previous ones
+        // are checked and passed to the subscriber
+        iroha::BoundedQueue<protocol::Block> received(kReceivedBlocksQueueSize);
+        std::thread receiver([&reader, &received] {
+          protocol::Block block;
+          while (reader->Read(&block)) {
+            if (not received.push(std::move(block))) {
+              break;
+            }
+          }
+          received.close();
+        });
+
+        bool stopped = false;
+        while (auto block = received.pop()) {
+          if (not subscriber.is_subscribed()) {
+            stopped = true;
+            break;
+          }
+          auto proto_block = block_factory_.createBlock(std::move(*block));
+          if (auto e = boost::get<iroha::expected::Error<std::string>>(
+                  &proto_block)) {
+            log_->error(e->error);
+            stopped = true;
+            break;
+          }
+          subscriber.on_next(std::shared_ptr<Block>(std::move(
+              boost::get<iroha::expected::Value<std::unique_ptr<Block>>>(
+                  &proto_block)
+                  ->value)));
         }
+        if (stopped) {
+          // the rest of the stream is not needed
+          received.close();
+          context.TryCancel();
+        }
+        receiver.join();
         reader->Finish();
         subscriber.on_completed();
       });
@@ -5,8 +5,8 @@
 
 #include "network/impl/block_loader_service.hpp"
 
+#include "ametsuchi/block_cursor.hpp"
 #include "backend/protobuf/block.hpp"
-#include "common/bind.hpp"
 #include "logger/logger.hpp"
 
 using namespace iroha;
@@ -26,18 +26,30 @@ grpc::Status BlockLoaderService::retrieveBlocks(
     ::grpc::ServerContext *context,
     const proto::BlocksRequest *request,
     ::grpc::ServerWriter<::iroha::protocol::Block> *writer) {
-  auto blocks = block_query_factory_->createBlockQuery() |
-      [height = request->height()](const auto &block_query) {
-        return block_query->getBlocksFrom(height);
-      };
-  std::for_each(blocks.begin(), blocks.end(), [&writer](const auto &block) {
+  auto block_query = block_query_factory_->createBlockQuery();
+  if (not block_query) {
+    log_->error("Could not create block query to retrieve blocks");
+    return grpc::Status(grpc::StatusCode::INTERNAL, "internal error happened");
+  }
+
+  // blocks are read and sent one by one, so that the whole chain is never
+  // held in memory
+  BlockCursor cursor(**block_query, request->height());
+  while (auto block = cursor.next()) {
+    if (context->IsCancelled()) {
+      log_->info("Blocks retrieval was cancelled by the client");
+      return grpc::Status::CANCELLED;
+    }
     protocol::Block proto_block;
     *proto_block.mutable_block_v1() =
-        std::dynamic_pointer_cast<shared_model::proto::Block>(block)
+        std::dynamic_pointer_cast<shared_model::proto::Block>(*block)
             ->getTransport();
 
-    writer->Write(proto_block);
-  });
+    if (not writer->Write(proto_block)) {
+      log_->info("Blocks stream was closed by the client");
+      break;
+    }
+  }
   return grpc::Status::OK;
 }
 
@@ -76,30 +88,37 @@ grpc::Status BlockLoaderService::retrieveBlock(
   }
 
   // cache missed: notify and try to fetch the block from block storage itself
-  auto blocks = block_query_factory_->createBlockQuery() |
-      // TODO [IR-1757] Akvinikym 12.10.18: use block height to get one block
-      // instead of the whole chain
-      [](const auto &block_query) {
-        return boost::make_optional(block_query->getBlocksFrom(1));
-      };
-  if (not blocks) {
+  auto block_query = block_query_factory_->createBlockQuery();
+  if (not block_query) {
     log_->error("Could not create block query to retrieve block from storage");
     return grpc::Status(grpc::StatusCode::INTERNAL, "internal error happened");
   }
 
-  auto found_block = std::find_if(
-      std::begin(*blocks), std::end(*blocks), [&hash](const auto &block) {
-        return block->hash() == hash;
-      });
-  if (found_block == std::end(*blocks)) {
-    log_->error("Could not retrieve a block from block storage: requested {}",
-                hash.hex());
-    return grpc::Status(grpc::StatusCode::NOT_FOUND, "Block not found");
-  }
-
-  auto block_v1 =
-      std::static_pointer_cast<shared_model::proto::Block>(*found_block)
-          ->getTransport();
-  *response->mutable_block_v1() = block_v1;
-  return grpc::Status::OK;
+  return (*block_query)
+      ->getBlockByHash(hash)
+      .match(
+          [response](const expected::Value<
+                     std::shared_ptr<shared_model::interface::Block>> &block) {
+            *response->mutable_block_v1() =
+                std::static_pointer_cast<shared_model::proto::Block>(
+                    block.value)
+                    ->getTransport();
+            return grpc::Status::OK;
+          },
+          [this, &hash](
+              const expected::Error<ametsuchi::BlockQuery::GetBlockError>
+                  &error) {
+            log_->error(
+                "Could not retrieve a block from block storage: requested {}, "
+                "reason: {}",
+                hash.hex(),
+                error.error.message);
+            if (error.error.code
+                == ametsuchi::BlockQuery::GetBlockError::Code::kNoBlock) {
+              return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                                  "Block not found");
+            }
+            return grpc::Status(grpc::StatusCode::INTERNAL,
+                                "internal error happened");
+          });
 }
@@ -40,6 +40,17 @@ namespace iroha {
        */
       virtual rxcpp::observable<OrderingEvent> onProposal() = 0;
 
+      /**
+       * Return observable of proposals of the rounds, which follow a commit
+       * of the current one, as soon as they are received, before the current
+       * round is finished. Replays are not removed from them yet, so a
+       * proposal may differ from the one later emitted by onProposal
+       * @return observable with notifications
+       */
+      virtual rxcpp::observable<OrderingEvent> onPrefetchedProposal() {
+        return rxcpp::observable<>::empty<OrderingEvent>();
+      }
+
       virtual ~OrderingGate() = default;
     };
   }  // namespace network
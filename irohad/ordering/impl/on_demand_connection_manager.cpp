@@ -6,6 +6,7 @@
 #include "ordering/impl/on_demand_connection_manager.hpp"
 
 #include <boost/range/combine.hpp>
+#include "interfaces/common_objects/peer.hpp"
 #include "interfaces/iroha_internal/proposal.hpp"
 #include "logger/logger.hpp"
 #include "ordering/impl/on_demand_common.hpp"
@@ -69,6 +70,47 @@ OnDemandConnectionManager::onRequestProposal(consensus::Round round) {
   return connections_.peers[kIssuer]->onRequestProposal(round);
 }
 
+void OnDemandConnectionManager::onRequestProposalAsync(
+    consensus::Round round, ProposalCallbackType callback) {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  log_->debug("onRequestProposalAsync, {}", round);
+
+  auto issuer = issuerOf(round);
+  if (not issuer) {
+    log_->debug("Issuer of {} is unknown in {}", round, current_round_);
+    callback(boost::none);
+    return;
+  }
+
+  connections_.peers[*issuer]->onRequestProposalAsync(round,
+                                                      std::move(callback));
+}
+
+boost::optional<shared_model::interface::types::PubkeyType>
+OnDemandConnectionManager::proposalIssuer(consensus::Round round) {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (auto issuer = issuerOf(round)) {
+    return peers_[*issuer]->pubkey();
+  }
+  return boost::none;
+}
+
+boost::optional<OnDemandConnectionManager::PeerType>
+OnDemandConnectionManager::issuerOf(consensus::Round round) const {
+  if (round == current_round_) {
+    return kIssuer;
+  }
+  if (round == nextRejectRound(current_round_)) {
+    return kNextRejectRoundIssuer;
+  }
+  if (round == nextCommitRound(current_round_)) {
+    return kNextCommitRoundIssuer;
+  }
+  return boost::none;
+}
+
 void OnDemandConnectionManager::initializeConnections(
     const CurrentPeers &peers) {
   auto create_assign = [this](auto &ptr, auto &peer) {
@@ -78,4 +120,6 @@ void OnDemandConnectionManager::initializeConnections(
   for (auto &&pair : boost::combine(connections_.peers, peers.peers)) {
     create_assign(boost::get<0>(pair), boost::get<1>(pair));
   }
+  peers_ = peers.peers;
+  current_round_ = peers.round;
 }
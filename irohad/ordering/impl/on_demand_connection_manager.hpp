@@ -27,12 +27,16 @@ namespace iroha {
        * reject round for current block, reject round for next block, and
        * commit for subsequent next round
        * Proposal is requested from the current ordering service: issuer
+       * Proposals of the possible next rounds are prefetched from their
+       * issuers: next reject round issuer and next commit round issuer
        */
       enum PeerType {
         kCurrentRoundRejectConsumer = 0,
         kNextRoundRejectConsumer,
         kNextRoundCommitConsumer,
         kIssuer,
+        kNextRejectRoundIssuer,
+        kNextCommitRoundIssuer,
         kCount
       };
 
@@ -47,6 +51,8 @@ namespace iroha {
       struct CurrentPeers {
         PeerCollectionType<std::shared_ptr<shared_model::interface::Peer>>
             peers;
+        /// round, for which the peers are selected
+        consensus::Round round{};
       };
 
       OnDemandConnectionManager(
@@ -67,7 +73,30 @@ namespace iroha {
       boost::optional<std::shared_ptr<const ProposalType>> onRequestProposal(
           consensus::Round round) override;
 
+      /**
+       * Request proposal from the issuer of the given round, which is either
+       * the current round or one of the possible next rounds. Callback gets
+       * no proposal for other rounds
+       */
+      void onRequestProposalAsync(consensus::Round round,
+                                  ProposalCallbackType callback) override;
+
+      /**
+       * Issuer of the given round, which is either the current round or one
+       * of the possible next rounds. Issuer of the next commit round is
+       * selected with the current peers, so it can differ from the actual
+       * one, when the peers of the round are known
+       */
+      boost::optional<shared_model::interface::types::PubkeyType>
+      proposalIssuer(consensus::Round round) override;
+
      private:
+      /**
+       * @return issuer of the round relative to the current round, or none
+       * if the round does not follow the current one
+       */
+      boost::optional<PeerType> issuerOf(consensus::Round round) const;
+
       /**
        * Corresponding connections created by OdOsNotificationFactory
        * @see PeerType for individual descriptions
@@ -87,6 +116,9 @@ namespace iroha {
       rxcpp::composite_subscription subscription_;
 
       CurrentConnections connections_;
+      PeerCollectionType<std::shared_ptr<shared_model::interface::Peer>>
+          peers_;
+      consensus::Round current_round_{};
 
       std::shared_timed_mutex mutex_;
     };
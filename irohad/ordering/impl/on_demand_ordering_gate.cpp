@@ -61,8 +61,11 @@ OnDemandOrderingGate::OnDemandOrderingGate(
         this->sendCachedTransactions(event);
 
         // request proposal for the current round
-        auto proposal = this->processProposalRequest(
-            network_client_->onRequestProposal(current_round));
+        auto proposal =
+            this->processProposalRequest(this->requestProposal(current_round));
+        // the next round starts after consensus on the current one, so its
+        // proposal can be requested meanwhile
+        this->prefetchProposals(current_round);
         // vote for the object received from the network
         proposal_notifier_.get_subscriber().on_next(
             network::OrderingEvent{std::move(proposal), current_round});
@@ -87,6 +90,73 @@ rxcpp::observable<network::OrderingEvent> OnDemandOrderingGate::onProposal() {
   return proposal_notifier_.get_observable();
 }
 
+rxcpp::observable<network::OrderingEvent>
+OnDemandOrderingGate::onPrefetchedProposal() {
+  return prefetched_proposal_notifier_.get_observable();
+}
+
+OnDemandOrderingGate::ProposalResultType
+OnDemandOrderingGate::requestProposal(consensus::Round round) {
+  ProposalResultType proposal;
+  auto prefetched = prefetched_proposals_.find(round);
+  if (prefetched != prefetched_proposals_.end()) {
+    // the issuer was guessed at the time of prefetch, and the peers of the
+    // round are known now
+    auto issuer = network_client_->proposalIssuer(round);
+    if (issuer != prefetched->second.issuer) {
+      log_->info("Issuer of {} has changed since the prefetch, discarding "
+                 "the prefetched proposal",
+                 round);
+    } else {
+      try {
+        // waits for the response, if the request is still in progress
+        proposal = prefetched->second.proposal.get();
+      } catch (const std::future_error &e) {
+        log_->warn("Prefetch of proposal for {} failed: {}", round, e.what());
+      }
+    }
+  }
+  prefetched_proposals_.erase(prefetched_proposals_.begin(),
+                              prefetched_proposals_.upper_bound(round));
+
+  if (proposal) {
+    log_->debug("Using prefetched proposal for {}", round);
+    return proposal;
+  }
+  // the issuer could have had no proposal yet at the time of prefetch
+  return network_client_->onRequestProposal(round);
+}
+
+void OnDemandOrderingGate::prefetchProposals(consensus::Round round) {
+  for (const auto &next_round :
+       {nextRejectRound(round), nextCommitRound(round)}) {
+    if (prefetched_proposals_.count(next_round) != 0) {
+      continue;
+    }
+    auto promise = std::make_shared<std::promise<ProposalResultType>>();
+    prefetched_proposals_.emplace(
+        next_round,
+        PrefetchedProposal{network_client_->proposalIssuer(next_round),
+                           promise->get_future().share()});
+    const bool is_commit_round = next_round == nextCommitRound(round);
+    network_client_->onRequestProposalAsync(
+        next_round,
+        [promise,
+         next_round,
+         is_commit_round,
+         subscriber = prefetched_proposal_notifier_.get_subscriber()](
+            ProposalResultType proposal) {
+          // the proposal of the commit round can be validated on top of the
+          // current round while it is in consensus
+          if (is_commit_round and proposal
+              and not boost::empty((*proposal)->transactions())) {
+            subscriber.on_next(network::OrderingEvent{*proposal, next_round});
+          }
+          promise->set_value(std::move(proposal));
+        });
+  }
+}
+
 boost::optional<std::shared_ptr<const shared_model::interface::Proposal>>
 OnDemandOrderingGate::processProposalRequest(
     boost::optional<
@@ -117,6 +187,12 @@ void OnDemandOrderingGate::sendCachedTransactions(
   auto batches = cache_->pop();
   cache_->addToBack(batches);
 
+  auto metrics = cache_->metrics();
+  log_->debug("Cache holds {} transactions of {} batches, oldest is {} ms old",
+              metrics.transactions,
+              metrics.batches,
+              metrics.oldest_batch_age.count());
+
   // get only transactions which fit to next proposal
   auto end_iterator = batches.begin();
   auto current_number_of_transactions = 0u;
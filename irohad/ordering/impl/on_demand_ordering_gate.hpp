@@ -8,6 +8,8 @@
 
 #include "network/ordering_gate.hpp"
 
+#include <future>
+#include <map>
 #include <shared_mutex>
 
 #include <boost/variant.hpp>
@@ -28,7 +30,9 @@ namespace iroha {
 
     /**
      * Ordering gate which requests proposals from the ordering service
-     * votes for proposals, and passes committed proposals to the pipeline
+     * votes for proposals, and passes committed proposals to the pipeline.
+     * Proposals of the possible next rounds are requested asynchronously
+     * while the current round is in consensus
      */
     class OnDemandOrderingGate : public network::OrderingGate {
      public:
@@ -77,7 +81,36 @@ namespace iroha {
 
       rxcpp::observable<network::OrderingEvent> onProposal() override;
 
+      rxcpp::observable<network::OrderingEvent> onPrefetchedProposal()
+          override;
+
      private:
+      using ProposalResultType = boost::optional<
+          std::shared_ptr<const OnDemandOrderingService::ProposalType>>;
+
+      /**
+       * Response to an asynchronous proposal request, and the issuer it was
+       * requested from
+       */
+      struct PrefetchedProposal {
+        boost::optional<shared_model::interface::types::PubkeyType> issuer;
+        std::shared_future<ProposalResultType> proposal;
+      };
+
+      /**
+       * Get proposal of the round, prefetched one if it was received from
+       * the actual issuer of the round, or requested from the network
+       * otherwise. Prefetched proposals of this and previous rounds are
+       * discarded
+       */
+      ProposalResultType requestProposal(consensus::Round round);
+
+      /**
+       * Start asynchronous requests of proposals for rounds which can follow
+       * the given one
+       */
+      void prefetchProposals(consensus::Round round);
+
       /**
        * Handle an incoming proposal from ordering service
        */
@@ -108,7 +141,14 @@ namespace iroha {
           proposal_factory_;
       std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache_;
 
+      /// responses to asynchronous proposal requests, accessed only from
+      /// round events handler
+      std::map<consensus::Round, PrefetchedProposal> prefetched_proposals_;
+
       rxcpp::subjects::subject<network::OrderingEvent> proposal_notifier_;
+      /// emits from the threads of the asynchronous proposal requests
+      rxcpp::subjects::subject<network::OrderingEvent>
+          prefetched_proposal_notifier_;
     };
 
   }  // namespace ordering
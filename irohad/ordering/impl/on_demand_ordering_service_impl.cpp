@@ -5,7 +5,9 @@
 
 #include "ordering/impl/on_demand_ordering_service_impl.hpp"
 
-#include <unordered_set>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
 
 #include <boost/optional.hpp>
 #include <boost/range/adaptor/filtered.hpp>
@@ -33,9 +35,11 @@ OnDemandOrderingServiceImpl::OnDemandOrderingServiceImpl(
     std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
     logger::LoggerPtr log,
     size_t number_of_proposals,
-    const consensus::Round &initial_round)
+    const consensus::Round &initial_round,
+    bool group_conflicting_batches)
     : transaction_limit_(transaction_limit),
       number_of_proposals_(number_of_proposals),
+      group_conflicting_batches_(group_conflicting_batches),
       proposal_factory_(std::move(proposal_factory)),
       tx_cache_(std::move(tx_cache)),
       log_(std::move(log)) {
@@ -47,11 +51,14 @@ OnDemandOrderingServiceImpl::OnDemandOrderingServiceImpl(
 void OnDemandOrderingServiceImpl::onCollaborationOutcome(
     consensus::Round round) {
   log_->info("onCollaborationOutcome => {}", round);
+  // storage is queried before the write lock, so that incoming batches and
+  // proposal requests are not blocked meanwhile
+  auto processed = processedLeftOverTransactions(round);
   // exclusive write lock
   std::lock_guard<std::shared_timed_mutex> guard(lock_);
   log_->debug("onCollaborationOutcome => write lock is acquired");
 
-  packNextProposals(round);
+  packNextProposals(round, processed);
   tryErase(round);
 }
 
@@ -71,7 +78,10 @@ void OnDemandOrderingServiceImpl::onBatches(CollectionType batches) {
   std::for_each(
       unprocessed_batches.begin(),
       unprocessed_batches.end(),
-      [this](auto &obj) { current_round_batches_.insert(std::move(obj)); });
+      [this](auto &obj) {
+        current_round_batches_.insert(
+            {std::move(obj), detail::BatchInfo{next_arrival_++, false}});
+      });
   log_->debug("onBatches => collection is inserted");
 }
 
@@ -95,49 +105,132 @@ OnDemandOrderingServiceImpl::onRequestProposal(consensus::Round round) {
 
 // ---------------------------------| Private |---------------------------------
 
-/**
- * Get transactions from the given batches queue. Does not break batches -
- * continues getting all the transactions from the ongoing batch until the
- * required amount is collected.
- * @tparam Lambda - type of side effect function for batches
- * @param requested_tx_amount - amount of transactions to get
- * @param batch_collection - the collection to get transactions from
- * @param discarded_txs_amount - the amount of discarded txs
- * @param batch_operation - side effect function to be performed on each
- * inserted batch. Passed pointer could be modified
- * @return transactions
- */
-template <typename Lambda>
-static std::vector<std::shared_ptr<shared_model::interface::Transaction>>
-getTransactions(size_t requested_tx_amount,
-                detail::BatchSetType &batch_collection,
-                boost::optional<size_t &> discarded_txs_amount,
-                Lambda batch_operation) {
-  std::vector<std::shared_ptr<shared_model::interface::Transaction>> collection;
-
-  auto it = batch_collection.begin();
-  for (;
-       it != batch_collection.end() and collection.size() < requested_tx_amount;
-       ++it) {
-    collection.insert(std::end(collection),
-                      std::begin((*it)->transactions()),
-                      std::end((*it)->transactions()));
-    batch_operation(*it);
-  }
-
-  if (discarded_txs_amount) {
-    *discarded_txs_amount = 0;
-    for (; it != batch_collection.end(); ++it) {
-      *discarded_txs_amount += boost::size((*it)->transactions());
+namespace {
+  /// Number of full proposals, which the batches left for the following
+  /// rounds can make up at most
+  const size_t kMaxLeftOverProposals = 4;
+
+  /**
+   * @return transactions of the batches in the same order
+   */
+  std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+  getTransactions(const std::vector<detail::BatchEntryType> &batches) {
+    std::vector<std::shared_ptr<shared_model::interface::Transaction>>
+        collection;
+    for (const auto &batch : batches) {
+      collection.insert(std::end(collection),
+                        std::begin(batch.first->transactions()),
+                        std::end(batch.first->transactions()));
+    }
+    return collection;
+  }
+}  // namespace
+
+std::vector<detail::BatchEntryType> OnDemandOrderingServiceImpl::takeBatches(
+    detail::BatchCollectionType &batches,
+    const detail::HashSetType &processed) {
+  std::vector<detail::BatchEntryType> entries;
+  entries.reserve(batches.size());
+  for (auto &batch : batches) {
+    // batches left in previous rounds could have been committed by other
+    // peers meanwhile
+    if (batch.second.left_over
+        and std::any_of(batch.first->transactions().begin(),
+                        batch.first->transactions().end(),
+                        [&processed](const auto &tx) {
+                          return processed.count(tx->hash()) != 0;
+                        })) {
+      continue;
+    }
+    entries.emplace_back(batch.first, batch.second);
+  }
+  batches.clear();
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+    return a.second.arrival < b.second.arrival;
+  });
+
+  // queues of batches of each creator, ordered by arrival of their first
+  // batches
+  std::vector<std::deque<detail::BatchEntryType>> queues;
+  std::unordered_map<shared_model::interface::types::AccountIdType, size_t>
+      queue_of_creator;
+  for (auto &entry : entries) {
+    const auto &creator =
+        entry.first->transactions().front()->creatorAccountId();
+    auto queue = queue_of_creator.emplace(creator, queues.size()).first;
+    if (queue->second == queues.size()) {
+      queues.emplace_back();
+    }
+    queues[queue->second].push_back(std::move(entry));
+  }
+
+  // batches are taken one per creator at a time, so that a creator with
+  // many batches does not delay the others. Like before, a batch is not
+  // broken, so the limit can be exceeded by the last taken batch
+  std::vector<std::pair<size_t, detail::BatchEntryType>> taken;
+  size_t transactions_count = 0;
+  bool has_batches = true;
+  while (transactions_count < transaction_limit_ and has_batches) {
+    has_batches = false;
+    for (size_t i = 0;
+         i < queues.size() and transactions_count < transaction_limit_;
+         ++i) {
+      if (queues[i].empty()) {
+        continue;
+      }
+      transactions_count +=
+          boost::size(queues[i].front().first->transactions());
+      taken.emplace_back(i, std::move(queues[i].front()));
+      queues[i].pop_front();
+      has_batches = true;
+    }
+  }
+
+  if (group_conflicting_batches_) {
+    // batches of a creator keep their relative order
+    std::stable_sort(
+        taken.begin(), taken.end(), [](const auto &a, const auto &b) {
+          return a.first < b.first;
+        });
+  }
+
+  // the rest of batches is left for the following rounds, except for the
+  // latest ones, if there are too many of them
+  std::vector<detail::BatchEntryType> left;
+  for (auto &queue : queues) {
+    std::move(queue.begin(), queue.end(), std::back_inserter(left));
+  }
+  std::sort(left.begin(), left.end(), [](const auto &a, const auto &b) {
+    return a.second.arrival < b.second.arrival;
+  });
+  size_t left_transactions = 0, discarded_transactions = 0;
+  for (auto &entry : left) {
+    auto size = boost::size(entry.first->transactions());
+    if (left_transactions + size
+        > kMaxLeftOverProposals * transaction_limit_) {
+      discarded_transactions += size;
+      continue;
     }
+    left_transactions += size;
+    entry.second.left_over = true;
+    batches.insert(std::move(entry));
   }
-  batch_collection.clear();
+  log_->debug(
+      "takeBatches: {} transactions are left for the following rounds, {} "
+      "are discarded",
+      left_transactions,
+      discarded_transactions);
 
-  return collection;
+  std::vector<detail::BatchEntryType> result;
+  result.reserve(taken.size());
+  for (auto &entry : taken) {
+    result.push_back(std::move(entry.second));
+  }
+  return result;
 }
 
 void OnDemandOrderingServiceImpl::packNextProposals(
-    const consensus::Round &round) {
+    const consensus::Round &round, const detail::HashSetType &processed) {
   /*
    * The possible cases can be visualised as a diagram, where:
    * o - current round, x - next round, v - target round
@@ -169,32 +262,26 @@ void OnDemandOrderingServiceImpl::packNextProposals(
    * (1,0) - current round. The diagram is similar to the initial case.
    */
 
-  size_t discarded_txs_amount;
-  auto get_transactions = [this, &discarded_txs_amount](auto &queue,
-                                                        auto lambda) {
-    return getTransactions(
-        transaction_limit_, queue, discarded_txs_amount, lambda);
-  };
-
   auto now = iroha::time::now();
-  auto generate_proposal = [this, now, &discarded_txs_amount](
-                               consensus::Round round, const auto &txs) {
+  auto generate_proposal = [this, now](consensus::Round round,
+                                       const auto &txs) {
     auto proposal = proposal_factory_->unsafeCreateProposal(
         round.block_round, now, txs | boost::adaptors::indirected);
     proposal_map_.emplace(round, std::move(proposal));
     log_->debug(
         "packNextProposal: data has been fetched for {}. "
-        "Number of transactions in proposal = {}. Discarded {} "
-        "transactions.",
+        "Number of transactions in proposal = {}.",
         round,
-        txs.size(),
-        discarded_txs_amount);
+        txs.size());
   };
 
   if (not current_round_batches_.empty()) {
-    auto txs = get_transactions(current_round_batches_, [this](auto &batch) {
+    auto batches = takeBatches(current_round_batches_, processed);
+    auto txs = getTransactions(batches);
+    for (auto &batch : batches) {
+      batch.second.left_over = false;
       next_round_batches_.insert(std::move(batch));
-    });
+    }
 
     if (not txs.empty() and round.reject_round != kFirstRejectRound) {
       generate_proposal({round.block_round, round.reject_round + 1}, txs);
@@ -203,7 +290,8 @@ void OnDemandOrderingServiceImpl::packNextProposals(
 
   if (not next_round_batches_.empty()
       and round.reject_round == kFirstRejectRound) {
-    auto txs = get_transactions(next_round_batches_, [](auto &) {});
+    auto txs =
+        getTransactions(takeBatches(next_round_batches_, processed));
 
     if (not txs.empty()) {
       generate_proposal({round.block_round, kNextRejectRoundConsumer}, txs);
@@ -233,6 +321,49 @@ void OnDemandOrderingServiceImpl::tryErase(
   }
 }
 
+detail::HashSetType OnDemandOrderingServiceImpl::processedLeftOverTransactions(
+    const consensus::Round &round) {
+  std::vector<shared_model::crypto::Hash> hashes;
+  {
+    // read lock
+    std::shared_lock<std::shared_timed_mutex> guard(lock_);
+    auto collect = [&hashes](const detail::BatchCollectionType &batches) {
+      for (const auto &batch : batches) {
+        if (batch.second.left_over) {
+          for (const auto &tx : batch.first->transactions()) {
+            hashes.push_back(tx->hash());
+          }
+        }
+      }
+    };
+    collect(current_round_batches_);
+    // batches of the next round are taken only in the first reject round
+    if (round.reject_round == kFirstRejectRound) {
+      collect(next_round_batches_);
+    }
+  }
+
+  detail::HashSetType processed;
+  if (hashes.empty()) {
+    return processed;
+  }
+  auto tx_statuses = tx_cache_->check(hashes);
+  if (not tx_statuses) {
+    // TODO andrei 30.11.18 IR-51 Handle database error
+    log_->warn("Check txs presence database error. Txs: {}", hashes.size());
+    processed.insert(hashes.begin(), hashes.end());
+    return processed;
+  }
+  for (const auto &tx_status : *tx_statuses) {
+    if (iroha::ametsuchi::isAlreadyProcessed(tx_status)) {
+      auto hash = iroha::ametsuchi::getHash(tx_status);
+      log_->warn("Duplicate transaction: {}", hash.hex());
+      processed.insert(hash);
+    }
+  }
+  return processed;
+}
+
 bool OnDemandOrderingServiceImpl::batchAlreadyProcessed(
     const shared_model::interface::TransactionBatch &batch) {
   auto tx_statuses = tx_cache_->check(batch);
@@ -8,10 +8,13 @@
 
 #include "ordering/on_demand_ordering_service.hpp"
 
+#include <atomic>
 #include <map>
 #include <shared_mutex>
+#include <unordered_set>
 
-#include <tbb/concurrent_unordered_set.h>
+#include <tbb/concurrent_unordered_map.h>
+#include "cryptography/hash.hpp"
 #include "interfaces/iroha_internal/unsafe_proposal_factory.hpp"
 #include "logger/logger_fwd.hpp"
 #include "multi_sig_transactions/hash.hpp"
@@ -25,10 +28,29 @@ namespace iroha {
   }
   namespace ordering {
     namespace detail {
-      using BatchSetType = tbb::concurrent_unordered_set<
+      /**
+       * Information about a batch waiting for a proposal
+       */
+      struct BatchInfo {
+        /// sequence number of the batch in order of arrival
+        uint64_t arrival;
+        /// whether the batch did not fit into a proposal
+        bool left_over;
+      };
+
+      using BatchCollectionType = tbb::concurrent_unordered_map<
           transport::OdOsNotification::TransactionBatchType,
+          BatchInfo,
           model::PointerBatchHasher,
           BatchHashEquality>;
+
+      using BatchEntryType =
+          std::pair<transport::OdOsNotification::TransactionBatchType,
+                    BatchInfo>;
+
+      using HashSetType =
+          std::unordered_set<shared_model::crypto::Hash,
+                             shared_model::crypto::Hash::Hasher>;
     }  // namespace detail
 
     class OnDemandOrderingServiceImpl : public OnDemandOrderingService {
@@ -44,6 +66,8 @@ namespace iroha {
        * removed. Default value is 3
        * @param initial_round - first round of agreement.
        * Default value is {2, kFirstRejectRound} since genesis block height is 1
+       * @param group_conflicting_batches - whether batches of the same creator
+       * are placed next to each other in a proposal
        */
       OnDemandOrderingServiceImpl(
           size_t transaction_limit,
@@ -52,7 +76,8 @@ namespace iroha {
           std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
           logger::LoggerPtr log,
           size_t number_of_proposals = 3,
-          const consensus::Round &initial_round = {2, kFirstRejectRound});
+          const consensus::Round &initial_round = {2, kFirstRejectRound},
+          bool group_conflicting_batches = false);
 
       // --------------------- | OnDemandOrderingService |_---------------------
 
@@ -69,8 +94,12 @@ namespace iroha {
       /**
        * Packs new proposals and creates new rounds
        * Note: method is not thread-safe
+       * @param round - round, which the proposals are packed after
+       * @param processed - hashes of the transactions of left-over batches,
+       * which are already processed
        */
-      void packNextProposals(const consensus::Round &round);
+      void packNextProposals(const consensus::Round &round,
+                             const detail::HashSetType &processed);
 
       /**
        * Removes last elements if it is required
@@ -79,6 +108,33 @@ namespace iroha {
        */
       void tryErase(const consensus::Round &current_round);
 
+      /**
+       * Take batches for a proposal from the collection. Batches are taken in
+       * order of arrival, one batch per creator at a time, until the
+       * transaction limit is reached. The rest of batches are left in the
+       * collection for the following rounds. Left-over batches with
+       * processed transactions are dropped
+       * Note: method is not thread-safe
+       * @param batches - collection to take batches from
+       * @param processed - hashes of the transactions of left-over batches,
+       * which are already processed
+       * @return taken batches in order of the proposal
+       */
+      std::vector<detail::BatchEntryType> takeBatches(
+          detail::BatchCollectionType &batches,
+          const detail::HashSetType &processed);
+
+      /**
+       * Check transactions of the left-over batches, which are taken after
+       * the round, with a single query. Takes the read lock only to collect
+       * the hashes, so the query does not block the other methods
+       * @param round - round, which the proposals are packed after
+       * @return hashes of the transactions, which are already processed, or
+       * all the hashes if the query failed
+       */
+      detail::HashSetType processedLeftOverTransactions(
+          const consensus::Round &round);
+
       /**
        * Check if batch was already processed by the peer
        */
@@ -95,6 +151,11 @@ namespace iroha {
        */
       size_t number_of_proposals_;
 
+      /**
+       * Whether batches of the same creator are placed next to each other
+       */
+      bool group_conflicting_batches_;
+
       /**
        * Map of available proposals
        */
@@ -104,7 +165,12 @@ namespace iroha {
       /**
        * Collections of batches for current and next rounds
        */
-      detail::BatchSetType current_round_batches_, next_round_batches_;
+      detail::BatchCollectionType current_round_batches_, next_round_batches_;
+
+      /**
+       * Sequence number of the next arriving batch
+       */
+      std::atomic<uint64_t> next_arrival_{0};
 
       /**
        * Read write mutex for public methods
@@ -16,55 +16,98 @@ using namespace iroha;
 using namespace iroha::ordering;
 using namespace iroha::ordering::transport;
 
+namespace {
+  /**
+   * Add counters of a queue to the total ones
+   */
+  void addMetrics(OutboundBatchesQueue::Metrics &total,
+                  const OutboundBatchesQueue::Metrics &metrics) {
+    total.batches_queued += metrics.batches_queued;
+    total.batches_coalesced += metrics.batches_coalesced;
+    total.batches_dropped += metrics.batches_dropped;
+    total.requests_sent += metrics.requests_sent;
+    total.transactions_sent += metrics.transactions_sent;
+    total.requests_in_flight += metrics.requests_in_flight;
+    total.pending_size += metrics.pending_size;
+  }
+}  // namespace
+
 OnDemandOsClientGrpc::OnDemandOsClientGrpc(
     std::unique_ptr<proto::OnDemandOrdering::StubInterface> stub,
-    std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
-        async_call,
+    std::shared_ptr<OutboundBatchesQueue> batches_queue,
+    std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+        proposal_async_call,
     std::shared_ptr<TransportFactoryType> proposal_factory,
     std::function<TimepointType()> time_provider,
     std::chrono::milliseconds proposal_request_timeout,
     logger::LoggerPtr log)
     : log_(std::move(log)),
       stub_(std::move(stub)),
-      async_call_(std::move(async_call)),
+      batches_queue_(std::move(batches_queue)),
+      proposal_async_call_(std::move(proposal_async_call)),
       proposal_factory_(std::move(proposal_factory)),
       time_provider_(std::move(time_provider)),
       proposal_request_timeout_(proposal_request_timeout) {}
 
 void OnDemandOsClientGrpc::onBatches(CollectionType batches) {
-  proto::BatchesRequest request;
-  for (auto &batch : batches) {
-    for (auto &transaction : batch->transactions()) {
-      *request.add_transactions() = std::move(
-          static_cast<shared_model::proto::Transaction *>(transaction.get())
-              ->getTransport());
-    }
+  log_->debug("Propagating {} batches", batches.size());
+  if (auto dropped = batches_queue_->push(batches)) {
+    // the batches stay in the ordering gate cache, and are propagated again
+    // in the next round
+    log_->warn("Dropped {} of {} batches, too many requests are in progress",
+               dropped,
+               batches.size());
   }
-
-  log_->debug("Propagating: '{}'", request.DebugString());
-
-  async_call_->Call([&](auto context, auto cq) {
-    return stub_->AsyncSendBatches(context, request, cq);
-  });
 }
 
 boost::optional<std::shared_ptr<const OdOsNotification::ProposalType>>
 OnDemandOsClientGrpc::onRequestProposal(consensus::Round round) {
   grpc::ClientContext context;
   context.set_deadline(time_provider_() + proposal_request_timeout_);
+  proto::ProposalResponse response;
+  auto status = stub_->RequestProposal(&context, makeRequest(round), &response);
+  return processResponse(status, response, *proposal_factory_, log_);
+}
+
+void OnDemandOsClientGrpc::onRequestProposalAsync(
+    consensus::Round round, ProposalCallbackType callback) {
+  auto deadline = time_provider_() + proposal_request_timeout_;
+  auto request = makeRequest(round);
+  proposal_async_call_->Call(
+      [&](auto context, auto cq) {
+        context->set_deadline(deadline);
+        return stub_->AsyncRequestProposal(context, request, cq);
+      },
+      [proposal_factory = proposal_factory_,
+       log = log_,
+       callback = std::move(callback)](
+          const grpc::Status &status, const proto::ProposalResponse &response) {
+        callback(processResponse(status, response, *proposal_factory, log));
+      });
+}
+
+proto::ProposalRequest OnDemandOsClientGrpc::makeRequest(
+    consensus::Round round) {
   proto::ProposalRequest request;
   request.mutable_round()->set_block_round(round.block_round);
   request.mutable_round()->set_reject_round(round.reject_round);
-  proto::ProposalResponse response;
-  auto status = stub_->RequestProposal(&context, request, &response);
+  return request;
+}
+
+boost::optional<std::shared_ptr<const OdOsNotification::ProposalType>>
+OnDemandOsClientGrpc::processResponse(
+    const grpc::Status &status,
+    const proto::ProposalResponse &response,
+    TransportFactoryType &proposal_factory,
+    const logger::LoggerPtr &log) {
   if (not status.ok()) {
-    log_->warn("RPC failed: {}", status.error_message());
+    log->warn("RPC failed: {}", status.error_message());
     return boost::none;
   }
   if (not response.has_proposal()) {
     return boost::none;
   }
-  return proposal_factory_->build(response.proposal())
+  return proposal_factory.build(response.proposal())
       .match(
           [&](iroha::expected::Value<
               std::unique_ptr<shared_model::interface::Proposal>> &v) {
@@ -72,33 +115,161 @@ OnDemandOsClientGrpc::onRequestProposal(consensus::Round round) {
                 std::shared_ptr<const OdOsNotification::ProposalType>(
                     std::move(v).value));
           },
-          [this](iroha::expected::Error<TransportFactoryType::Error> &error) {
-            log_->info(error.error.error);  // error
+          [&log](iroha::expected::Error<TransportFactoryType::Error> &error) {
+            log->info(error.error.error);  // error
             return boost::optional<
                 std::shared_ptr<const OdOsNotification::ProposalType>>();
           });
 }
 
+constexpr std::chrono::milliseconds
+    OnDemandOsClientGrpcFactory::kDefaultBatchesFlushWindow;
+constexpr size_t OnDemandOsClientGrpcFactory::kDefaultMaxBatchesRequestSize;
+constexpr size_t
+    OnDemandOsClientGrpcFactory::kDefaultMaxBatchesRequestsInFlight;
+constexpr std::chrono::seconds
+    OnDemandOsClientGrpcFactory::kMetricsReportPeriod;
+
 OnDemandOsClientGrpcFactory::OnDemandOsClientGrpcFactory(
     std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
         async_call,
+    std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+        proposal_async_call,
     std::shared_ptr<TransportFactoryType> proposal_factory,
     std::function<OnDemandOsClientGrpc::TimepointType()> time_provider,
     OnDemandOsClientGrpc::TimeoutType proposal_request_timeout,
-    logger::LoggerPtr client_log)
+    logger::LoggerPtr client_log,
+    std::chrono::milliseconds batches_flush_window,
+    size_t max_batches_request_size,
+    size_t max_batches_requests_in_flight)
     : async_call_(std::move(async_call)),
+      proposal_async_call_(std::move(proposal_async_call)),
       proposal_factory_(std::move(proposal_factory)),
       time_provider_(time_provider),
       proposal_request_timeout_(proposal_request_timeout),
-      client_log_(std::move(client_log)) {}
+      client_log_(std::move(client_log)),
+      batches_flush_window_(batches_flush_window),
+      max_batches_request_size_(max_batches_request_size),
+      max_batches_requests_in_flight_(max_batches_requests_in_flight),
+      stopped_(false),
+      flush_thread_([this] {
+        auto last_report = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(batches_queues_mutex_);
+        while (not stop_cv_.wait_for(
+            lock, batches_flush_window_, [this] { return stopped_; })) {
+          for (auto &queue : batches_queues_) {
+            queue.second->flush();
+          }
+          pruneQueues();
+
+          if (std::chrono::steady_clock::now() - last_report
+              >= kMetricsReportPeriod) {
+            last_report = std::chrono::steady_clock::now();
+            reportMetrics();
+          }
+        }
+      }) {}
+
+OnDemandOsClientGrpcFactory::~OnDemandOsClientGrpcFactory() {
+  {
+    std::lock_guard<std::mutex> lock(batches_queues_mutex_);
+    stopped_ = true;
+  }
+  stop_cv_.notify_one();
+  flush_thread_.join();
+}
 
 std::unique_ptr<OdOsNotification> OnDemandOsClientGrpcFactory::create(
     const shared_model::interface::Peer &to) {
+  std::shared_ptr<OutboundBatchesQueue> batches_queue;
+  {
+    std::lock_guard<std::mutex> lock(batches_queues_mutex_);
+    auto &queue = batches_queues_[to.address()];
+    if (not queue) {
+      queue = std::make_shared<OutboundBatchesQueue>(
+          network::createClient<proto::OnDemandOrdering>(to.address()),
+          async_call_,
+          max_batches_request_size_,
+          max_batches_requests_in_flight_,
+          client_log_);
+    }
+    batches_queue = queue;
+  }
+
   return std::make_unique<OnDemandOsClientGrpc>(
       network::createClient<proto::OnDemandOrdering>(to.address()),
-      async_call_,
+      std::move(batches_queue),
+      proposal_async_call_,
       proposal_factory_,
       time_provider_,
       proposal_request_timeout_,
       client_log_);
 }
+
+OutboundBatchesQueue::Metrics OnDemandOsClientGrpcFactory::metrics() {
+  std::lock_guard<std::mutex> lock(batches_queues_mutex_);
+  return totalMetrics();
+}
+
+size_t OnDemandOsClientGrpcFactory::queuesCount() {
+  std::lock_guard<std::mutex> lock(batches_queues_mutex_);
+  return batches_queues_.size();
+}
+
+void OnDemandOsClientGrpcFactory::pruneQueues() {
+  for (auto it = batches_queues_.begin(); it != batches_queues_.end();) {
+    // clients are created for each round, so a queue which is owned only by
+    // the factory belongs to a peer, which is not a consumer anymore
+    if (it->second.use_count() > 1) {
+      ++it;
+      continue;
+    }
+    if (auto dropped = it->second->discardPending()) {
+      client_log_->warn(
+          "Dropped {} batches to {}, which is not used anymore",
+          dropped,
+          it->first);
+    }
+    auto metrics = it->second->metrics();
+    // requests of the removed queue are not tracked anymore
+    metrics.requests_in_flight = 0;
+    addMetrics(removed_queues_metrics_, metrics);
+    it = batches_queues_.erase(it);
+  }
+}
+
+OutboundBatchesQueue::Metrics OnDemandOsClientGrpcFactory::totalMetrics()
+    const {
+  auto total = removed_queues_metrics_;
+  for (const auto &queue : batches_queues_) {
+    addMetrics(total, queue.second->metrics());
+  }
+  return total;
+}
+
+void OnDemandOsClientGrpcFactory::reportMetrics() {
+  for (const auto &queue : batches_queues_) {
+    auto metrics = queue.second->metrics();
+    client_log_->info(
+        "Batches to {}: {} queued, {} coalesced, {} dropped; {} transactions "
+        "in {} requests sent, {} requests in progress, {} bytes pending",
+        queue.first,
+        metrics.batches_queued,
+        metrics.batches_coalesced,
+        metrics.batches_dropped,
+        metrics.transactions_sent,
+        metrics.requests_sent,
+        metrics.requests_in_flight,
+        metrics.pending_size);
+  }
+
+  auto total = totalMetrics();
+  auto dropped = total.batches_dropped - reported_batches_dropped_;
+  reported_batches_dropped_ = total.batches_dropped;
+  if (dropped != 0) {
+    client_log_->warn(
+        "{} batches were dropped since the last report, {} in total",
+        dropped,
+        total.batches_dropped);
+  }
+}
@@ -8,10 +8,16 @@
 
 #include "ordering/on_demand_os_transport.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "interfaces/iroha_internal/abstract_transport_factory.hpp"
 #include "logger/logger_fwd.hpp"
 #include "network/impl/async_grpc_client.hpp"
 #include "ordering.grpc.pb.h"
+#include "ordering/impl/outbound_batches_queue.hpp"
 
 namespace iroha {
   namespace ordering {
@@ -32,11 +38,14 @@ namespace iroha {
         /**
          * Constructor is left public because testing required passing a mock
          * stub interface
+         * @param batches_queue - queue of batches to the peer, which is
+         * shared by all clients of the peer
          */
         OnDemandOsClientGrpc(
             std::unique_ptr<proto::OnDemandOrdering::StubInterface> stub,
-            std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
-                async_call,
+            std::shared_ptr<OutboundBatchesQueue> batches_queue,
+            std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+                proposal_async_call,
             std::shared_ptr<TransportFactoryType> proposal_factory,
             std::function<TimepointType()> time_provider,
             std::chrono::milliseconds proposal_request_timeout,
@@ -47,26 +56,82 @@ namespace iroha {
         boost::optional<std::shared_ptr<const ProposalType>> onRequestProposal(
             consensus::Round round) override;
 
+        /**
+         * Request proposal through the completion queue of proposal async
+         * call, callback is invoked from its thread
+         */
+        void onRequestProposalAsync(consensus::Round round,
+                                    ProposalCallbackType callback) override;
+
        private:
+        /**
+         * Create request for proposal of the given round
+         */
+        static proto::ProposalRequest makeRequest(consensus::Round round);
+
+        /**
+         * Build proposal from the server response. Does not use the client
+         * object, since it can be destroyed before an asynchronous call ends
+         * @param status - status of the call
+         * @param response - server response
+         * @param proposal_factory - factory to build the proposal with
+         * @param log - logger to report errors
+         * @return proposal, if the call succeeded and the response contains
+         * a valid proposal
+         */
+        static boost::optional<std::shared_ptr<const ProposalType>>
+        processResponse(const grpc::Status &status,
+                        const proto::ProposalResponse &response,
+                        TransportFactoryType &proposal_factory,
+                        const logger::LoggerPtr &log);
+
         logger::LoggerPtr log_;
         std::unique_ptr<proto::OnDemandOrdering::StubInterface> stub_;
-        std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
-            async_call_;
+        std::shared_ptr<OutboundBatchesQueue> batches_queue_;
+        std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+            proposal_async_call_;
         std::shared_ptr<TransportFactoryType> proposal_factory_;
         std::function<TimepointType()> time_provider_;
         std::chrono::milliseconds proposal_request_timeout_;
       };
 
+      /**
+       * Factory of gRPC clients. Batches sent to a peer by all its clients
+       * are coalesced in one queue, which is flushed periodically. Queue of
+       * a peer is removed, once there are no clients of the peer, so the
+       * number of queues is bounded by the number of peers in use
+       */
+
       class OnDemandOsClientGrpcFactory : public OdOsNotificationFactory {
        public:
         using TransportFactoryType = OnDemandOsClientGrpc::TransportFactoryType;
+
+        /// Default period of sending batches accumulated in queues
+        static constexpr std::chrono::milliseconds kDefaultBatchesFlushWindow{
+            5};
+        /// Default size of request in bytes, which is sent without waiting
+        /// for the period to end
+        static constexpr size_t kDefaultMaxBatchesRequestSize = 1 << 20;
+        /// Default number of requests in progress to a peer, after which
+        /// batches are accumulated in the queue
+        static constexpr size_t kDefaultMaxBatchesRequestsInFlight = 4;
+
         OnDemandOsClientGrpcFactory(
             std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
                 async_call,
+            std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+                proposal_async_call,
             std::shared_ptr<TransportFactoryType> proposal_factory,
             std::function<OnDemandOsClientGrpc::TimepointType()> time_provider,
             OnDemandOsClientGrpc::TimeoutType proposal_request_timeout,
-            logger::LoggerPtr client_log);
+            logger::LoggerPtr client_log,
+            std::chrono::milliseconds batches_flush_window =
+                kDefaultBatchesFlushWindow,
+            size_t max_batches_request_size = kDefaultMaxBatchesRequestSize,
+            size_t max_batches_requests_in_flight =
+                kDefaultMaxBatchesRequestsInFlight);
+
+        ~OnDemandOsClientGrpcFactory() override;
 
         /**
          * Create connection with insecure gRPC channel defined by
@@ -77,13 +142,61 @@ namespace iroha {
         std::unique_ptr<OdOsNotification> create(
             const shared_model::interface::Peer &to) override;
 
+        /**
+         * @return counters of the batches sent to all peers, including the
+         * removed queues
+         */
+        OutboundBatchesQueue::Metrics metrics();
+
+        /**
+         * @return number of queues of peers in use
+         */
+        size_t queuesCount();
+
        private:
+        /// Period of logging counters of the queues
+        static constexpr std::chrono::seconds kMetricsReportPeriod{60};
+
+        /**
+         * Remove the queues, which are not used by any client, and drop
+         * their pending batches. Requires locked batches_queues_mutex_
+         */
+        void pruneQueues();
+
+        /**
+         * Sum counters of all queues, requires locked batches_queues_mutex_
+         */
+        OutboundBatchesQueue::Metrics totalMetrics() const;
+
+        /**
+         * Log counters of the queues, requires locked batches_queues_mutex_
+         */
+        void reportMetrics();
+
         std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
             async_call_;
+        std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+            proposal_async_call_;
         std::shared_ptr<TransportFactoryType> proposal_factory_;
         std::function<OnDemandOsClientGrpc::TimepointType()> time_provider_;
         std::chrono::milliseconds proposal_request_timeout_;
         logger::LoggerPtr client_log_;
+        const std::chrono::milliseconds batches_flush_window_;
+        const size_t max_batches_request_size_;
+        const size_t max_batches_requests_in_flight_;
+
+        /// queues of batches by addresses of peers
+        std::unordered_map<shared_model::interface::types::AddressType,
+                           std::shared_ptr<OutboundBatchesQueue>>
+            batches_queues_;
+        /// counters of the removed queues
+        OutboundBatchesQueue::Metrics removed_queues_metrics_;
+        /// number of dropped batches at the time of the last report
+        uint64_t reported_batches_dropped_ = 0;
+        std::mutex batches_queues_mutex_;
+        std::condition_variable stop_cv_;
+        bool stopped_;
+        std::thread flush_thread_;
       };
 
     }  // namespace transport
@@ -5,6 +5,10 @@
 
 #include "ordering/impl/ordering_gate_cache/on_demand_cache.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/transaction.hpp"
 
@@ -16,24 +20,32 @@ using namespace iroha::ordering::cache;
 void OnDemandCache::addToBack(
     const OrderingGateCache::BatchesSetType &batches) {
   std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-  circ_buffer.back().insert(batches.begin(), batches.end());
+  auto now = std::chrono::steady_clock::now();
+  auto back_slot = front_slot_ + circ_buffer.size() - 1;
+  for (const auto &batch : batches) {
+    // batches returned by the last pop keep their age
+    auto popped = popped_.find(batch);
+    insertBatch(
+        batch, back_slot, popped == popped_.end() ? now : popped->second);
+  }
 }
 
 void OnDemandCache::remove(const OrderingGateCache::HashesSetType &hashes) {
   std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-  for (auto &batches : circ_buffer) {
-    for (auto it = batches.begin(); it != batches.end();) {
-      if (std::any_of(it->get()->transactions().begin(),
-                      it->get()->transactions().end(),
-                      [&hashes](const auto &tx) {
-                        return hashes.find(tx->hash()) != hashes.end();
-                      })) {
-        // returns iterator following the last removed element
-        // hence there is no increment in loop iteration_expression
-        it = batches.erase(it);
-      } else {
-        ++it;
+  for (const auto &hash : hashes) {
+    auto range = batches_by_tx_.equal_range(hash);
+    std::vector<BatchPointerType> batches;
+    std::transform(range.first,
+                   range.second,
+                   std::back_inserter(batches),
+                   [](const auto &entry) { return entry.second; });
+    for (const auto &batch : batches) {
+      auto it = batches_.find(batch);
+      if (it == batches_.end()) {
+        continue;
       }
+      circ_buffer[it->second.slot - front_slot_].erase(batch);
+      unindexBatch(it);
     }
   }
 }
@@ -44,6 +56,16 @@ OrderingGateCache::BatchesSetType OnDemandCache::pop() {
   std::swap(res, circ_buffer.front());
   // push empty set to remove front element
   circ_buffer.push_back(BatchesSetType{});
+  ++front_slot_;
+
+  popped_.clear();
+  for (const auto &batch : res) {
+    auto it = batches_.find(batch);
+    if (it != batches_.end()) {
+      popped_.emplace(batch, it->second.added);
+      unindexBatch(it);
+    }
+  }
   return res;
 }
 
@@ -56,3 +78,54 @@ const OrderingGateCache::BatchesSetType &OnDemandCache::tail() const {
   std::shared_lock<std::shared_timed_mutex> lock(mutex_);
   return circ_buffer.back();
 }
+
+OrderingGateCache::Metrics OnDemandCache::metrics() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return Metrics{
+      batches_.size(),
+      transactions_,
+      added_times_.empty()
+          ? std::chrono::milliseconds::zero()
+          : std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - *added_times_.begin())};
+}
+
+void OnDemandCache::insertBatch(const BatchPointerType &batch,
+                                uint64_t slot,
+                                TimepointType added) {
+  auto it = batches_.find(batch);
+  if (it != batches_.end()) {
+    if (it->second.slot == slot) {
+      return;
+    }
+    // batch is moved to the new slot and keeps its age
+    added = std::min(added, it->second.added);
+    circ_buffer[it->second.slot - front_slot_].erase(batch);
+    unindexBatch(it);
+  }
+
+  circ_buffer[slot - front_slot_].insert(batch);
+  batches_.emplace(batch, BatchInfo{slot, added});
+  for (const auto &tx : batch->transactions()) {
+    batches_by_tx_.emplace(tx->hash(), batch);
+  }
+  added_times_.insert(added);
+  transactions_ += batch->transactions().size();
+}
+
+OnDemandCache::BatchesInfoType::iterator OnDemandCache::unindexBatch(
+    BatchesInfoType::iterator it) {
+  const auto &batch = it->first;
+  for (const auto &tx : batch->transactions()) {
+    auto range = batches_by_tx_.equal_range(tx->hash());
+    for (auto entry = range.first; entry != range.second; ++entry) {
+      if (entry->second == batch) {
+        batches_by_tx_.erase(entry);
+        break;
+      }
+    }
+  }
+  added_times_.erase(added_times_.find(it->second.added));
+  transactions_ -= batch->transactions().size();
+  return batches_.erase(it);
+}
@@ -8,7 +8,9 @@
 
 #include "ordering/impl/ordering_gate_cache/ordering_gate_cache.hpp"
 
+#include <set>
 #include <shared_mutex>
+#include <unordered_map>
 
 #include <boost/circular_buffer.hpp>
 
@@ -16,6 +18,11 @@ namespace iroha {
   namespace ordering {
     namespace cache {
 
+      /**
+       * Ordering gate cache, which indexes cached batches by hashes of their
+       * transactions, so that batches are removed in time proportional to
+       * the number of the given hashes
+       */
       class OnDemandCache : public OrderingGateCache {
        public:
         void addToBack(const BatchesSetType &batches) override;
@@ -28,10 +35,63 @@ namespace iroha {
 
         virtual const BatchesSetType &tail() const override;
 
+        Metrics metrics() const override;
+
        private:
+        using BatchPointerType = BatchesSetType::value_type;
+        using TimepointType = std::chrono::steady_clock::time_point;
+
+        /**
+         * Position and age of a cached batch
+         */
+        struct BatchInfo {
+          /// number of the slot of the queue, counted from the creation
+          uint64_t slot;
+          /// time when the batch was added to the cache
+          TimepointType added;
+        };
+
+        using BatchesInfoType = std::unordered_map<BatchPointerType,
+                                                   BatchInfo,
+                                                   BatchesSetType::hasher>;
+
+        /**
+         * Put the batch to the slot and index it, requires locked mutex_
+         */
+        void insertBatch(const BatchPointerType &batch,
+                         uint64_t slot,
+                         TimepointType added);
+
+        /**
+         * Remove the batch from the index, but not from its slot, requires
+         * locked mutex_
+         * @return iterator following the removed batch
+         */
+        BatchesInfoType::iterator unindexBatch(BatchesInfoType::iterator it);
+
         mutable std::shared_timed_mutex mutex_;
         using BatchesQueueType = boost::circular_buffer<BatchesSetType>;
         BatchesQueueType circ_buffer{3, BatchesSetType{}};
+
+        /// number of the slot at the front of the queue
+        uint64_t front_slot_{0};
+        /// cached batches
+        BatchesInfoType batches_;
+        /// cached batches by hashes of their transactions
+        std::unordered_multimap<shared_model::crypto::Hash,
+                                BatchPointerType,
+                                shared_model::crypto::Hash::Hasher>
+            batches_by_tx_;
+        /// times when cached batches were added
+        std::multiset<TimepointType> added_times_;
+        /// number of transactions in cached batches
+        size_t transactions_{0};
+        /// times when batches returned by the last pop were added, so that
+        /// they keep their age if they are added back
+        std::unordered_map<BatchPointerType,
+                           TimepointType,
+                           BatchesSetType::hasher>
+            popped_;
       };
 
     }  // namespace cache
@@ -6,6 +6,7 @@
 #ifndef IROHA_ON_DEMAND_ORDERING_CACHE_HPP
 #define IROHA_ON_DEMAND_ORDERING_CACHE_HPP
 
+#include <chrono>
 #include <unordered_set>
 
 #include "cryptography/hash.hpp"
@@ -48,6 +49,18 @@ namespace iroha {
             std::unordered_set<shared_model::crypto::Hash,
                                shared_model::crypto::Hash::Hasher>;
 
+        /**
+         * Size and age of the cache contents
+         */
+        struct Metrics {
+          /// number of cached batches
+          size_t batches;
+          /// number of transactions in cached batches
+          size_t transactions;
+          /// time since the oldest cached batch was added
+          std::chrono::milliseconds oldest_batch_age;
+        };
+
         /**
          * Concatenates batches from the tail of the queue with provided batches
          */
@@ -73,6 +86,11 @@ namespace iroha {
          */
         virtual const BatchesSetType &tail() const = 0;
 
+        /**
+         * Return size and age of the cache contents
+         */
+        virtual Metrics metrics() const = 0;
+
         virtual ~OrderingGateCache() = default;
       };
 
@@ -0,0 +1,142 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ordering/impl/outbound_batches_queue.hpp"
+
+#include "backend/protobuf/transaction.hpp"
+#include "interfaces/iroha_internal/transaction_batch.hpp"
+#include "logger/logger.hpp"
+
+using namespace iroha;
+using namespace iroha::ordering;
+using namespace iroha::ordering::transport;
+
+/**
+ * @return size of transactions of the batch in the request
+ */
+static size_t batchSize(
+    const shared_model::interface::TransactionBatch &batch) {
+  size_t size = 0;
+  for (const auto &transaction : batch.transactions()) {
+    size += static_cast<const shared_model::proto::Transaction &>(*transaction)
+                .getTransport()
+                .ByteSizeLong();
+  }
+  return size;
+}
+
+OutboundBatchesQueue::OutboundBatchesQueue(
+    std::shared_ptr<proto::OnDemandOrdering::StubInterface> stub,
+    std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
+        async_call,
+    size_t max_request_size,
+    size_t max_requests_in_flight,
+    logger::LoggerPtr log)
+    : stub_(std::move(stub)),
+      async_call_(std::move(async_call)),
+      max_request_size_(max_request_size),
+      max_requests_in_flight_(max_requests_in_flight),
+      log_(std::move(log)) {}
+
+size_t OutboundBatchesQueue::push(const CollectionType &batches) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t dropped = 0;
+  for (const auto &batch : batches) {
+    ++metrics_.batches_queued;
+    if (pending_set_.count(batch.get()) != 0) {
+      ++metrics_.batches_coalesced;
+      continue;
+    }
+    if (metrics_.pending_size >= max_request_size_) {
+      if (metrics_.requests_in_flight >= max_requests_in_flight_) {
+        ++dropped;
+        continue;
+      }
+      send(lock);
+    }
+    pending_set_.insert(batch.get());
+    pending_batches_.push_back(batch);
+    metrics_.pending_size += batchSize(*batch);
+  }
+  metrics_.batches_dropped += dropped;
+
+  if (metrics_.pending_size >= max_request_size_
+      and metrics_.requests_in_flight < max_requests_in_flight_) {
+    send(lock);
+  }
+  return dropped;
+}
+
+void OutboundBatchesQueue::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (pending_batches_.empty()
+      or metrics_.requests_in_flight >= max_requests_in_flight_) {
+    return;
+  }
+  send(lock);
+}
+
+size_t OutboundBatchesQueue::discardPending() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto dropped = pending_batches_.size();
+  pending_batches_.clear();
+  pending_set_.clear();
+  metrics_.pending_size = 0;
+  metrics_.batches_dropped += dropped;
+  return dropped;
+}
+
+OutboundBatchesQueue::Metrics OutboundBatchesQueue::metrics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return metrics_;
+}
+
+void OutboundBatchesQueue::send(std::unique_lock<std::mutex> &lock) {
+  auto batches = std::move(pending_batches_);
+  pending_batches_.clear();
+  pending_set_.clear();
+  metrics_.pending_size = 0;
+  ++metrics_.requests_sent;
+  ++metrics_.requests_in_flight;
+  auto requests_in_flight = metrics_.requests_in_flight;
+  lock.unlock();
+
+  proto::BatchesRequest request;
+  for (const auto &batch : batches) {
+    for (const auto &transaction : batch->transactions()) {
+      *request.add_transactions() =
+          static_cast<const shared_model::proto::Transaction &>(*transaction)
+              .getTransport();
+    }
+  }
+
+  log_->debug("Sending {} transactions of {} batches, {} requests in progress",
+              request.transactions_size(),
+              batches.size(),
+              requests_in_flight);
+
+  std::weak_ptr<OutboundBatchesQueue> weak_queue = shared_from_this();
+  async_call_->Call(
+      [&](auto context, auto cq) {
+        return stub_->AsyncSendBatches(context, request, cq);
+      },
+      [weak_queue](const grpc::Status &, const google::protobuf::Empty &) {
+        if (auto queue = weak_queue.lock()) {
+          queue->onRequestCompleted();
+        }
+      });
+
+  lock.lock();
+  metrics_.transactions_sent += request.transactions_size();
+}
+
+void OutboundBatchesQueue::onRequestCompleted() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  --metrics_.requests_in_flight;
+  // batches accumulated while the limit of requests was reached
+  if (metrics_.pending_size >= max_request_size_) {
+    send(lock);
+  }
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_OUTBOUND_BATCHES_QUEUE_HPP
+#define IROHA_OUTBOUND_BATCHES_QUEUE_HPP
+
+#include "ordering/on_demand_os_transport.hpp"
+
+#include <mutex>
+#include <unordered_set>
+
+#include "logger/logger_fwd.hpp"
+#include "network/impl/async_grpc_client.hpp"
+#include "ordering.grpc.pb.h"
+
+namespace iroha {
+  namespace ordering {
+    namespace transport {
+
+      /**
+       * Queue of transaction batches to be sent to the ordering service of a
+       * peer. Batches are coalesced into one request, which is sent when its
+       * size reaches the limit, or when the queue is flushed. The same batch
+       * added several times before the request is sent, is sent once.
+       * Number of requests in progress is limited: while the limit is
+       * reached, batches are accumulated, and those which do not fit into
+       * the pending request are dropped. Dropped batches are reported to the
+       * caller and counted; the ordering gate keeps them in its cache and
+       * propagates them again in the next round
+       */
+      class OutboundBatchesQueue
+          : public std::enable_shared_from_this<OutboundBatchesQueue> {
+       public:
+        using CollectionType = OdOsNotification::CollectionType;
+
+        /**
+         * Counters of the queue
+         */
+        struct Metrics {
+          /// batches added to the queue
+          uint64_t batches_queued = 0;
+          /// batches added while they were already pending
+          uint64_t batches_coalesced = 0;
+          /// batches dropped since the pending request was full
+          uint64_t batches_dropped = 0;
+          /// requests sent to the peer
+          uint64_t requests_sent = 0;
+          /// transactions sent to the peer
+          uint64_t transactions_sent = 0;
+          /// requests which are sent, but not completed yet
+          uint64_t requests_in_flight = 0;
+          /// size of the pending request in bytes
+          size_t pending_size = 0;
+        };
+
+        /**
+         * @param stub - stub of the ordering service of the peer
+         * @param async_call - client which performs requests
+         * @param max_request_size - size of request in bytes, which causes
+         * it to be sent without waiting for flush
+         * @param max_requests_in_flight - number of requests in progress,
+         * after which no more requests are sent
+         * @param log - logger
+         */
+        OutboundBatchesQueue(
+            std::shared_ptr<proto::OnDemandOrdering::StubInterface> stub,
+            std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
+                async_call,
+            size_t max_request_size,
+            size_t max_requests_in_flight,
+            logger::LoggerPtr log);
+
+        /**
+         * Add batches to the pending request
+         * @param batches - batches to send
+         * @return number of batches, which are dropped since the pending
+         * request is full and too many requests are in progress
+         */
+        size_t push(const CollectionType &batches);
+
+        /**
+         * Send the pending request, unless it is empty or too many requests
+         * are in progress
+         */
+        void flush();
+
+        /**
+         * Drop the pending request, when the queue is not used anymore.
+         * Its batches are counted as dropped
+         * @return number of dropped batches
+         */
+        size_t discardPending();
+
+        /**
+         * @return current values of the counters
+         */
+        Metrics metrics() const;
+
+       private:
+        /**
+         * Send the pending request
+         * @param lock - acquired lock of mutex_, which is released while the
+         * request is sent
+         */
+        void send(std::unique_lock<std::mutex> &lock);
+
+        /**
+         * Handle completion of a request
+         */
+        void onRequestCompleted();
+
+        std::shared_ptr<proto::OnDemandOrdering::StubInterface> stub_;
+        std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
+            async_call_;
+        const size_t max_request_size_;
+        const size_t max_requests_in_flight_;
+        logger::LoggerPtr log_;
+
+        CollectionType pending_batches_;
+        /// batches of pending_batches_, kept alive by it
+        std::unordered_set<const shared_model::interface::TransactionBatch *>
+            pending_set_;
+        Metrics metrics_;
+        mutable std::mutex mutex_;
+      };
+
+    }  // namespace transport
+  }    // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_OUTBOUND_BATCHES_QUEUE_HPP
@@ -6,12 +6,15 @@
 #ifndef IROHA_ON_DEMAND_OS_TRANSPORT_HPP
 #define IROHA_ON_DEMAND_OS_TRANSPORT_HPP
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include <boost/optional.hpp>
 #include "consensus/round.hpp"
+#include "cryptography/public_key.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -61,6 +64,36 @@ namespace iroha {
         virtual boost::optional<std::shared_ptr<const ProposalType>>
         onRequestProposal(consensus::Round round) = 0;
 
+        /**
+         * Type of callback which receives the requested proposal
+         */
+        using ProposalCallbackType = std::function<void(
+            boost::optional<std::shared_ptr<const ProposalType>>)>;
+
+        /**
+         * Request proposal without waiting for the response. Default
+         * implementation performs the request synchronously
+         * @param round - number of collaboration round
+         * @param callback - receives proposal for requested round, can be
+         * invoked from another thread
+         */
+        virtual void onRequestProposalAsync(consensus::Round round,
+                                            ProposalCallbackType callback) {
+          callback(onRequestProposal(round));
+        }
+
+        /**
+         * Key of the peer, which is requested for the proposal of the round.
+         * Default implementation does not select peers, so the issuer is
+         * unknown
+         * @param round - number of collaboration round
+         * @return public key of the issuer, or none if it is unknown
+         */
+        virtual boost::optional<shared_model::interface::types::PubkeyType>
+        proposalIssuer(consensus::Round round) {
+          return boost::none;
+        }
+
         virtual ~OdOsNotification() = default;
       };
 
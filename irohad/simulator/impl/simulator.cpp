@@ -7,6 +7,7 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include "common/bind.hpp"
+#include "common/visitor.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 #include "interfaces/iroha_internal/proposal.hpp"
 #include "logger/logger.hpp"
@@ -16,6 +17,7 @@ namespace iroha {
 
     Simulator::Simulator(
         std::shared_ptr<network::OrderingGate> ordering_gate,
+        rxcpp::observable<consensus::GateObject> consensus_outcomes,
         std::shared_ptr<validation::StatefulValidator> statefulValidator,
         std::shared_ptr<ametsuchi::TemporaryFactory> factory,
         std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
@@ -29,20 +31,24 @@ namespace iroha {
           crypto_signer_(std::move(crypto_signer)),
           block_factory_(std::move(block_factory)),
           log_(std::move(log)) {
+      ordering_gate->onPrefetchedProposal().subscribe(
+          prefetched_proposal_subscription_,
+          [this](const network::OrderingEvent &event) {
+            {
+              std::lock_guard<std::mutex> lock(speculation_mutex_);
+              prefetched_ = event;
+            }
+            speculation_cv_.notify_all();
+          });
+
+      consensus_outcomes.subscribe(
+          outcome_subscription_, [this](const consensus::GateObject &object) {
+            this->processOutcome(object);
+          });
+
       ordering_gate->onProposal().subscribe(
           proposal_subscription_, [this](const network::OrderingEvent &event) {
-            if (event.proposal) {
-              auto validated_proposal_and_errors =
-                  this->processProposal(*getProposalUnsafe(event));
-
-              if (validated_proposal_and_errors) {
-                notifier_.get_subscriber().on_next(VerifiedProposalCreatorEvent{
-                    *validated_proposal_and_errors, event.round});
-              }
-            } else {
-              notifier_.get_subscriber().on_next(
-                  VerifiedProposalCreatorEvent{boost::none, event.round});
-            }
+            this->processRound(event);
           });
 
       notifier_.get_observable().subscribe(
@@ -52,6 +58,7 @@ namespace iroha {
               auto proposal_and_errors = getVerifiedProposalUnsafe(event);
               auto block = this->processVerifiedProposal(proposal_and_errors);
               if (block) {
+                created_block_ = *block;
                 block_notifier_.get_subscriber().on_next(BlockCreatorEvent{
                     RoundData{proposal_and_errors->verified_proposal, *block},
                     event.round});
@@ -66,6 +73,17 @@ namespace iroha {
     Simulator::~Simulator() {
       proposal_subscription_.unsubscribe();
       verified_proposal_subscription_.unsubscribe();
+      prefetched_proposal_subscription_.unsubscribe();
+      outcome_subscription_.unsubscribe();
+
+      {
+        std::lock_guard<std::mutex> lock(speculation_mutex_);
+        stop_ = true;
+      }
+      speculation_cv_.notify_all();
+      if (worker_.joinable()) {
+        worker_.join();
+      }
     }
 
     rxcpp::observable<VerifiedProposalCreatorEvent>
@@ -76,6 +94,18 @@ namespace iroha {
     boost::optional<std::shared_ptr<validation::VerifiedProposalAndErrors>>
     Simulator::processProposal(
         const shared_model::interface::Proposal &proposal) {
+      auto validated = validateProposal(proposal, boost::none);
+      if (not validated) {
+        return boost::none;
+      }
+      ametsuchi_factory_->prepareBlock(std::move(validated->wsv));
+
+      return validated->result;
+    }
+
+    boost::optional<Simulator::ValidatedProposal> Simulator::validateProposal(
+        const shared_model::interface::Proposal &proposal,
+        const boost::optional<consensus::Round> &round) {
       log_->info("process proposal");
 
       // Get last block from local ledger
@@ -113,12 +143,91 @@ namespace iroha {
               &temporary_wsv_var)
               ->value);
 
-      std::shared_ptr<iroha::validation::VerifiedProposalAndErrors>
-          validated_proposal_and_errors =
-              validator_->validate(proposal, *storage);
-      ametsuchi_factory_->prepareBlock(std::move(storage));
+      std::shared_ptr<validation::VerifiedProposalAndErrors> result;
+      if (round) {
+        result = takeSpeculation(proposal, *round);
+      }
+      const bool is_speculated = result != nullptr;
+      if (not is_speculated) {
+        result = validator_->validate(proposal, *storage);
+      }
+      return ValidatedProposal{
+          std::move(result), std::move(storage), is_speculated};
+    }
+
+    std::shared_ptr<validation::VerifiedProposalAndErrors>
+    Simulator::takeSpeculation(
+        const shared_model::interface::Proposal &proposal,
+        const consensus::Round &round) {
+      std::lock_guard<std::mutex> lock(speculation_mutex_);
+      auto speculation = std::move(speculation_);
+      speculation_ = boost::none;
+      if (not speculation) {
+        return nullptr;
+      }
+
+      const bool is_committed = outcome_
+          and outcome_->round == speculation->round and outcome_->block_hash
+          and *outcome_->block_hash == speculation->block_hash;
+      if (is_committed and speculation->proposal_round == round
+          and last_block->hash() == speculation->block_hash
+          and proposal.hash() == speculation->proposal_hash) {
+        log_->info("Using speculatively verified proposal for {}", round);
+        return speculation->result;
+      }
+      log_->info("Discarding speculatively verified proposal for {}",
+                 speculation->proposal_round);
+      return nullptr;
+    }
+
+    void Simulator::processRound(const network::OrderingEvent &event) {
+      // the worker stops waiting for the previous round, so that its state is
+      // prepared before the state of the new round is created
+      {
+        std::lock_guard<std::mutex> lock(speculation_mutex_);
+        current_round_ = event.round;
+      }
+      speculation_cv_.notify_all();
+      if (worker_.joinable()) {
+        worker_.join();
+      }
+
+      if (not event.proposal) {
+        notifier_.get_subscriber().on_next(
+            VerifiedProposalCreatorEvent{boost::none, event.round});
+        return;
+      }
+
+      const auto &proposal = *getProposalUnsafe(event);
+      auto validated = validateProposal(proposal, event.round);
+      if (not validated) {
+        return;
+      }
 
-      return validated_proposal_and_errors;
+      // the worker owns the state before the block is voted for, so that the
+      // outcome of the round waits for its preparation
+      {
+        std::lock_guard<std::mutex> lock(speculation_mutex_);
+        preparing_round_ = event.round;
+        block_hash_ = boost::none;
+      }
+      worker_ = std::thread(
+          &Simulator::speculate,
+          this,
+          std::move(validated->wsv),
+          event.round,
+          validated->is_speculated ? validated->result : nullptr);
+
+      created_block_.reset();
+      notifier_.get_subscriber().on_next(
+          VerifiedProposalCreatorEvent{validated->result, event.round});
+      if (created_block_) {
+        {
+          std::lock_guard<std::mutex> lock(speculation_mutex_);
+          block_hash_ = created_block_->hash();
+        }
+        speculation_cv_.notify_all();
+      }
     }
 
     boost::optional<std::shared_ptr<shared_model::interface::Block>>
@@ -155,6 +264,103 @@ namespace iroha {
       return block;
     }
 
+    void Simulator::speculate(
+        std::unique_ptr<ametsuchi::TemporaryWsv> wsv,
+        consensus::Round round,
+        std::shared_ptr<validation::VerifiedProposalAndErrors> reused) {
+      auto finish_preparation = [this] {
+        {
+          std::lock_guard<std::mutex> lock(speculation_mutex_);
+          preparing_round_ = boost::none;
+        }
+        speculation_cv_.notify_all();
+      };
+
+      if (reused) {
+        const auto &transactions = reused->verified_proposal->transactions();
+        auto applied =
+            wsv->applyVerified(ametsuchi::TemporaryWsv::TransactionRefs(
+                transactions.begin(), transactions.end()));
+        if (auto e = boost::get<expected::Error<std::string>>(&applied)) {
+          // the state is dropped, and the block is applied on commit
+          log_->error("Could not apply speculatively verified proposal: {}",
+                      e->error);
+          wsv.reset();
+          finish_preparation();
+          return;
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(speculation_mutex_);
+      speculation_cv_.wait(lock, [this, &round] {
+        return isFinished(round)
+            or (block_hash_ and prefetched_
+                and prefetched_->round.block_round == round.block_round + 1);
+      });
+      if (not isFinished(round)) {
+        auto proposal = getProposalUnsafe(*prefetched_);
+        auto proposal_round = prefetched_->round;
+        auto block_hash = *block_hash_;
+        lock.unlock();
+
+        log_->info("Validating proposal for {} speculatively", proposal_round);
+        std::shared_ptr<validation::VerifiedProposalAndErrors> result;
+        {
+          // the changes of the proposal are rolled back, so only the state of
+          // the round is prepared
+          auto savepoint = wsv->createSavepoint("speculation");
+          result = validator_->validate(*proposal, *wsv);
+        }
+
+        lock.lock();
+        const bool is_discarded = outcome_ and not(outcome_->round < round)
+            and not(outcome_->block_hash
+                    and *outcome_->block_hash == block_hash);
+        if (not is_discarded) {
+          speculation_ = Speculation{round,
+                                     std::move(block_hash),
+                                     proposal_round,
+                                     proposal->hash(),
+                                     std::move(result)};
+        }
+      }
+      lock.unlock();
+
+      ametsuchi_factory_->prepareBlock(std::move(wsv));
+      finish_preparation();
+    }
+
+    void Simulator::processOutcome(const consensus::GateObject &object) {
+      auto outcome = visit_in_place(
+          object,
+          [](const consensus::PairValid &pair_valid) {
+            return Outcome{pair_valid.round, pair_valid.block->hash()};
+          },
+          [](const auto &other) { return Outcome{other.round, boost::none}; });
+
+      std::unique_lock<std::mutex> lock(speculation_mutex_);
+      outcome_ = outcome;
+      if (speculation_ and not(outcome.round < speculation_->round)
+          and not(outcome.block_hash
+                  and *outcome.block_hash == speculation_->block_hash)) {
+        log_->info("Discarding speculatively verified proposal for {}",
+                   speculation_->proposal_round);
+        speculation_ = boost::none;
+      }
+      speculation_cv_.notify_all();
+
+      // the synchronizer commits the prepared state after the outcome is
+      // handled, and the worker prepares it as soon as it stops speculating
+      speculation_cv_.wait(lock, [this, &outcome] {
+        return not preparing_round_ or outcome.round < *preparing_round_;
+      });
+    }
+
+    bool Simulator::isFinished(const consensus::Round &round) const {
+      return stop_ or (current_round_ and *current_round_ != round)
+          or (outcome_ and not(outcome_->round < round));
+    }
+
     rxcpp::observable<BlockCreatorEvent> Simulator::onBlock() {
       return block_notifier_.get_observable();
     }
@@ -9,9 +9,14 @@
 #include "simulator/block_creator.hpp"
 #include "simulator/verified_proposal_creator.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <boost/optional.hpp>
 #include "ametsuchi/block_query_factory.hpp"
 #include "ametsuchi/temporary_factory.hpp"
+#include "consensus/gate_object.hpp"
 #include "cryptography/crypto_provider/abstract_crypto_model_signer.hpp"
 #include "interfaces/iroha_internal/unsafe_block_factory.hpp"
 #include "logger/logger_fwd.hpp"
@@ -21,13 +26,33 @@
 namespace iroha {
   namespace simulator {
 
+    /**
+     * Validates proposals and creates blocks of them. While the block of a
+     * round is in consensus, the proposal of the next round is validated on
+     * top of its state, if the ordering gate has already received it. The
+     * result is used, if the block is committed and the same proposal is
+     * emitted for the next round, and is discarded otherwise
+     */
     class Simulator : public VerifiedProposalCreator, public BlockCreator {
      public:
       using CryptoSignerType = shared_model::crypto::AbstractCryptoModelSigner<
           shared_model::interface::Block>;
 
+      /**
+       * @param ordering_gate - source of proposals
+       * @param consensus_outcomes - outcomes of the rounds, which have to be
+       * received before the synchronizer commits the prepared block
+       * @param statefulValidator - validator of proposals
+       * @param factory - factory of the states, which proposals are validated
+       * on
+       * @param block_query_factory - factory of queries of the top block
+       * @param crypto_signer - signer of the created blocks
+       * @param block_factory - factory of the created blocks
+       * @param log - logger
+       */
       Simulator(
           std::shared_ptr<network::OrderingGate> ordering_gate,
+          rxcpp::observable<consensus::GateObject> consensus_outcomes,
           std::shared_ptr<validation::StatefulValidator> statefulValidator,
           std::shared_ptr<ametsuchi::TemporaryFactory> factory,
           std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
@@ -53,12 +78,94 @@ namespace iroha {
       rxcpp::observable<BlockCreatorEvent> onBlock() override;
 
      private:
+      /// proposal verified on the state, which is not prepared yet
+      struct ValidatedProposal {
+        std::shared_ptr<validation::VerifiedProposalAndErrors> result;
+        std::unique_ptr<ametsuchi::TemporaryWsv> wsv;
+        /// whether the result is of speculative validation, so the verified
+        /// transactions are not applied to the state yet
+        bool is_speculated;
+      };
+
+      /// result of validation of the next proposal on top of a block, which
+      /// is in consensus
+      struct Speculation {
+        /// round of the block
+        consensus::Round round;
+        shared_model::crypto::Hash block_hash;
+        /// round of the proposal
+        consensus::Round proposal_round;
+        shared_model::crypto::Hash proposal_hash;
+        std::shared_ptr<validation::VerifiedProposalAndErrors> result;
+      };
+
+      /// outcome of consensus on a round
+      struct Outcome {
+        consensus::Round round;
+        /// hash of the committed block, or none if no block is committed
+        boost::optional<shared_model::crypto::Hash> block_hash;
+      };
+
+      /**
+       * Get the top block, and validate the proposal on top of it, unless
+       * the proposal does not follow the top block
+       * @param proposal - proposal to validate
+       * @param round - round of the proposal, none if it is not emitted by
+       * the ordering gate, and can not be speculated
+       * @return verified proposal and the state it was verified on, or none
+       * in case of error
+       */
+      boost::optional<ValidatedProposal> validateProposal(
+          const shared_model::interface::Proposal &proposal,
+          const boost::optional<consensus::Round> &round);
+
+      /**
+       * Take the result of speculative validation of the proposal, if the
+       * block it was validated on top of is committed and is the top block
+       * @return verified proposal, or nullptr if there is no such result
+       */
+      std::shared_ptr<validation::VerifiedProposalAndErrors> takeSpeculation(
+          const shared_model::interface::Proposal &proposal,
+          const consensus::Round &round);
+
+      /**
+       * Handle the proposal of a round emitted by the ordering gate
+       */
+      void processRound(const network::OrderingEvent &event);
+
+      /**
+       * Prepare the state of the block of the round, once the outcome of the
+       * round is received. Until then validate the proposal of the next round
+       * on top of the state under a savepoint, if the proposal is received.
+       * Runs in the worker thread
+       * @param wsv - state of the block
+       * @param round - round of the block
+       * @param reused - verified proposal, which is applied to the state
+       * first, if its result of speculative validation is reused
+       */
+      void speculate(
+          std::unique_ptr<ametsuchi::TemporaryWsv> wsv,
+          consensus::Round round,
+          std::shared_ptr<validation::VerifiedProposalAndErrors> reused);
+
+      /**
+       * Discard the speculation, unless the outcome commits its block, and
+       * wait until the state of the round is prepared
+       */
+      void processOutcome(const consensus::GateObject &object);
+
+      /// whether the outcome of the round or of a following one is received,
+      /// or the simulator does not wait for it anymore
+      bool isFinished(const consensus::Round &round) const;
+
       // internal
       rxcpp::subjects::subject<VerifiedProposalCreatorEvent> notifier_;
       rxcpp::subjects::subject<BlockCreatorEvent> block_notifier_;
 
       rxcpp::composite_subscription proposal_subscription_;
       rxcpp::composite_subscription verified_proposal_subscription_;
+      rxcpp::composite_subscription prefetched_proposal_subscription_;
+      rxcpp::composite_subscription outcome_subscription_;
 
       std::shared_ptr<validation::StatefulValidator> validator_;
       std::shared_ptr<ametsuchi::TemporaryFactory> ametsuchi_factory_;
@@ -71,6 +178,26 @@ namespace iroha {
 
       // last block
       std::shared_ptr<shared_model::interface::Block> last_block;
+      /// block created of the last verified proposal
+      std::shared_ptr<shared_model::interface::Block> created_block_;
+
+      /// prepares the state of the round and speculates on the next one
+      std::thread worker_;
+
+      /// protects the fields below, which are shared with the worker thread
+      std::mutex speculation_mutex_;
+      std::condition_variable speculation_cv_;
+      bool stop_ = false;
+      /// round of the last proposal emitted by the ordering gate
+      boost::optional<consensus::Round> current_round_;
+      /// round, whose state is not prepared yet
+      boost::optional<consensus::Round> preparing_round_;
+      /// hash of the block of the preparing round, once it is created
+      boost::optional<shared_model::crypto::Hash> block_hash_;
+      /// last proposal, which follows a commit of a round
+      boost::optional<network::OrderingEvent> prefetched_;
+      boost::optional<Outcome> outcome_;
+      boost::optional<Speculation> speculation_;
     };
   }  // namespace simulator
 }  // namespace iroha
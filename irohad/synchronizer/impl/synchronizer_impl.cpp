@@ -5,10 +5,14 @@
 
 #include "synchronizer/impl/synchronizer_impl.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <thread>
 #include <utility>
 
 #include "ametsuchi/block_query_factory.hpp"
 #include "ametsuchi/mutable_storage.hpp"
+#include "common/bounded_queue.hpp"
 #include "common/visitor.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 #include "logger/logger.hpp"
@@ -16,17 +20,22 @@
 namespace iroha {
   namespace synchronizer {
 
+    /// number of downloaded blocks waiting to be applied
+    const size_t kDownloadQueueSize = 64;
+
     SynchronizerImpl::SynchronizerImpl(
         std::shared_ptr<network::ConsensusGate> consensus_gate,
         std::shared_ptr<validation::ChainValidator> validator,
         std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
         std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
         std::shared_ptr<network::BlockLoader> block_loader,
-        logger::LoggerPtr log)
+        logger::LoggerPtr log,
+        size_t chunk_size)
         : validator_(std::move(validator)),
           mutable_factory_(std::move(mutable_factory)),
           block_query_factory_(std::move(block_query_factory)),
           block_loader_(std::move(block_loader)),
+          chunk_size_(std::max<size_t>(chunk_size, 1)),
           log_(std::move(log)) {
       consensus_gate->onOutcome().subscribe(
           subscription_, [this](consensus::GateObject object) {
@@ -71,49 +80,131 @@ namespace iroha {
           });
     }
 
+    SynchronizerImpl::ChainOutcome SynchronizerImpl::applyChain(
+        Chain chain,
+        std::unique_ptr<ametsuchi::MutableStorage> &storage,
+        std::vector<std::shared_ptr<shared_model::interface::Block>>
+            &committed,
+        std::unique_ptr<LedgerState> &ledger_state) {
+      BoundedQueue<std::shared_ptr<shared_model::interface::Block>> downloaded(
+          kDownloadQueueSize);
+      // blocks are downloaded and checked by the block loader on a separate
+      // thread, while the previous ones are applied
+      std::thread loader([&chain, &downloaded] {
+        chain
+            // the download stops as soon as the queue is closed
+            .take_while([&downloaded](const auto &block) {
+              return downloaded.push(block);
+            })
+            .as_blocking()
+            .subscribe([](const auto &) {});
+        downloaded.close();
+      });
+
+      auto outcome = ChainOutcome::kApplied;
+      auto block = downloaded.pop();
+      if (not block) {
+        log_->info("Downloaded an empty chain");
+        outcome = ChainOutcome::kInvalid;
+      }
+      while (block and outcome == ChainOutcome::kApplied) {
+        std::vector<std::shared_ptr<shared_model::interface::Block>> chunk;
+        for (; block and chunk.size() < chunk_size_;
+             block = downloaded.pop()) {
+          chunk.push_back(std::move(*block));
+        }
+
+        if (not storage) {
+          auto opt_storage = getStorage();
+          if (not opt_storage) {
+            outcome = ChainOutcome::kStorageFailure;
+            break;
+          }
+          storage = std::move(*opt_storage);
+        }
+        if (not validator_->validateAndApply(
+                rxcpp::observable<>::iterate(chunk,
+                                             rxcpp::identity_immediate()),
+                *storage)) {
+          log_->warn("Downloaded blocks from height {} to {} are invalid",
+                     chunk.front()->height(),
+                     chunk.back()->height());
+          outcome = ChainOutcome::kInvalid;
+          break;
+        }
+        auto chunk_state = mutable_factory_->commit(std::move(storage));
+        if (not chunk_state) {
+          log_->error("failed to commit mutable storage");
+          outcome = ChainOutcome::kStorageFailure;
+          break;
+        }
+        ledger_state = std::move(*chunk_state);
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(committed));
+        log_->info("Committed downloaded blocks up to height {}",
+                   committed.back()->height());
+      }
+      // stop the download if the blocks were not applied
+      downloaded.close();
+      loader.join();
+      return outcome;
+    }
+
     boost::optional<SynchronizationEvent>
     SynchronizerImpl::downloadMissingBlocks(
         const consensus::VoteOther &msg,
         std::unique_ptr<ametsuchi::MutableStorage> storage,
         const shared_model::interface::types::HeightType height) {
       auto expected_height = msg.round.block_round;
+      auto top_height = height;
+      std::vector<std::shared_ptr<shared_model::interface::Block>> committed;
+      std::unique_ptr<LedgerState> ledger_state;
+
+      auto make_event = [&] {
+        return SynchronizationEvent{
+            rxcpp::observable<>::iterate(committed,
+                                         rxcpp::identity_immediate()),
+            SynchronizationOutcomeType::kCommit,
+            top_height > expected_height
+                // TODO 07.03.19 andrei: IR-387 Remove reject round
+                ? consensus::Round{top_height, 0}
+                : msg.round,
+            std::move(ledger_state)};
+      };
 
       // while blocks are not loaded and not committed
       while (true) {
         // TODO andrei 17.10.18 IR-1763 Add delay strategy for loading blocks
         for (const auto &public_key : msg.public_keys) {
-          auto network_chain =
-              block_loader_->retrieveBlocks(height, public_key);
-
-          std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
-          network_chain.as_blocking().subscribe(
-              [&blocks](auto block) { blocks.push_back(block); });
-          if (blocks.empty()) {
-            log_->info("Downloaded an empty chain");
-            continue;
-          } else {
-            log_->info("Successfully downloaded {} blocks", blocks.size());
+          auto outcome =
+              applyChain(block_loader_->retrieveBlocks(top_height, public_key),
+                         storage,
+                         committed,
+                         ledger_state);
+          if (not committed.empty()) {
+            top_height = committed.back()->height();
           }
 
-          auto chain =
-              rxcpp::observable<>::iterate(blocks, rxcpp::identity_immediate());
-
-          if (blocks.back()->height() >= expected_height
-              and validator_->validateAndApply(chain, *storage)) {
-            auto ledger_state = mutable_factory_->commit(std::move(storage));
-
-            if (ledger_state) {
-              return SynchronizationEvent{
-                  chain,
-                  SynchronizationOutcomeType::kCommit,
-                  blocks.back()->height() > expected_height
-                      // TODO 07.03.19 andrei: IR-387 Remove reject round
-                      ? consensus::Round{blocks.back()->height(), 0}
-                      : msg.round,
-                  std::move(*ledger_state)};
-            } else {
+          if (outcome == ChainOutcome::kStorageFailure) {
+            if (committed.empty()) {
               return boost::none;
             }
+            // the ledger has already changed, so the committed blocks are
+            // reported even though the rest of them are not
+            log_->error(
+                "Synchronization stopped at height {}, expected height {}",
+                top_height,
+                expected_height);
+            return make_event();
+          }
+          if (top_height >= expected_height) {
+            return make_event();
+          }
+          if (not committed.empty()) {
+            log_->warn(
+                "Synchronized up to height {} of {}, continuing with the "
+                "next peer",
+                top_height,
+                expected_height);
           }
         }
       }
@@ -25,13 +25,21 @@ namespace iroha {
 
     class SynchronizerImpl : public Synchronizer {
      public:
+      /// Number of downloaded blocks committed in one transaction by default
+      static const size_t kDefaultChunkSize = 1000;
+
+      /**
+       * @param chunk_size - number of downloaded blocks, which are validated,
+       * applied and committed together
+       */
       SynchronizerImpl(
           std::shared_ptr<network::ConsensusGate> consensus_gate,
           std::shared_ptr<validation::ChainValidator> validator,
           std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
           std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
           std::shared_ptr<network::BlockLoader> block_loader,
-          logger::LoggerPtr log);
+          logger::LoggerPtr log,
+          size_t chunk_size = kDefaultChunkSize);
 
       ~SynchronizerImpl() override;
 
@@ -39,14 +47,47 @@ namespace iroha {
       rxcpp::observable<SynchronizationEvent> on_commit_chain() override;
 
      private:
+      /// result of applying the chain downloaded from a peer
+      enum class ChainOutcome {
+        /// all blocks of the chain are committed
+        kApplied,
+        /// the chain is empty, or one of its chunks is invalid. Previous
+        /// chunks are committed
+        kInvalid,
+        /// mutable storage could not be created or committed, so the
+        /// synchronization cannot continue
+        kStorageFailure
+      };
+
+      /**
+       * Apply the chain by chunks, committing each of them, while the next
+       * blocks are being downloaded
+       * @param chain - blocks downloaded from a peer
+       * @param storage - mutable storage for the next chunk, replaced after
+       * each commit
+       * @param committed - committed blocks are appended to it
+       * @param ledger_state - state of the ledger after the last commit
+       * @return outcome of the application
+       */
+      ChainOutcome applyChain(
+          Chain chain,
+          std::unique_ptr<ametsuchi::MutableStorage> &storage,
+          std::vector<std::shared_ptr<shared_model::interface::Block>>
+              &committed,
+          std::unique_ptr<LedgerState> &ledger_state);
+
       /**
        * Iterate through the peers which signed the commit_message, load and
-       * apply the missing blocks
+       * apply the missing blocks. Blocks are committed by chunks, so if a
+       * peer provides an invalid block, the blocks before it stay committed,
+       * and the rest are requested from the next peer
        * @param commit_message - the commit that triggered synchronization
        * @param storage - mutable storage to apply downloaded commits from other
        * peers
        * @param height - the top block height of a peer that needs to be
        * synchronized
+       * @return event with the committed blocks, or boost::none if none of
+       * them were committed
        */
       boost::optional<SynchronizationEvent> downloadMissingBlocks(
           const consensus::VoteOther &msg,
@@ -62,6 +103,7 @@ namespace iroha {
       std::shared_ptr<ametsuchi::MutableFactory> mutable_factory_;
       std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory_;
       std::shared_ptr<network::BlockLoader> block_loader_;
+      const size_t chunk_size_;
 
       // internal
       rxcpp::subjects::subject<SynchronizationEvent> notifier_;
@@ -46,6 +46,14 @@ namespace torii {
     grpc::Status Status(const iroha::protocol::TxStatusRequest &tx,
                         iroha::protocol::ToriiResponse &response) const;
 
+    /**
+     * @param request - hashes of transactions
+     * @param response returns ToriiResponseList if succeeded
+     * @return grpc::Status - returns connection is success or not.
+     */
+    grpc::Status Statuses(const iroha::protocol::TxStatusesRequest &request,
+                          iroha::protocol::ToriiResponseList &response) const;
+
     /**
      * Acquires stream of transaction statuses from the request
      * moment until final.
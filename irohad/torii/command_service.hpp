@@ -6,7 +6,9 @@
 #ifndef TORII_COMMAND_SERVICE_HPP
 #define TORII_COMMAND_SERVICE_HPP
 
-#include <rxcpp/rx.hpp>
+#include <memory>
+#include <vector>
+
 #include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
@@ -45,16 +47,29 @@ namespace iroha {
       getStatus(const shared_model::crypto::Hash &request) = 0;
 
       /**
-       * Streaming call which will repeatedly send all statuses of requested
-       * transaction from its status at the moment of receiving this request to
-       * the some final transaction status (which cannot change anymore)
-       * @param request- TxStatusRequest object which identifies transaction
-       * uniquely
-       * @return observable with transaction statuses
+       * Request to retrieve statuses of several transactions at once. The
+       * statuses are the same as getStatus would return, but the ones absent
+       * in cache are looked up in storage with a single query
+       * @param hashes - hashes which identify transactions uniquely
+       * @return responses which contain current states of requested
+       * transactions in the order of hashes
        */
-      virtual rxcpp::observable<
+      virtual std::vector<
           std::shared_ptr<shared_model::interface::TransactionResponse>>
-      getStatusStream(const shared_model::crypto::Hash &hash) = 0;
+      getStatuses(const std::vector<shared_model::crypto::Hash> &hashes) = 0;
+
+      /**
+       * Request to retrieve a status, which a status stream of the transaction
+       * starts with. Unlike getStatus, the status is also looked up among
+       * rejected transactions. Further statuses up to the final one (which
+       * cannot change anymore) are delivered to the stream as they are
+       * published
+       * @param hash - hash which identifies transaction uniquely
+       * @return response which contains a current state of requested
+       * transaction
+       */
+      virtual std::shared_ptr<shared_model::interface::TransactionResponse>
+      getInitialStatus(const shared_model::crypto::Hash &hash) = 0;
     };
 
   }  // namespace torii
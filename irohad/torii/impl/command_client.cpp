@@ -42,6 +42,13 @@ namespace torii {
     return stub_->Status(&context, request, &response);
   }
 
+  grpc::Status CommandSyncClient::Statuses(
+      const iroha::protocol::TxStatusesRequest &request,
+      iroha::protocol::ToriiResponseList &response) const {
+    grpc::ClientContext context;
+    return stub_->Statuses(&context, request, &response);
+  }
+
   void CommandSyncClient::StatusStream(
       const iroha::protocol::TxStatusRequest &tx,
       std::vector<iroha::protocol::ToriiResponse> &response) const {
@@ -9,11 +9,11 @@
 
 #include "ametsuchi/block_query.hpp"
 #include "common/byteutils.hpp"
-#include "common/is_any.hpp"
 #include "common/visitor.hpp"
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/transaction_responses/not_received_tx_response.hpp"
 #include "logger/logger.hpp"
+#include "torii/impl/final_status_value.hpp"
 
 namespace iroha {
   namespace torii {
@@ -81,107 +81,108 @@ namespace iroha {
         return status_factory_->makeNotReceived(request);
       }
 
+      return makeStoredStatus(request, *status);
+    }
+
+    std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
+    CommandServiceImpl::getStatuses(
+        const std::vector<shared_model::crypto::Hash> &hashes) {
+      std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
+          responses(hashes.size());
+      // positions of the hashes, which are absent in cache
+      std::vector<size_t> missed;
+      std::vector<shared_model::crypto::Hash> missed_hashes;
+      for (size_t i = 0; i < hashes.size(); ++i) {
+        if (auto cached = cache_->findItem(hashes[i])) {
+          responses[i] = std::move(*cached);
+        } else {
+          missed.push_back(i);
+          missed_hashes.push_back(hashes[i]);
+        }
+      }
+      if (missed.empty()) {
+        return responses;
+      }
+
+      auto not_received = [&] {
+        for (auto i : missed) {
+          responses[i] = status_factory_->makeNotReceived(hashes[i]);
+        }
+        return responses;
+      };
+
+      auto block_query = storage_->getBlockQuery();
+      if (not block_query) {
+        // TODO andrei 30.11.18 IR-51 Handle database error
+        log_->warn("Could not create block query. Txs: {}", missed.size());
+        return not_received();
+      }
+
+      auto statuses = block_query->checkTxsPresence(missed_hashes);
+      if (not statuses) {
+        // TODO andrei 30.11.18 IR-51 Handle database error
+        log_->warn("Check txs presence database error. Txs: {}",
+                   missed.size());
+        return not_received();
+      }
+
+      for (size_t i = 0; i < missed.size(); ++i) {
+        responses[missed[i]] =
+            makeStoredStatus(hashes[missed[i]], (*statuses)[i]);
+      }
+      return responses;
+    }
+
+    std::shared_ptr<shared_model::interface::TransactionResponse>
+    CommandServiceImpl::getInitialStatus(
+        const shared_model::crypto::Hash &hash) {
+      if (auto cached = cache_->findItem(hash)) {
+        return *cached;
+      }
+      // if cache_ doesn't contain some status there is required to check
+      // persistent cache
+      log_->debug("tx {} isn't present in cache", hash);
+      auto from_persistent_cache = tx_presence_cache_->check(hash);
+      if (not from_persistent_cache) {
+        // TODO andrei 30.11.18 IR-51 Handle database error
+        log_->warn("Check hash presence database error. {}", hash);
+        return status_factory_->makeNotReceived(hash);
+      }
+      return iroha::visit_in_place(
+          *from_persistent_cache,
+          [this,
+           &hash](const iroha::ametsuchi::tx_cache_status_responses::Committed
+                      &) { return status_factory_->makeCommitted(hash); },
+          [this, &hash](
+              const iroha::ametsuchi::tx_cache_status_responses::Rejected &) {
+            return status_factory_->makeRejected(hash);
+          },
+          [this, &hash](
+              const iroha::ametsuchi::tx_cache_status_responses::Missing &) {
+            return status_factory_->makeNotReceived(hash);
+          });
+    }
+
+    std::shared_ptr<shared_model::interface::TransactionResponse>
+    CommandServiceImpl::makeStoredStatus(
+        const shared_model::crypto::Hash &hash,
+        const iroha::ametsuchi::TxCacheStatusType &status) {
       return iroha::visit_in_place(
-          *status,
-          [this, &request](
+          status,
+          [this, &hash](
               const iroha::ametsuchi::tx_cache_status_responses::Missing &)
               -> std::shared_ptr<shared_model::interface::TransactionResponse> {
-            log_->warn("Asked non-existing tx: {}", request.hex());
-            return status_factory_->makeNotReceived(request);
+            log_->warn("Asked non-existing tx: {}", hash.hex());
+            return status_factory_->makeNotReceived(hash);
           },
-          [this, &request](const auto &) {
+          [this, &hash](const auto &) {
             std::shared_ptr<shared_model::interface::TransactionResponse>
-                response = status_factory_->makeCommitted(request);
-            cache_->addItem(request, response);
+                response = status_factory_->makeCommitted(hash);
+            cache_->addItem(hash, response);
             return response;
           });
     }
 
-    /**
-     * Statuses considered final for streaming. Observable stops value emission
-     * after receiving a value of one of the following types
-     * @tparam T concrete response type
-     *
-     * StatefulFailedTxResponse and MstExpiredResponse were removed from the
-     * list of final statuses.
-     *
-     * StatefulFailedTxResponse is not a final status because the node might be
-     * in non-synchronized state and the transaction may be stateful valid from
-     * the viewpoint of up to date nodes.
-     *
-     * MstExpiredResponse is not a final status in general case because it will
-     * depend on MST expiration timeout. The transaction might expire in MST,
-     * but remain valid in terms of Iroha validation rules. Thus, it may be
-     * resent and committed successfully. As the result the final status may
-     * differ from MstExpiredResponse.
-     */
-    template <typename T>
-    constexpr bool FinalStatusValue =
-        iroha::is_any<std::decay_t<T>,
-                      shared_model::interface::StatelessFailedTxResponse,
-                      shared_model::interface::CommittedTxResponse,
-                      shared_model::interface::RejectedTxResponse>::value;
-
-    rxcpp::observable<
-        std::shared_ptr<shared_model::interface::TransactionResponse>>
-    CommandServiceImpl::getStatusStream(
-        const shared_model::crypto::Hash &hash) {
-      using ResponsePtrType =
-          std::shared_ptr<shared_model::interface::TransactionResponse>;
-      auto initial_status = cache_->findItem(hash).value_or([&] {
-        // if cache_ doesn't contain some status there is required to check
-        // persistent cache
-
-        log_->debug("tx {} isn't present in cache", hash);
-        auto from_persistent_cache = tx_presence_cache_->check(hash);
-        if (not from_persistent_cache) {
-          // TODO andrei 30.11.18 IR-51 Handle database error
-          log_->warn("Check hash presence database error. {}", hash);
-          return status_factory_->makeNotReceived(hash);
-        }
-        return iroha::visit_in_place(
-            *from_persistent_cache,
-            [this,
-             &hash](const iroha::ametsuchi::tx_cache_status_responses::Committed
-                        &) { return status_factory_->makeCommitted(hash); },
-            [this, &hash](
-                const iroha::ametsuchi::tx_cache_status_responses::Rejected &) {
-              return status_factory_->makeRejected(hash);
-            },
-            [this, &hash](
-                const iroha::ametsuchi::tx_cache_status_responses::Missing &) {
-              return status_factory_->makeNotReceived(hash);
-            });
-      }());
-      return status_bus_
-          ->statuses()
-          // prepend initial status
-          .start_with(initial_status)
-          // select statuses with requested hash
-          .filter([hash](auto response) {
-            return response->transactionHash() == hash;
-          })
-          // successfully complete the observable if final status is received.
-          // final status is included in the observable
-          .template lift<ResponsePtrType>(
-              [](rxcpp::subscriber<ResponsePtrType> dest) {
-                return rxcpp::make_subscriber<ResponsePtrType>(
-                    dest, [=](ResponsePtrType response) {
-                      dest.on_next(response);
-                      iroha::visit_in_place(
-                          response->get(),
-                          [dest](const auto &resp)
-                              -> std::enable_if_t<
-                                  FinalStatusValue<decltype(resp)>> {
-                            dest.on_completed();
-                          },
-                          [](const auto &resp)
-                              -> std::enable_if_t<
-                                  not FinalStatusValue<decltype(resp)>>{});
-                    });
-              });
-    }
-
     void CommandServiceImpl::pushStatus(
         const std::string &who,
         std::shared_ptr<shared_model::interface::TransactionResponse>
@@ -65,9 +65,11 @@ namespace iroha {
 
       std::shared_ptr<shared_model::interface::TransactionResponse> getStatus(
           const shared_model::crypto::Hash &request) override;
-      rxcpp::observable<
-          std::shared_ptr<shared_model::interface::TransactionResponse>>
-      getStatusStream(const shared_model::crypto::Hash &hash) override;
+      std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
+      getStatuses(
+          const std::vector<shared_model::crypto::Hash> &hashes) override;
+      std::shared_ptr<shared_model::interface::TransactionResponse>
+      getInitialStatus(const shared_model::crypto::Hash &hash) override;
 
      private:
       /**
@@ -79,6 +81,16 @@ namespace iroha {
       inline void handleEvents(rxcpp::composite_subscription &subscription,
                                rxcpp::schedulers::run_loop &run_loop);
 
+      /**
+       * Make response for the status of the transaction found in storage
+       * @param hash - hash of the transaction
+       * @param status - status of the transaction in storage
+       * @return response, which is put to cache if it is final
+       */
+      std::shared_ptr<shared_model::interface::TransactionResponse>
+      makeStoredStatus(const shared_model::crypto::Hash &hash,
+                       const iroha::ametsuchi::TxCacheStatusType &status);
+
       /**
        * Share tx status and log it
        * @param who identifier for the logging
@@ -7,27 +7,30 @@
 
 #include "torii/impl/command_service_transport_grpc.hpp"
 
-#include <atomic>
-#include <condition_variable>
+#include <algorithm>
 #include <iterator>
+#include <mutex>
+#include <vector>
 
 #include <boost/format.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include "backend/protobuf/transaction_responses/proto_tx_response.hpp"
-#include "common/combine_latest_until_first_completed.hpp"
-#include "common/run_loop_handler.hpp"
+#include "common/visitor.hpp"
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/iroha_internal/transaction_batch_factory.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser.hpp"
 #include "interfaces/iroha_internal/tx_status_factory.hpp"
 #include "interfaces/transaction.hpp"
 #include "logger/logger.hpp"
+#include "torii/impl/final_status_value.hpp"
 #include "torii/status_bus.hpp"
 
 namespace iroha {
   namespace torii {
 
+    constexpr size_t CommandServiceTransportGrpc::kMaxStatusesRequestSize;
+
     CommandServiceTransportGrpc::CommandServiceTransportGrpc(
         std::shared_ptr<CommandService> command_service,
         std::shared_ptr<iroha::torii::StatusBus> status_bus,
@@ -49,7 +52,41 @@ namespace iroha {
           batch_factory_(std::move(transaction_batch_factory)),
           log_(std::move(log)),
           consensus_gate_objects_(std::move(consensus_gate_objects)),
-          maximum_rounds_without_update_(maximum_rounds_without_update) {}
+          maximum_rounds_without_update_(maximum_rounds_without_update),
+          status_dispatcher_(std::make_shared<StatusDispatcher>()),
+          stream_starts_(rxcpp::observe_on_new_thread(),
+                         stream_starts_lifetime_) {
+      // the only subscriptions for all the status streams: statuses are
+      // delivered to the streams of their transactions
+      status_subscription_ = status_bus_->statuses().subscribe(
+          [dispatcher = status_dispatcher_](const auto &response) {
+            dispatcher->dispatch(response);
+          });
+      rounds_subscription_ = consensus_gate_objects_.subscribe(
+          [dispatcher = status_dispatcher_](const auto &) {
+            dispatcher->notifyRound();
+          });
+      // the handler does not refer to the transport, since the worker may
+      // still run it while the transport is being destroyed
+      stream_starts_subscription_ = stream_starts_.get_observable().subscribe(
+          [command_service = command_service_,
+           dispatcher = status_dispatcher_,
+           maximum_rounds_without_update = maximum_rounds_without_update_,
+           log = log_](const std::shared_ptr<StatusStreamType> &stream) {
+            startStatusStream(stream,
+                              *command_service,
+                              *dispatcher,
+                              maximum_rounds_without_update,
+                              log);
+          });
+    }
+
+    CommandServiceTransportGrpc::~CommandServiceTransportGrpc() {
+      status_subscription_.unsubscribe();
+      rounds_subscription_.unsubscribe();
+      stream_starts_subscription_.unsubscribe();
+      stream_starts_lifetime_.unsubscribe();
+    }
 
     grpc::Status CommandServiceTransportGrpc::Torii(
         grpc::ServerContext *context,
@@ -166,89 +203,254 @@ namespace iroha {
       return grpc::Status::OK;
     }
 
-    grpc::Status CommandServiceTransportGrpc::StatusStream(
+    grpc::Status CommandServiceTransportGrpc::Statuses(
         grpc::ServerContext *context,
-        const iroha::protocol::TxStatusRequest *request,
-        grpc::ServerWriter<iroha::protocol::ToriiResponse> *response_writer) {
-      rxcpp::schedulers::run_loop rl;
+        const iroha::protocol::TxStatusesRequest *request,
+        iroha::protocol::ToriiResponseList *response) {
+      if (static_cast<size_t>(request->tx_hashes_size())
+          > kMaxStatusesRequestSize) {
+        return grpc::Status(
+            grpc::StatusCode::INVALID_ARGUMENT,
+            (boost::format("at most %d hashes are allowed, got %d")
+             % kMaxStatusesRequestSize % request->tx_hashes_size())
+                .str());
+      }
+
+      std::vector<shared_model::crypto::Hash> hashes;
+      hashes.reserve(request->tx_hashes_size());
+      for (const auto &hex : request->tx_hashes()) {
+        hashes.push_back(shared_model::crypto::Hash::fromHexString(hex));
+        if (hashes.back().blob().empty()) {
+          return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                              (boost::format("invalid hash at position %d")
+                               % (hashes.size() - 1))
+                                  .str());
+        }
+      }
+
+      const auto statuses = command_service_->getStatuses(hashes);
+      response->mutable_responses()->Reserve(statuses.size());
+      for (const auto &status : statuses) {
+        *response->add_responses() =
+            std::static_pointer_cast<shared_model::proto::TransactionResponse>(
+                status)
+                ->getTransport();
+      }
+      return grpc::Status::OK;
+    }
 
-      auto current_thread = rxcpp::synchronize_in_one_worker(
-          rxcpp::schedulers::make_run_loop(rl));
+    namespace {
+      /**
+       * @return true if no statuses follow the given one
+       */
+      bool isFinalStatus(
+          const shared_model::interface::TransactionResponse &response) {
+        return iroha::visit_in_place(
+            response.get(),
+            [](const auto &resp)
+                -> std::enable_if_t<FinalStatusValue<decltype(resp)>, bool> {
+              return true;
+            },
+            [](const auto &resp)
+                -> std::enable_if_t<not FinalStatusValue<decltype(resp)>,
+                                    bool> { return false; });
+      }
 
-      rxcpp::composite_subscription subscription;
+      /**
+       * Statuses of the transaction sent to a single status stream. New
+       * statuses are written until the final one, or until too many rounds
+       * pass without an update
+       */
+      class StatusStreamState
+          : public std::enable_shared_from_this<StatusStreamState> {
+       public:
+        using StreamType = network::AsyncServerStream<
+            iroha::protocol::TxStatusRequest,
+            iroha::protocol::ToriiResponse>;
 
-      auto hash = shared_model::crypto::Hash::fromHexString(request->tx_hash());
+        StatusStreamState(std::shared_ptr<StreamType> stream,
+                          int maximum_rounds_without_update,
+                          std::string client_id,
+                          logger::LoggerPtr log)
+            : stream_(std::move(stream)),
+              maximum_rounds_without_update_(maximum_rounds_without_update),
+              client_id_(std::move(client_id)),
+              log_(std::move(log)) {}
 
-      auto client_id_format = boost::format("Peer: '%s', %s");
-      std::string client_id =
-          (client_id_format % context->peer() % hash.toString()).str();
-      auto status_bus = command_service_->getStatusStream(hash);
-      auto consensus_gate_observable =
-          consensus_gate_objects_
-              // a dummy start_with lets us don't wait for the consensus event
-              // on further combine_latest
-              .start_with(ConsensusGateEvent{});
-
-      boost::optional<iroha::protocol::TxStatus> last_tx_status;
-      auto rounds_counter{0};
-      makeCombineLatestUntilFirstCompleted(
-          status_bus,
-          current_thread,
-          [](auto status, auto) { return status; },
-          consensus_gate_observable)
-          // complete the observable if client is disconnected or too many
-          // rounds have passed without tx status change
-          .take_while([=, &rounds_counter, &last_tx_status](
-                          const auto &response) {
-            const auto &proto_response =
-                std::static_pointer_cast<
-                    shared_model::proto::TransactionResponse>(response)
-                    ->getTransport();
-
-            if (context->IsCancelled()) {
-              log_->debug("client unsubscribed, {}", client_id);
-              return false;
-            }
+        /**
+         * Subscribe to statuses of the transaction and send the initial one.
+         * The subscription is made before the initial status is read, so
+         * that no status is missed. Statuses dispatched meanwhile are
+         * handled after the initial status
+         * @param get_initial_status - reads the current status, invoked
+         * without the lock, since it may query the storage
+         */
+        void start(StatusDispatcher &dispatcher,
+                   const shared_model::crypto::Hash &hash,
+                   const std::function<StatusDispatcher::ResponsePtrType()>
+                       &get_initial_status) {
+          std::weak_ptr<StatusStreamState> weak_state = shared_from_this();
+          auto subscription = dispatcher.subscribe(
+              hash,
+              [weak_state](const StatusDispatcher::ResponsePtrType &response) {
+                if (auto state = weak_state.lock()) {
+                  state->onStatus(response);
+                }
+              });
+          auto initial_status = get_initial_status();
 
-            // increment round counter when the same status arrived again.
-            auto status = proto_response.tx_status();
-            auto status_is_same =
-                last_tx_status and (status == *last_tx_status);
-            if (status_is_same) {
-              ++rounds_counter;
-              if (rounds_counter >= maximum_rounds_without_update_) {
-                // we stop the stream when round counter is greater than
-                // allowed.
-                return false;
-              }
-              // omit the received status, but do not stop the stream
-              return true;
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (done_) {
+            // the client is gone while the initial status was read
+            return;
+          }
+          subscription_ = std::move(subscription);
+          started_ = true;
+          handle(initial_status);
+          for (const auto &response : pending_) {
+            handle(response);
+          }
+          pending_.clear();
+        }
+
+        /**
+         * Handle a status of the transaction, or the end of a round if it is
+         * null. Statuses received before the initial one are kept until it
+         * is sent
+         */
+        void onStatus(const StatusDispatcher::ResponsePtrType &response) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (not started_) {
+            pending_.push_back(response);
+            return;
+          }
+          handle(response);
+        }
+
+        /**
+         * Stop receiving statuses, when the stream is done
+         */
+        void stop() {
+          std::shared_ptr<StatusDispatcher::Subscription> subscription;
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+            subscription = std::move(subscription_);
+          }
+          if (auto dropped = stream_->dropped()) {
+            log_->warn("{} statuses were dropped, {}", dropped, client_id_);
+          }
+          log_->debug("status stream done, {}", client_id_);
+        }
+
+       private:
+        void handle(const StatusDispatcher::ResponsePtrType &response) {
+          if (done_) {
+            return;
+          }
+          if (not response) {
+            // increment round counter when a round has passed without a
+            // status
+            ++rounds_counter_;
+            if (rounds_counter_ >= maximum_rounds_without_update_) {
+              finish();
             }
-            rounds_counter = 0;
-            last_tx_status = status;
+            return;
+          }
+          const auto &proto_response =
+              static_cast<const shared_model::proto::TransactionResponse &>(
+                  *response)
+                  .getTransport();
 
-            // write a new status to the stream
-            if (not response_writer->Write(proto_response)) {
-              log_->error("write to stream has failed to client {}", client_id);
-              return false;
+          // increment round counter when the same status arrived again.
+          auto status = proto_response.tx_status();
+          auto status_is_same =
+              last_tx_status_ and (status == *last_tx_status_);
+          if (status_is_same) {
+            ++rounds_counter_;
+            if (rounds_counter_ >= maximum_rounds_without_update_) {
+              // we stop the stream when round counter is greater than
+              // allowed.
+              finish();
             }
-            log_->debug("status written, {}", client_id);
-            return true;
-          })
-          .subscribe(subscription,
-                     [](const auto &) {},
-                     [&](std::exception_ptr ep) {
-                       log_->error("something bad happened, client_id {}",
-                                   client_id);
-                     },
-                     [&] { log_->debug("stream done, {}", client_id); });
-
-      // run loop while subscription is active or there are pending events in
-      // the queue
-      iroha::schedulers::handleEvents(subscription, rl);
-
-      log_->debug("status stream done, {}", client_id);
-      return grpc::Status::OK;
+            // omit the received status, but do not stop the stream
+            return;
+          }
+          rounds_counter_ = 0;
+          last_tx_status_ = status;
+
+          // write a new status to the stream
+          stream_->write(proto_response);
+          log_->debug("status written, {}", client_id_);
+
+          if (isFinalStatus(*response)) {
+            finish();
+          }
+        }
+
+        void finish() {
+          done_ = true;
+          stream_->finish(grpc::Status::OK);
+        }
+
+        std::shared_ptr<StreamType> stream_;
+        const int maximum_rounds_without_update_;
+        const std::string client_id_;
+        logger::LoggerPtr log_;
+
+        std::shared_ptr<StatusDispatcher::Subscription> subscription_;
+        std::vector<StatusDispatcher::ResponsePtrType> pending_;
+        boost::optional<iroha::protocol::TxStatus> last_tx_status_;
+        int rounds_counter_{0};
+        bool started_{false};
+        bool done_{false};
+        std::mutex mutex_;
+      };
+    }  // namespace
+
+    void CommandServiceTransportGrpc::startStatusStream(
+        std::shared_ptr<StatusStreamType> stream,
+        CommandService &command_service,
+        StatusDispatcher &dispatcher,
+        int maximum_rounds_without_update,
+        const logger::LoggerPtr &log) {
+      auto hash = shared_model::crypto::Hash::fromHexString(
+          stream->request().tx_hash());
+
+      auto client_id_format = boost::format("Peer: '%s', %s");
+      std::string client_id =
+          (client_id_format % stream->context().peer() % hash.toString())
+              .str();
+
+      auto state = std::make_shared<StatusStreamState>(
+          stream, maximum_rounds_without_update, client_id, log);
+      stream->onDone([state] { state->stop(); });
+      state->start(dispatcher, hash, [&command_service, &hash] {
+        return command_service.getInitialStatus(hash);
+      });
+    }
+
+    void CommandServiceTransportGrpc::requestCalls(
+        network::AsyncCallQueue &queue) {
+      requestStatusStream(queue);
+    }
+
+    void CommandServiceTransportGrpc::requestStatusStream(
+        network::AsyncCallQueue &queue) {
+      StatusStreamType::request(
+          queue,
+          [this, &queue](auto context, auto request, auto writer, auto tag) {
+            auto cq = queue.get();
+            this->RequestStatusStream(context, request, writer, cq, cq, tag);
+          },
+          [this, &queue](std::shared_ptr<StatusStreamType> stream) {
+            // accept the next call while this one is handled, unless the
+            // queue is shut down meanwhile
+            this->requestStatusStream(queue);
+            stream_starts_.get_subscriber().on_next(std::move(stream));
+          },
+          kMaxQueuedStatuses,
+          network::StreamOverflowPolicy::kDropOldest);
     }
   }  // namespace torii
 }  // namespace iroha
@@ -8,11 +8,14 @@
 
 #include "torii/command_service.hpp"
 
+#include <rxcpp/rx.hpp>
 #include "endpoint.grpc.pb.h"
 #include "endpoint.pb.h"
 #include "interfaces/common_objects/transaction_sequence_common.hpp"
 #include "interfaces/iroha_internal/abstract_transport_factory.hpp"
 #include "logger/logger_fwd.hpp"
+#include "network/impl/async_grpc_server.hpp"
+#include "torii/impl/status_dispatcher.hpp"
 
 namespace iroha {
   namespace torii {
@@ -30,8 +33,15 @@ namespace shared_model {
 
 namespace iroha {
   namespace torii {
+    /**
+     * Transport of the command service. StatusStream is handled
+     * asynchronously, so that long-lived streams do not occupy server threads
+     */
     class CommandServiceTransportGrpc
-        : public iroha::protocol::CommandService_v1::Service {
+        : public iroha::protocol::CommandService_v1::
+              WithAsyncMethod_StatusStream<
+                  iroha::protocol::CommandService_v1::Service>,
+          public network::AsyncGrpcService {
      public:
       using TransportFactoryType =
           shared_model::interface::AbstractTransportFactory<
@@ -67,6 +77,8 @@ namespace iroha {
           int maximum_rounds_without_update,
           logger::LoggerPtr log);
 
+      ~CommandServiceTransportGrpc() override;
+
       /**
        * Torii call via grpc
        * @param context - call context (see grpc docs for details)
@@ -103,21 +115,57 @@ namespace iroha {
                           iroha::protocol::ToriiResponse *response) override;
 
       /**
-       * StatusStream call via grpc
+       * Statuses call via grpc
        * @param context - call context
-       * @param request - TxStatusRequest object which identifies transaction
-       * uniquely
-       * @param response_writer - grpc::ServerWriter which can repeatedly send
-       * transaction statuses back to the client
-       * @return status
+       * @param request - TxStatusesRequest object which identifies
+       * transactions uniquely
+       * @param response - ToriiResponseList which contains current states of
+       * requested transactions in the order of the request
+       * @return status, INVALID_ARGUMENT if there are more than
+       * kMaxStatusesRequestSize hashes or some of them are not valid hex
        */
-      grpc::Status StatusStream(
+      grpc::Status Statuses(
           grpc::ServerContext *context,
-          const iroha::protocol::TxStatusRequest *request,
-          grpc::ServerWriter<iroha::protocol::ToriiResponse> *response_writer)
-          override;
+          const iroha::protocol::TxStatusesRequest *request,
+          iroha::protocol::ToriiResponseList *response) override;
+
+      /**
+       * Start accepting StatusStream calls. Each stream repeatedly sends
+       * statuses of the requested transaction, until the final one is sent,
+       * too many rounds pass without an update, or the client disconnects.
+       * Streams are started on a separate thread, since their initial
+       * statuses may be read from the storage
+       * @param queue - completion queue of the server
+       */
+      void requestCalls(network::AsyncCallQueue &queue) override;
+
+      /// maximum number of hashes in a single Statuses call
+      static constexpr size_t kMaxStatusesRequestSize = 1000;
 
      private:
+      using StatusStreamType =
+          network::AsyncServerStream<iroha::protocol::TxStatusRequest,
+                                     iroha::protocol::ToriiResponse>;
+
+      /// number of statuses queued for a stream, which has not sent them yet
+      static constexpr size_t kMaxQueuedStatuses = 16;
+
+      /**
+       * Wait for the next StatusStream call
+       */
+      void requestStatusStream(network::AsyncCallQueue &queue);
+
+      /**
+       * Send statuses of the requested transaction to the stream. Static,
+       * since it is invoked on the thread starting the streams, which may
+       * outlive the transport
+       */
+      static void startStatusStream(std::shared_ptr<StatusStreamType> stream,
+                                    CommandService &command_service,
+                                    StatusDispatcher &dispatcher,
+                                    int maximum_rounds_without_update,
+                                    const logger::LoggerPtr &log);
+
       /**
        * Flat map transport transactions to shared model
        */
@@ -136,6 +184,17 @@ namespace iroha {
 
       rxcpp::observable<ConsensusGateEvent> consensus_gate_objects_;
       const int maximum_rounds_without_update_;
+
+      std::shared_ptr<StatusDispatcher> status_dispatcher_;
+      rxcpp::composite_subscription status_subscription_;
+      rxcpp::composite_subscription rounds_subscription_;
+
+      /// received status streams, which are started on a separate thread
+      rxcpp::composite_subscription stream_starts_lifetime_;
+      rxcpp::subjects::synchronize<std::shared_ptr<StatusStreamType>,
+                                   rxcpp::observe_on_one_worker>
+          stream_starts_;
+      rxcpp::composite_subscription stream_starts_subscription_;
     };
   }  // namespace torii
 }  // namespace iroha
@@ -5,9 +5,10 @@
 
 #include "torii/query_service.hpp"
 
+#include <boost/format.hpp>
+
 #include "backend/protobuf/query_responses/proto_block_query_response.hpp"
 #include "backend/protobuf/query_responses/proto_query_response.hpp"
-#include "common/run_loop_handler.hpp"
 #include "cryptography/default_hash_provider.hpp"
 #include "interfaces/iroha_internal/abstract_transport_factory.hpp"
 #include "logger/logger.hpp"
@@ -66,97 +67,126 @@ namespace iroha {
       return grpc::Status::OK;
     }
 
-    grpc::Status QueryService::FetchCommits(
-        grpc::ServerContext *context,
-        const iroha::protocol::BlocksQuery *request,
-        grpc::ServerWriter<iroha::protocol::BlockQueryResponse> *writer) {
-      log_->debug("Fetching commits");
+    constexpr size_t QueryService::kMaxQueuedBlocks;
+
+    void QueryService::requestCalls(network::AsyncCallQueue &queue) {
+      requestFetchCommits(queue);
+    }
+
+    void QueryService::requestFetchCommits(network::AsyncCallQueue &queue) {
+      BlocksStreamType::request(
+          queue,
+          [this, &queue](auto context, auto request, auto writer, auto tag) {
+            auto cq = queue.get();
+            this->RequestFetchCommits(context, request, writer, cq, cq, tag);
+          },
+          [this, &queue](std::shared_ptr<BlocksStreamType> stream) {
+            // accept the next call while this one is handled, unless the
+            // queue is shut down meanwhile
+            this->requestFetchCommits(queue);
+            this->startFetchCommits(std::move(stream));
+          },
+          kMaxQueuedBlocks,
+          // blocks cannot be skipped, so a slow client loses the stream
+          network::StreamOverflowPolicy::kFinish);
+    }
 
-      rxcpp::schedulers::run_loop run_loop;
-      auto current_thread = rxcpp::synchronize_in_one_worker(
-          rxcpp::schedulers::make_run_loop(run_loop));
+    void QueryService::startFetchCommits(
+        std::shared_ptr<BlocksStreamType> stream) {
+      log_->debug("Fetching commits");
 
       shared_model::proto::TransportBuilder<
           shared_model::proto::BlocksQuery,
           shared_model::validation::DefaultSignedBlocksQueryValidator>()
-          .build(*request)
+          .build(stream->request())
           .match(
-              [this, context, request, writer, &current_thread, &run_loop](
+              [this, &stream](
                   const iroha::expected::Value<shared_model::proto::BlocksQuery>
                       &query) {
                 rxcpp::composite_subscription subscription;
                 std::string client_id =
-                    (boost::format("Peer: '%s'") % context->peer()).str();
+                    (boost::format("Peer: '%s'") % stream->context().peer())
+                        .str();
+                const auto &creator_account_id =
+                    stream->request().meta().creator_account_id();
+                // the stream is owned by the completion queue, blocks are
+                // not sent after it is done
+                std::weak_ptr<BlocksStreamType> weak_stream = stream;
+                stream->onDone([this, subscription, weak_stream, client_id] {
+                  if (auto stream = weak_stream.lock()) {
+                    if (auto dropped = stream->dropped()) {
+                      log_->warn(
+                          "block stream is finished, since {} blocks were not "
+                          "sent in time, {}",
+                          dropped,
+                          client_id);
+                    }
+                  }
+                  log_->debug("Unsubscribed from block stream");
+                  subscription.unsubscribe();
+                });
                 query_processor_->blocksQueryHandle(query.value)
-                    .observe_on(current_thread)
-                    .take_while([this, context, request, writer](
-                                    const std::shared_ptr<
-                                        shared_model::interface::
-                                            BlockQueryResponse> response) {
-                      if (context->IsCancelled()) {
-                        log_->debug("Unsubscribed from block stream");
-                        return false;
-                      } else {
-                        auto result = iroha::visit_in_place(
-                            response->get(),
-                            [this, writer, request](
-                                const shared_model::interface::BlockResponse
-                                    &block_response) {
-                              log_->debug("{} receives committed block",
-                                          request->meta().creator_account_id());
-                              auto proto_block_response = static_cast<
-                                  const shared_model::proto::BlockResponse &>(
-                                  block_response);
-                              bool written = writer->Write(
-                                  proto_block_response.getTransport());
-                              if (not written) {
+                    .subscribe(
+                        subscription,
+                        [this, weak_stream, creator_account_id](
+                            const std::shared_ptr<
+                                shared_model::interface::BlockQueryResponse>
+                                &response) {
+                          auto stream = weak_stream.lock();
+                          if (not stream) {
+                            return;
+                          }
+                          iroha::visit_in_place(
+                              response->get(),
+                              [&](const shared_model::interface::BlockResponse
+                                      &block_response) {
+                                log_->debug("{} receives committed block",
+                                            creator_account_id);
+                                stream->write(
+                                    static_cast<const shared_model::proto::
+                                                    BlockResponse &>(
+                                        block_response)
+                                        .getTransport());
+                              },
+                              [&](const shared_model::interface::
+                                      BlockErrorResponse
+                                          &block_error_response) {
                                 log_->debug(
-                                    "Block stream appears to be closed");
-                                return false;
-                              }
-                              return true;
-                            },
-                            [this, writer, request](
-                                const shared_model::interface::
-                                    BlockErrorResponse &block_error_response) {
-                              log_->debug("{} received error with message: {}",
-                                          request->meta().creator_account_id(),
-                                          block_error_response.message());
-                              auto proto_block_error_response = static_cast<
-                                  const shared_model::proto::BlockErrorResponse
-                                      &>(block_error_response);
-                              writer->WriteLast(
-                                  proto_block_error_response.getTransport(),
-                                  grpc::WriteOptions());
-                              return false;
-                            });
-                        return result;
-                      }
-                    })
-                    .subscribe(subscription,
-                               [](const auto &) {},
-                               [&](std::exception_ptr ep) {
-                                 log_->error(
-                                     "something bad happened during block "
-                                     "streaming, client_id {}",
-                                     client_id);
-                               },
-                               [&] {
-                                 log_->debug("block stream done, {}",
-                                             client_id);
-                               });
-
-                iroha::schedulers::handleEvents(subscription, run_loop);
+                                    "{} received error with message: {}",
+                                    creator_account_id,
+                                    block_error_response.message());
+                                stream->write(
+                                    static_cast<const shared_model::proto::
+                                                    BlockErrorResponse &>(
+                                        block_error_response)
+                                        .getTransport());
+                                stream->finish(grpc::Status::OK);
+                              });
+                        },
+                        [this, weak_stream, client_id](std::exception_ptr ep) {
+                          log_->error(
+                              "something bad happened during block "
+                              "streaming, client_id {}",
+                              client_id);
+                          if (auto stream = weak_stream.lock()) {
+                            stream->finish(grpc::Status::OK);
+                          }
+                        },
+                        [this, weak_stream, client_id] {
+                          log_->debug("block stream done, {}", client_id);
+                          if (auto stream = weak_stream.lock()) {
+                            stream->finish(grpc::Status::OK);
+                          }
+                        });
               },
-              [this, writer](const auto &error) {
+              [this, &stream](const auto &error) {
                 log_->debug("Stateless invalid: {}", error.error);
                 iroha::protocol::BlockQueryResponse response;
                 response.mutable_block_error_response()->set_message(
                     std::move(error.error));
-                writer->WriteLast(response, grpc::WriteOptions());
+                stream->write(std::move(response));
+                stream->finish(grpc::Status::OK);
               });
-
-      return grpc::Status::OK;
     }
 
   }  // namespace torii
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "torii/impl/status_dispatcher.hpp"
+
+#include <vector>
+
+#include "interfaces/transaction_responses/tx_response.hpp"
+
+namespace iroha {
+  namespace torii {
+
+    StatusDispatcher::Subscription::Subscription(
+        std::weak_ptr<StatusDispatcher> dispatcher,
+        shared_model::crypto::Hash hash,
+        HandlerType handler)
+        : dispatcher_(std::move(dispatcher)),
+          hash_(std::move(hash)),
+          handler_(std::move(handler)) {}
+
+    StatusDispatcher::Subscription::~Subscription() {
+      if (auto dispatcher = dispatcher_.lock()) {
+        dispatcher->unsubscribe(hash_, this);
+      }
+    }
+
+    std::shared_ptr<StatusDispatcher::Subscription>
+    StatusDispatcher::subscribe(const shared_model::crypto::Hash &hash,
+                                HandlerType handler) {
+      // constructor is private, so make_shared is not applicable
+      std::shared_ptr<Subscription> subscription(
+          new Subscription(shared_from_this(), hash, std::move(handler)));
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      subscriptions_.emplace(
+          hash, SubscriptionEntry{subscription.get(), subscription});
+      return subscription;
+    }
+
+    void StatusDispatcher::dispatch(const ResponsePtrType &response) {
+      std::vector<std::shared_ptr<Subscription>> subscriptions;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto range = subscriptions_.equal_range(response->transactionHash());
+        for (auto it = range.first; it != range.second; ++it) {
+          if (auto subscription = it->second.subscription.lock()) {
+            subscriptions.push_back(std::move(subscription));
+          }
+        }
+      }
+      // handlers are invoked without the lock, since the last reference to a
+      // subscription can be released there
+      for (const auto &subscription : subscriptions) {
+        subscription->handler_(response);
+      }
+    }
+
+    void StatusDispatcher::notifyRound() {
+      std::vector<std::shared_ptr<Subscription>> subscriptions;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscriptions.reserve(subscriptions_.size());
+        for (const auto &entry : subscriptions_) {
+          if (auto subscription = entry.second.subscription.lock()) {
+            subscriptions.push_back(std::move(subscription));
+          }
+        }
+      }
+      for (const auto &subscription : subscriptions) {
+        subscription->handler_(nullptr);
+      }
+    }
+
+    size_t StatusDispatcher::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return subscriptions_.size();
+    }
+
+    void StatusDispatcher::unsubscribe(const shared_model::crypto::Hash &hash,
+                                       const Subscription *subscription) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto range = subscriptions_.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.address == subscription) {
+          subscriptions_.erase(it);
+          return;
+        }
+      }
+    }
+
+  }  // namespace torii
+}  // namespace iroha
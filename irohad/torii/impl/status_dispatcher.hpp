@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TORII_STATUS_DISPATCHER_HPP
+#define TORII_STATUS_DISPATCHER_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "cryptography/hash.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class TransactionResponse;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace torii {
+
+    /**
+     * Delivers transaction statuses to the subscribers of the transaction
+     * hash, so that a status is handled only by the streams which requested
+     * it. The dispatcher does not queue statuses: handlers are invoked
+     * synchronously and must not block, so subscribers, which cannot handle
+     * a status at once, buffer it themselves with their own bound, as the
+     * asynchronous status streams do
+     */
+    class StatusDispatcher
+        : public std::enable_shared_from_this<StatusDispatcher> {
+     public:
+      using ResponsePtrType =
+          std::shared_ptr<shared_model::interface::TransactionResponse>;
+      /// receives a status of the transaction, or nullptr after a round
+      using HandlerType = std::function<void(const ResponsePtrType &)>;
+
+      /**
+       * Statuses of a single transaction, which are waited by a single client.
+       * Subscription is removed from the dispatcher on destruction
+       */
+      class Subscription {
+       public:
+        Subscription(const Subscription &) = delete;
+        Subscription &operator=(const Subscription &) = delete;
+
+        ~Subscription();
+
+       private:
+        friend class StatusDispatcher;
+
+        Subscription(std::weak_ptr<StatusDispatcher> dispatcher,
+                     shared_model::crypto::Hash hash,
+                     HandlerType handler);
+
+        std::weak_ptr<StatusDispatcher> dispatcher_;
+        const shared_model::crypto::Hash hash_;
+        const HandlerType handler_;
+      };
+
+      /**
+       * Subscribe to statuses of the transaction
+       * @param hash - hash of the transaction
+       * @param handler - invoked from the thread, which dispatches a status
+       * or notifies about a round, without locks of the dispatcher held
+       * @return subscription, which receives statuses until it is destroyed
+       */
+      std::shared_ptr<Subscription> subscribe(
+          const shared_model::crypto::Hash &hash, HandlerType handler);
+
+      /**
+       * Deliver the status to the subscribers of its transaction
+       */
+      void dispatch(const ResponsePtrType &response);
+
+      /**
+       * Notify all the subscribers that a round has passed
+       */
+      void notifyRound();
+
+      /**
+       * @return number of active subscriptions
+       */
+      size_t size() const;
+
+     private:
+      /**
+       * Subscription, and its address to find it when the subscription is
+       * being destroyed and cannot be locked
+       */
+      struct SubscriptionEntry {
+        const Subscription *address;
+        std::weak_ptr<Subscription> subscription;
+      };
+
+      /**
+       * Remove the subscription of the transaction
+       */
+      void unsubscribe(const shared_model::crypto::Hash &hash,
+                       const Subscription *subscription);
+
+      std::unordered_multimap<shared_model::crypto::Hash,
+                              SubscriptionEntry,
+                              shared_model::crypto::Hash::Hasher>
+          subscriptions_;
+      mutable std::mutex mutex_;
+    };
+
+  }  // namespace torii
+}  // namespace iroha
+
+#endif  // TORII_STATUS_DISPATCHER_HPP
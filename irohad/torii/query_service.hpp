@@ -16,6 +16,7 @@
 #include "builders/protobuf/transport_builder.hpp"
 #include "cache/cache.hpp"
 #include "logger/logger_fwd.hpp"
+#include "network/impl/async_grpc_server.hpp"
 #include "torii/processor/query_processor.hpp"
 
 namespace shared_model {
@@ -30,9 +31,13 @@ namespace iroha {
     /**
      * Actual implementation of async QueryService.
      * ToriiServiceHandler::(SomeMethod)Handler calls a corresponding method in
-     * this class.
+     * this class. FetchCommits is handled asynchronously, so that long-lived
+     * block streams do not occupy server threads.
      */
-    class QueryService : public iroha::protocol::QueryService_v1::Service {
+    class QueryService
+        : public iroha::protocol::QueryService_v1::WithAsyncMethod_FetchCommits<
+              iroha::protocol::QueryService_v1::Service>,
+          public network::AsyncGrpcService {
      public:
       using QueryFactoryType =
           shared_model::interface::AbstractTransportFactory<
@@ -59,13 +64,34 @@ namespace iroha {
                         const iroha::protocol::Query *request,
                         iroha::protocol::QueryResponse *response) override;
 
-      grpc::Status FetchCommits(
-          grpc::ServerContext *context,
-          const iroha::protocol::BlocksQuery *request,
-          grpc::ServerWriter<::iroha::protocol::BlockQueryResponse> *writer)
-          override;
+      /**
+       * Start accepting FetchCommits calls. Each stream sends blocks committed
+       * after the request, until the client disconnects. A client, which
+       * falls behind by more than kMaxQueuedBlocks blocks, gets its stream
+       * finished with RESOURCE_EXHAUSTED status, since blocks cannot be
+       * skipped
+       * @param queue - completion queue of the server
+       */
+      void requestCalls(network::AsyncCallQueue &queue) override;
+
+      /// number of blocks queued for a stream, which has not sent them yet
+      static constexpr size_t kMaxQueuedBlocks = 32;
 
      private:
+      using BlocksStreamType =
+          network::AsyncServerStream<iroha::protocol::BlocksQuery,
+                                     iroha::protocol::BlockQueryResponse>;
+
+      /**
+       * Wait for the next FetchCommits call
+       */
+      void requestFetchCommits(network::AsyncCallQueue &queue);
+
+      /**
+       * Send committed blocks to the stream
+       */
+      void startFetchCommits(std::shared_ptr<BlocksStreamType> stream);
+
       std::shared_ptr<iroha::torii::QueryProcessor> query_processor_;
       std::shared_ptr<QueryFactoryType> query_factory_;
 
@@ -21,17 +21,17 @@ namespace iroha {
   namespace validation {
 
     /**
-     * Complements initial transaction check with command-by-command check
-     * @param temporary_wsv to apply commands on
+     * Write the error of transaction application to the log
+     * @param result of application of the transaction
      * @param transactions_errors_log to write errors to
-     * @param tx to be checked
-     * @return empty result, if check is successful, command error otherwise
+     * @param tx which was applied
+     * @return true, if the transaction was applied successfully
      */
-    static bool checkTransactions(
-        ametsuchi::TemporaryWsv &temporary_wsv,
+    static bool logResult(
+        expected::Result<void, validation::CommandError> result,
         validation::TransactionsErrors &transactions_errors_log,
         const shared_model::interface::Transaction &tx) {
-      return temporary_wsv.apply(tx).match(
+      return result.match(
           [](expected::Value<void> &) { return true; },
           [&tx, &transactions_errors_log](
               expected::Error<validation::CommandError> &error) {
@@ -39,7 +39,21 @@ namespace iroha {
                 tx.hash(), std::move(error.error)});
             return false;
           });
-    };
+    }
+
+    /**
+     * Complements initial transaction check with command-by-command check
+     * @param temporary_wsv to apply commands on
+     * @param transactions_errors_log to write errors to
+     * @param tx to be checked
+     * @return empty result, if check is successful, command error otherwise
+     */
+    static bool checkTransactions(
+        ametsuchi::TemporaryWsv &temporary_wsv,
+        validation::TransactionsErrors &transactions_errors_log,
+        const shared_model::interface::Transaction &tx) {
+      return logResult(temporary_wsv.apply(tx), transactions_errors_log, tx);
+    }
 
     /**
      * Validate all transactions supplied; includes special rules, such as batch
@@ -58,6 +72,19 @@ namespace iroha {
       std::vector<bool> validation_results;
       validation_results.reserve(boost::size(txs));
 
+      // transactions of consecutive non-atomic batches are accepted or
+      // rejected one by one, so the temporary wsv may apply them together
+      ametsuchi::TemporaryWsv::TransactionRefs pending;
+      auto apply_pending = [&] {
+        auto results = temporary_wsv.applyTransactions(pending);
+        for (size_t i = 0; i < pending.size(); ++i) {
+          validation_results.push_back(logResult(std::move(results[i]),
+                                                 transactions_errors_log,
+                                                 pending[i].get()));
+        }
+        pending.clear();
+      };
+
       for (auto batch : batch_parser.parseBatches(txs)) {
         auto validation = [&](auto &tx) {
           return checkTransactions(temporary_wsv, transactions_errors_log, tx);
@@ -65,6 +92,7 @@ namespace iroha {
         if (batch.front().batchMeta()
             and batch.front().batchMeta()->get()->type()
                 == shared_model::interface::types::BatchType::ATOMIC) {
+          apply_pending();
           // check all batch's transactions for validness
           auto savepoint = temporary_wsv.createSavepoint(
               "batch_" + batch.front().hash().hex());
@@ -97,10 +125,11 @@ namespace iroha {
               validation_results.end(), boost::size(batch), validation_result);
         } else {
           for (const auto &tx : batch) {
-            validation_results.push_back(validation(tx));
+            pending.push_back(std::cref(tx));
           }
         }
       }
+      apply_pending();
 
       return txs | boost::adaptors::indexed()
           | boost::adaptors::filtered(
@@ -6,15 +6,28 @@
 #ifndef IROHA_CACHE_HPP
 #define IROHA_CACHE_HPP
 
-#include "cache/abstract_cache.hpp"
-
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <stdexcept>
 #include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 namespace iroha {
   namespace cache {
 
     /**
-     * Cache for arbitrary types
+     * Thread-safe cache for arbitrary types with least recently used
+     * eviction. Items are distributed among shards by the hash of the key,
+     * each shard is guarded by its own lock and evicts its own least recently
+     * used items, so concurrent accesses of different keys rarely contend.
+     * Capacity is limited by the number of items, and optionally by their
+     * estimated size in bytes.
      * @tparam KeyType type of key objects
      * @tparam ValueType type of value objects
      * @tparam KeyHash hasher for keys
@@ -22,60 +35,241 @@ namespace iroha {
     template <typename KeyType,
               typename ValueType,
               typename KeyHash = std::hash<KeyType>>
-    class Cache : public AbstractCache<KeyType,
-                                       ValueType,
-                                       Cache<KeyType, ValueType, KeyHash>> {
+    class Cache {
      public:
-      Cache(uint32_t max_handler_map_size_high = 20000,
-            uint32_t max_handler_map_size_low = 10000)
-          : max_handler_map_size_high_(max_handler_map_size_high),
-            max_handler_map_size_low_(max_handler_map_size_low) {}
+      /// estimates memory occupied by the item in bytes
+      using ItemSizeType =
+          std::function<size_t(const KeyType &, const ValueType &)>;
+
+      /// counters of the cache accesses, and its current occupancy
+      struct Statistics {
+        size_t items;
+        size_t bytes;
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+      };
+
+      static constexpr size_t kDefaultMaxItems = 20000;
+      static constexpr size_t kUnlimitedBytes =
+          std::numeric_limits<size_t>::max();
+      static constexpr size_t kDefaultShards = 16;
+
+      /// capacity and layout of the cache
+      struct Options {
+        /// maximum number of items in the cache
+        size_t max_items = kDefaultMaxItems;
+        /// number of independently locked parts of the cache. Reduced to
+        /// max_items if it is greater, so that each shard can hold at least
+        /// one item
+        size_t shards = kDefaultShards;
+        /// maximum total size of items in the cache
+        size_t max_bytes = kUnlimitedBytes;
+        /// size estimation of an item. Required if max_bytes is limited,
+        /// since only the caller knows the memory owned by the key and value
+        /// objects, for example by pointers in them. Otherwise, if it is not
+        /// set, sizes of items are not tracked
+        ItemSizeType item_size;
+      };
+
+      /**
+       * @param max_items - maximum number of items in the cache
+       */
+      explicit Cache(size_t max_items = kDefaultMaxItems)
+          : Cache(makeOptions(max_items)) {}
+
+      /**
+       * @param options - capacity and layout of the cache
+       * @throws std::invalid_argument if max_bytes is limited without
+       * item_size
+       */
+      explicit Cache(Options options)
+          : max_items_(options.max_items),
+            max_bytes_(options.max_bytes),
+            item_size_(std::move(options.item_size)),
+            shards_(std::max<size_t>(
+                1, std::min(options.shards, options.max_items))) {
+        if (max_bytes_ != kUnlimitedBytes and not item_size_) {
+          throw std::invalid_argument(
+              "Cache size in bytes is limited without item size function");
+        }
+        // capacity is split evenly, the remainder goes to the first shards
+        for (size_t i = 0; i < shards_.size(); ++i) {
+          shards_[i].max_items = splitCapacity(max_items_, i);
+          shards_[i].max_bytes = max_bytes_ == kUnlimitedBytes
+              ? kUnlimitedBytes
+              : splitCapacity(max_bytes_, i);
+        }
+      }
+
+      Cache(const Cache &) = delete;
+      Cache &operator=(const Cache &) = delete;
 
-      uint32_t getIndexSizeHighImpl() const {
-        return max_handler_map_size_high_;
+      /**
+       * @return maximum number of items in the cache
+       */
+      size_t getMaxItemCount() const {
+        return max_items_;
       }
 
-      uint32_t getIndexSizeLowImpl() const {
-        return max_handler_map_size_low_;
+      /**
+       * @return maximum total size of items in the cache
+       */
+      size_t getMaxByteSize() const {
+        return max_bytes_;
       }
 
-      uint32_t getCacheItemCountImpl() const {
-        return (uint32_t)handler_map_.size();
+      /**
+       * @return amount of items in cache
+       */
+      size_t getCacheItemCount() const {
+        size_t count = 0;
+        for (auto &shard : shards_) {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          count += shard.index.size();
+        }
+        return count;
       }
 
-      void addItemImpl(const KeyType &key, const ValueType &value) {
-        // elements with the same hash should be replaced
-        handler_map_[key] = value;
-        handler_map_index_.push_back(key);
-        if (handler_map_.size() > getIndexSizeHighImpl()) {
-          while (handler_map_.size() > getIndexSizeLowImpl()) {
-            handler_map_.erase(handler_map_index_.front());
-            handler_map_index_.pop_front();
-          }
+      /**
+       * @return counters of the cache, summed over all shards
+       */
+      Statistics getStatistics() const {
+        Statistics statistics{0, 0, 0, 0, 0};
+        for (auto &shard : shards_) {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          statistics.items += shard.index.size();
+          statistics.bytes += shard.bytes;
+          statistics.hits += shard.hits;
+          statistics.misses += shard.misses;
+          statistics.evictions += shard.evictions;
         }
+        return statistics;
       }
 
-      boost::optional<ValueType> findItemImpl(const KeyType &key) const {
-        auto found = handler_map_.find(key);
-        if (found == handler_map_.end()) {
-          return boost::none;
+      /**
+       * Adds new item to cache, or replaces the value of the existing one.
+       * The item becomes the most recently used one, and the least recently
+       * used items of its shard are evicted until the shard fits its
+       * capacity. An item, which alone exceeds the capacity, is not cached.
+       * Note: cache does not have a remove method, deletion performs
+       * automatically.
+       * @param key - key to insert
+       * @param value - value to insert
+       */
+      void addItem(const KeyType &key, const ValueType &value) {
+        const auto size = item_size_ ? item_size_(key, value) : 0;
+        auto &shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+          auto item = found->second;
+          shard.bytes -= item->size;
+          item->value = value;
+          item->size = size;
+          shard.bytes += size;
+          shard.items.splice(shard.items.begin(), shard.items, item);
         } else {
-          return handler_map_.at(key);
+          shard.items.push_front(Item{key, value, size});
+          shard.index.emplace(key, shard.items.begin());
+          shard.bytes += size;
+        }
+
+        while (not shard.items.empty()
+               and (shard.items.size() > shard.max_items
+                    or shard.bytes > shard.max_bytes)) {
+          shard.bytes -= shard.items.back().size;
+          shard.index.erase(shard.items.back().key);
+          shard.items.pop_back();
+          ++shard.evictions;
         }
       }
 
+      /**
+       * Performs a search for an item with a specific key. The found item
+       * becomes the most recently used one.
+       * @param key - key to find
+       * @return Optional of ValueType
+       */
+      boost::optional<ValueType> findItem(const KeyType &key) const {
+        auto &shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+          ++shard.misses;
+          return boost::none;
+        }
+        ++shard.hits;
+        shard.items.splice(shard.items.begin(), shard.items, found->second);
+        return found->second->value;
+      }
+
      private:
-      std::unordered_map<KeyType, ValueType, KeyHash> handler_map_;
-      std::list<KeyType> handler_map_index_;
+      struct Item {
+        KeyType key;
+        ValueType value;
+        size_t size;
+      };
+
+      using ItemListType = std::list<Item>;
 
       /**
-       * Protection from handler map overflow.
-       * TODO 27/10/2017 luckychess Values are quite random and should be tuned
-       * for better performance and may be even move to config IR-579
+       * Independently locked part of the cache. Items are ordered from the
+       * most recently used to the least recently used one
        */
-      const uint32_t max_handler_map_size_high_;
-      const uint32_t max_handler_map_size_low_;
+      struct Shard {
+        std::mutex mutex;
+        ItemListType items;
+        std::unordered_map<KeyType, typename ItemListType::iterator, KeyHash>
+            index;
+        size_t bytes = 0;
+        size_t max_items = 0;
+        size_t max_bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+      };
+
+      static Options makeOptions(size_t max_items) {
+        Options options;
+        options.max_items = max_items;
+        return options;
+      }
+
+      /**
+       * @return part of the capacity, which belongs to the shard
+       */
+      size_t splitCapacity(size_t capacity, size_t shard) const {
+        return capacity / shards_.size()
+            + (shard < capacity % shards_.size() ? 1 : 0);
+      }
+
+      Shard &getShard(const KeyType &key) const {
+        // hashes are mixed, since low bits of some hashers are poorly
+        // distributed
+        uint64_t hash = KeyHash{}(key);
+        hash *= 0x9E3779B97F4A7C15ull;
+        return shards_[(hash >> 32) % shards_.size()];
+      }
+
+      const size_t max_items_;
+      const size_t max_bytes_;
+      const ItemSizeType item_size_;
+      // shards are modified on lookups to keep the order of use
+      mutable std::vector<Shard> shards_;
     };
+
+    template <typename KeyType, typename ValueType, typename KeyHash>
+    constexpr size_t Cache<KeyType, ValueType, KeyHash>::kDefaultMaxItems;
+
+    template <typename KeyType, typename ValueType, typename KeyHash>
+    constexpr size_t Cache<KeyType, ValueType, KeyHash>::kUnlimitedBytes;
+
+    template <typename KeyType, typename ValueType, typename KeyHash>
+    constexpr size_t Cache<KeyType, ValueType, KeyHash>::kDefaultShards;
+
   }  // namespace cache
 }  // namespace iroha
 
@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BOUNDED_QUEUE_HPP
+#define IROHA_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <boost/optional.hpp>
+
+namespace iroha {
+
+  /**
+   * FIFO queue of limited capacity for passing items between threads.
+   * Producers wait while the queue is full, and consumers wait while it is
+   * empty, so the memory used by a pipeline stays bounded.
+   * After the queue is closed, items can no longer be pushed, and remaining
+   * items can still be popped.
+   * @tparam T - type of items
+   */
+  template <typename T>
+  class BoundedQueue {
+   public:
+    /**
+     * @param capacity - maximum number of items in the queue, at least 1
+     */
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    /**
+     * Add an item to the queue, waiting for a free slot
+     * @param item - item to add
+     * @return false if the queue has been closed, true otherwise
+     */
+    bool push(T item) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock,
+                     [this] { return closed_ or items_.size() < capacity_; });
+      if (closed_) {
+        return false;
+      }
+      items_.push_back(std::move(item));
+      not_empty_.notify_one();
+      return true;
+    }
+
+    /**
+     * Take the oldest item from the queue, waiting for one to appear
+     * @return the item, or boost::none if the queue is closed and empty
+     */
+    boost::optional<T> pop() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return closed_ or not items_.empty(); });
+      if (items_.empty()) {
+        return boost::none;
+      }
+      boost::optional<T> item(std::move(items_.front()));
+      items_.pop_front();
+      not_full_.notify_one();
+      return item;
+    }
+
+    /**
+     * Stop accepting new items and wake up all waiting threads
+     */
+    void close() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      not_full_.notify_all();
+      not_empty_.notify_all();
+    }
+
+   private:
+    const size_t capacity_;
+    std::deque<T> items_;
+    bool closed_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_BOUNDED_QUEUE_HPP
@@ -0,0 +1,39 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+
+#include <limits>
+
+#include "backend/protobuf/block.hpp"
+
+using namespace shared_model;
+using namespace shared_model::proto;
+
+iroha::expected::Result<std::string, std::string>
+ProtoBlockBinaryConverter::serialize(const interface::Block &block) const
+    noexcept {
+  const auto &proto_block_v1 = static_cast<const Block &>(block).getTransport();
+  iroha::protocol::Block proto_block;
+  *proto_block.mutable_block_v1() = proto_block_v1;
+  std::string result;
+  if (not proto_block.SerializeToString(&result)) {
+    return iroha::expected::makeError("Failed to serialize block");
+  }
+  return iroha::expected::makeValue(std::move(result));
+}
+
+iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+ProtoBlockBinaryConverter::deserialize(const uint8_t *data, size_t size) const
+    noexcept {
+  iroha::protocol::Block block;
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max())
+      or not block.ParseFromArray(data, static_cast<int>(size))) {
+    return iroha::expected::makeError("Failed to parse block");
+  }
+  std::unique_ptr<interface::Block> result =
+      std::make_unique<Block>(std::move(*block.mutable_block_v1()));
+  return iroha::expected::makeValue(std::move(result));
+}
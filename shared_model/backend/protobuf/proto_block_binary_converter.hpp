@@ -0,0 +1,30 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
+#define IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
+
+#include "interfaces/iroha_internal/block_binary_converter.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+  }
+
+  namespace proto {
+    class ProtoBlockBinaryConverter : public interface::BlockBinaryConverter {
+     public:
+      iroha::expected::Result<std::string, std::string> serialize(
+          const interface::Block &block) const noexcept override;
+
+      using interface::BlockBinaryDeserializer::deserialize;
+
+      iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+      deserialize(const uint8_t *data, size_t size) const noexcept override;
+    };
+  }  // namespace proto
+}  // namespace shared_model
+
+#endif  // IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
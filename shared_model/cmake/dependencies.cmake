@@ -43,6 +43,19 @@ set_target_properties(boost PROPERTIES
 ###################################
 find_package(ed25519)
 
+##########################
+#          TBB           #
+##########################
+if (MSVC)
+  find_package(TBB REQUIRED CONFIG)
+  add_library(tbb INTERFACE IMPORTED)
+  target_link_libraries(tbb INTERFACE
+      TBB::tbb
+      )
+else ()
+  find_package(tbb)
+endif()
+
 ##########################
 #         gtest          #
 ##########################
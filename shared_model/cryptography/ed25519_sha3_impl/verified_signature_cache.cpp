@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cryptography/ed25519_sha3_impl/verified_signature_cache.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace shared_model {
+  namespace crypto {
+
+    VerifiedSignatureCache::VerifiedSignatureCache(size_t capacity)
+        : shard_capacity_(std::max<size_t>(capacity / kShards, 1)) {}
+
+    namespace {
+      /**
+       * Append the part of a key prefixed with its length, so that bytes
+       * cannot be moved between adjacent parts without changing the key
+       */
+      void appendKeyPart(std::string &key, const std::string &part) {
+        const auto size = static_cast<uint32_t>(part.size());
+        for (size_t i = 0; i < sizeof(size); ++i) {
+          key.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+        }
+        key.append(part);
+      }
+    }  // namespace
+
+    std::string VerifiedSignatureCache::makeKey(const std::string &hash,
+                                                const std::string &public_key,
+                                                const std::string &signature) {
+      std::string key;
+      key.reserve(3 * sizeof(uint32_t) + hash.size() + public_key.size()
+                  + signature.size());
+      appendKeyPart(key, hash);
+      appendKeyPart(key, public_key);
+      appendKeyPart(key, signature);
+      return key;
+    }
+
+    bool VerifiedSignatureCache::contains(const std::string &key) const {
+      auto &s = shard(key);
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto found = s.keys.find(key);
+      if (found == s.keys.end()) {
+        return false;
+      }
+      s.order.splice(s.order.begin(), s.order, found->second);
+      return true;
+    }
+
+    void VerifiedSignatureCache::insert(std::string key) {
+      auto &s = shard(key);
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto inserted = s.keys.emplace(std::move(key), s.order.end());
+      if (not inserted.second) {
+        s.order.splice(s.order.begin(), s.order, inserted.first->second);
+        return;
+      }
+      s.order.push_front(&inserted.first->first);
+      inserted.first->second = s.order.begin();
+      if (s.order.size() > shard_capacity_) {
+        // the key is erased by iterator, since the element referenced by the
+        // back of the list is destroyed by the erasure
+        s.keys.erase(s.keys.find(*s.order.back()));
+        s.order.pop_back();
+      }
+    }
+
+    VerifiedSignatureCache::Shard &VerifiedSignatureCache::shard(
+        const std::string &key) const {
+      return shards_[std::hash<std::string>{}(key) % kShards];
+    }
+
+  }  // namespace crypto
+}  // namespace shared_model
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SHARED_MODEL_VERIFIED_SIGNATURE_CACHE_HPP
+#define IROHA_SHARED_MODEL_VERIFIED_SIGNATURE_CACHE_HPP
+
+#include <array>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace shared_model {
+  namespace crypto {
+
+    /**
+     * Bounded thread-safe set of signatures which have been verified
+     * successfully. An entry is made of the length-prefixed hash of signed
+     * data, public key and signature, so a signature is only found for
+     * exactly the same data and key. Entries are split between independently
+     * locked shards, and the least recently used entries of a shard are
+     * evicted when it is full.
+     */
+    class VerifiedSignatureCache {
+     public:
+      /// Number of entries kept by default
+      static const size_t kDefaultCapacity = 1 << 15;
+
+      explicit VerifiedSignatureCache(size_t capacity = kDefaultCapacity);
+
+      /**
+       * Make an entry of the cache
+       * @param hash - hash of the signed data
+       * @param public_key - binary public key
+       * @param signature - binary signature
+       * @return cache entry
+       */
+      static std::string makeKey(const std::string &hash,
+                                 const std::string &public_key,
+                                 const std::string &signature);
+
+      /**
+       * @return true if the signature was added to the cache and has not
+       * been evicted yet. The found entry becomes the most recently used one
+       */
+      bool contains(const std::string &key) const;
+
+      /**
+       * Add a successfully verified signature
+       */
+      void insert(std::string key);
+
+     private:
+      struct Shard {
+        using OrderType = std::list<const std::string *>;
+
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, OrderType::iterator> keys;
+        /// most recently used entries first, references to map keys stay
+        /// valid on rehash
+        OrderType order;
+      };
+
+      static const size_t kShards = 16;
+
+      Shard &shard(const std::string &key) const;
+
+      const size_t shard_capacity_;
+      mutable std::array<Shard, kShards> shards_;
+    };
+
+  }  // namespace crypto
+}  // namespace shared_model
+
+#endif  // IROHA_SHARED_MODEL_VERIFIED_SIGNATURE_CACHE_HPP
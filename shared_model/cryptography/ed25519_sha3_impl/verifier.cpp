@@ -6,16 +6,40 @@
 #include "verifier.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/ed25519_impl.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+#include "cryptography/ed25519_sha3_impl/verified_signature_cache.hpp"
 
 namespace shared_model {
   namespace crypto {
+    namespace {
+      /// signatures verified by this process
+      VerifiedSignatureCache &verifiedSignatures() {
+        static VerifiedSignatureCache cache;
+        return cache;
+      }
+    }  // namespace
+
     bool Verifier::verify(const Signed &signedData,
                           const Blob &orig,
                           const PublicKey &publicKey) {
-      return iroha::verify(
-          iroha::sha3_256(crypto::toBinaryString(orig)).to_string(),
-          iroha::pubkey_t::from_string(toBinaryString(publicKey)),
-          iroha::sig_t::from_string(toBinaryString(signedData)));
+      // the same signature is checked on each stage a transaction passes
+      // through, so successful verifications are remembered
+      auto hash = iroha::sha3_256(crypto::toBinaryString(orig)).to_string();
+      auto public_key = toBinaryString(publicKey);
+      auto signature = toBinaryString(signedData);
+      // sizes are checked before the lookup, so that a malformed key or
+      // signature is never accepted from the cache
+      auto pubkey = iroha::pubkey_t::from_string(public_key);
+      auto sig = iroha::sig_t::from_string(signature);
+      auto key = VerifiedSignatureCache::makeKey(hash, public_key, signature);
+      if (verifiedSignatures().contains(key)) {
+        return true;
+      }
+
+      auto verified = iroha::verify(hash, pubkey, sig);
+      if (verified) {
+        verifiedSignatures().insert(std::move(key));
+      }
+      return verified;
     }
   }  // namespace crypto
 }  // namespace shared_model
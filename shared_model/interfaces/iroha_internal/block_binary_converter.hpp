@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_BINARY_CONVERTER_HPP
+#define IROHA_BLOCK_BINARY_CONVERTER_HPP
+
+#include "interfaces/iroha_internal/block_binary_deserializer.hpp"
+#include "interfaces/iroha_internal/block_binary_serializer.hpp"
+
+namespace shared_model {
+  namespace interface {
+
+    /**
+     * Block binary converter is a class which can convert blocks to/from
+     * their binary representation
+     */
+    class BlockBinaryConverter : public BlockBinarySerializer,
+                                 public BlockBinaryDeserializer {
+     public:
+      ~BlockBinaryConverter() override = default;
+    };
+  }  // namespace interface
+}  // namespace shared_model
+
+#endif  // IROHA_BLOCK_BINARY_CONVERTER_HPP
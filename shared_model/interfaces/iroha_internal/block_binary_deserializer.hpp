@@ -0,0 +1,50 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_BINARY_DESERIALIZER_HPP
+#define IROHA_BLOCK_BINARY_DESERIALIZER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/result.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+    /**
+     * BlockBinaryDeserializer is an interface which allows transforming binary
+     * representation of a block to block objects.
+     */
+    class BlockBinaryDeserializer {
+     public:
+      /**
+       * Try to parse binary data into a block object. The data is only read
+       * during the call, so it may point to a memory mapped storage
+       * @param data - pointer to serialized block
+       * @param size - size of serialized block
+       * @return pointer to a block if data was valid or an error
+       */
+      virtual iroha::expected::Result<std::unique_ptr<Block>, std::string>
+      deserialize(const uint8_t *data, size_t size) const = 0;
+
+      /**
+       * Try to parse binary string into a block object
+       * @param blob - serialized block
+       * @return pointer to a block if blob was valid or an error
+       */
+      iroha::expected::Result<std::unique_ptr<Block>, std::string> deserialize(
+          const std::string &blob) const {
+        return deserialize(reinterpret_cast<const uint8_t *>(blob.data()),
+                           blob.size());
+      }
+
+      virtual ~BlockBinaryDeserializer() = default;
+    };
+  }  // namespace interface
+}  // namespace shared_model
+
+#endif  // IROHA_BLOCK_BINARY_DESERIALIZER_HPP
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_BINARY_SERIALIZER_HPP
+#define IROHA_BLOCK_BINARY_SERIALIZER_HPP
+
+#include <memory>
+#include <string>
+
+#include "common/result.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+    /**
+     * BlockBinarySerializer is an interface which allows transforming block
+     * objects to their binary wire representation
+     */
+    class BlockBinarySerializer {
+     public:
+      /**
+       * Try to transform block to binary string
+       * @param block - block to be serialized
+       * @return serialized block or an error
+       */
+      virtual iroha::expected::Result<std::string, std::string> serialize(
+          const Block &block) const = 0;
+
+      virtual ~BlockBinarySerializer() = default;
+    };
+  }  // namespace interface
+}  // namespace shared_model
+
+#endif  // IROHA_BLOCK_BINARY_SERIALIZER_HPP
@@ -7,6 +7,8 @@
 
 #include <unordered_map>
 
+#include <tbb/parallel_for.h>
+
 #include "interfaces/iroha_internal/batch_meta.hpp"
 #include "interfaces/iroha_internal/transaction_batch_factory_impl.hpp"
 #include "interfaces/iroha_internal/transaction_batch_helpers.hpp"
@@ -44,24 +46,31 @@ namespace shared_model {
             "Transaction collection error",
             std::vector<std::string>{"sequence can not be empty"}));
       }
-      for (const auto &tx : transactions) {
-        // perform stateless validation checks
-        validation::ReasonsGroupType reason;
+      // perform stateless validation checks of the transactions in parallel
+      std::vector<validation::ReasonsGroupType> reasons(transactions.size());
+      tbb::parallel_for(size_t{0}, transactions.size(), [&](size_t i) {
+        const auto &tx = transactions[i];
+        auto &reason = reasons[i];
         reason.first = "Transaction: ";
         // check signatures validness
         if (not boost::empty(tx->signatures())) {
           field_validator.validateSignatures(
               reason, tx->signatures(), tx->payload());
           if (not reason.second.empty()) {
-            result.addReason(std::move(reason));
-            continue;
+            return;
           }
         }
         // check transaction validness
         auto tx_errors = transaction_validator.validate(*tx);
         if (tx_errors) {
           reason.second.emplace_back(tx_errors.reason());
-          result.addReason(std::move(reason));
+        }
+      });
+
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto &tx = transactions[i];
+        if (not reasons[i].second.empty()) {
+          result.addReason(std::move(reasons[i]));
           continue;
         }
 
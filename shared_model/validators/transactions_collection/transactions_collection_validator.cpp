@@ -6,9 +6,12 @@
 #include "validators/transactions_collection/transactions_collection_validator.hpp"
 
 #include <algorithm>
+#include <functional>
 
 #include <boost/format.hpp>
+#include <boost/optional.hpp>
 #include <boost/range/adaptor/indirected.hpp>
+#include <tbb/parallel_for.h>
 #include "interfaces/common_objects/transaction_sequence_common.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser_impl.hpp"
 #include "validators/default_validator.hpp"
@@ -49,13 +52,23 @@ namespace shared_model {
         return res;
       }
 
-      for (const auto &tx : transactions) {
-        auto answer = std::forward<Validator>(validator)(tx);
+      // transactions are validated independently of each other, so signature
+      // verification, which dominates the validation, is spread over cores
+      std::vector<std::reference_wrapper<const interface::Transaction>> txs(
+          transactions.begin(), transactions.end());
+      std::vector<boost::optional<std::string>> messages(txs.size());
+      tbb::parallel_for(size_t{0}, txs.size(), [&](size_t i) {
+        const interface::Transaction &tx = txs[i];
+        auto answer = validator(tx);
         if (answer.hasErrors()) {
-          auto message =
+          messages[i] =
               (boost::format("Tx %s : %s") % tx.hash().hex() % answer.reason())
                   .str();
-          reason.second.push_back(message);
+        }
+      });
+      for (auto &message : messages) {
+        if (message) {
+          reason.second.push_back(std::move(*message));
         }
       }
 
@@ -15,7 +15,7 @@
 #include "ametsuchi/impl/in_memory_block_storage_factory.hpp"
 #include "ametsuchi/impl/storage_impl.hpp"
 #include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
-#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
 #include "backend/protobuf/proto_permission_to_string.hpp"
 #include "common/files.hpp"
 #include "framework/config_helper.hpp"
@@ -42,7 +42,7 @@ namespace iroha {
         perm_converter_ =
             std::make_shared<shared_model::proto::ProtoPermissionToString>();
         auto converter =
-            std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+            std::make_shared<shared_model::proto::ProtoBlockBinaryConverter>();
         auto block_storage_factory =
             std::make_unique<InMemoryBlockStorageFactory>();
         StorageImpl::create(block_store_path,
@@ -162,10 +162,14 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
     permission_id character varying(45),
     PRIMARY KEY (permittee_account_id, account_id, permission_id)
 );
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash varchar PRIMARY KEY,
+    height bigint NOT NULL
+);
 CREATE TABLE IF NOT EXISTS position_by_hash (
     hash varchar,
-    height text,
-    index text
+    height bigint,
+    index bigint
 );
 
 CREATE TABLE IF NOT EXISTS tx_status_by_hash (
@@ -176,13 +180,19 @@ CREATE INDEX IF NOT EXISTS tx_status_by_hash_hash_index ON tx_status_by_hash USI
 
 CREATE TABLE IF NOT EXISTS height_by_account_set (
     account_id text,
-    height text
+    height bigint
 );
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
     creator_id text,
-    height text,
-    index text
+    height bigint,
+    index bigint
+);
+CREATE TABLE IF NOT EXISTS position_by_account_asset (
+    account_id text,
+    asset_id text,
+    height bigint,
+    index bigint
 );
 CREATE TABLE IF NOT EXISTS index_by_id_height_asset (
     id text,
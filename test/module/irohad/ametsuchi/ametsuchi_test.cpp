@@ -470,6 +470,139 @@ TEST_F(AmetsuchiTest, TestRestoreWSV) {
   EXPECT_TRUE(res);
 }
 
+/**
+ * Create a block with a transaction, which creates a domain
+ * @param domain to create
+ * @param height of the block
+ * @param prev_hash of the block
+ * @return created block
+ */
+std::shared_ptr<const shared_model::interface::Block> createDomainBlock(
+    const std::string &domain,
+    shared_model::interface::types::HeightType height,
+    const shared_model::crypto::Hash &prev_hash) {
+  std::vector<shared_model::proto::Transaction> txs;
+  txs.push_back(TestTransactionBuilder()
+                    .creatorAccountId("admin@test")
+                    .createRole(domain + "role", {Role::kCreateDomain})
+                    .createDomain(domain, domain + "role")
+                    .build());
+  return createBlock(txs, height, prev_hash);
+}
+
+/**
+ * @given storage with 2 blocks and WSV snapshot taken after the first one
+ * @when WSV is spoiled and restored
+ * @then WSV contains the effects of both blocks
+ */
+TEST_F(AmetsuchiTest, TestRestoreWsvFromSnapshot) {
+  auto block1 = createDomainBlock("first", 1, fake_hash);
+  apply(storage, block1);
+  storage->createWsvSnapshot().match(
+      [](const iroha::expected::Value<
+          shared_model::interface::types::HeightType> &height) {
+        ASSERT_EQ(height.value, 1);
+      },
+      [](const iroha::expected::Error<std::string> &error) {
+        FAIL() << error.error;
+      });
+  apply(storage, createDomainBlock("second", 2, block1->hash()));
+
+  *sql << "DELETE FROM domain";
+
+  WsvRestorerImpl wsv_restorer;
+  wsv_restorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV: " << error.error;
+      });
+
+  EXPECT_TRUE(sql_query->getDomain("first"));
+  EXPECT_TRUE(sql_query->getDomain("second"));
+}
+
+/**
+ * @given storage with 3 blocks and no WSV snapshot
+ * @when WSV is spoiled and restored by chunks of 2 blocks
+ * @then WSV contains the effects of all blocks
+ */
+TEST_F(AmetsuchiTest, TestRestoreWsvByChunks) {
+  auto block1 = createDomainBlock("first", 1, fake_hash);
+  auto block2 = createDomainBlock("second", 2, block1->hash());
+  auto block3 = createDomainBlock("third", 3, block2->hash());
+  for (const auto &block : {block1, block2, block3}) {
+    apply(storage, block);
+  }
+
+  *sql << "DELETE FROM domain";
+
+  WsvRestorerImpl wsv_restorer(WsvRestorerImpl::kDefaultSnapshotInterval, 2);
+  wsv_restorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV: " << error.error;
+      });
+
+  EXPECT_TRUE(sql_query->getDomain("first"));
+  EXPECT_TRUE(sql_query->getDomain("second"));
+  EXPECT_TRUE(sql_query->getDomain("third"));
+}
+
+/**
+ * @given storage with a block and WSV snapshot, which was modified after it
+ * had been taken
+ * @when WSV is restored
+ * @then the snapshot is not used @and WSV is restored from the blocks
+ */
+TEST_F(AmetsuchiTest, TestRestoreWsvFromModifiedSnapshot) {
+  apply(storage, createDomainBlock("first", 1, fake_hash));
+  ASSERT_TRUE(framework::expected::val(storage->createWsvSnapshot()));
+
+  *sql << "DELETE FROM wsv_snapshot.domain";
+
+  WsvRestorerImpl wsv_restorer;
+  wsv_restorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV: " << error.error;
+      });
+
+  EXPECT_TRUE(sql_query->getDomain("first"));
+}
+
+/**
+ * @given storage with 2 blocks and WSV snapshot taken after the first one
+ * @when the block index is dropped and WSV is restored
+ * @then transactions of both blocks are found in the block index
+ */
+TEST_F(AmetsuchiTest, TestRestoreWsvRebuildsBlockIndex) {
+  auto block1 = createDomainBlock("first", 1, fake_hash);
+  auto block2 = createDomainBlock("second", 2, block1->hash());
+  apply(storage, block1);
+  ASSERT_TRUE(framework::expected::val(storage->createWsvSnapshot()));
+  apply(storage, block2);
+
+  *sql << "DELETE FROM height_by_block_hash; DELETE FROM tx_status_by_hash";
+
+  WsvRestorerImpl wsv_restorer;
+  wsv_restorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV: " << error.error;
+      });
+
+  auto blocks = storage->getBlockQuery();
+  for (const auto &block : {block1, block2}) {
+    for (const auto &tx : block->transactions()) {
+      auto status = blocks->checkTxPresence(tx.hash());
+      ASSERT_TRUE(status);
+      EXPECT_NO_THROW(
+          boost::get<tx_cache_status_responses::Committed>(*status));
+    }
+  }
+  EXPECT_TRUE(sql_query->getDomain("second"));
+}
+
 /**
  * @given created storage
  *        @and a subscribed observer on on_commit() event
@@ -698,3 +831,112 @@ TEST_F(PreparedBlockTest, TemporaryWsvUnlocks) {
   ASSERT_TRUE(framework::expected::val(result));
   storage->prepareBlock(std::move(temp_wsv));
 }
+
+/**
+ * @given TemporaryWSV with a transaction, which fails on its second command
+ * after the first one is executed, and a successful transaction
+ * @when block is prepared and the prepared state is applied
+ * @then only the successful transaction changes the state of the ledger
+ */
+TEST_F(PreparedBlockTest, PrepareBlockAfterFailedTransaction) {
+  auto failed_tx = shared_model::proto::TransactionBuilder()
+                       .creatorAccountId("admin@test")
+                       .createdTime(iroha::time::now())
+                       .quorum(1)
+                       .addAssetQuantity("coin#test", "5.00")
+                       .addAssetQuantity("nonexistent#test", "5.00")
+                       .build()
+                       .signAndAddSignature(key)
+                       .finish();
+  ASSERT_TRUE(framework::expected::err(temp_wsv->apply(failed_tx)));
+
+  auto result = temp_wsv->apply(*initial_tx);
+  ASSERT_TRUE(framework::expected::val(result));
+  storage->prepareBlock(std::move(temp_wsv));
+
+  auto block = createBlock({*initial_tx});
+  ASSERT_TRUE(storage->commitPrepared(block));
+
+  shared_model::interface::Amount resultingBalance{"10.00"};
+  validateAccountAsset(sql_query, "admin@test", "coin#test", resultingBalance);
+}
+
+/**
+ * @given TemporaryWSV and three transactions, the second of which fails on its
+ * second command after the first one is executed
+ * @when the transactions are applied together and the prepared state is
+ * applied
+ * @then only the failed transaction is rejected with the index of the failed
+ * command, and only the successful ones change the state of the ledger
+ */
+TEST_F(PreparedBlockTest, ApplyTransactionsRollsBackFailedOne) {
+  auto failed_tx = shared_model::proto::TransactionBuilder()
+                       .creatorAccountId("admin@test")
+                       .createdTime(iroha::time::now())
+                       .quorum(1)
+                       .addAssetQuantity("coin#test", "5.00")
+                       .addAssetQuantity("nonexistent#test", "5.00")
+                       .build()
+                       .signAndAddSignature(key)
+                       .finish();
+  auto last_tx = createAddAsset("1.00");
+
+  auto results = temp_wsv->applyTransactions(
+      {std::cref<shared_model::interface::Transaction>(*initial_tx),
+       std::cref<shared_model::interface::Transaction>(failed_tx),
+       std::cref<shared_model::interface::Transaction>(last_tx)});
+  ASSERT_EQ(results.size(), 3);
+  ASSERT_TRUE(framework::expected::val(results[0]));
+  auto error = framework::expected::err(results[1]);
+  ASSERT_TRUE(error);
+  ASSERT_EQ(error->error.index, 1);
+  ASSERT_TRUE(framework::expected::val(results[2]));
+  storage->prepareBlock(std::move(temp_wsv));
+
+  auto block = createBlock({*initial_tx, last_tx});
+  ASSERT_TRUE(storage->commitPrepared(block));
+
+  shared_model::interface::Amount resultingBalance{"11.00"};
+  validateAccountAsset(sql_query, "admin@test", "coin#test", resultingBalance);
+}
+
+/**
+ * @given TemporaryWSV with a transaction applied in memory under a savepoint,
+ * which is rolled back
+ * @when transactions applied in memory and in the database are applied
+ * together and the prepared state is applied
+ * @then the state of the ledger is changed by these transactions only
+ */
+TEST_F(PreparedBlockTest, PrepareBlockMixedWithRolledBackSavepoint) {
+  {
+    auto savepoint = temp_wsv->createSavepoint("rolled_back");
+    ASSERT_TRUE(framework::expected::val(
+        temp_wsv->apply(createAddAsset("3.00"))));
+  }
+
+  auto domain_tx = shared_model::proto::TransactionBuilder()
+                       .creatorAccountId("admin@test")
+                       .createdTime(iroha::time::now())
+                       .quorum(1)
+                       .createDomain("other", default_role)
+                       .build()
+                       .signAndAddSignature(key)
+                       .finish();
+  auto last_tx = createAddAsset("1.00");
+
+  auto results = temp_wsv->applyTransactions(
+      {std::cref<shared_model::interface::Transaction>(*initial_tx),
+       std::cref<shared_model::interface::Transaction>(domain_tx),
+       std::cref<shared_model::interface::Transaction>(last_tx)});
+  ASSERT_EQ(results.size(), 3);
+  for (const auto &result : results) {
+    ASSERT_TRUE(framework::expected::val(result));
+  }
+  storage->prepareBlock(std::move(temp_wsv));
+
+  auto block = createBlock({*initial_tx, domain_tx, last_tx});
+  ASSERT_TRUE(storage->commitPrepared(block));
+
+  shared_model::interface::Amount resultingBalance{"11.00"};
+  validateAccountAsset(sql_query, "admin@test", "coin#test", resultingBalance);
+}
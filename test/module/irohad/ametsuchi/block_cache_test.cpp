@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+#include <gtest/gtest.h>
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+class BlockCacheTest : public ::testing::Test {
+ protected:
+  BlockCache::BlockType makeBlock(
+      shared_model::interface::types::HeightType height) {
+    return std::make_shared<shared_model::proto::Block>(
+        TestBlockBuilder().height(height).build());
+  }
+};
+
+/**
+ * @given empty block cache
+ * @when a block is inserted
+ * @then the block is returned by height and the lookup is counted as a hit
+ */
+TEST_F(BlockCacheTest, InsertAndGet) {
+  BlockCache cache;
+  auto block = makeBlock(1);
+  cache.insert(block);
+
+  auto cached = cache.get(1);
+  ASSERT_TRUE(cached);
+  ASSERT_EQ(*cached, block);
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 0);
+}
+
+/**
+ * @given empty block cache
+ * @when a block which was not inserted is requested
+ * @then nothing is returned and the lookup is counted as a miss
+ */
+TEST_F(BlockCacheTest, Miss) {
+  BlockCache cache;
+  ASSERT_FALSE(cache.get(1));
+  ASSERT_EQ(cache.hits(), 0);
+  ASSERT_EQ(cache.misses(), 1);
+}
+
+/**
+ * @given full block cache, where the oldest block has been read recently
+ * @when a new block is inserted
+ * @then the least recently used block is evicted
+ */
+TEST_F(BlockCacheTest, EvictsLeastRecentlyUsed) {
+  BlockCache cache(2);
+  cache.insert(makeBlock(1));
+  cache.insert(makeBlock(2));
+  ASSERT_TRUE(cache.get(1));
+
+  cache.insert(makeBlock(3));
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_TRUE(cache.get(1));
+  ASSERT_FALSE(cache.get(2));
+  ASSERT_TRUE(cache.get(3));
+}
+
+/**
+ * @given block cache with a block
+ * @when another block with the same height is inserted
+ * @then the block is replaced
+ */
+TEST_F(BlockCacheTest, ReplaceSameHeight) {
+  BlockCache cache;
+  cache.insert(makeBlock(1));
+  auto block = makeBlock(1);
+  cache.insert(block);
+
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(*cache.get(1), block);
+}
+
+/**
+ * @given block cache with blocks
+ * @when the cache is cleared
+ * @then no blocks are returned
+ */
+TEST_F(BlockCacheTest, Clear) {
+  BlockCache cache;
+  cache.insert(makeBlock(1));
+  cache.insert(makeBlock(2));
+  cache.clear();
+
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_FALSE(cache.get(1));
+  ASSERT_FALSE(cache.get(2));
+}
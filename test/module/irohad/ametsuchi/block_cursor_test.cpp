@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/block_cursor.hpp"
+
+#include <gtest/gtest.h>
+#include "module/irohad/ametsuchi/mock_block_query.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+using testing::_;
+using testing::Return;
+
+using wBlock = std::shared_ptr<shared_model::interface::Block>;
+
+class BlockCursorTest : public ::testing::Test {
+ protected:
+  std::vector<wBlock> makeBlocks(
+      shared_model::interface::types::HeightType from, uint32_t count) {
+    std::vector<wBlock> blocks;
+    for (auto height = from; height < from + count; ++height) {
+      blocks.push_back(std::make_shared<shared_model::proto::Block>(
+          TestBlockBuilder().height(height).build()));
+    }
+    return blocks;
+  }
+
+  MockBlockQuery block_query;
+};
+
+/**
+ * @given block query with 5 blocks
+ * @when cursor with read ahead of 2 blocks iterates from height 1
+ * @then all blocks are returned in order @and they are requested by batches
+ * of at most 2 blocks
+ */
+TEST_F(BlockCursorTest, ReadsByBatches) {
+  EXPECT_CALL(block_query, getTopBlockHeight()).WillOnce(Return(5));
+  EXPECT_CALL(block_query, getBlocks(1, 2)).WillOnce(Return(makeBlocks(1, 2)));
+  EXPECT_CALL(block_query, getBlocks(3, 2)).WillOnce(Return(makeBlocks(3, 2)));
+  EXPECT_CALL(block_query, getBlocks(5, 1)).WillOnce(Return(makeBlocks(5, 1)));
+
+  BlockCursor cursor(block_query, 1, 2);
+  for (shared_model::interface::types::HeightType height = 1; height <= 5;
+       ++height) {
+    auto block = cursor.next();
+    ASSERT_TRUE(block);
+    ASSERT_EQ((*block)->height(), height);
+  }
+  ASSERT_FALSE(cursor.next());
+}
+
+/**
+ * @given block query with 2 blocks
+ * @when cursor starts above the top block
+ * @then no blocks are requested and returned
+ */
+TEST_F(BlockCursorTest, StartAboveTop) {
+  EXPECT_CALL(block_query, getTopBlockHeight()).WillOnce(Return(2));
+  EXPECT_CALL(block_query, getBlocks(_, _)).Times(0);
+
+  BlockCursor cursor(block_query, 3);
+  ASSERT_FALSE(cursor.next());
+}
+
+/**
+ * @given block query with 3 blocks, where block #2 cannot be read
+ * @when cursor with read ahead of 1 block iterates from height 1
+ * @then the unreadable block is skipped
+ */
+TEST_F(BlockCursorTest, SkipsUnreadableBlocks) {
+  EXPECT_CALL(block_query, getTopBlockHeight()).WillOnce(Return(3));
+  EXPECT_CALL(block_query, getBlocks(1, 1)).WillOnce(Return(makeBlocks(1, 1)));
+  EXPECT_CALL(block_query, getBlocks(2, 1))
+      .WillOnce(Return(std::vector<wBlock>{}));
+  EXPECT_CALL(block_query, getBlocks(3, 1)).WillOnce(Return(makeBlocks(3, 1)));
+
+  BlockCursor cursor(block_query, 1, 1);
+  ASSERT_EQ((*cursor.next())->height(), 1);
+  ASSERT_EQ((*cursor.next())->height(), 3);
+  ASSERT_FALSE(cursor.next());
+}
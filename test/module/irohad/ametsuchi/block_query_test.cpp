@@ -8,7 +8,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 #include "ametsuchi/impl/postgres_block_index.hpp"
-#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
 #include "common/byteutils.hpp"
 #include "converters/protobuf/json_proto_converter.hpp"
 #include "framework/result_fixture.hpp"
@@ -36,11 +36,16 @@ class BlockQueryTest : public AmetsuchiTest {
     index =
         std::make_shared<PostgresBlockIndex>(*sql, getTestLogger("BlockIndex"));
     auto converter =
-        std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+        std::make_shared<shared_model::proto::ProtoBlockBinaryConverter>();
+    block_cache = std::make_shared<BlockCache>();
     blocks = std::make_shared<PostgresBlockQuery>(
-        *sql, *file, converter, getTestLogger("BlockQuery"));
+        *sql, *file, converter, block_cache, getTestLogger("BlockQuery"));
     empty_blocks = std::make_shared<PostgresBlockQuery>(
-        *sql, *mock_file, converter, getTestLogger("PostgresBlockQueryEmpty"));
+        *sql,
+        *mock_file,
+        converter,
+        std::make_shared<BlockCache>(),
+        getTestLogger("PostgresBlockQueryEmpty"));
 
     *sql << init_;
 
@@ -88,6 +93,7 @@ class BlockQueryTest : public AmetsuchiTest {
           [this, &b](const iroha::expected::Value<std::string> &json) {
             file->add(b.height(), iroha::stringToBytes(json.value));
             index->index(b);
+            block_hashes.push_back(b.hash());
             blocks_total++;
           },
           [](const auto &error) { FAIL() << error.error; });
@@ -101,9 +107,11 @@ class BlockQueryTest : public AmetsuchiTest {
 
   std::unique_ptr<soci::session> sql;
   std::vector<shared_model::crypto::Hash> tx_hashes;
+  std::vector<shared_model::crypto::Hash> block_hashes;
   std::shared_ptr<BlockQuery> blocks;
   std::shared_ptr<BlockQuery> empty_blocks;
   std::shared_ptr<BlockIndex> index;
+  std::shared_ptr<BlockCache> block_cache;
   std::unique_ptr<FlatFile> file;
   std::shared_ptr<MockKeyValueStorage> mock_file;
   std::string creator1 = "user1@test";
@@ -220,6 +228,29 @@ TEST_F(BlockQueryTest, GetBlockButItIsInvalidBlock) {
   ASSERT_TRUE(stored_blocks.empty());
 }
 
+/**
+ * @given block store with 2 blocks, where block #1 has been read once
+ * @when block #1 is overwritten with trash data and read again
+ * @then the block is returned from the block cache
+ */
+TEST_F(BlockQueryTest, GetBlockFromCache) {
+  namespace fs = boost::filesystem;
+  size_t block_n = 1;
+  auto first_read = blocks->getBlocks(block_n, 1);
+  ASSERT_EQ(first_read.size(), 1);
+  ASSERT_EQ(block_cache->misses(), 1);
+
+  auto block_path = fs::path{block_store_path} / FlatFile::id_to_name(block_n);
+  fs::ofstream block_file(block_path);
+  block_file << "this is definitely not a block";
+  block_file.close();
+
+  auto stored_blocks = blocks->getBlocks(block_n, 1);
+  ASSERT_EQ(stored_blocks.size(), 1);
+  ASSERT_EQ(*stored_blocks[0], *first_read[0]);
+  ASSERT_EQ(block_cache->hits(), 1);
+}
+
 /**
  * @given block store with 2 blocks totally containing 3 txs created by
  * user1@test AND 1 tx created by user2@test
@@ -282,6 +313,66 @@ TEST_F(BlockQueryTest, HasTxWithRejectedHash) {
   });
 }
 
+/**
+ * @given block store with preinserted blocks containing committed and
+ * rejected transactions
+ * @when checkTxsPresence is invoked on existing, missing and rejected hashes
+ * @then statuses of all the hashes are returned in the order of the hashes
+ */
+TEST_F(BlockQueryTest, HasTxsWithHashes) {
+  shared_model::crypto::Hash missing_tx_hash(zero_string);
+  auto statuses = blocks->checkTxsPresence(
+      {tx_hashes.at(0), missing_tx_hash, rejected_hash, tx_hashes.at(3)});
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(statuses->size(), 4);
+  ASSERT_NO_THROW({
+    ASSERT_EQ(boost::get<tx_cache_status_responses::Committed>(statuses->at(0))
+                  .hash,
+              tx_hashes.at(0));
+    ASSERT_EQ(
+        boost::get<tx_cache_status_responses::Missing>(statuses->at(1)).hash,
+        missing_tx_hash);
+    ASSERT_EQ(
+        boost::get<tx_cache_status_responses::Rejected>(statuses->at(2)).hash,
+        rejected_hash);
+    ASSERT_EQ(boost::get<tx_cache_status_responses::Committed>(statuses->at(3))
+                  .hash,
+              tx_hashes.at(3));
+  });
+}
+
+/**
+ * @given block store with preinserted blocks
+ * @when checkTxsPresence is invoked on an existing hash between malformed
+ * empty ones
+ * @then the existing hash is found, and the empty ones are missing
+ */
+TEST_F(BlockQueryTest, HasTxsWithMalformedHashes) {
+  shared_model::crypto::Hash empty_hash("");
+  auto statuses =
+      blocks->checkTxsPresence({empty_hash, tx_hashes.at(0), empty_hash});
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(statuses->size(), 3);
+  ASSERT_NO_THROW({
+    boost::get<tx_cache_status_responses::Missing>(statuses->at(0));
+    ASSERT_EQ(boost::get<tx_cache_status_responses::Committed>(statuses->at(1))
+                  .hash,
+              tx_hashes.at(0));
+    boost::get<tx_cache_status_responses::Missing>(statuses->at(2));
+  });
+}
+
+/**
+ * @given block store with preinserted blocks
+ * @when checkTxsPresence is invoked on no hashes
+ * @then empty collection of statuses is returned
+ */
+TEST_F(BlockQueryTest, HasTxsWithNoHashes) {
+  auto statuses = blocks->checkTxsPresence({});
+  ASSERT_TRUE(statuses);
+  ASSERT_TRUE(statuses->empty());
+}
+
 /**
  * @given block store with preinserted blocks
  * @when getTopBlock is invoked on this block store
@@ -309,3 +400,43 @@ TEST_F(BlockQueryTest, GetTopBlockFail) {
   ASSERT_EQ(top_block_error.value().error,
             (expected_error % mock_file->last_id()).str());
 }
+
+/**
+ * @given block store with preinserted blocks
+ * @when getBlockByHash is invoked with hash of the first block
+ * @then the first block is returned
+ */
+TEST_F(BlockQueryTest, GetBlockByHash) {
+  auto block =
+      framework::expected::val(blocks->getBlockByHash(block_hashes[0]));
+  ASSERT_TRUE(block);
+  ASSERT_EQ(block->value->height(), 1);
+  ASSERT_EQ(block->value->hash(), block_hashes[0]);
+}
+
+/**
+ * @given block store with preinserted blocks
+ * @when getBlockByHash is invoked with hash which does not belong to any block
+ * @then an error is returned
+ */
+TEST_F(BlockQueryTest, GetBlockByMissingHash) {
+  auto error = framework::expected::err(
+      blocks->getBlockByHash(shared_model::crypto::Hash(zero_string)));
+  ASSERT_TRUE(error);
+  ASSERT_EQ(error->error.code, BlockQuery::GetBlockError::Code::kNoBlock);
+}
+
+/**
+ * @given block index with preinserted blocks @and block store, which fails to
+ * read them
+ * @when getBlockByHash is invoked with hash of the first block
+ * @then an internal error is returned instead of a missing block
+ */
+TEST_F(BlockQueryTest, GetBlockByHashWithStorageFailure) {
+  EXPECT_CALL(*mock_file, get(1)).WillOnce(Return(boost::none));
+  auto error =
+      framework::expected::err(empty_blocks->getBlockByHash(block_hashes[0]));
+  ASSERT_TRUE(error);
+  ASSERT_EQ(error->error.code,
+            BlockQuery::GetBlockError::Code::kInternalError);
+}
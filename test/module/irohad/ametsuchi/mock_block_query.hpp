@@ -23,9 +23,15 @@ namespace iroha {
                        shared_model::interface::types::HeightType));
       MOCK_METHOD1(getTopBlocks, std::vector<BlockQuery::wBlock>(uint32_t));
       MOCK_METHOD0(getTopBlock, expected::Result<wBlock, std::string>(void));
+      MOCK_METHOD1(getBlockByHash,
+                   expected::Result<wBlock, GetBlockError>(
+                       const shared_model::crypto::Hash &));
       MOCK_METHOD1(checkTxPresence,
                    boost::optional<TxCacheStatusType>(
                        const shared_model::crypto::Hash &));
+      MOCK_METHOD1(checkTxsPresence,
+                   boost::optional<std::vector<TxCacheStatusType>>(
+                       const std::vector<shared_model::crypto::Hash> &));
       MOCK_METHOD0(getTopBlockHeight, uint32_t(void));
     };
 
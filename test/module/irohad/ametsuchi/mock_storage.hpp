@@ -45,6 +45,14 @@ namespace iroha {
       MOCK_METHOD1(insertBlocks,
                    bool(const std::vector<
                         std::shared_ptr<shared_model::interface::Block>> &));
+      MOCK_METHOD0(createWsvSnapshot,
+                   expected::Result<shared_model::interface::types::HeightType,
+                                    std::string>(void));
+      MOCK_METHOD0(restoreWsvSnapshot,
+                   expected::Result<shared_model::interface::types::HeightType,
+                                    std::string>(void));
+      MOCK_METHOD2(replayBlocks,
+                   expected::Result<void, std::string>(BlockCursor &, size_t));
       MOCK_METHOD0(reset, void(void));
       MOCK_METHOD0(dropStorage, void(void));
       MOCK_METHOD0(freeConnections, void(void));
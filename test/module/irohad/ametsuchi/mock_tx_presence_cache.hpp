@@ -23,6 +23,11 @@ namespace iroha {
           check,
           boost::optional<TxPresenceCache::BatchStatusCollectionType>(
               const shared_model::interface::TransactionBatch &));
+
+      MOCK_CONST_METHOD1(
+          check,
+          boost::optional<std::vector<TxCacheStatusType>>(
+              const std::vector<shared_model::crypto::Hash> &));
     };
 
   }  // namespace ametsuchi
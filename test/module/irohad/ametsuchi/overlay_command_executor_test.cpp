@@ -0,0 +1,227 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/overlay_command_executor.hpp"
+
+#include <boost/optional/optional_io.hpp>
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "framework/result_fixture.hpp"
+#include "framework/test_logger.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+#include "module/shared_model/mock_objects_factories/mock_command_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using namespace framework::expected;
+
+    class OverlayCommandExecutorTest : public AmetsuchiTest {
+     public:
+      void SetUp() override {
+        AmetsuchiTest::SetUp();
+        sql = std::make_unique<soci::session>(*soci::factory_postgresql(),
+                                              pgopt_);
+        PostgresCommandExecutor::prepareStatements(*sql);
+        postgres_executor =
+            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        executor = std::make_unique<OverlayCommandExecutor>(
+            *sql,
+            *postgres_executor,
+            getTestLogger("OverlayCommandExecutor"));
+        *sql << init_;
+
+        shared_model::interface::RolePermissionSet permissions;
+        permissions.set();
+        postgres_executor->doValidation(false);
+        ASSERT_TRUE(val((*postgres_executor)(
+            *mock_command_factory->constructCreateRole(role, permissions))));
+        ASSERT_TRUE(val((*postgres_executor)(
+            *mock_command_factory->constructCreateDomain(domain_id, role))));
+        for (const auto &name : {"id", "id2"}) {
+          ASSERT_TRUE(val((*postgres_executor)(
+              *mock_command_factory->constructCreateAccount(
+                  name, domain_id, pubkey))));
+        }
+        ASSERT_TRUE(val((*postgres_executor)(
+            *mock_command_factory->constructCreateAsset(
+                "coin", domain_id, 1))));
+        executor->doValidation(true);
+        executor->setCreatorAccountId(account_id);
+      }
+
+      void TearDown() override {
+        sql->close();
+        AmetsuchiTest::TearDown();
+      }
+
+      /// write the changes kept in memory to the database
+      void flush() {
+        auto statement = executor->flush();
+        if (not statement.empty()) {
+          *sql << statement;
+        }
+      }
+
+      /// balance of the asset of the account, which is in the database
+      boost::optional<std::string> balance(
+          const shared_model::interface::types::AccountIdType &account) {
+        if (auto account_asset =
+                sql_query->getAccountAsset(account, asset_id)) {
+          return account_asset.get()->balance().toStringRepr();
+        }
+        return boost::none;
+      }
+
+      /**
+       * Execute the command with both overlay and postgres executors, which
+       * are expected to fail it with the same error
+       */
+      template <typename CommandType>
+      void checkSameError(const CommandType &command,
+                          CommandError::ErrorCodeType expected_code) {
+        auto overlay_error = err(executor->operator()(command));
+        postgres_executor->doValidation(true);
+        postgres_executor->setCreatorAccountId(account_id);
+        auto postgres_error = err(postgres_executor->operator()(command));
+        ASSERT_TRUE(overlay_error);
+        ASSERT_TRUE(postgres_error);
+        EXPECT_EQ(overlay_error->error.error_code, expected_code);
+        EXPECT_EQ(overlay_error->error.toString(),
+                  postgres_error->error.toString());
+      }
+
+      const std::string role = "all";
+      const std::string domain_id = "domain";
+      const std::string account_id = "id@domain";
+      const std::string account2_id = "id2@domain";
+      const std::string asset_id = "coin#domain";
+      const shared_model::interface::types::PubkeyType pubkey{
+          std::string('1', 32)};
+
+      std::unique_ptr<soci::session> sql;
+      std::unique_ptr<PostgresCommandExecutor> postgres_executor;
+      std::unique_ptr<OverlayCommandExecutor> executor;
+
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter =
+              std::make_shared<shared_model::proto::ProtoPermissionToString>();
+      std::unique_ptr<shared_model::interface::MockCommandFactory>
+          mock_command_factory =
+              std::make_unique<shared_model::interface::MockCommandFactory>();
+    };
+
+    /**
+     * @given accounts with permissions to add and transfer an asset
+     * @when the asset is added and transferred with the overlay executor
+     * @then the balances are changed in memory only, until the statement
+     * returned by flush is executed
+     */
+    TEST_F(OverlayCommandExecutorTest, ChangesAreWrittenWithFlush) {
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructAddAssetQuantity(
+              asset_id, shared_model::interface::Amount{"2.0"}))));
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructTransferAsset(
+              account_id,
+              account2_id,
+              asset_id,
+              "desc",
+              shared_model::interface::Amount{"1.5"}))));
+      EXPECT_FALSE(balance(account_id));
+      EXPECT_FALSE(balance(account2_id));
+
+      flush();
+      EXPECT_EQ(balance(account_id), std::string("0.5"));
+      EXPECT_EQ(balance(account2_id), std::string("1.5"));
+      EXPECT_TRUE(executor->flush().empty());
+    }
+
+    /**
+     * @given an asset added with the overlay executor
+     * @when invalid commands are executed with the overlay executor
+     * @then they fail with the same errors as with the postgres executor
+     */
+    TEST_F(OverlayCommandExecutorTest, ErrorsAreSameAsPostgres) {
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructAddAssetQuantity(
+              asset_id, shared_model::interface::Amount{"2.0"}))));
+      flush();
+
+      checkSameError(*mock_command_factory->constructAddAssetQuantity(
+                         "nonexistent#domain",
+                         shared_model::interface::Amount{"1.0"}),
+                     3);
+      checkSameError(*mock_command_factory->constructAddAssetQuantity(
+                         asset_id, shared_model::interface::Amount{"1.00"}),
+                     3);
+      checkSameError(*mock_command_factory->constructSubtractAssetQuantity(
+                         asset_id, shared_model::interface::Amount{"2.5"}),
+                     4);
+      checkSameError(*mock_command_factory->constructTransferAsset(
+                         account_id,
+                         "nonexistent@domain",
+                         asset_id,
+                         "desc",
+                         shared_model::interface::Amount{"1.0"}),
+                     2);
+      checkSameError(*mock_command_factory->constructTransferAsset(
+                         account_id,
+                         account2_id,
+                         asset_id,
+                         "desc",
+                         shared_model::interface::Amount{"3.0"}),
+                     6);
+      checkSameError(*mock_command_factory->constructTransferAsset(
+                         account2_id,
+                         account_id,
+                         asset_id,
+                         "desc",
+                         shared_model::interface::Amount{"1.0"}),
+                     2);
+    }
+
+    /**
+     * @given an asset added with the overlay executor
+     * @when a transfer of a started transaction is rolled back
+     * @then only the balance before the transaction is written
+     */
+    TEST_F(OverlayCommandExecutorTest, RollbackTransactionRestoresBalances) {
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructAddAssetQuantity(
+              asset_id, shared_model::interface::Amount{"2.0"}))));
+      executor->beginTransaction();
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructTransferAsset(
+              account_id,
+              account2_id,
+              asset_id,
+              "desc",
+              shared_model::interface::Amount{"1.0"}))));
+      executor->rollbackTransaction();
+
+      flush();
+      EXPECT_EQ(balance(account_id), std::string("2.0"));
+      EXPECT_FALSE(balance(account2_id));
+    }
+
+    /**
+     * @given an asset added with the overlay executor
+     * @when a command, which is not applied in memory, is executed
+     * @then the changes kept in memory are written before it
+     */
+    TEST_F(OverlayCommandExecutorTest, FallbackCommandWritesChangesFirst) {
+      ASSERT_TRUE(val(
+          executor->operator()(*mock_command_factory->constructAddAssetQuantity(
+              asset_id, shared_model::interface::Amount{"2.0"}))));
+      ASSERT_TRUE(val(executor->operator()(
+          *mock_command_factory->constructCreateAsset("coin2", domain_id, 1))));
+
+      EXPECT_EQ(balance(account_id), std::string("2.0"));
+      EXPECT_TRUE(executor->flush().empty());
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
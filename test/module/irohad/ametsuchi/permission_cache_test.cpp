@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/permission_cache.hpp"
+
+#include <gtest/gtest.h>
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+using shared_model::interface::RolePermissionSet;
+using shared_model::interface::permissions::Role;
+
+class PermissionCacheTest : public ::testing::Test {
+ protected:
+  /**
+   * @param tx - transaction to put to the block
+   * @return block with the transaction
+   */
+  shared_model::proto::Block makeBlock(shared_model::proto::Transaction tx) {
+    return TestBlockBuilder()
+        .height(1)
+        .transactions(std::vector<shared_model::proto::Transaction>{tx})
+        .build();
+  }
+
+  TestTransactionBuilder txBuilder() {
+    return TestTransactionBuilder()
+        .creatorAccountId("admin@test")
+        .createdTime(iroha::time::now())
+        .quorum(1);
+  }
+
+  const std::string account_id = "user@test";
+  const RolePermissionSet permissions{Role::kGetRoles, Role::kGetMyAccount};
+};
+
+/**
+ * @given empty permission cache
+ * @when permissions of an account are inserted with the current version
+ * @then they are returned for the account
+ */
+TEST_F(PermissionCacheTest, InsertAndGet) {
+  PermissionCache cache;
+  ASSERT_FALSE(cache.get(account_id));
+
+  cache.insert(account_id, permissions, cache.version());
+
+  auto cached = cache.get(account_id);
+  ASSERT_TRUE(cached);
+  ASSERT_EQ(*cached, permissions);
+}
+
+/**
+ * @given permission cache, which was invalidated after its version was taken
+ * @when permissions are inserted with the taken version
+ * @then they are not cached
+ */
+TEST_F(PermissionCacheTest, OutdatedVersionIgnored) {
+  PermissionCache cache;
+  auto version = cache.version();
+  cache.clear();
+
+  cache.insert(account_id, permissions, version);
+
+  ASSERT_FALSE(cache.get(account_id));
+}
+
+/**
+ * @given permission cache with permissions of two accounts
+ * @when a block which appends a role to one of them is committed
+ * @then only permissions of that account are forgotten
+ */
+TEST_F(PermissionCacheTest, InvalidatedByAppendRole) {
+  PermissionCache cache;
+  cache.insert(account_id, permissions, cache.version());
+  cache.insert("other@test", permissions, cache.version());
+
+  cache.invalidate(
+      makeBlock(txBuilder().appendRole(account_id, "role").build()));
+
+  ASSERT_FALSE(cache.get(account_id));
+  ASSERT_TRUE(cache.get("other@test"));
+}
+
+/**
+ * @given permission cache with permissions of an account
+ * @when a block which does not change roles of accounts is committed
+ * @then permissions are kept and the version does not change
+ */
+TEST_F(PermissionCacheTest, NotInvalidatedByOtherCommands) {
+  PermissionCache cache;
+  cache.insert(account_id, permissions, cache.version());
+  auto version = cache.version();
+
+  cache.invalidate(
+      makeBlock(txBuilder().setAccountQuorum(account_id, 2).build()));
+
+  ASSERT_TRUE(cache.get(account_id));
+  ASSERT_EQ(cache.version(), version);
+}
+
+/**
+ * @given full permission cache
+ * @when permissions of one more account are inserted
+ * @then the number of cached accounts does not exceed the capacity
+ */
+TEST_F(PermissionCacheTest, CapacityRespected) {
+  PermissionCache cache(1);
+  cache.insert(account_id, permissions, cache.version());
+  cache.insert("other@test", permissions, cache.version());
+
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_TRUE(cache.get("other@test"));
+}
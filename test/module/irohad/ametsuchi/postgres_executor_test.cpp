@@ -1367,6 +1367,36 @@ namespace iroha {
       ASSERT_EQ(kv.get(), "{\"id@domain\": {\"key\": \"value\"}}");
     }
 
+    /**
+     * @given command with a value containing quotes
+     * @when trying to set kv
+     * @then kv is set with the value unchanged
+     */
+    TEST_F(SetAccountDetail, ValueWithQuotes) {
+      CHECK_SUCCESSFUL_RESULT(
+          execute(*mock_command_factory->constructSetAccountDetail(
+              account_id, "key", "it's a value")));
+      auto kv = sql_query->getAccountDetail(account_id);
+      ASSERT_TRUE(kv);
+      ASSERT_EQ(kv.get(), "{\"id@domain\": {\"key\": \"it's a value\"}}");
+    }
+
+    /**
+     * @given command with a value containing backslashes followed by a quote,
+     * which is a JSON escaped backslash
+     * @when trying to set kv
+     * @then kv is set with the value unchanged, since backslashes do not
+     * escape the quote in the statement
+     */
+    TEST_F(SetAccountDetail, ValueWithBackslashAndQuote) {
+      CHECK_SUCCESSFUL_RESULT(
+          execute(*mock_command_factory->constructSetAccountDetail(
+              account_id, "key", R"(it\\'s a value)")));
+      auto kv = sql_query->getAccountDetail(account_id);
+      ASSERT_TRUE(kv);
+      ASSERT_EQ(kv.get(), R"({"id@domain": {"key": "it\\'s a value"}})");
+    }
+
     /**
      * @given command
      * @when trying to set kv when has grantable permission
@@ -1984,5 +2014,147 @@ namespace iroha {
       CHECK_ERROR_CODE_AND_MESSAGE(cmd_result, 7, query_args);
     }
 
+    class CommandBatchTest : public AddAccountAssetTest {
+     public:
+      void SetUp() override {
+        AddAccountAssetTest::SetUp();
+        addAsset();
+        batch_executor =
+            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        batch_executor->doValidation(false);
+        batch_executor->setCreatorAccountId(account_id);
+        batch_executor->startBatch();
+      }
+
+      /**
+       * Queue add asset quantity command to the batch
+       * @param asset - asset to add
+       */
+      void queueAddAsset(
+          const shared_model::interface::types::AssetIdType &asset) {
+        CHECK_SUCCESSFUL_RESULT(batch_executor->operator()(
+            *mock_command_factory->constructAddAssetQuantity(
+                asset, asset_amount_one_zero)));
+      }
+
+      std::unique_ptr<PostgresCommandExecutor> batch_executor;
+    };
+
+    /**
+     * @given batch of two add asset quantity commands
+     * @when the batch is executed
+     * @then both commands are applied
+     */
+    TEST_F(CommandBatchTest, Valid) {
+      queueAddAsset(asset_id);
+      queueAddAsset(asset_id);
+
+      ASSERT_FALSE(sql_query->getAccountAsset(account_id, asset_id));
+      ASSERT_TRUE(val(batch_executor->executeBatch()));
+
+      auto account_asset = sql_query->getAccountAsset(account_id, asset_id);
+      ASSERT_TRUE(account_asset);
+      ASSERT_EQ("2.0", account_asset.get()->balance().toStringRepr());
+    }
+
+    /**
+     * @given batch of three commands, where the second one adds a
+     * non-existing asset
+     * @when the batch is executed
+     * @then error of the second command is returned
+     */
+    TEST_F(CommandBatchTest, FirstFailedCommandReported) {
+      queueAddAsset(asset_id);
+      queueAddAsset("nonexistent#" + domain_id);
+      queueAddAsset(asset_id);
+
+      auto error = err(batch_executor->executeBatch());
+      ASSERT_TRUE(error);
+      EXPECT_EQ(error->error.command_index, 1u);
+      EXPECT_TRUE(error->error.is_command_error);
+      EXPECT_EQ(error->error.error.command_name, "AddAssetQuantity");
+      EXPECT_EQ(error->error.error.error_code, 3);
+      EXPECT_THAT(error->error.error.error_extra,
+                  HasSubstr("nonexistent#" + domain_id));
+    }
+
+    /**
+     * @given batch of commands, where the second one violates a constraint
+     * of the database
+     * @when the batch is executed
+     * @then error of the second command is returned with the error code of
+     * the violation
+     */
+    TEST_F(CommandBatchTest, DatabaseErrorReported) {
+      queueAddAsset(asset_id);
+      CHECK_SUCCESSFUL_RESULT(batch_executor->operator()(
+          *mock_command_factory->constructCreateDomain(domain_id, role)));
+
+      auto error = err(batch_executor->executeBatch());
+      ASSERT_TRUE(error);
+      EXPECT_EQ(error->error.command_index, 1u);
+      EXPECT_TRUE(error->error.is_command_error);
+      EXPECT_EQ(error->error.error.command_name, "CreateDomain");
+      EXPECT_EQ(error->error.error.error_code, 3);
+    }
+
+    /**
+     * @given batch of a command after a savepoint, and a subsequent batch,
+     * which consists only of the rollback to the savepoint
+     * @when both batches are executed
+     * @then the rollback is executed, and the command is reverted
+     */
+    TEST_F(CommandBatchTest, OnlyQueuedStatementsExecuted) {
+      batch_executor->queueStatement("BEGIN; SAVEPOINT batch_test");
+      queueAddAsset(asset_id);
+      ASSERT_TRUE(val(batch_executor->executeBatch()));
+      ASSERT_TRUE(sql_query->getAccountAsset(account_id, asset_id));
+
+      batch_executor->startBatch();
+      batch_executor->queueStatement(
+          "ROLLBACK TO SAVEPOINT batch_test; COMMIT");
+      ASSERT_TRUE(val(batch_executor->executeBatch()));
+
+      ASSERT_FALSE(sql_query->getAccountAsset(account_id, asset_id));
+    }
+
+    /**
+     * @given batch, which consists only of a failing statement
+     * @when the batch is executed
+     * @then general error is returned for the first index with the text of
+     * the statement
+     */
+    TEST_F(CommandBatchTest, QueuedStatementErrorReported) {
+      batch_executor->queueStatement("RELEASE SAVEPOINT nonexistent");
+
+      auto error = err(batch_executor->executeBatch());
+      ASSERT_TRUE(error);
+      EXPECT_EQ(error->error.command_index, 0u);
+      EXPECT_FALSE(error->error.is_command_error);
+      EXPECT_EQ(error->error.error.error_code, 1);
+      EXPECT_THAT(error->error.error.error_extra,
+                  HasSubstr("RELEASE SAVEPOINT nonexistent"));
+    }
+
+    /**
+     * @given batch of two commands with a failing statement between them
+     * @when the batch is executed
+     * @then error of the statement is returned for the second command, and
+     * it is not reported as an error of the command
+     */
+    TEST_F(CommandBatchTest, StatementBetweenCommandsErrorReported) {
+      queueAddAsset(asset_id);
+      batch_executor->queueStatement("RELEASE SAVEPOINT nonexistent");
+      queueAddAsset(asset_id);
+
+      auto error = err(batch_executor->executeBatch());
+      ASSERT_TRUE(error);
+      EXPECT_EQ(error->error.command_index, 1u);
+      EXPECT_FALSE(error->error.is_command_error);
+      EXPECT_EQ(error->error.error.command_name, "QueuedStatements");
+      EXPECT_THAT(error->error.error.error_extra,
+                  HasSubstr("RELEASE SAVEPOINT nonexistent"));
+    }
+
   }  // namespace ametsuchi
 }  // namespace iroha
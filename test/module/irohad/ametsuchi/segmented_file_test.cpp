@@ -0,0 +1,282 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_file/block_store_migration.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "common/byteutils.hpp"
+#include "framework/result_fixture.hpp"
+#include "framework/test_logger.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+
+using namespace iroha::ametsuchi;
+namespace fs = boost::filesystem;
+using Identifier = SegmentedFile::Identifier;
+
+class SegmentedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fs::create_directory(block_store_path);
+    block = std::vector<uint8_t>(100000, 5);
+  }
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  std::unique_ptr<SegmentedFile> createStore(
+      uint64_t segment_size = SegmentedFile::kDefaultSegmentSize) {
+    auto store = SegmentedFile::create(block_store_path, log_, segment_size);
+    EXPECT_TRUE(store);
+    return store ? std::move(*store) : nullptr;
+  }
+
+  fs::path segmentPath(SegmentedFile::SegmentIdType segment,
+                       const std::string &extension) {
+    return fs::path(block_store_path)
+        / (SegmentedFile::segment_name(segment) + extension);
+  }
+
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+
+  std::vector<uint8_t> block;
+  logger::LoggerPtr log_ = getTestLogger("SegmentedFile");
+};
+
+/**
+ * @given initialized storage
+ * @when two entries are added
+ * @then the entries can be read back
+ */
+TEST_F(SegmentedFileTest, ReadWrite) {
+  auto store = createStore();
+  ASSERT_TRUE(store->add(1, block));
+  ASSERT_TRUE(store->add(2, std::vector<uint8_t>(10, 7)));
+
+  auto res = store->get(1);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, block);
+  res = store->get(2);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, std::vector<uint8_t>(10, 7));
+  ASSERT_EQ(store->last_id(), 2);
+  ASSERT_EQ(store->directory(), block_store_path);
+}
+
+/**
+ * @given storage with one entry
+ * @when entry with the same id is added
+ * @then add() fails and the entry is not changed
+ */
+TEST_F(SegmentedFileTest, AddExistingId) {
+  auto store = createStore();
+  ASSERT_TRUE(store->add(1, block));
+  ASSERT_FALSE(store->add(1, std::vector<uint8_t>(10, 7)));
+  ASSERT_EQ(*store->get(1), block);
+}
+
+/**
+ * @given empty storage
+ * @when non-existent id is requested
+ * @then get() fails
+ */
+TEST_F(SegmentedFileTest, GetNonExistingId) {
+  auto store = createStore();
+  ASSERT_FALSE(store->get(98759385));
+  ASSERT_EQ(store->last_id(), 0);
+}
+
+/**
+ * @given storage with segment size smaller than two entries
+ * @when three entries are added
+ * @then every entry is placed to its own segment and is readable after the
+ * storage is reopened
+ */
+TEST_F(SegmentedFileTest, SegmentRollover) {
+  {
+    auto store = createStore(block.size() + 1);
+    ASSERT_TRUE(store->add(1, block));
+    ASSERT_TRUE(store->add(2, block));
+    ASSERT_TRUE(store->add(3, block));
+  }
+  ASSERT_TRUE(fs::exists(segmentPath(0, SegmentedFile::kDataExtension)));
+  ASSERT_TRUE(fs::exists(segmentPath(1, SegmentedFile::kDataExtension)));
+  ASSERT_TRUE(fs::exists(segmentPath(2, SegmentedFile::kDataExtension)));
+
+  auto store = createStore(block.size() + 1);
+  ASSERT_EQ(store->last_id(), 3);
+  for (Identifier id : {1, 2, 3}) {
+    auto res = store->get(id);
+    ASSERT_TRUE(res);
+    ASSERT_EQ(*res, block);
+  }
+}
+
+/**
+ * @given storage with entries inserted in non-consecutive order
+ * @when storage is reopened
+ * @then only inserted entries are available and last id is the maximum one
+ */
+TEST_F(SegmentedFileTest, RandomNumbers) {
+  {
+    auto store = createStore();
+    ASSERT_TRUE(store->add(4, block));
+    ASSERT_TRUE(store->add(17, block));
+    ASSERT_TRUE(store->add(7, block));
+  }
+  auto store = createStore();
+  ASSERT_TRUE(store->get(4));
+  ASSERT_TRUE(store->get(17));
+  ASSERT_TRUE(store->get(7));
+  ASSERT_FALSE(store->get(1));
+  ASSERT_EQ(store->last_id(), 17);
+}
+
+/**
+ * @given storage with two entries, where the last record is torn
+ * @when storage is reopened
+ * @then the torn record is dropped and new entries are appended after the
+ * last complete one
+ */
+TEST_F(SegmentedFileTest, TornRecordIsTruncated) {
+  {
+    auto store = createStore();
+    ASSERT_TRUE(store->add(1, block));
+    ASSERT_TRUE(store->add(2, block));
+  }
+  const auto data_path = segmentPath(0, SegmentedFile::kDataExtension);
+  fs::resize_file(data_path, fs::file_size(data_path) - 10);
+
+  auto store = createStore();
+  ASSERT_EQ(store->last_id(), 1);
+  ASSERT_FALSE(store->get(2));
+  ASSERT_TRUE(store->add(2, block));
+  ASSERT_EQ(*store->get(1), block);
+  ASSERT_EQ(*store->get(2), block);
+}
+
+/**
+ * @given storage with two entries and index file of the segment removed
+ * @when storage is reopened
+ * @then both entries are restored from the data file
+ */
+TEST_F(SegmentedFileTest, IndexIsRestored) {
+  {
+    auto store = createStore();
+    ASSERT_TRUE(store->add(1, block));
+    ASSERT_TRUE(store->add(2, block));
+  }
+  fs::remove(segmentPath(0, SegmentedFile::kIndexExtension));
+
+  {
+    auto store = createStore();
+    ASSERT_EQ(store->last_id(), 2);
+    ASSERT_EQ(*store->get(1), block);
+    ASSERT_EQ(*store->get(2), block);
+  }
+  ASSERT_EQ(fs::file_size(segmentPath(0, SegmentedFile::kIndexExtension)),
+            2 * sizeof(SegmentedFile::IndexEntry));
+}
+
+/**
+ * @given storage with entries
+ * @when dropAll is called
+ * @then storage is empty and accepts new entries
+ */
+TEST_F(SegmentedFileTest, DropAll) {
+  auto store = createStore();
+  ASSERT_TRUE(store->add(1, block));
+  store->dropAll();
+  ASSERT_EQ(store->last_id(), 0);
+  ASSERT_FALSE(store->get(1));
+  ASSERT_TRUE(store->add(1, block));
+  ASSERT_EQ(*store->get(1), block);
+}
+
+/**
+ * @given storage with one entry
+ * @when view of the entry is requested
+ * @then the view contains the stored data
+ */
+TEST_F(SegmentedFileTest, GetView) {
+  auto store = createStore();
+  ASSERT_TRUE(store->add(1, block));
+  auto view = store->getView(1);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(std::vector<uint8_t>(view->data(), view->data() + view->size()),
+            block);
+  ASSERT_FALSE(store->getView(2));
+}
+
+/**
+ * @given storage with an entry and a view of the entry
+ * @when more entries are appended to the same segment and read
+ * @then the new entries are readable and the old view stays valid
+ */
+TEST_F(SegmentedFileTest, ViewSurvivesAppend) {
+  auto store = createStore();
+  ASSERT_TRUE(store->add(1, block));
+  auto view = store->getView(1);
+  ASSERT_TRUE(view);
+
+  ASSERT_TRUE(store->add(2, std::vector<uint8_t>(10, 7)));
+  auto res = store->get(2);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, std::vector<uint8_t>(10, 7));
+  ASSERT_EQ(std::vector<uint8_t>(view->data(), view->data() + view->size()),
+            block);
+}
+
+/**
+ * @given empty path
+ * @when storage is created
+ * @then creation fails
+ */
+TEST_F(SegmentedFileTest, WriteEmptyFolder) {
+  ASSERT_FALSE(SegmentedFile::create("", log_));
+}
+
+/**
+ * @given directory with blocks stored by FlatFile as json
+ * @when the blocks are migrated to the segmented storage
+ * @then block files are removed and the blocks are available in binary form
+ */
+TEST_F(SegmentedFileTest, MigrateFlatFileBlocks) {
+  shared_model::proto::ProtoBlockJsonConverter json_converter;
+  shared_model::proto::ProtoBlockBinaryConverter binary_converter;
+  auto block1 = TestBlockBuilder().height(1).build();
+  auto block2 = TestBlockBuilder().height(2).prevHash(block1.hash()).build();
+  {
+    auto flat_file = FlatFile::create(block_store_path, log_);
+    ASSERT_TRUE(flat_file);
+    for (const auto *b : {&block1, &block2}) {
+      auto json = framework::expected::val(json_converter.serialize(*b));
+      ASSERT_TRUE(json);
+      (*flat_file)->add(b->height(), iroha::stringToBytes(json->value));
+    }
+  }
+  ASSERT_TRUE(hasFlatFileBlocks(block_store_path));
+
+  auto store = createStore();
+  auto migrated = framework::expected::val(migrateFlatFileBlocks(
+      block_store_path, *store, json_converter, binary_converter, log_));
+  ASSERT_TRUE(migrated);
+  ASSERT_EQ(migrated->value, 2u);
+  ASSERT_FALSE(hasFlatFileBlocks(block_store_path));
+  ASSERT_EQ(store->last_id(), 2);
+
+  auto stored = store->getView(2);
+  ASSERT_TRUE(stored);
+  auto result = framework::expected::val(
+      binary_converter.deserialize(stored->data(), stored->size()));
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->value->hash(), block2.hash());
+}
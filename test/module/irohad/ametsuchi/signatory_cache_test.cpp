@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/signatory_cache.hpp"
+
+#include <gtest/gtest.h>
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::ametsuchi;
+
+class SignatoryCacheTest : public ::testing::Test {
+ protected:
+  /**
+   * @param tx - transaction to put to the block
+   * @return block with the transaction
+   */
+  shared_model::proto::Block makeBlock(shared_model::proto::Transaction tx) {
+    return TestBlockBuilder()
+        .height(1)
+        .transactions(std::vector<shared_model::proto::Transaction>{tx})
+        .build();
+  }
+
+  TestTransactionBuilder txBuilder() {
+    return TestTransactionBuilder()
+        .creatorAccountId("admin@test")
+        .createdTime(iroha::time::now())
+        .quorum(1);
+  }
+
+  const std::string account_id = "user@test";
+  const SignatoryCache::EntryType entry =
+      std::make_shared<AccountSignatories>(AccountSignatories{{"abcd"}, 1});
+};
+
+/**
+ * @given empty signatory cache
+ * @when signatories of an account are inserted with the current version
+ * @then they are returned for the account
+ */
+TEST_F(SignatoryCacheTest, InsertAndGet) {
+  SignatoryCache cache;
+  ASSERT_FALSE(cache.get(account_id));
+
+  cache.insert(account_id, entry, cache.version());
+
+  ASSERT_EQ(cache.get(account_id), entry);
+}
+
+/**
+ * @given signatory cache, which was invalidated after its version was taken
+ * @when signatories are inserted with the taken version
+ * @then they are not cached
+ */
+TEST_F(SignatoryCacheTest, OutdatedVersionIgnored) {
+  SignatoryCache cache;
+  auto version = cache.version();
+  cache.clear();
+
+  cache.insert(account_id, entry, version);
+
+  ASSERT_FALSE(cache.get(account_id));
+}
+
+/**
+ * @given signatory cache with signatories of two accounts
+ * @when a block which changes quorum of one of them is committed
+ * @then only signatories of that account are forgotten
+ */
+TEST_F(SignatoryCacheTest, InvalidatedBySetQuorum) {
+  SignatoryCache cache;
+  cache.insert(account_id, entry, cache.version());
+  cache.insert("other@test", entry, cache.version());
+
+  cache.invalidate(
+      makeBlock(txBuilder().setAccountQuorum(account_id, 2).build()));
+
+  ASSERT_FALSE(cache.get(account_id));
+  ASSERT_TRUE(cache.get("other@test"));
+}
+
+/**
+ * @given transaction which adds a signatory to one account and appends a role
+ * to another one
+ * @when accounts affected by the transaction are requested
+ * @then only the account with the added signatory is returned
+ */
+TEST_F(SignatoryCacheTest, AffectedAccounts) {
+  auto tx = txBuilder()
+                .addSignatory(account_id, shared_model::crypto::PublicKey("a"))
+                .appendRole("other@test", "role")
+                .build();
+
+  ASSERT_EQ(SignatoryCache::affectedAccounts(tx),
+            std::vector<std::string>{account_id});
+}
@@ -13,7 +13,7 @@
 #include <boost/uuid/uuid_io.hpp>
 #include "ametsuchi/impl/in_memory_block_storage_factory.hpp"
 #include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
-#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
 #include "backend/protobuf/proto_permission_to_string.hpp"
 #include "framework/config_helper.hpp"
 #include "framework/test_logger.hpp"
@@ -48,8 +48,8 @@ class StorageInitTest : public ::testing::Test {
       factory = std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
           shared_model::validation::FieldValidator>>();
 
-  std::shared_ptr<shared_model::proto::ProtoBlockJsonConverter> converter =
-      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+  std::shared_ptr<shared_model::proto::ProtoBlockBinaryConverter> converter =
+      std::make_shared<shared_model::proto::ProtoBlockBinaryConverter>();
 
   std::shared_ptr<shared_model::interface::PermissionToString> perm_converter_ =
       std::make_shared<shared_model::proto::ProtoPermissionToString>();
@@ -124,3 +124,51 @@ TEST_F(StorageInitTest, CreateStorageWithInvalidPgOpt) {
           },
           [](const Error<std::string> &) { SUCCEED(); });
 }
+
+/**
+ * @given database with block index tables of an earlier version, which store
+ * heights and indexes as text
+ * @when Create storage using that database
+ * @then the columns are converted to bigint @and indexed rows are kept
+ */
+TEST_F(StorageInitTest, MigrateTextIndexColumns) {
+  {
+    soci::session sql(*soci::factory_postgresql(), pg_opt_without_dbname_);
+    sql << "CREATE DATABASE " + dbname_;
+  }
+  {
+    soci::session sql(*soci::factory_postgresql(), pgopt_);
+    sql << "CREATE TABLE position_by_hash (hash varchar, height text, "
+           "index text);"
+           "INSERT INTO position_by_hash VALUES ('hash', '10', '2');";
+  }
+
+  std::shared_ptr<StorageImpl> storage;
+  StorageImpl::create(block_store_path,
+                      pgopt_,
+                      factory,
+                      converter,
+                      perm_converter_,
+                      std::move(block_storage_factory_),
+                      storage_log_manager_)
+      .match(
+          [&storage](const Value<std::shared_ptr<StorageImpl>> &value) {
+            storage = value.value;
+          },
+          [](const Error<std::string> &error) { FAIL() << error.error; });
+  ASSERT_TRUE(storage);
+
+  {
+    soci::session sql(*soci::factory_postgresql(), pgopt_);
+    std::string type;
+    sql << "SELECT data_type FROM information_schema.columns "
+           "WHERE table_name = 'position_by_hash' AND column_name = 'height'",
+        soci::into(type);
+    ASSERT_EQ(type, "bigint");
+    long long height = 0;
+    sql << "SELECT height FROM position_by_hash WHERE hash = 'hash'",
+        soci::into(height);
+    ASSERT_EQ(height, 10);
+  }
+  storage->dropStorage();
+}
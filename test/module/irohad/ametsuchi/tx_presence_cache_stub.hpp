@@ -32,6 +32,17 @@ namespace iroha {
                        [](auto &tx) { return T{tx->hash()}; });
         return result;
       }
+
+      boost::optional<std::vector<TxCacheStatusType>> check(
+          const std::vector<shared_model::crypto::Hash> &hashes)
+          const override {
+        std::vector<TxCacheStatusType> result;
+        std::transform(hashes.begin(),
+                       hashes.end(),
+                       std::back_inserter(result),
+                       [](auto &hash) { return T{hash}; });
+        return result;
+      }
     };
 
   }  // namespace ametsuchi
@@ -166,3 +166,44 @@ TEST_F(TxPresenceCacheTest, BatchHashTest) {
         FAIL() << error.error;
       });
 }
+
+/**
+ * @given hash with Committed status in cache, hashes with Rejected and
+ * Missing statuses in storage
+ * @when cache asked for statuses of the hashes
+ * @then only the hashes, which are not cached, are checked in storage with a
+ * single query
+ * @and the statuses are returned in the order of hashes
+ */
+TEST_F(TxPresenceCacheTest, HashesTest) {
+  shared_model::crypto::Hash hash1("1");
+  shared_model::crypto::Hash hash2("2");
+  shared_model::crypto::Hash hash3("3");
+  EXPECT_CALL(*mock_block_query, checkTxPresence(hash1))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Committed(hash1))));
+  EXPECT_CALL(*mock_block_query,
+              checkTxsPresence(ElementsAre(hash2, hash3)))
+      .WillOnce(Return(std::vector<TxCacheStatusType>{
+          tx_cache_status_responses::Rejected(hash2),
+          tx_cache_status_responses::Missing(hash3)}));
+  TxPresenceCacheImpl cache(mock_storage);
+  ASSERT_TRUE(cache.check(hash1));
+
+  auto statuses = cache.check(std::vector<shared_model::crypto::Hash>{
+      hash1, hash2, hash3});
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(3, statuses->size());
+  tx_cache_status_responses::Committed ts1;
+  tx_cache_status_responses::Rejected ts2;
+  tx_cache_status_responses::Missing ts3;
+  ASSERT_NO_THROW(ts1 = boost::get<tx_cache_status_responses::Committed>(
+                      statuses->at(0)));
+  ASSERT_NO_THROW(ts2 = boost::get<tx_cache_status_responses::Rejected>(
+                      statuses->at(1)));
+  ASSERT_NO_THROW(ts3 = boost::get<tx_cache_status_responses::Missing>(
+                      statuses->at(2)));
+  ASSERT_EQ(hash1, ts1.hash);
+  ASSERT_EQ(hash2, ts2.hash);
+  ASSERT_EQ(hash3, ts3.hash);
+}
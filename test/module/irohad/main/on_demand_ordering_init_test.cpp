@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "main/impl/on_demand_ordering_init.hpp"
+
+#include <gtest/gtest.h>
+#include "backend/protobuf/proto_proposal_factory.hpp"
+#include "builders/protobuf/transaction.hpp"
+#include "datetime/time.hpp"
+#include "framework/test_logger.hpp"
+#include "interfaces/iroha_internal/transaction_batch_impl.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/shared_model/validators/validators.hpp"
+#include "ordering/impl/on_demand_common.hpp"
+
+using namespace iroha;
+using namespace iroha::ordering;
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+using shared_model::validation::MockValidator;
+using MockProposalValidator =
+    MockValidator<shared_model::interface::Proposal>;
+
+class OnDemandOrderingInitTest : public ::testing::Test {
+ public:
+  /**
+   * Create the ordering service the same way the daemon does
+   * @param group_conflicting_batches - value of the configuration parameter
+   * @return ordering service
+   */
+  std::shared_ptr<OnDemandOrderingService> createService(
+      bool group_conflicting_batches) {
+    auto tx_cache =
+        std::make_shared<NiceMock<iroha::ametsuchi::MockTxPresenceCache>>();
+    ON_CALL(*tx_cache,
+            check(testing::Matcher<
+                  const shared_model::interface::TransactionBatch &>(_)))
+        .WillByDefault(
+            Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
+                iroha::ametsuchi::tx_cache_status_responses::Missing()}));
+    return init.createService(
+        kTransactionLimit,
+        std::make_shared<
+            shared_model::proto::ProtoProposalFactory<MockProposalValidator>>(),
+        std::move(tx_cache),
+        group_conflicting_batches,
+        getTestLoggerManager());
+  }
+
+  OnDemandOrderingService::CollectionType makeBatch(
+      shared_model::interface::types::TimestampType created_time,
+      const std::string &creator) {
+    OnDemandOrderingService::CollectionType collection;
+    collection.push_back(
+        std::make_unique<shared_model::interface::TransactionBatchImpl>(
+            shared_model::interface::types::SharedTxsCollectionType{
+                std::make_unique<shared_model::proto::Transaction>(
+                    shared_model::proto::TransactionBuilder()
+                        .createdTime(created_time)
+                        .creatorAccountId(creator)
+                        .createAsset("asset", "domain", 1)
+                        .quorum(1)
+                        .build()
+                        .signAndAddSignature(
+                            shared_model::crypto::DefaultCryptoAlgorithmType::
+                                generateKeypair())
+                        .finish())}));
+    return collection;
+  }
+
+  /**
+   * Send batches of two creators interleaved, and get the proposal of them
+   * @return creators of transactions in the order of the proposal
+   */
+  std::vector<std::string> proposalCreators(OnDemandOrderingService &os) {
+    auto now = iroha::time::now();
+    os.onBatches(makeBatch(now, "a@test"));
+    os.onBatches(makeBatch(now, "b@test"));
+    os.onBatches(makeBatch(now + 1, "a@test"));
+
+    os.onCollaborationOutcome({3, kFirstRejectRound});
+
+    std::vector<std::string> creators;
+    auto proposal = os.onRequestProposal({4, kNextCommitRoundConsumer});
+    if (proposal) {
+      for (const auto &tx : (*proposal)->transactions()) {
+        creators.push_back(tx.creatorAccountId());
+      }
+    }
+    return creators;
+  }
+
+  const size_t kTransactionLimit = 10;
+  network::OnDemandOrderingInit init{getTestLogger("OrderingInit")};
+};
+
+/**
+ * @given ordering service created by ordering initialization with grouping of
+ * conflicting batches enabled
+ * @when batches of two creators arrive interleaved
+ * @then batches of each creator are adjacent in the proposal
+ */
+TEST_F(OnDemandOrderingInitTest, ServiceGroupsConflictingBatches) {
+  auto os = createService(true);
+  EXPECT_EQ(proposalCreators(*os),
+            (std::vector<std::string>{"a@test", "a@test", "b@test"}));
+}
+
+/**
+ * @given ordering service created by ordering initialization with grouping of
+ * conflicting batches disabled
+ * @when batches of two creators arrive interleaved
+ * @then batches are packed one per creator in the order of arrival
+ */
+TEST_F(OnDemandOrderingInitTest, ServiceKeepsArrivalOrder) {
+  auto os = createService(false);
+  EXPECT_EQ(proposalCreators(*os),
+            (std::vector<std::string>{"a@test", "b@test", "a@test"}));
+}
@@ -151,8 +151,9 @@ TEST_F(BlockLoaderTest, ValidWhenSameTopBlock) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(block.height() + 1))
-      .WillOnce(Return(std::vector<wBlock>()));
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(block.height()));
+  EXPECT_CALL(*storage, getBlocks(_, _)).Times(0);
 
   auto wrapper = make_test_subscriber<CallExact>(
       loader->retrieveBlocks(1, peer->pubkey()), 0);
@@ -185,7 +186,9 @@ TEST_F(BlockLoaderTest, ValidWhenOneBlock) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(block.height() + 1))
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(top_block.height()));
+  EXPECT_CALL(*storage, getBlocks(block.height() + 1, 1))
       .WillOnce(Return(std::vector<wBlock>{clone(top_block)}));
   auto wrapper =
       make_test_subscriber<CallExact>(loader->retrieveBlocks(1, peer_key), 1);
@@ -225,7 +228,10 @@ TEST_F(BlockLoaderTest, ValidWhenMultipleBlocks) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(next_height)).WillOnce(Return(blocks));
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(next_height + num_blocks - 1));
+  EXPECT_CALL(*storage, getBlocks(next_height, num_blocks))
+      .WillOnce(Return(blocks));
   auto wrapper = make_test_subscriber<CallExact>(
       loader->retrieveBlocks(1, peer_key), num_blocks);
   auto height = next_height;
@@ -254,7 +260,7 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
       .WillOnce(Return(std::vector<wPeer>{peer}));
   EXPECT_CALL(*validator, validate(RefAndPointerEq(block)))
       .WillOnce(Return(Answer{}));
-  EXPECT_CALL(*storage, getBlocksFrom(_)).Times(0);
+  EXPECT_CALL(*storage, getBlockByHash(_)).Times(0);
   auto retrieved_block = loader->retrieveBlock(peer_key, block->hash());
 
   ASSERT_TRUE(retrieved_block);
@@ -280,10 +286,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(
-          Return(std::vector<std::shared_ptr<shared_model::interface::Block>>{
-              prev_block, cur_block}));
+  EXPECT_CALL(*storage, getBlockByHash(prev_block->hash()))
+      .WillOnce(Return(iroha::expected::makeValue(wBlock{prev_block})));
 
   auto block = loader->retrieveBlock(peer_key, prev_block->hash());
   ASSERT_TRUE(block);
@@ -307,10 +311,8 @@ TEST_F(BlockLoaderTest, ValidWithEmptyCache) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(
-          Return(std::vector<std::shared_ptr<shared_model::interface::Block>>{
-              prev_block, cur_block}));
+  EXPECT_CALL(*storage, getBlockByHash(prev_block->hash()))
+      .WillOnce(Return(iroha::expected::makeValue(wBlock{prev_block})));
 
   auto block = loader->retrieveBlock(peer_key, prev_block->hash());
   ASSERT_TRUE(block);
@@ -326,9 +328,11 @@ TEST_F(BlockLoaderTest, ValidWithEmptyCache) {
 TEST_F(BlockLoaderTest, NoBlocksInStorage) {
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(
-          std::vector<std::shared_ptr<shared_model::interface::Block>>{}));
+  EXPECT_CALL(*storage, getBlockByHash(kPrevHash))
+      .WillOnce(Return(iroha::expected::makeError(
+          iroha::ametsuchi::BlockQuery::GetBlockError{
+              iroha::ametsuchi::BlockQuery::GetBlockError::Code::kNoBlock,
+              "Block is not found"})));
 
   auto block = loader->retrieveBlock(peer_key, kPrevHash);
   ASSERT_FALSE(block);
@@ -70,6 +70,8 @@ namespace iroha {
 
       MOCK_METHOD0(onProposal, rxcpp::observable<OrderingEvent>());
 
+      MOCK_METHOD0(onPrefetchedProposal, rxcpp::observable<OrderingEvent>());
+
       MOCK_METHOD1(setPcs, void(const PeerCommunicationService &));
     };
 
@@ -20,6 +20,14 @@ namespace iroha {
         MOCK_METHOD1(onRequestProposal,
                      boost::optional<std::shared_ptr<const ProposalType>>(
                          consensus::Round));
+
+        MOCK_METHOD2(onRequestProposalAsync,
+                     void(consensus::Round, ProposalCallbackType));
+
+        MOCK_METHOD1(
+            proposalIssuer,
+            boost::optional<shared_model::interface::types::PubkeyType>(
+                consensus::Round));
       };
 
     }  // namespace transport
@@ -18,6 +18,16 @@ using ::testing::Return;
 using ::testing::ReturnRef;
 using ::testing::UnorderedElementsAre;
 
+/**
+ * @param hash - hash of the only transaction of the batch
+ * @return batch with the transaction
+ */
+auto createBatchWithTransactionHash(
+    const shared_model::interface::types::HashType &hash) {
+  return createMockBatchWithTransactions({createMockTransactionWithHash(hash)},
+                                         hash.hex());
+}
+
 /**
  * @given empty cache
  * @when add to back is invoked with batch1 and batch2
@@ -27,10 +37,10 @@ TEST(OnDemandCacheTest, TestAddToBack) {
   OnDemandCache cache;
 
   shared_model::interface::types::HashType hash1("hash1");
-  auto batch1 = createMockBatchWithHash(hash1);
+  auto batch1 = createBatchWithTransactionHash(hash1);
 
   shared_model::interface::types::HashType hash2("hash2");
-  auto batch2 = createMockBatchWithHash(hash2);
+  auto batch2 = createBatchWithTransactionHash(hash2);
 
   cache.addToBack({batch1, batch2});
 
@@ -51,9 +61,9 @@ TEST(OnDemandCache, Pop) {
   shared_model::interface::types::HashType hash2("hash2");
   shared_model::interface::types::HashType hash3("hash3");
 
-  auto batch1 = createMockBatchWithHash(hash1);
-  auto batch2 = createMockBatchWithHash(hash2);
-  auto batch3 = createMockBatchWithHash(hash3);
+  auto batch1 = createBatchWithTransactionHash(hash1);
+  auto batch2 = createBatchWithTransactionHash(hash2);
+  auto batch3 = createBatchWithTransactionHash(hash3);
 
   cache.addToBack({batch1});
   /**
@@ -140,3 +150,75 @@ TEST(OnDemandCache, Remove) {
    */
   ASSERT_THAT(cache.head(), ElementsAre(batch2));
 }
+
+/**
+ * @given cache with batch1 in the middle and batch2 in the tail
+ * @when remove is invoked with hashes of transactions of both batches
+ * @then both batches are removed from their places
+ * AND nothing is popped afterwards
+ */
+TEST(OnDemandCache, RemoveFromAnyPlace) {
+  OnDemandCache cache;
+
+  shared_model::interface::types::HashType hash1("hash1");
+  shared_model::interface::types::HashType hash2("hash2");
+
+  auto batch1 = createBatchWithTransactionHash(hash1);
+  auto batch2 = createBatchWithTransactionHash(hash2);
+
+  cache.addToBack({batch1});
+  cache.pop();
+  cache.addToBack({batch2});
+  /**
+   * 1. {}
+   * 2. {batch1}
+   * 3. {batch2}
+   */
+  cache.remove({hash1, hash2});
+
+  ASSERT_THAT(cache.tail(), IsEmpty());
+  ASSERT_EQ(0, cache.metrics().batches);
+  ASSERT_THAT(cache.pop(), IsEmpty());
+  ASSERT_THAT(cache.pop(), IsEmpty());
+  ASSERT_THAT(cache.pop(), IsEmpty());
+}
+
+/**
+ * @given cache with batch1 in the head
+ * @when batch1 is popped and added to the back with batch2
+ * @then metrics count both batches and their transactions
+ * AND batch1 is not duplicated, when it is added to the back again
+ */
+TEST(OnDemandCache, Metrics) {
+  OnDemandCache cache;
+
+  shared_model::interface::types::HashType hash1("hash1");
+  shared_model::interface::types::HashType hash2("hash2");
+  shared_model::interface::types::HashType hash3("hash3");
+
+  auto batch1 = createMockBatchWithTransactions(
+      {createMockTransactionWithHash(hash1),
+       createMockTransactionWithHash(hash2)},
+      "batch1");
+  auto batch2 = createBatchWithTransactionHash(hash3);
+
+  ASSERT_EQ(0, cache.metrics().batches);
+  ASSERT_EQ(std::chrono::milliseconds::zero(),
+            cache.metrics().oldest_batch_age);
+
+  cache.addToBack({batch1});
+  cache.pop();
+  cache.pop();
+  cache.addToBack(cache.pop());
+  cache.addToBack({batch1, batch2});
+
+  auto metrics = cache.metrics();
+  ASSERT_EQ(2, metrics.batches);
+  ASSERT_EQ(3, metrics.transactions);
+  ASSERT_THAT(cache.tail(), UnorderedElementsAre(batch1, batch2));
+
+  cache.remove({hash2});
+  metrics = cache.metrics();
+  ASSERT_EQ(1, metrics.batches);
+  ASSERT_EQ(1, metrics.transactions);
+}
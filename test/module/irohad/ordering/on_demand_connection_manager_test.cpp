@@ -17,7 +17,9 @@ using namespace iroha;
 using namespace iroha::ordering;
 using namespace iroha::ordering::transport;
 
+using ::testing::_;
 using ::testing::ByMove;
+using ::testing::Invoke;
 using ::testing::Ref;
 using ::testing::Return;
 
@@ -130,3 +132,81 @@ TEST_F(OnDemandConnectionManagerTest, onRequestProposalNone) {
 
   ASSERT_FALSE(result);
 }
+
+/**
+ * @given initialized OnDemandConnectionManager
+ * @when onRequestProposalAsync is called for the possible next rounds
+ * @then issuers of the corresponding rounds are triggered
+ */
+TEST_F(OnDemandConnectionManagerTest, onRequestProposalAsync) {
+  auto reject_round = nextRejectRound(cpeers.round);
+  auto commit_round = nextCommitRound(cpeers.round);
+  EXPECT_CALL(
+      *connections[OnDemandConnectionManager::kNextRejectRoundIssuer],
+      onRequestProposalAsync(reject_round, _))
+      .Times(1);
+  EXPECT_CALL(
+      *connections[OnDemandConnectionManager::kNextCommitRoundIssuer],
+      onRequestProposalAsync(commit_round, _))
+      .Times(1);
+
+  manager->onRequestProposalAsync(reject_round, [](auto) {});
+  manager->onRequestProposalAsync(commit_round, [](auto) {});
+}
+
+/**
+ * @given initialized OnDemandConnectionManager
+ * @when onRequestProposalAsync is called for a round which does not follow
+ * the current one
+ * @then no peer is triggered
+ * AND no proposal is returned
+ */
+TEST_F(OnDemandConnectionManagerTest, onRequestProposalAsyncUnknownRound) {
+  consensus::Round round{cpeers.round.block_round + 2, 0};
+  for (auto &connection : connections) {
+    EXPECT_CALL(*connection, onRequestProposalAsync(_, _)).Times(0);
+  }
+
+  bool called = false;
+  manager->onRequestProposalAsync(round, [&called](auto proposal) {
+    called = true;
+    ASSERT_FALSE(proposal);
+  });
+
+  ASSERT_TRUE(called);
+}
+
+/**
+ * @given initialized OnDemandConnectionManager
+ * @when peers are selected with the current peer list
+ * AND the peers of the next commit round are selected with a changed list
+ * @then the issuer of the round is the guessed peer before the change
+ * AND the actually selected peer after the change
+ * AND issuer of a round, which does not follow the current one, is unknown
+ */
+TEST_F(OnDemandConnectionManagerTest, ProposalIssuerOnPeersChange) {
+  EXPECT_CALL(*factory, create(_)).WillRepeatedly(Invoke([](const auto &) {
+    return std::unique_ptr<OdOsNotification>(
+        std::make_unique<MockOdOsNotification>());
+  }));
+  shared_model::crypto::PublicKey guessed_key("guessed"),
+      actual_key("actual");
+  auto select = [this](auto round, auto peer) {
+    OnDemandConnectionManager::CurrentPeers current_peers;
+    current_peers.peers.fill(peer);
+    current_peers.round = round;
+    peers.get_subscriber().on_next(current_peers);
+  };
+  auto commit_round = nextCommitRound(cpeers.round);
+
+  select(cpeers.round, makePeer("guessed", guessed_key));
+  auto guessed_issuer = manager->proposalIssuer(commit_round);
+  ASSERT_TRUE(guessed_issuer);
+  ASSERT_EQ(guessed_key, *guessed_issuer);
+
+  select(commit_round, makePeer("actual", actual_key));
+  auto actual_issuer = manager->proposalIssuer(commit_round);
+  ASSERT_TRUE(actual_issuer);
+  ASSERT_EQ(actual_key, *actual_issuer);
+  ASSERT_FALSE(manager->proposalIssuer(cpeers.round));
+}
@@ -23,8 +23,10 @@ using namespace iroha::network;
 using namespace framework::test_subscriber;
 
 using ::testing::_;
+using ::testing::AnyNumber;
 using ::testing::AtMost;
 using ::testing::ByMove;
+using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnRefOfCopy;
@@ -195,6 +197,152 @@ TEST_F(OnDemandOrderingGateTest, EmptyEventNoProposal) {
   ASSERT_TRUE(gate_wrapper.validate());
 }
 
+/**
+ * @given initialized ordering gate
+ * @when a block round event is received from the PCS
+ * AND the proposal of the next commit round is prefetched
+ * AND a block round event of the next commit round is received
+ * @then the prefetched proposal is emitted as soon as it is received
+ * AND it is used for the next round
+ * AND it is not requested from the network again
+ */
+TEST_F(OnDemandOrderingGateTest, PrefetchedProposal) {
+  auto next_round = nextCommitRound(round);
+  auto mproposal = std::make_unique<MockProposal>();
+  auto proposal = mproposal.get();
+  boost::optional<std::shared_ptr<const OdOsNotification::ProposalType>>
+      oproposal(std::move(mproposal));
+  std::vector<std::shared_ptr<MockTransaction>> txs{
+      std::make_shared<MockTransaction>()};
+  ON_CALL(*txs[0], hash())
+      .WillByDefault(ReturnRefOfCopy(shared_model::crypto::Hash("")));
+  ON_CALL(*proposal, transactions())
+      .WillByDefault(Return(txs | boost::adaptors::indirected));
+
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(round)).Times(1);
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(next_round)).Times(1);
+  EXPECT_CALL(*notification, onRequestProposal(round))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*notification, onRequestProposal(next_round)).Times(0);
+  // prefetch of rounds after the next one
+  EXPECT_CALL(*notification, onRequestProposalAsync(_, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(*notification, onRequestProposalAsync(next_round, _))
+      .WillOnce(Invoke(
+          [&](consensus::Round, OdOsNotification::ProposalCallbackType f) {
+            f(oproposal);
+          }));
+  EXPECT_CALL(*notification, onRequestProposalAsync(nextRejectRound(round), _))
+      .WillOnce(Invoke(
+          [](consensus::Round, OdOsNotification::ProposalCallbackType f) {
+            f(boost::none);
+          }));
+
+  auto gate_wrapper =
+      make_test_subscriber<CallExact>(ordering_gate->onProposal(), 2);
+  gate_wrapper.subscribe([&](auto val) {
+    if (val.round == next_round) {
+      ASSERT_EQ(proposal, getProposalUnsafe(val).get());
+    } else {
+      ASSERT_FALSE(val.proposal);
+    }
+  });
+
+  auto prefetched_wrapper =
+      make_test_subscriber<CallExact>(ordering_gate->onPrefetchedProposal(), 1);
+  prefetched_wrapper.subscribe([&](auto val) {
+    EXPECT_EQ(val.round, next_round);
+    EXPECT_EQ(proposal, getProposalUnsafe(val).get());
+  });
+
+  rounds.get_subscriber().on_next(OnDemandOrderingGate::BlockEvent{round, {}});
+  rounds.get_subscriber().on_next(
+      OnDemandOrderingGate::BlockEvent{next_round, {}});
+
+  ASSERT_TRUE(gate_wrapper.validate());
+  ASSERT_TRUE(prefetched_wrapper.validate());
+}
+
+/**
+ * @given initialized ordering gate
+ * @when a block round event is received from the PCS
+ * AND the proposal of the next commit round is prefetched from the issuer
+ * selected with the current peer list
+ * AND the peer list is changed by the block, so that the next commit round
+ * has another issuer
+ * AND a block round event of the next commit round is received
+ * @then the prefetched proposal is discarded
+ * AND the proposal is requested from the actual issuer
+ */
+TEST_F(OnDemandOrderingGateTest, PrefetchedProposalOfChangedIssuer) {
+  auto next_round = nextCommitRound(round);
+  auto mproposal = std::make_unique<MockProposal>();
+  boost::optional<std::shared_ptr<const OdOsNotification::ProposalType>>
+      oproposal(std::move(mproposal));
+
+  std::string issuer = "guessed";
+  EXPECT_CALL(*notification, proposalIssuer(_))
+      .WillRepeatedly(Invoke([&issuer](consensus::Round) {
+        return boost::make_optional(shared_model::crypto::PublicKey(issuer));
+      }));
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(round)).Times(1);
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(next_round)).Times(1);
+  EXPECT_CALL(*notification, onRequestProposal(round))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*notification, onRequestProposal(next_round))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*notification, onRequestProposalAsync(_, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(*notification, onRequestProposalAsync(next_round, _))
+      .WillOnce(Invoke(
+          [&](consensus::Round, OdOsNotification::ProposalCallbackType f) {
+            f(oproposal);
+          }));
+
+  auto gate_wrapper =
+      make_test_subscriber<CallExact>(ordering_gate->onProposal(), 2);
+  gate_wrapper.subscribe([&](auto val) { ASSERT_FALSE(val.proposal); });
+
+  rounds.get_subscriber().on_next(OnDemandOrderingGate::BlockEvent{round, {}});
+  issuer = "actual";
+  rounds.get_subscriber().on_next(
+      OnDemandOrderingGate::BlockEvent{next_round, {}});
+
+  ASSERT_TRUE(gate_wrapper.validate());
+}
+
+/**
+ * @given initialized ordering gate
+ * @when an empty block round event is received from the PCS
+ * AND no proposal of the next reject round is prefetched
+ * AND an empty block round event of the next reject round is received
+ * @then the proposal of the next round is requested from the network
+ */
+TEST_F(OnDemandOrderingGateTest, PrefetchedNoProposal) {
+  auto next_round = nextRejectRound(round);
+
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(round)).Times(1);
+  EXPECT_CALL(*ordering_service, onCollaborationOutcome(next_round)).Times(1);
+  EXPECT_CALL(*notification, onRequestProposal(round))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*notification, onRequestProposal(next_round))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*notification, onRequestProposalAsync(_, _))
+      .WillRepeatedly(Invoke(
+          [](consensus::Round, OdOsNotification::ProposalCallbackType f) {
+            f(boost::none);
+          }));
+
+  auto gate_wrapper =
+      make_test_subscriber<CallExact>(ordering_gate->onProposal(), 2);
+  gate_wrapper.subscribe([&](auto val) { ASSERT_FALSE(val.proposal); });
+
+  rounds.get_subscriber().on_next(OnDemandOrderingGate::EmptyEvent{round});
+  rounds.get_subscriber().on_next(OnDemandOrderingGate::EmptyEvent{next_round});
+
+  ASSERT_TRUE(gate_wrapper.validate());
+}
+
 /**
  * @given initialized ordering gate
  * @when new proposal arrives and the transaction was already committed
@@ -5,6 +5,10 @@
 
 #include "ordering/impl/on_demand_os_client_grpc.hpp"
 
+#include <future>
+#include <thread>
+
+#include <grpcpp/alarm.h>
 #include <gtest/gtest.h>
 #include "backend/protobuf/proposal.hpp"
 #include "backend/protobuf/proto_transport_factory.hpp"
@@ -13,6 +17,7 @@
 #include "framework/test_logger.hpp"
 #include "interfaces/iroha_internal/proposal.hpp"
 #include "interfaces/iroha_internal/transaction_batch_impl.hpp"
+#include "module/shared_model/interface_mocks.hpp"
 #include "module/shared_model/validators/validators.hpp"
 #include "ordering_mock.grpc.pb.h"
 
@@ -23,6 +28,7 @@ using namespace iroha::ordering::transport;
 using grpc::testing::MockClientAsyncResponseReader;
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SaveArg;
 using ::testing::SetArgPointee;
@@ -45,9 +51,19 @@ class OnDemandOsClientGrpcTest : public ::testing::Test {
   void SetUp() override {
     auto ustub = std::make_unique<proto::MockOnDemandOrderingStub>();
     stub = ustub.get();
+    batches_stub = std::make_shared<proto::MockOnDemandOrderingStub>();
     async_call =
         std::make_shared<network::AsyncGrpcClient<google::protobuf::Empty>>(
             getTestLogger("AsyncCall"));
+    batches_queue = std::make_shared<OutboundBatchesQueue>(
+        batches_stub,
+        async_call,
+        OnDemandOsClientGrpcFactory::kDefaultMaxBatchesRequestSize,
+        OnDemandOsClientGrpcFactory::kDefaultMaxBatchesRequestsInFlight,
+        getTestLogger("BatchesQueue"));
+    proposal_async_call =
+        std::make_shared<network::AsyncGrpcClient<proto::ProposalResponse>>(
+            getTestLogger("AsyncProposalCall"));
     auto validator = std::make_unique<MockProposalValidator>();
     proposal_validator = validator.get();
     auto proto_validator = std::make_unique<MockProtoProposalValidator>();
@@ -56,7 +72,8 @@ class OnDemandOsClientGrpcTest : public ::testing::Test {
         std::move(validator), std::move(proto_validator));
     client =
         std::make_shared<OnDemandOsClientGrpc>(std::move(ustub),
-                                               async_call,
+                                               batches_queue,
+                                               proposal_async_call,
                                                proposal_factory,
                                                [&] { return timepoint; },
                                                timeout,
@@ -64,7 +81,11 @@ class OnDemandOsClientGrpcTest : public ::testing::Test {
   }
 
   proto::MockOnDemandOrderingStub *stub;
+  std::shared_ptr<proto::MockOnDemandOrderingStub> batches_stub;
   std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>> async_call;
+  std::shared_ptr<OutboundBatchesQueue> batches_queue;
+  std::shared_ptr<network::AsyncGrpcClient<proto::ProposalResponse>>
+      proposal_async_call;
   OnDemandOsClientGrpc::TimepointType timepoint;
   std::chrono::milliseconds timeout{1};
   std::shared_ptr<OnDemandOsClientGrpc> client;
@@ -78,13 +99,14 @@ class OnDemandOsClientGrpcTest : public ::testing::Test {
 /**
  * @given client
  * @when onBatches is called
+ * AND the queue of batches is flushed
  * @then data is correctly serialized and sent
  */
 TEST_F(OnDemandOsClientGrpcTest, onBatches) {
   proto::BatchesRequest request;
   auto r = std::make_unique<
       MockClientAsyncResponseReader<google::protobuf::Empty>>();
-  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _))
+  EXPECT_CALL(*batches_stub, AsyncSendBatchesRaw(_, _, _))
       .WillOnce(DoAll(SaveArg<1>(&request), Return(r.get())));
 
   OdOsNotification::CollectionType collection;
@@ -97,6 +119,7 @@ TEST_F(OnDemandOsClientGrpcTest, onBatches) {
           shared_model::interface::types::SharedTxsCollectionType{
               std::make_unique<shared_model::proto::Transaction>(tx)}));
   client->onBatches(std::move(collection));
+  batches_queue->flush();
 
   ASSERT_EQ(request.transactions()
                 .Get(0)
@@ -169,3 +192,89 @@ TEST_F(OnDemandOsClientGrpcTest, onRequestProposalNone) {
   ASSERT_EQ(request.round().reject_round(), round.reject_round);
   ASSERT_FALSE(proposal);
 }
+
+/**
+ * @given client
+ * @when onRequestProposalAsync is called
+ * AND proposal returned
+ * @then data is correctly serialized and sent
+ * AND reply is correctly deserialized and passed to the callback
+ */
+TEST_F(OnDemandOsClientGrpcTest, onRequestProposalAsync) {
+  std::chrono::system_clock::time_point deadline;
+  proto::ProposalRequest request;
+  grpc::CompletionQueue *cq = nullptr;
+  auto creator = "test";
+  proto::ProposalResponse response;
+  response.mutable_proposal()
+      ->add_transactions()
+      ->mutable_payload()
+      ->mutable_reduced_payload()
+      ->set_creator_account_id(creator);
+  // the reader is owned by the client after the call
+  auto reader = new MockClientAsyncResponseReader<proto::ProposalResponse>();
+  // completion of the call is emulated with an alarm on its queue
+  grpc::Alarm alarm;
+  EXPECT_CALL(*stub, AsyncRequestProposalRaw(_, _, _))
+      .WillOnce(DoAll(SaveClientContextDeadline(&deadline),
+                      SaveArg<1>(&request),
+                      SaveArg<2>(&cq),
+                      Return(reader)));
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce(DoAll(
+          SetArgPointee<0>(response),
+          SetArgPointee<1>(grpc::Status::OK),
+          Invoke([&](proto::ProposalResponse *, grpc::Status *, void *tag) {
+            alarm.Set(cq, gpr_now(GPR_CLOCK_REALTIME), tag);
+          })));
+
+  std::promise<
+      boost::optional<std::shared_ptr<const OdOsNotification::ProposalType>>>
+      promise;
+  auto future = promise.get_future();
+  client->onRequestProposalAsync(
+      round, [&promise](auto proposal) { promise.set_value(proposal); });
+
+  ASSERT_EQ(std::future_status::ready,
+            future.wait_for(std::chrono::seconds(1)));
+  auto proposal = future.get();
+  ASSERT_EQ(timepoint + timeout, deadline);
+  ASSERT_EQ(request.round().block_round(), round.block_round);
+  ASSERT_EQ(request.round().reject_round(), round.reject_round);
+  ASSERT_TRUE(proposal);
+  ASSERT_EQ(proposal.value()->transactions()[0].creatorAccountId(), creator);
+}
+
+/**
+ * @given client factory
+ * @when several clients of a peer are created
+ * AND all of them are destroyed
+ * @then the clients share a single queue of batches
+ * AND the queue is removed after the last client is destroyed
+ */
+TEST_F(OnDemandOsClientGrpcTest, FactoryRemovesUnusedQueues) {
+  OnDemandOsClientGrpcFactory factory(async_call,
+                                      proposal_async_call,
+                                      proposal_factory,
+                                      [&] { return timepoint; },
+                                      timeout,
+                                      getTestLogger("OdOsClientGrpcFactory"),
+                                      std::chrono::milliseconds(1));
+  auto peer =
+      makePeer("127.0.0.1:10001", shared_model::crypto::PublicKey("key"));
+
+  auto first = factory.create(*peer);
+  auto second = factory.create(*peer);
+  ASSERT_EQ(1, factory.queuesCount());
+
+  first.reset();
+  second.reset();
+  // queues are removed by the flush thread
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (factory.queuesCount() != 0
+         and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(0, factory.queuesCount());
+  ASSERT_EQ(0, factory.metrics().batches_dropped);
+}
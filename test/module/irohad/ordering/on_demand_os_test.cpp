@@ -62,6 +62,13 @@ class OnDemandOsTest : public ::testing::Test {
                 _)))
         .WillByDefault(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
             iroha::ametsuchi::tx_cache_status_responses::Missing()}));
+    ON_CALL(*mock_cache,
+            check(Matcher<const std::vector<shared_model::crypto::Hash> &>(_)))
+        .WillByDefault(Invoke([](const auto &hashes) {
+          return std::vector<iroha::ametsuchi::TxCacheStatusType>(
+              hashes.size(),
+              iroha::ametsuchi::tx_cache_status_responses::Missing());
+        }));
     os = std::make_shared<OnDemandOrderingServiceImpl>(
         transaction_limit,
         std::move(factory),
@@ -81,7 +88,8 @@ class OnDemandOsTest : public ::testing::Test {
 
   OnDemandOrderingService::CollectionType generateTransactions(
       std::pair<uint64_t, uint64_t> range,
-      shared_model::interface::types::TimestampType now = iroha::time::now()) {
+      shared_model::interface::types::TimestampType now = iroha::time::now(),
+      const std::string &creator = "foo@bar") {
     OnDemandOrderingService::CollectionType collection;
 
     for (auto i = range.first; i < range.second; ++i) {
@@ -91,7 +99,7 @@ class OnDemandOsTest : public ::testing::Test {
                   std::make_unique<shared_model::proto::Transaction>(
                       shared_model::proto::TransactionBuilder()
                           .createdTime(now + i)
-                          .creatorAccountId("foo@bar")
+                          .creatorAccountId(creator)
                           .createAsset("asset", "domain", 1)
                           .quorum(1)
                           .build()
@@ -145,7 +153,6 @@ TEST_F(OnDemandOsTest, NormalRound) {
  * @when  send number of transactions greater that limit
  * AND initiate next round
  * @then  check that previous round has only limit of transactions
- * AND the rest of transactions isn't appeared in next after next round
  */
 TEST_F(OnDemandOsTest, OverflowRound) {
   generateTransactionsAndInsert({1, transaction_limit * 2});
@@ -157,6 +164,132 @@ TEST_F(OnDemandOsTest, OverflowRound) {
             (*os->onRequestProposal(target_round))->transactions().size());
 }
 
+/**
+ * @given initialized on-demand OS
+ * @when  send number of transactions greater that limit
+ * AND initiate two next rounds
+ * @then  check that the transactions, which did not fit into the first
+ * proposal, appear in the second one
+ */
+TEST_F(OnDemandOsTest, OverflowRoundLeftOverBatches) {
+  generateTransactionsAndInsert({1, transaction_limit * 2 + 1});
+
+  os->onCollaborationOutcome(commit_round);
+  os->onCollaborationOutcome({commit_round.block_round + 1, kFirstRejectRound});
+
+  auto proposal = os->onRequestProposal(
+      {commit_round.block_round + 2, kNextCommitRoundConsumer});
+  ASSERT_TRUE(proposal);
+  ASSERT_EQ(transaction_limit, (*proposal)->transactions().size());
+}
+
+/**
+ * @given initialized on-demand OS with batches left over from a proposal
+ * @when  one of the left-over transactions is committed by other peers
+ * AND initiate next round
+ * @then  the left-over transactions are checked with a single query
+ * AND the committed transaction is not in the next proposal
+ */
+TEST_F(OnDemandOsTest, LeftOverBatchCommittedMeanwhile) {
+  auto batches = generateTransactions({1, transaction_limit + 3});
+  auto committed_hash = batches.back()->transactions().front()->hash();
+  os->onBatches(batches);
+  os->onCollaborationOutcome(commit_round);
+
+  EXPECT_CALL(
+      *mock_cache,
+      check(Matcher<const std::vector<shared_model::crypto::Hash> &>(
+          testing::SizeIs(2))))
+      .WillOnce(Invoke([&committed_hash](const auto &hashes) {
+        std::vector<iroha::ametsuchi::TxCacheStatusType> statuses;
+        for (const auto &hash : hashes) {
+          if (hash == committed_hash) {
+            statuses.push_back(
+                iroha::ametsuchi::tx_cache_status_responses::Committed{hash});
+          } else {
+            statuses.push_back(
+                iroha::ametsuchi::tx_cache_status_responses::Missing{hash});
+          }
+        }
+        return statuses;
+      }));
+  os->onCollaborationOutcome({commit_round.block_round + 1, kFirstRejectRound});
+
+  auto proposal = os->onRequestProposal(
+      {commit_round.block_round + 2, kNextCommitRoundConsumer});
+  ASSERT_TRUE(proposal);
+  ASSERT_EQ(1, boost::size((*proposal)->transactions()));
+  EXPECT_NE(committed_hash, (*proposal)->transactions()[0].hash());
+}
+
+/**
+ * @given initialized on-demand OS
+ * @when  one creator sends transactions up to the limit
+ * AND another creator sends a transaction after that
+ * AND initiate next round
+ * @then  check that the transaction of the second creator is in the proposal
+ * AND the transactions are packed in order of arrival one per creator
+ */
+TEST_F(OnDemandOsTest, FairPacking) {
+  auto now = iroha::time::now();
+  os->onBatches(generateTransactions({0, transaction_limit}, now, "a@test"));
+  os->onBatches(generateTransactions({0, 1}, now, "b@test"));
+
+  os->onCollaborationOutcome(commit_round);
+
+  auto proposal = os->onRequestProposal(target_round);
+  ASSERT_TRUE(proposal);
+  const auto &txs = (*proposal)->transactions();
+  ASSERT_EQ(transaction_limit, boost::size(txs));
+  EXPECT_EQ("a@test", txs[0].creatorAccountId());
+  EXPECT_EQ(now, txs[0].createdTime());
+  EXPECT_EQ("b@test", txs[1].creatorAccountId());
+  EXPECT_EQ("a@test", txs[2].creatorAccountId());
+  EXPECT_EQ(now + 1, txs[2].createdTime());
+}
+
+/**
+ * @given initialized on-demand OS, which groups conflicting batches
+ * @when  batches of two creators arrive interleaved
+ * AND initiate next round
+ * @then  check that batches of each creator are adjacent in the proposal and
+ * keep their order of arrival
+ */
+TEST_F(OnDemandOsTest, GroupConflictingBatches) {
+  auto tx_cache =
+      std::make_unique<NiceMock<iroha::ametsuchi::MockTxPresenceCache>>();
+  ON_CALL(*tx_cache,
+          check(testing::Matcher<
+                const shared_model::interface::TransactionBatch &>(_)))
+      .WillByDefault(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
+          iroha::ametsuchi::tx_cache_status_responses::Missing()}));
+  os = std::make_shared<OnDemandOrderingServiceImpl>(
+      transaction_limit,
+      std::make_unique<
+          shared_model::proto::ProtoProposalFactory<MockProposalValidator>>(),
+      std::move(tx_cache),
+      getTestLogger("OdOrderingService"),
+      proposal_limit,
+      initial_round,
+      true);
+  auto now = iroha::time::now();
+  os->onBatches(generateTransactions({0, 1}, now, "a@test"));
+  os->onBatches(generateTransactions({0, 1}, now, "b@test"));
+  os->onBatches(generateTransactions({1, 2}, now, "a@test"));
+
+  os->onCollaborationOutcome(commit_round);
+
+  auto proposal = os->onRequestProposal(target_round);
+  ASSERT_TRUE(proposal);
+  const auto &txs = (*proposal)->transactions();
+  ASSERT_EQ(3, boost::size(txs));
+  EXPECT_EQ("a@test", txs[0].creatorAccountId());
+  EXPECT_EQ(now, txs[0].createdTime());
+  EXPECT_EQ("a@test", txs[1].creatorAccountId());
+  EXPECT_EQ(now + 1, txs[1].createdTime());
+  EXPECT_EQ("b@test", txs[2].creatorAccountId());
+}
+
 /**
  * @given initialized on-demand OS
  * @when  send transactions from different threads
@@ -0,0 +1,184 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ordering/impl/outbound_batches_queue.hpp"
+
+#include <gtest/gtest.h>
+#include "backend/protobuf/transaction.hpp"
+#include "framework/mock_stream.h"
+#include "framework/test_logger.hpp"
+#include "interfaces/iroha_internal/transaction_batch_impl.hpp"
+#include "ordering_mock.grpc.pb.h"
+
+using namespace iroha;
+using namespace iroha::ordering;
+using namespace iroha::ordering::transport;
+
+using grpc::testing::MockClientAsyncResponseReader;
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::Return;
+
+class OutboundBatchesQueueTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    stub = std::make_shared<proto::MockOnDemandOrderingStub>();
+    async_call =
+        std::make_shared<network::AsyncGrpcClient<google::protobuf::Empty>>(
+            getTestLogger("AsyncCall"));
+    // requests are never completed, so readers are owned by the test
+    ON_CALL(*stub, AsyncSendBatchesRaw(_, _, _))
+        .WillByDefault(Invoke([this](auto, const auto &request, auto) {
+          requests.push_back(request);
+          readers.push_back(std::make_unique<
+                            MockClientAsyncResponseReader<
+                                google::protobuf::Empty>>());
+          return readers.back().get();
+        }));
+  }
+
+  /**
+   * @param max_request_size - size of request, which is sent immediately
+   * @param max_requests_in_flight - limit of requests in progress
+   * @return queue with the given limits
+   */
+  std::shared_ptr<OutboundBatchesQueue> makeQueue(
+      size_t max_request_size, size_t max_requests_in_flight) {
+    return std::make_shared<OutboundBatchesQueue>(
+        stub,
+        async_call,
+        max_request_size,
+        max_requests_in_flight,
+        getTestLogger("BatchesQueue"));
+  }
+
+  /**
+   * @param creator - creator of the transaction of the batch
+   * @return batch with a single transaction
+   */
+  OutboundBatchesQueue::CollectionType::value_type makeBatch(
+      const std::string &creator) {
+    protocol::Transaction tx;
+    tx.mutable_payload()->mutable_reduced_payload()->set_creator_account_id(
+        creator);
+    return std::make_shared<shared_model::interface::TransactionBatchImpl>(
+        shared_model::interface::types::SharedTxsCollectionType{
+            std::make_shared<shared_model::proto::Transaction>(tx)});
+  }
+
+  std::shared_ptr<proto::MockOnDemandOrderingStub> stub;
+  std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>> async_call;
+  std::vector<proto::BatchesRequest> requests;
+  std::vector<
+      std::unique_ptr<MockClientAsyncResponseReader<google::protobuf::Empty>>>
+      readers;
+
+  const size_t kLargeRequestSize = 1 << 20;
+};
+
+/**
+ * @given queue
+ * @when batches are pushed in separate calls
+ * AND the queue is flushed
+ * @then they are sent in a single request
+ */
+TEST_F(OutboundBatchesQueueTest, Coalescing) {
+  auto queue = makeQueue(kLargeRequestSize, 1);
+  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _)).Times(1);
+
+  queue->push({makeBatch("a@test")});
+  queue->push({makeBatch("b@test")});
+  ASSERT_TRUE(requests.empty());
+  queue->flush();
+
+  ASSERT_EQ(1, requests.size());
+  ASSERT_EQ(2, requests[0].transactions_size());
+  ASSERT_EQ("a@test",
+            requests[0]
+                .transactions(0)
+                .payload()
+                .reduced_payload()
+                .creator_account_id());
+  ASSERT_EQ(1, queue->metrics().requests_sent);
+  ASSERT_EQ(2, queue->metrics().transactions_sent);
+}
+
+/**
+ * @given queue
+ * @when the same batch is pushed twice before flush
+ * @then it is sent once
+ */
+TEST_F(OutboundBatchesQueueTest, SameBatchSentOnce) {
+  auto queue = makeQueue(kLargeRequestSize, 1);
+  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _)).Times(1);
+  auto batch = makeBatch("a@test");
+
+  queue->push({batch});
+  queue->push({batch});
+  queue->flush();
+
+  ASSERT_EQ(1, requests.size());
+  ASSERT_EQ(1, requests[0].transactions_size());
+  ASSERT_EQ(1, queue->metrics().batches_coalesced);
+}
+
+/**
+ * @given queue with small request size
+ * @when a batch is pushed
+ * @then it is sent without flush
+ */
+TEST_F(OutboundBatchesQueueTest, SentWhenSizeReached) {
+  auto queue = makeQueue(1, 1);
+  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _)).Times(1);
+
+  queue->push({makeBatch("a@test")});
+
+  ASSERT_EQ(1, requests.size());
+  ASSERT_EQ(0, queue->metrics().pending_size);
+}
+
+/**
+ * @given queue with small request size and a single request in progress
+ * @when more batches are pushed, than the pending request can hold
+ * @then they are not sent until the request is completed
+ * AND batches which do not fit are dropped
+ */
+TEST_F(OutboundBatchesQueueTest, Backpressure) {
+  auto queue = makeQueue(1, 1);
+  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _)).Times(1);
+
+  ASSERT_EQ(0, queue->push({makeBatch("a@test")}));
+  ASSERT_EQ(0, queue->push({makeBatch("b@test")}));
+  ASSERT_EQ(1, queue->push({makeBatch("c@test")}));
+  queue->flush();
+
+  ASSERT_EQ(1, requests.size());
+  auto metrics = queue->metrics();
+  ASSERT_EQ(3, metrics.batches_queued);
+  ASSERT_EQ(1, metrics.batches_dropped);
+  ASSERT_EQ(1, metrics.requests_in_flight);
+  ASSERT_LT(0, metrics.pending_size);
+}
+
+/**
+ * @given queue with a pending request
+ * @when the pending request is discarded
+ * @then its batches are counted as dropped
+ * AND nothing is sent on flush
+ */
+TEST_F(OutboundBatchesQueueTest, DiscardPending) {
+  auto queue = makeQueue(kLargeRequestSize, 1);
+  EXPECT_CALL(*stub, AsyncSendBatchesRaw(_, _, _)).Times(0);
+
+  queue->push({makeBatch("a@test"), makeBatch("b@test")});
+  ASSERT_EQ(2, queue->discardPending());
+  queue->flush();
+
+  auto metrics = queue->metrics();
+  ASSERT_EQ(2, metrics.batches_dropped);
+  ASSERT_EQ(0, metrics.pending_size);
+  ASSERT_TRUE(requests.empty());
+}
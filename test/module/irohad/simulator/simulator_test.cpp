@@ -5,6 +5,7 @@
 
 #include "simulator/impl/simulator.hpp"
 
+#include <future>
 #include <vector>
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -15,6 +16,7 @@
 #include "datetime/time.hpp"
 #include "framework/test_logger.hpp"
 #include "framework/test_subscriber.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 #include "module/irohad/ametsuchi/mock_block_query.hpp"
 #include "module/irohad/ametsuchi/mock_block_query_factory.hpp"
 #include "module/irohad/ametsuchi/mock_temporary_factory.hpp"
@@ -35,6 +37,7 @@ using namespace framework::test_subscriber;
 
 using ::testing::_;
 using ::testing::A;
+using ::testing::ByMove;
 using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
@@ -65,8 +68,11 @@ class SimulatorTest : public ::testing::Test {
 
     EXPECT_CALL(*ordering_gate, onProposal())
         .WillOnce(Return(ordering_events.get_observable()));
+    EXPECT_CALL(*ordering_gate, onPrefetchedProposal())
+        .WillOnce(Return(prefetched_events.get_observable()));
 
     simulator = std::make_shared<Simulator>(ordering_gate,
+                                            outcomes.get_observable(),
                                             validator,
                                             factory,
                                             block_query_factory,
@@ -85,6 +91,8 @@ class SimulatorTest : public ::testing::Test {
   std::shared_ptr<CryptoSignerType> crypto_signer;
   std::unique_ptr<shared_model::interface::UnsafeBlockFactory> block_factory;
   rxcpp::subjects::subject<OrderingEvent> ordering_events;
+  rxcpp::subjects::subject<OrderingEvent> prefetched_events;
+  rxcpp::subjects::subject<consensus::GateObject> outcomes;
 
   std::shared_ptr<Simulator> simulator;
 };
@@ -315,3 +323,139 @@ TEST_F(SimulatorTest, SomeFailingTxs) {
         << rejected_tx->toString() << " missing in rejected transactions.";
   }
 }
+
+/// result of validation, which accepts all transactions of the proposal
+std::unique_ptr<VerifiedProposalAndErrors> makeVerifiedProposal(
+    std::shared_ptr<const shared_model::interface::Proposal> proposal) {
+  auto verified_proposal = std::make_unique<VerifiedProposalAndErrors>();
+  verified_proposal->verified_proposal = std::move(proposal);
+  return verified_proposal;
+}
+
+/// successfully created temporary wsv
+expected::Result<std::unique_ptr<TemporaryWsv>, std::string> makeWsvResult(
+    std::unique_ptr<TemporaryWsv> wsv) {
+  return expected::makeValue(std::move(wsv));
+}
+
+/**
+ * @given proposal of the next round received while the block of the current
+ * round is in consensus
+ * @when the block is committed
+ * AND the same proposal is emitted for the next round
+ * @then the proposal is validated only once, on top of the state of the block
+ * AND its verified transactions are applied to the state of the next round
+ * AND the block of the next round is created of it
+ */
+TEST_F(SimulatorTest, SpeculationIsUsedWhenBlockIsCommitted) {
+  const consensus::Round round{1, 0}, next_round{2, 0};
+  auto proposal = makeProposal(2);
+  auto next_proposal = makeProposal(3);
+
+  auto wsv = std::make_unique<NiceMock<MockTemporaryWsv>>();
+  auto next_wsv = std::make_unique<NiceMock<MockTemporaryWsv>>();
+  EXPECT_CALL(*wsv, applyVerified(_)).Times(0);
+  EXPECT_CALL(*next_wsv, applyVerified(_)).Times(1);
+  EXPECT_CALL(*factory, createTemporaryWsv())
+      .WillOnce(Return(ByMove(makeWsvResult(std::move(wsv)))))
+      .WillOnce(Return(ByMove(makeWsvResult(std::move(next_wsv)))));
+
+  std::promise<void> speculated;
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Return(ByMove(makeVerifiedProposal(proposal))))
+      .WillOnce(Invoke([&](const auto &, auto &) {
+        speculated.set_value();
+        return makeVerifiedProposal(next_proposal);
+      }));
+
+  std::vector<wBlock> blocks;
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(expected::makeValue(wBlock(clone(makeBlock(1))))))
+      .WillOnce(Invoke(
+          [&] { return expected::makeValue(wBlock(blocks.front())); }));
+  EXPECT_CALL(*query, getTopBlockHeight())
+      .WillOnce(Return(1))
+      .WillOnce(Return(2));
+  EXPECT_CALL(*crypto_signer, sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  simulator->onBlock().subscribe(
+      [&](const auto &event) { blocks.push_back(getBlockUnsafe(event)); });
+
+  prefetched_events.get_subscriber().on_next(
+      OrderingEvent{next_proposal, next_round});
+  ordering_events.get_subscriber().on_next(OrderingEvent{proposal, round});
+  ASSERT_EQ(blocks.size(), 1);
+  ASSERT_EQ(speculated.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+
+  outcomes.get_subscriber().on_next(consensus::PairValid{blocks[0], round});
+  ordering_events.get_subscriber().on_next(
+      OrderingEvent{next_proposal, next_round});
+
+  ASSERT_EQ(blocks.size(), 2);
+  EXPECT_EQ(blocks[1]->height(), next_proposal->height());
+  EXPECT_EQ(blocks[1]->prevHash(), blocks[0]->hash());
+  EXPECT_EQ(blocks[1]->transactions(), next_proposal->transactions());
+}
+
+/**
+ * @given proposal of the next round received while the block of the current
+ * round is in consensus
+ * @when the block is rejected
+ * AND a proposal of the next reject round is emitted
+ * @then the speculatively verified proposal is discarded
+ * AND the proposal of the next reject round is validated
+ * AND no verified transactions are applied without validation
+ */
+TEST_F(SimulatorTest, SpeculationIsDiscardedWhenBlockIsRejected) {
+  const consensus::Round round{1, 0}, next_round{2, 0}, reject_round{1, 1};
+  auto proposal = makeProposal(2);
+  auto next_proposal = makeProposal(3);
+  auto reject_proposal = makeProposal(2);
+
+  auto wsv = std::make_unique<NiceMock<MockTemporaryWsv>>();
+  auto reject_wsv = std::make_unique<NiceMock<MockTemporaryWsv>>();
+  EXPECT_CALL(*wsv, applyVerified(_)).Times(0);
+  EXPECT_CALL(*reject_wsv, applyVerified(_)).Times(0);
+  EXPECT_CALL(*factory, createTemporaryWsv())
+      .WillOnce(Return(ByMove(makeWsvResult(std::move(wsv)))))
+      .WillOnce(Return(ByMove(makeWsvResult(std::move(reject_wsv)))));
+
+  std::promise<void> speculated;
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Return(ByMove(makeVerifiedProposal(proposal))))
+      .WillOnce(Invoke([&](const auto &, auto &) {
+        speculated.set_value();
+        return makeVerifiedProposal(next_proposal);
+      }))
+      .WillOnce(Return(ByMove(makeVerifiedProposal(reject_proposal))))
+      // the next proposal may be validated again on top of the reject round
+      .WillRepeatedly(Invoke([&](const auto &, auto &) {
+        return makeVerifiedProposal(next_proposal);
+      }));
+
+  auto top_block = wBlock(clone(makeBlock(1)));
+  EXPECT_CALL(*query, getTopBlock())
+      .WillRepeatedly(Return(expected::makeValue(wBlock(top_block))));
+  EXPECT_CALL(*query, getTopBlockHeight()).WillRepeatedly(Return(1));
+  EXPECT_CALL(*crypto_signer, sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  std::vector<wBlock> blocks;
+  simulator->onBlock().subscribe(
+      [&](const auto &event) { blocks.push_back(getBlockUnsafe(event)); });
+
+  prefetched_events.get_subscriber().on_next(
+      OrderingEvent{next_proposal, next_round});
+  ordering_events.get_subscriber().on_next(OrderingEvent{proposal, round});
+  ASSERT_EQ(speculated.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+
+  outcomes.get_subscriber().on_next(consensus::BlockReject{round});
+  ordering_events.get_subscriber().on_next(
+      OrderingEvent{reject_proposal, reject_round});
+
+  ASSERT_EQ(blocks.size(), 2);
+  EXPECT_EQ(blocks[1]->transactions(), reject_proposal->transactions());
+}
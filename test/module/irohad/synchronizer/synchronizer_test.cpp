@@ -259,6 +259,61 @@ TEST_F(SynchronizerTest, ValidWhenValidChainMultipleBlocks) {
   ASSERT_TRUE(wrapper.validate());
 }
 
+/**
+ * @given synchronizer, which commits downloaded blocks one by one
+ * @when the loaded chain contains the expected block followed by an invalid
+ * one
+ * @then the expected block is committed @and the commit event contains only
+ * that block
+ */
+TEST_F(SynchronizerTest, InvalidBlockAfterCommittedChunk) {
+  synchronizer.reset();
+  EXPECT_CALL(*consensus_gate, onOutcome())
+      .WillOnce(Return(gate_outcome.get_observable()));
+  synchronizer =
+      std::make_shared<SynchronizerImpl>(consensus_gate,
+                                         chain_validator,
+                                         mutable_factory,
+                                         block_query_factory,
+                                         block_loader,
+                                         getTestLogger("Synchronizer"),
+                                         1);
+
+  DefaultValue<expected::Result<std::unique_ptr<MutableStorage>, std::string>>::
+      SetFactory(&createMockMutableStorage);
+
+  // the second storage is created for the block after the committed one
+  EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(2);
+  EXPECT_CALL(*mutable_factory, commit_(_))
+      .WillOnce(Return(ByMove(std::make_unique<LedgerState>(ledger_peers))));
+  EXPECT_CALL(*chain_validator, validateAndApply(_, _))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+  auto second_commit = makeCommit(kHeight + 1);
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _))
+      .WillOnce(Return(rxcpp::observable<>::iterate(
+          std::vector<std::shared_ptr<shared_model::interface::Block>>{
+              commit_message, second_commit})));
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 1);
+  wrapper.subscribe([this](auto commit_event) {
+    auto block_wrapper =
+        make_test_subscriber<CallExact>(commit_event.synced_blocks, 1);
+    block_wrapper.subscribe([this](auto block) {
+      ASSERT_EQ(block->height(), commit_message->height());
+    });
+    ASSERT_EQ(commit_event.round.block_round, kHeight);
+    ASSERT_EQ(commit_event.sync_outcome, SynchronizationOutcomeType::kCommit);
+    ASSERT_TRUE(block_wrapper.validate());
+  });
+
+  gate_outcome.get_subscriber().on_next(
+      consensus::VoteOther{public_keys, hash, consensus::Round{kHeight, 1}});
+
+  ASSERT_TRUE(wrapper.validate());
+}
+
 /**
  * @given A commit from consensus and initialized components
  * @when gate have voted for other block
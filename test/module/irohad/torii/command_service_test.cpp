@@ -10,7 +10,6 @@
 #include "cryptography/hash.hpp"
 #include "cryptography/public_key.hpp"
 #include "framework/test_logger.hpp"
-#include "framework/test_subscriber.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 #include "module/irohad/ametsuchi/mock_storage.hpp"
 #include "module/irohad/ametsuchi/mock_tx_presence_cache.hpp"
@@ -62,11 +61,11 @@ class CommandServiceTest : public Test {
 /**
  * @given intialized command service
  *        @and hash with passed consensus but not present in runtime cache
- * @when  invoke getStatusStream by hash
+ * @when  invoke getInitialStatus by hash
  * @then  verify that code checks run-time and persistent caches for the hash
  *        @and return CommittedTxResponse status
  */
-TEST_F(CommandServiceTest, getStatusStreamWithAbsentHash) {
+TEST_F(CommandServiceTest, getInitialStatusWithAbsentHash) {
   using HashType = shared_model::crypto::Hash;
   auto hash = HashType("a");
   iroha::ametsuchi::TxCacheStatusType ret_value{
@@ -83,16 +82,59 @@ TEST_F(CommandServiceTest, getStatusStreamWithAbsentHash) {
           rxcpp::observable<>::empty<iroha::torii::StatusBus::Objects>()));
 
   initCommandService();
-  auto wrapper = framework::test_subscriber::make_test_subscriber<
-      framework::test_subscriber::CallExact>(
-      command_service_->getStatusStream(hash), 1);
-  wrapper.subscribe([](const auto &tx_response) {
-    return iroha::visit_in_place(
-        tx_response->get(),
-        [](const shared_model::interface::CommittedTxResponse &) {},
-        [](const auto &a) { FAIL() << "Wrong response!"; });
-  });
-  ASSERT_TRUE(wrapper.validate());
+  iroha::visit_in_place(
+      command_service_->getInitialStatus(hash)->get(),
+      [](const shared_model::interface::CommittedTxResponse &) {},
+      [](const auto &a) { FAIL() << "Wrong response!"; });
+}
+
+/**
+ * @given intialized command service
+ *        @and hashes, one of which is present in runtime cache
+ * @when  invoke getStatuses by the hashes
+ * @then  verify that the hashes absent in cache are checked in storage with
+ *        a single query
+ *        @and statuses are returned in the order of the hashes
+ */
+TEST_F(CommandServiceTest, getStatusesWithSingleStorageQuery) {
+  using HashType = shared_model::crypto::Hash;
+  auto cached_hash = HashType("a"), committed_hash = HashType("b"),
+       missing_hash = HashType("c");
+  auto block_query = std::make_shared<iroha::ametsuchi::MockBlockQuery>();
+  EXPECT_CALL(*status_bus_, statuses())
+      .WillRepeatedly(Return(
+          rxcpp::observable<>::empty<iroha::torii::StatusBus::Objects>()));
+  EXPECT_CALL(*storage_, getBlockQuery()).WillOnce(Return(block_query));
+  EXPECT_CALL(*block_query,
+              checkTxsPresence(ElementsAre(committed_hash, missing_hash)))
+      .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
+          iroha::ametsuchi::tx_cache_status_responses::Committed{
+              committed_hash},
+          iroha::ametsuchi::tx_cache_status_responses::Missing{
+              missing_hash}}));
+
+  cache_->addItem(cached_hash,
+                  tx_status_factory_->makeStatelessValid(cached_hash));
+  initCommandService();
+  auto statuses = command_service_->getStatuses(
+      {cached_hash, committed_hash, missing_hash});
+
+  ASSERT_EQ(statuses.size(), 3);
+  iroha::visit_in_place(
+      statuses[0]->get(),
+      [](const shared_model::interface::StatelessValidTxResponse &) {},
+      [](const auto &a) { FAIL() << "Wrong response!"; });
+  iroha::visit_in_place(
+      statuses[1]->get(),
+      [](const shared_model::interface::CommittedTxResponse &) {},
+      [](const auto &a) { FAIL() << "Wrong response!"; });
+  iroha::visit_in_place(
+      statuses[2]->get(),
+      [](const shared_model::interface::NotReceivedTxResponse &) {},
+      [](const auto &a) { FAIL() << "Wrong response!"; });
+  ASSERT_EQ(statuses[0]->transactionHash(), cached_hash);
+  ASSERT_EQ(statuses[1]->transactionHash(), committed_hash);
+  ASSERT_EQ(statuses[2]->transactionHash(), missing_hash);
 }
 
 /**
@@ -96,6 +96,29 @@ TEST_F(CommandSyncClientTest, ListTorii) {
   ASSERT_TRUE(stat.ok());
 }
 
+/**
+ * @given command client
+ * @when Statuses is called
+ * @then the stub handles passed data correctly (no corruptions in both
+ * directions)
+ */
+TEST_F(CommandSyncClientTest, Statuses) {
+  iroha::protocol::TxStatusesRequest request, intermediary_request;
+  iroha::protocol::ToriiResponseList responses, received_responses;
+  auto hash = std::string(kHashLength, '1');
+  request.add_tx_hashes(hash);
+  responses.add_responses()->set_tx_hash(hash);
+  EXPECT_CALL(*stub, Statuses(_, _, _))
+      .WillOnce(::testing::DoAll(::testing::SaveArg<1>(&intermediary_request),
+                                 ::testing::SetArgPointee<2>(responses),
+                                 ::testing::Return(::grpc::Status::OK)));
+  auto stat = client->Statuses(request, received_responses);
+  ASSERT_EQ(intermediary_request.tx_hashes(0), hash);
+  ASSERT_EQ(received_responses.responses_size(), 1);
+  ASSERT_EQ(received_responses.responses(0).tx_hash(), hash);
+  ASSERT_TRUE(stat.ok());
+}
+
 /**
  * @given command client
  * @when StatusStream is called
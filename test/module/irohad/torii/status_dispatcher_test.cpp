@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "torii/impl/status_dispatcher.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "backend/protobuf/proto_tx_status_factory.hpp"
+
+using namespace iroha::torii;
+
+class StatusDispatcherTest : public ::testing::Test {
+ public:
+  /**
+   * @return handler, which stores received statuses to the given vector
+   */
+  StatusDispatcher::HandlerType collect(
+      std::vector<StatusDispatcher::ResponsePtrType> &received) {
+    return [&received](const auto &response) { received.push_back(response); };
+  }
+
+  std::shared_ptr<StatusDispatcher> dispatcher =
+      std::make_shared<StatusDispatcher>();
+  shared_model::proto::ProtoTxStatusFactory status_factory;
+  shared_model::crypto::Hash hash{"1"}, other_hash{"2"};
+};
+
+/**
+ * @given subscription to a transaction
+ * @when statuses of the transaction and of another one are dispatched
+ * @then the subscription receives the statuses of the transaction only
+ */
+TEST_F(StatusDispatcherTest, DeliversStatusesOfHash) {
+  std::vector<StatusDispatcher::ResponsePtrType> received;
+  auto subscription = dispatcher->subscribe(hash, collect(received));
+
+  StatusDispatcher::ResponsePtrType committed =
+      status_factory.makeCommitted(hash, {});
+  dispatcher->dispatch(status_factory.makeCommitted(other_hash, {}));
+  dispatcher->dispatch(committed);
+
+  ASSERT_EQ(1, received.size());
+  ASSERT_EQ(committed, received[0]);
+}
+
+/**
+ * @given subscriptions to different transactions
+ * @when a round passes
+ * @then each subscription is notified without a status
+ */
+TEST_F(StatusDispatcherTest, NotifiesRounds) {
+  std::vector<StatusDispatcher::ResponsePtrType> received, other_received;
+  auto subscription = dispatcher->subscribe(hash, collect(received));
+  auto other_subscription =
+      dispatcher->subscribe(other_hash, collect(other_received));
+
+  dispatcher->notifyRound();
+
+  ASSERT_EQ(1, received.size());
+  ASSERT_EQ(nullptr, received[0]);
+  ASSERT_EQ(1, other_received.size());
+}
+
+/**
+ * @given subscriptions to a transaction
+ * @when they are destroyed
+ * @then they are removed from the dispatcher and receive no more statuses
+ */
+TEST_F(StatusDispatcherTest, Unsubscribe) {
+  std::vector<StatusDispatcher::ResponsePtrType> received;
+  auto subscription = dispatcher->subscribe(hash, collect(received));
+  {
+    auto other = dispatcher->subscribe(hash, collect(received));
+    ASSERT_EQ(2, dispatcher->size());
+  }
+  ASSERT_EQ(1, dispatcher->size());
+
+  subscription.reset();
+  ASSERT_EQ(0, dispatcher->size());
+
+  dispatcher->dispatch(status_factory.makeCommitted(hash, {}));
+  ASSERT_TRUE(received.empty());
+}
+
+/**
+ * @given subscription, which is released by its handler
+ * @when a status is dispatched
+ * @then the subscription is removed without a deadlock
+ */
+TEST_F(StatusDispatcherTest, UnsubscribeFromHandler) {
+  std::shared_ptr<StatusDispatcher::Subscription> subscription;
+  subscription = dispatcher->subscribe(
+      hash, [&subscription](const auto &) { subscription.reset(); });
+
+  dispatcher->dispatch(status_factory.makeCommitted(hash, {}));
+
+  ASSERT_EQ(0, dispatcher->size());
+}
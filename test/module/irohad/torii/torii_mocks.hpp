@@ -37,9 +37,13 @@ namespace iroha {
           std::shared_ptr<shared_model::interface::TransactionResponse>(
               const shared_model::crypto::Hash &request));
       MOCK_METHOD1(
-          getStatusStream,
-          rxcpp::observable<
+          getStatuses,
+          std::vector<
               std::shared_ptr<shared_model::interface::TransactionResponse>>(
+              const std::vector<shared_model::crypto::Hash> &));
+      MOCK_METHOD1(
+          getInitialStatus,
+          std::shared_ptr<shared_model::interface::TransactionResponse>(
               const shared_model::crypto::Hash &));
     };
 
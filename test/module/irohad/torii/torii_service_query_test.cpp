@@ -13,6 +13,7 @@
 #include "builders/protobuf/queries.hpp"
 #include "framework/test_logger.hpp"
 #include "main/server_runner.hpp"
+#include "network/impl/grpc_channel_builder.hpp"
 #include "module/irohad/torii/processor/mock_query_processor.hpp"
 #include "module/shared_model/builders/protobuf/test_query_builder.hpp"
 #include "torii/query_client.hpp"
@@ -154,3 +155,51 @@ TEST_F(ToriiQueryServiceTest, FetchBlocksWhenInvalidQuery) {
   auto response = responses.at(0);
   ASSERT_TRUE(response.has_block_error_response());
 }
+
+/**
+ * @given valid blocks query
+ * @when the query processor emits much more blocks at once than the stream
+ * is allowed to keep waiting for sending
+ * @then the stream is finished with resource exhausted status
+ * @and not all of the blocks are received
+ */
+TEST_F(ToriiQueryServiceTest, FetchBlocksOverflowFinishesStream) {
+  auto blocks_query = shared_model::proto::BlocksQueryBuilder()
+                          .creatorAccountId("user@domain")
+                          .createdTime(iroha::time::now())
+                          .queryCounter(1)
+                          .build()
+                          .signAndAddSignature(keypair)
+                          .finish();
+
+  const size_t kEmittedBlocks =
+      10 * iroha::torii::QueryService::kMaxQueuedBlocks;
+  std::vector<std::shared_ptr<shared_model::interface::BlockQueryResponse>>
+      block_responses;
+  for (size_t i = 0; i < kEmittedBlocks; ++i) {
+    iroha::protocol::Block block;
+    block.mutable_block_v1()->mutable_payload()->set_height(i + 1);
+    block_responses.push_back(
+        shared_model::proto::ProtoQueryResponseFactory()
+            .createBlockQueryResponse(
+                std::make_unique<shared_model::proto::Block>(
+                    block.block_v1())));
+  }
+
+  EXPECT_CALL(*query_processor, blocksQueryHandle(_))
+      .WillOnce(Return(rxcpp::observable<>::iterate(block_responses)));
+
+  auto stub = iroha::network::createClient<iroha::protocol::QueryService_v1>(
+      ip + ":" + std::to_string(port));
+  grpc::ClientContext context;
+  auto reader = stub->FetchCommits(&context, blocks_query.getTransport());
+  size_t received = 0;
+  iroha::protocol::BlockQueryResponse response;
+  while (reader->Read(&response)) {
+    ++received;
+  }
+
+  ASSERT_EQ(reader->Finish().error_code(),
+            grpc::StatusCode::RESOURCE_EXHAUSTED);
+  ASSERT_LT(received, kEmittedBlocks);
+}
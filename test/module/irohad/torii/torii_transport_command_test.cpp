@@ -6,6 +6,7 @@
 #include "torii/impl/command_service_transport_grpc.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <string>
 #include <utility>
@@ -20,20 +21,19 @@
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/iroha_internal/transaction_batch_factory_impl.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser_impl.hpp"
+#include "main/server_runner.hpp"
 #include "module/irohad/network/network_mocks.hpp"
 #include "module/irohad/torii/torii_mocks.hpp"
 #include "module/shared_model/interface/mock_transaction_batch_factory.hpp"
 #include "module/shared_model/validators/validators.hpp"
-#include "module/vendor/grpc_mocks.hpp"
+#include "network/impl/grpc_channel_builder.hpp"
 #include "torii/impl/status_bus_impl.hpp"
 #include "validators/protobuf/proto_transaction_validator.hpp"
 
 using ::testing::_;
 using ::testing::A;
 using ::testing::Invoke;
-using ::testing::Property;
 using ::testing::Return;
-using ::testing::StrEq;
 
 using namespace iroha::torii;
 using namespace std::chrono_literals;
@@ -75,6 +75,8 @@ class CommandServiceTransportGrpcTest : public testing::Test {
     init();
 
     status_bus = std::make_shared<MockStatusBus>();
+    EXPECT_CALL(*status_bus, statuses())
+        .WillRepeatedly(Return(statuses.get_observable()));
     command_service = std::make_shared<MockCommandService>();
 
     transport_grpc = std::make_shared<CommandServiceTransportGrpc>(
@@ -84,7 +86,7 @@ class CommandServiceTransportGrpcTest : public testing::Test {
         transaction_factory,
         batch_parser,
         batch_factory,
-        rxcpp::observable<>::iterate(gate_objects),
+        consensus_gate_objects.get_observable(),
         gate_objects.size(),
         getTestLogger("CommandServiceTransportGrpc"));
   }
@@ -102,12 +104,60 @@ class CommandServiceTransportGrpcTest : public testing::Test {
   std::shared_ptr<MockCommandService> command_service;
   std::shared_ptr<CommandServiceTransportGrpc> transport_grpc;
 
+  /**
+   * Serve the transport and read the status stream of the request
+   * @param request - status stream request
+   * @param on_response - invoked for each received status
+   * @return received statuses
+   */
+  std::vector<iroha::protocol::ToriiResponse> readStatusStream(
+      const iroha::protocol::TxStatusRequest &request,
+      std::function<void(const iroha::protocol::ToriiResponse &)> on_response =
+          {}) {
+    ServerRunner runner(kAddress + ":0", getTestLogger("ServerRunner"));
+    int port = 0;
+    runner.append(transport_grpc)
+        .run()
+        .match(
+            [&port](const iroha::expected::Value<int> &v) { port = v.value; },
+            [](const iroha::expected::Error<std::string> &e) {
+              FAIL() << e.error;
+            });
+
+    auto stub =
+        iroha::network::createClient<iroha::protocol::CommandService_v1>(
+            kAddress + ":" + std::to_string(port));
+    grpc::ClientContext context;
+    auto reader = stub->StatusStream(&context, request);
+    std::vector<iroha::protocol::ToriiResponse> responses;
+    iroha::protocol::ToriiResponse response;
+    while (reader->Read(&response)) {
+      responses.push_back(response);
+      if (on_response) {
+        on_response(response);
+      }
+    }
+    EXPECT_TRUE(reader->Finish().ok());
+    return responses;
+  }
+
+  /**
+   * Notify the status streams that the rounds from gate_objects have passed
+   */
+  void passRounds() {
+    for (const auto &event : gate_objects) {
+      consensus_gate_objects.get_subscriber().on_next(event);
+    }
+  }
+
+  rxcpp::subjects::subject<iroha::torii::StatusBus::Objects> statuses;
   rxcpp::subjects::subject<
       iroha::torii::CommandServiceTransportGrpc::ConsensusGateEvent>
       consensus_gate_objects;
   std::vector<iroha::torii::CommandServiceTransportGrpc::ConsensusGateEvent>
       gate_objects{2};
 
+  const std::string kAddress = "127.0.0.1";
   const size_t kHashLength = 32;
   const size_t kTimes = 5;
 };
@@ -136,6 +186,89 @@ TEST_F(CommandServiceTransportGrpcTest, Status) {
             iroha::protocol::TxStatus::ENOUGH_SIGNATURES_COLLECTED);
 }
 
+/**
+ * @given torii service and hashes of transactions
+ * @when calling Statuses
+ * @then ensure that CommandService is asked once for statuses of all the
+ * hashes, and the statuses are returned in the order of the hashes
+ */
+TEST_F(CommandServiceTransportGrpcTest, Statuses) {
+  grpc::ServerContext context;
+
+  iroha::protocol::TxStatusesRequest request;
+  const shared_model::crypto::Hash hash1(std::string(kHashLength, '1'));
+  const shared_model::crypto::Hash hash2(std::string(kHashLength, '2'));
+  request.add_tx_hashes(hash1.hex());
+  request.add_tx_hashes(hash2.hex());
+
+  iroha::protocol::ToriiResponseList torii_responses;
+  std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
+      responses{status_factory->makeCommitted(hash1, {}),
+                status_factory->makeNotReceived(hash2, {})};
+
+  EXPECT_CALL(*command_service,
+              getStatuses(std::vector<shared_model::crypto::Hash>{hash1,
+                                                                  hash2}))
+      .WillOnce(Return(responses));
+
+  transport_grpc->Statuses(&context, &request, &torii_responses);
+
+  ASSERT_EQ(torii_responses.responses_size(), 2);
+  ASSERT_EQ(torii_responses.responses(0).tx_status(),
+            iroha::protocol::TxStatus::COMMITTED);
+  ASSERT_EQ(torii_responses.responses(0).tx_hash(), hash1.hex());
+  ASSERT_EQ(torii_responses.responses(1).tx_status(),
+            iroha::protocol::TxStatus::NOT_RECEIVED);
+  ASSERT_EQ(torii_responses.responses(1).tx_hash(), hash2.hex());
+}
+
+/**
+ * @given torii service and hashes of transactions, one of which is not a
+ * valid hex string
+ * @when calling Statuses
+ * @then INVALID_ARGUMENT is returned, and CommandService is not asked
+ */
+TEST_F(CommandServiceTransportGrpcTest, StatusesWithMalformedHash) {
+  grpc::ServerContext context;
+
+  iroha::protocol::TxStatusesRequest request;
+  request.add_tx_hashes(std::string(kHashLength * 2, '1'));
+  request.add_tx_hashes("");
+  request.add_tx_hashes("not a hash");
+
+  iroha::protocol::ToriiResponseList torii_responses;
+  EXPECT_CALL(*command_service, getStatuses(_)).Times(0);
+
+  auto status = transport_grpc->Statuses(&context, &request, &torii_responses);
+
+  ASSERT_EQ(status.error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+  ASSERT_EQ(torii_responses.responses_size(), 0);
+}
+
+/**
+ * @given torii service and more hashes than allowed in a single call
+ * @when calling Statuses
+ * @then INVALID_ARGUMENT is returned, and CommandService is not asked
+ */
+TEST_F(CommandServiceTransportGrpcTest, StatusesWithTooManyHashes) {
+  grpc::ServerContext context;
+
+  iroha::protocol::TxStatusesRequest request;
+  const shared_model::crypto::Hash hash(std::string(kHashLength, '1'));
+  for (size_t i = 0;
+       i <= iroha::torii::CommandServiceTransportGrpc::kMaxStatusesRequestSize;
+       ++i) {
+    request.add_tx_hashes(hash.hex());
+  }
+
+  iroha::protocol::ToriiResponseList torii_responses;
+  EXPECT_CALL(*command_service, getStatuses(_)).Times(0);
+
+  auto status = transport_grpc->Statuses(&context, &request, &torii_responses);
+
+  ASSERT_EQ(status.error_code(), grpc::StatusCode::INVALID_ARGUMENT);
+}
+
 /**
  * @given torii service and number of transactions
  * @when calling ListTorii
@@ -242,51 +375,109 @@ TEST_F(CommandServiceTransportGrpcTest, ListToriiPartialInvalid) {
 }
 
 /**
- * @given torii service and command_service with empty status stream
+ * @given torii service and command_service with final initial status
  * @when calling StatusStream on transport
- * @then Ok status is eventually returned without any fault
- *       and nothing is written to the status stream
+ * @then the stream is finished after the status is sent
  */
-TEST_F(CommandServiceTransportGrpcTest, StatusStreamEmpty) {
-  grpc::ServerContext context;
+TEST_F(CommandServiceTransportGrpcTest, StatusStreamOnFinalStatus) {
   iroha::protocol::TxStatusRequest request;
 
-  EXPECT_CALL(*command_service, getStatusStream(_))
-      .WillOnce(Return(rxcpp::observable<>::empty<std::shared_ptr<
-                           shared_model::interface::TransactionResponse>>()));
+  shared_model::crypto::Hash hash("1");
+  std::shared_ptr<shared_model::interface::TransactionResponse> response =
+      status_factory->makeCommitted(hash, {});
+  EXPECT_CALL(*command_service, getInitialStatus(_))
+      .WillOnce(Return(response));
+
+  auto responses = readStatusStream(request);
 
-  ASSERT_TRUE(transport_grpc->StatusStream(&context, &request, nullptr).ok());
+  ASSERT_EQ(1, responses.size());
+  ASSERT_EQ(iroha::protocol::TxStatus::COMMITTED, responses[0].tx_status());
 }
 
 /**
  * @given torii service with changed timeout, a transaction
  *        and a status stream with one NotRecieved status
  * @when calling StatusStream
- * @then ServerWriter calls Write method
+ *       @and rounds pass without status updates
+ * @then the status is sent
+ *       @and the stream is finished
  */
 TEST_F(CommandServiceTransportGrpcTest, StatusStreamOnNotReceived) {
-  grpc::ServerContext context;
   iroha::protocol::TxStatusRequest request;
-  iroha::MockServerWriter<iroha::protocol::ToriiResponse> response_writer;
 
-  std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
-      responses;
   shared_model::crypto::Hash hash("1");
-  responses.emplace_back(status_factory->makeNotReceived(hash, {}));
-  EXPECT_CALL(*command_service, getStatusStream(_))
-      .WillOnce(Return(rxcpp::observable<>::iterate(responses)));
-  EXPECT_CALL(response_writer,
-              Write(Property(&iroha::protocol::ToriiResponse::tx_hash,
-                             StrEq(hash.hex())),
-                    _))
-      .WillOnce(Return(true));
-
-  ASSERT_TRUE(transport_grpc
-                  ->StatusStream(
-                      &context,
-                      &request,
-                      reinterpret_cast<
-                          grpc::ServerWriter<iroha::protocol::ToriiResponse> *>(
-                          &response_writer))
-                  .ok());
+  std::shared_ptr<shared_model::interface::TransactionResponse> response =
+      status_factory->makeNotReceived(hash, {});
+  EXPECT_CALL(*command_service, getInitialStatus(_))
+      .WillOnce(Return(response));
+
+  auto responses =
+      readStatusStream(request, [this](const auto &) { passRounds(); });
+
+  ASSERT_EQ(1, responses.size());
+  ASSERT_EQ(hash.hex(), responses[0].tx_hash());
+}
+
+/**
+ * @given torii service and a status stream of a transaction
+ * @when statuses of the transaction and of another one are published
+ * @then only statuses of the transaction are sent to the stream
+ *       @and the stream is finished after the final status
+ */
+TEST_F(CommandServiceTransportGrpcTest, StatusStreamOfTransaction) {
+  using iroha::protocol::TxStatus;
+  shared_model::crypto::Hash hash("1"), other_hash("2");
+  iroha::protocol::TxStatusRequest request;
+  request.set_tx_hash(hash.hex());
+  std::shared_ptr<shared_model::interface::TransactionResponse> response =
+      status_factory->makeNotReceived(hash, {});
+  EXPECT_CALL(*command_service, getInitialStatus(hash))
+      .WillOnce(Return(response));
+
+  auto publish = [this](auto response) {
+    statuses.get_subscriber().on_next(std::move(response));
+  };
+  auto responses = readStatusStream(request, [&](const auto &response) {
+    switch (response.tx_status()) {
+      case TxStatus::NOT_RECEIVED:
+        publish(status_factory->makeCommitted(other_hash, {}));
+        publish(status_factory->makeStatelessValid(hash, {}));
+        break;
+      case TxStatus::STATELESS_VALIDATION_SUCCESS:
+        publish(status_factory->makeCommitted(hash, {}));
+        break;
+      default:
+        break;
+    }
+  });
+
+  ASSERT_EQ(3, responses.size());
+  ASSERT_EQ(TxStatus::NOT_RECEIVED, responses[0].tx_status());
+  ASSERT_EQ(TxStatus::STATELESS_VALIDATION_SUCCESS, responses[1].tx_status());
+  ASSERT_EQ(TxStatus::COMMITTED, responses[2].tx_status());
+}
+
+/**
+ * @given torii service and a status stream of a transaction
+ * @when the final status is published while the initial status is being read
+ * @then both statuses are sent to the stream
+ *       @and the stream is finished after the final status
+ */
+TEST_F(CommandServiceTransportGrpcTest, StatusStreamStatusDuringInitialRead) {
+  using iroha::protocol::TxStatus;
+  shared_model::crypto::Hash hash("1");
+  iroha::protocol::TxStatusRequest request;
+  request.set_tx_hash(hash.hex());
+  EXPECT_CALL(*command_service, getInitialStatus(hash))
+      .WillOnce(Invoke([this, &hash](const auto &) {
+        statuses.get_subscriber().on_next(
+            status_factory->makeCommitted(hash, {}));
+        return status_factory->makeStatelessValid(hash, {});
+      }));
+
+  auto responses = readStatusStream(request);
+
+  ASSERT_EQ(2, responses.size());
+  ASSERT_EQ(TxStatus::STATELESS_VALIDATION_SUCCESS, responses[0].tx_status());
+  ASSERT_EQ(TxStatus::COMMITTED, responses[1].tx_status());
 }
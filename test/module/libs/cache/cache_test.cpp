@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "cache/cache.hpp"
 #include "endpoint.pb.h"
 
@@ -13,6 +15,20 @@ using namespace iroha::protocol;
 
 const int typicalInsertAmount = 5;
 
+using ResponseCache = Cache<std::string, ToriiResponse>;
+using StringCache = Cache<std::string, std::string>;
+
+/**
+ * @return options of a cache with the given capacity and a single shard
+ */
+template <typename CacheType>
+typename CacheType::Options singleShard(size_t max_items) {
+  typename CacheType::Options options;
+  options.max_items = max_items;
+  options.shards = 1;
+  return options;
+}
+
 /**
  * @given initialized cache
  * @when insert N ToriiResponse objects into it
@@ -30,23 +46,40 @@ TEST(CacheTest, InsertValues) {
 }
 
 /**
- * @given initialized cache
- * @when insert cache.getIndexSizeHigh() items into it + 1
- * @then after the last insertion amount of items should decrease to
- * cache.getIndexSizeLow()
+ * @given initialized cache with a single shard
+ * @when insert cache.getMaxItemCount() items into it + 1
+ * @then after the last insertion amount of items stays
+ * cache.getMaxItemCount(), and one item is evicted
  */
 TEST(CacheTest, InsertMoreThanLimit) {
-  Cache<std::string, ToriiResponse> cache;
-  for (uint32_t i = 0; i < cache.getIndexSizeHigh(); ++i) {
+  ResponseCache cache(singleShard<ResponseCache>(typicalInsertAmount));
+  for (size_t i = 0; i < cache.getMaxItemCount(); ++i) {
     ToriiResponse response;
     response.set_tx_status(TxStatus::STATEFUL_VALIDATION_FAILED);
     cache.addItem("abcdefg" + std::to_string(i), response);
   }
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeHigh());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getMaxItemCount());
   ToriiResponse resp;
   resp.set_tx_status(TxStatus::COMMITTED);
   cache.addItem("1234", resp);
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeLow());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getMaxItemCount());
+  ASSERT_EQ(cache.getStatistics().evictions, 1);
+}
+
+/**
+ * @given initialized cache with several shards
+ * @when insert more items than cache.getMaxItemCount()
+ * @then amount of items in cache never exceeds cache.getMaxItemCount()
+ */
+TEST(CacheTest, ShardedInsertMoreThanLimit) {
+  Cache<std::string, std::string> cache(100);
+  for (int i = 0; i < 1000; ++i) {
+    cache.addItem(std::to_string(i), "value");
+    ASSERT_LE(cache.getCacheItemCount(), cache.getMaxItemCount());
+  }
+  auto statistics = cache.getStatistics();
+  ASSERT_EQ(statistics.items, cache.getCacheItemCount());
+  ASSERT_EQ(statistics.items + statistics.evictions, 1000);
 }
 
 /**
@@ -102,18 +135,18 @@ TEST(CacheTest, FindInEmptyCache) {
 }
 
 /**
- * @given Initialized cache
- * @when insert cache.getIndexSizeHigh() items into it + 1
+ * @given Initialized cache with a single shard
+ * @when insert cache.getMaxItemCount() items into it + 1
  * @then the oldest inserted item was in cache initially but not in cache
  * anymore
  */
 TEST(CacheTest, FindVeryOldTransaction) {
-  Cache<std::string, ToriiResponse> cache;
+  ResponseCache cache(singleShard<ResponseCache>(typicalInsertAmount));
   ToriiResponse resp;
   resp.set_tx_status(TxStatus::COMMITTED);
   cache.addItem("0", resp);
   ASSERT_EQ(cache.findItem("0")->tx_status(), TxStatus::COMMITTED);
-  for (uint32_t i = 0; i < cache.getIndexSizeHigh(); ++i) {
+  for (size_t i = 0; i < cache.getMaxItemCount(); ++i) {
     ToriiResponse response;
     response.set_tx_status(TxStatus::STATEFUL_VALIDATION_FAILED);
     cache.addItem("abcdefg" + std::to_string(i), response);
@@ -121,6 +154,102 @@ TEST(CacheTest, FindVeryOldTransaction) {
   ASSERT_EQ(cache.findItem("0"), boost::none);
 }
 
+/**
+ * @given Initialized full cache with a single shard
+ * @when the oldest item is looked up, and a new item is inserted
+ * @then the least recently used item is evicted instead of the oldest one
+ */
+TEST(CacheTest, EvictLeastRecentlyUsed) {
+  StringCache cache(singleShard<StringCache>(2));
+  cache.addItem("key1", "value1");
+  cache.addItem("key2", "value2");
+  ASSERT_TRUE(cache.findItem("key1"));
+  cache.addItem("key3", "value3");
+  ASSERT_TRUE(cache.findItem("key1"));
+  ASSERT_FALSE(cache.findItem("key2"));
+  ASSERT_TRUE(cache.findItem("key3"));
+}
+
+/**
+ * @given Initialized cache with capacity limited in bytes
+ * @when items with total size exceeding the capacity are inserted
+ * @then the least recently used items are evicted to fit the capacity
+ * @and an item larger than the capacity is not cached
+ */
+TEST(CacheTest, InsertMoreThanByteLimit) {
+  auto options = singleShard<StringCache>(10);
+  options.max_bytes = 10;
+  options.item_size = [](const std::string &key, const std::string &value) {
+    return key.size() + value.size();
+  };
+  StringCache cache(options);
+  cache.addItem("a", "1234");
+  cache.addItem("b", "1234");
+  ASSERT_EQ(cache.getStatistics().bytes, 10);
+  cache.addItem("c", "12");
+  ASSERT_FALSE(cache.findItem("a"));
+  ASSERT_TRUE(cache.findItem("b"));
+  ASSERT_TRUE(cache.findItem("c"));
+  ASSERT_EQ(cache.getStatistics().bytes, 8);
+  cache.addItem("d", "1234567890");
+  ASSERT_FALSE(cache.findItem("d"));
+  ASSERT_LE(cache.getStatistics().bytes, cache.getMaxByteSize());
+}
+
+/**
+ * @given cache options with capacity limited in bytes
+ * @when the cache is created without a size function of items
+ * @then the creation fails
+ */
+TEST(CacheTest, ByteLimitRequiresItemSize) {
+  StringCache::Options options;
+  options.max_bytes = 10;
+  ASSERT_THROW(StringCache cache(options), std::invalid_argument);
+}
+
+/**
+ * @given Initialized cache
+ * @when items are looked up
+ * @then found items are counted as hits, absent items are counted as misses
+ */
+TEST(CacheTest, CountHitsAndMisses) {
+  Cache<std::string, std::string> cache;
+  cache.addItem("key", "value");
+  ASSERT_TRUE(cache.findItem("key"));
+  ASSERT_TRUE(cache.findItem("key"));
+  ASSERT_FALSE(cache.findItem("key2"));
+  auto statistics = cache.getStatistics();
+  ASSERT_EQ(statistics.hits, 2);
+  ASSERT_EQ(statistics.misses, 1);
+  ASSERT_EQ(statistics.evictions, 0);
+}
+
+/**
+ * @given Initialized cache
+ * @when items are inserted and looked up from several threads
+ * @then all of the inserted items are found
+ */
+TEST(CacheTest, ConcurrentAccess) {
+  const int kThreads = 4, kItems = 1000;
+  Cache<std::string, int> cache(kThreads * kItems);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&cache, t] {
+      for (int i = 0; i < kItems; ++i) {
+        auto key = std::to_string(t * kItems + i);
+        cache.addItem(key, i);
+        ASSERT_EQ(cache.findItem(key).value_or(-1), i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto statistics = cache.getStatistics();
+  ASSERT_EQ(statistics.hits + statistics.misses, kThreads * kItems);
+  ASSERT_LE(statistics.items, cache.getMaxItemCount());
+}
+
 /// Custom key type for the test
 struct Key {
   std::string info;
@@ -161,19 +290,18 @@ TEST(CacheTest, CustomHasher) {
 
 /**
  * @given initialized cache with given parameters
- * @when insert cache.getIndexSizeHigh() items into it + 1
- * @then after the last insertion amount of items should decrease to
- * cache.getIndexSizeLow()
+ * @when insert cache.getMaxItemCount() items into it + 1
+ * @then after the last insertion the first item is evicted
  */
 TEST(CacheTest, InsertCustomSize) {
-  Cache<std::string, std::string> cache(1, 1);
+  Cache<std::string, std::string> cache(1);
   cache.addItem("key", "value");
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeHigh());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getMaxItemCount());
   auto val = cache.findItem("key");
   ASSERT_TRUE(val);
   ASSERT_EQ(val.value(), "value");
   cache.addItem("key2", "value2");
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeLow());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getMaxItemCount());
   val = cache.findItem("key");
   ASSERT_FALSE(val);
   ASSERT_TRUE(cache.findItem("key2"));
@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/bounded_queue.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <boost/optional/optional_io.hpp>
+
+using iroha::BoundedQueue;
+
+/**
+ * @given queue with pushed items
+ * @when items are popped
+ * @then they are returned in the order of pushing
+ */
+TEST(BoundedQueueTest, Fifo) {
+  BoundedQueue<int> queue(3);
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.push(2));
+  ASSERT_EQ(queue.pop(), 1);
+  ASSERT_EQ(queue.pop(), 2);
+}
+
+/**
+ * @given closed queue with an item
+ * @when an item is pushed @and items are popped
+ * @then push fails @and the remaining item is returned before boost::none
+ */
+TEST(BoundedQueueTest, Close) {
+  BoundedQueue<int> queue(3);
+  ASSERT_TRUE(queue.push(1));
+  queue.close();
+  ASSERT_FALSE(queue.push(2));
+  ASSERT_EQ(queue.pop(), 1);
+  ASSERT_EQ(queue.pop(), boost::none);
+}
+
+/**
+ * @given queue of capacity 2
+ * @when a producer thread pushes more items than the capacity
+ * @then the consumer receives all of them in order
+ */
+TEST(BoundedQueueTest, ProducerConsumer) {
+  constexpr int kItems = 1000;
+  BoundedQueue<int> queue(2);
+  std::thread producer([&queue] {
+    for (int i = 0; i < kItems; ++i) {
+      queue.push(i);
+    }
+    queue.close();
+  });
+
+  int expected = 0;
+  while (auto item = queue.pop()) {
+    ASSERT_EQ(*item, expected++);
+  }
+  producer.join();
+  ASSERT_EQ(expected, kItems);
+}
+
+/**
+ * @given full queue and a producer waiting for a free slot
+ * @when the queue is closed
+ * @then the producer is released and its push fails
+ */
+TEST(BoundedQueueTest, CloseReleasesProducer) {
+  BoundedQueue<int> queue(1);
+  ASSERT_TRUE(queue.push(1));
+  bool pushed = true;
+  std::thread producer([&] { pushed = queue.push(2); });
+  queue.close();
+  producer.join();
+  ASSERT_FALSE(pushed);
+}
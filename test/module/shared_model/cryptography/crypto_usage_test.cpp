@@ -194,3 +194,29 @@ TEST_F(CryptoUsageTest, SignAndVerifyTransactionkWithWrongSignature) {
 
   ASSERT_FALSE(verify(*transaction));
 }
+
+/**
+ * @given data signed with a keypair, which signature is verified
+ * @when a byte of the signature is moved to the end of the public key, and
+ * the malformed signature is verified
+ * @then verification does not succeed
+ */
+TEST_F(CryptoUsageTest, MalformedSignatureOfVerifiedData) {
+  auto signed_blob = DefaultCryptoAlgorithmType::sign(data, keypair);
+  ASSERT_TRUE(
+      CryptoVerifier<>::verify(signed_blob, data, keypair.publicKey()));
+
+  auto public_key = keypair.publicKey().blob();
+  auto signature = signed_blob.blob();
+  public_key.push_back(signature.back());
+  signature.pop_back();
+
+  bool verified = false;
+  try {
+    verified = CryptoVerifier<>::verify(
+        Signed(signature), data, PublicKey(Blob(public_key)));
+  } catch (const std::exception &) {
+    // malformed key and signature may be rejected with an exception
+  }
+  ASSERT_FALSE(verified);
+}
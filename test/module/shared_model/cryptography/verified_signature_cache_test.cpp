@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cryptography/ed25519_sha3_impl/verified_signature_cache.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+using shared_model::crypto::VerifiedSignatureCache;
+
+/**
+ * @given cache with an inserted signature
+ * @when the same and different signatures are looked up
+ * @then only the inserted one is found
+ */
+TEST(VerifiedSignatureCacheTest, Contains) {
+  VerifiedSignatureCache cache;
+  auto key = VerifiedSignatureCache::makeKey("hash", "key", "signature");
+  cache.insert(key);
+
+  ASSERT_TRUE(cache.contains(key));
+  ASSERT_FALSE(cache.contains(
+      VerifiedSignatureCache::makeKey("hash", "key", "other signature")));
+  ASSERT_FALSE(cache.contains(
+      VerifiedSignatureCache::makeKey("other hash", "key", "signature")));
+}
+
+/**
+ * @given cache with an inserted signature
+ * @when a byte of the signature is moved to the end of the public key
+ * @then the resulting entry is not found
+ */
+TEST(VerifiedSignatureCacheTest, BytesMovedBetweenParts) {
+  VerifiedSignatureCache cache;
+  cache.insert(VerifiedSignatureCache::makeKey("hash", "key", "signature"));
+
+  ASSERT_FALSE(cache.contains(
+      VerifiedSignatureCache::makeKey("hash", "keys", "ignature")));
+  ASSERT_FALSE(cache.contains(
+      VerifiedSignatureCache::makeKey("hashk", "ey", "signature")));
+}
+
+/**
+ * @given cache of a small capacity
+ * @when more signatures than the capacity are inserted
+ * @then the number of kept signatures does not exceed the capacity @and the
+ * last inserted signature is kept
+ */
+TEST(VerifiedSignatureCacheTest, Bounded) {
+  constexpr size_t kCapacity = 32;
+  VerifiedSignatureCache cache(kCapacity);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 10 * kCapacity; ++i) {
+    keys.push_back(
+        VerifiedSignatureCache::makeKey(std::to_string(i), "key", "signature"));
+    cache.insert(keys.back());
+  }
+
+  auto kept = std::count_if(keys.begin(), keys.end(), [&cache](auto &key) {
+    return cache.contains(key);
+  });
+  ASSERT_LE(kept, kCapacity);
+  ASSERT_TRUE(cache.contains(keys.back()));
+}
+
+/**
+ * @given full shard of the cache
+ * @when the oldest signature is looked up, and a new one is inserted
+ * @then the least recently used signature is evicted instead of the oldest
+ */
+TEST(VerifiedSignatureCacheTest, EvictLeastRecentlyUsed) {
+  // each of 16 shards holds two signatures
+  VerifiedSignatureCache cache(32);
+  auto shard = [](const std::string &key) {
+    return std::hash<std::string>{}(key) % 16;
+  };
+  // signatures of the same shard
+  std::vector<std::string> keys;
+  for (size_t i = 0; keys.size() < 3; ++i) {
+    auto key =
+        VerifiedSignatureCache::makeKey(std::to_string(i), "key", "signature");
+    if (keys.empty() or shard(key) == shard(keys.front())) {
+      keys.push_back(key);
+    }
+  }
+
+  cache.insert(keys[0]);
+  cache.insert(keys[1]);
+  ASSERT_TRUE(cache.contains(keys[0]));
+  cache.insert(keys[2]);
+
+  ASSERT_TRUE(cache.contains(keys[0]));
+  ASSERT_FALSE(cache.contains(keys[1]));
+  ASSERT_TRUE(cache.contains(keys[2]));
+}
@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
 #include "framework/batch_helper.hpp"
 #include "module/shared_model/builders/protobuf/test_proposal_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
@@ -47,3 +49,51 @@ TEST_F(ProposalValidatorTest, IncompleteBatch) {
   auto answer = validator_.validate(*proposal);
   ASSERT_TRUE(answer);
 }
+
+/**
+ * @given a proposal with many signed transactions, two of which have wrong
+ * signatures
+ * @when the proposal is validated
+ * @then exactly these two transactions are reported in the proposal order
+ */
+TEST_F(ProposalValidatorTest, WrongSignaturesReportedInOrder) {
+  using shared_model::crypto::DefaultCryptoAlgorithmType;
+  auto keypair = DefaultCryptoAlgorithmType::generateKeypair();
+  const auto created_time = iroha::time::now();
+  constexpr size_t kTransactions = 32;
+  const size_t kFirstWrong = 3, kSecondWrong = 17;
+
+  std::vector<shared_model::proto::Transaction> txs;
+  for (size_t i = 0; i < kTransactions; ++i) {
+    auto tx = TestTransactionBuilder()
+                  .creatorAccountId("a@domain")
+                  .createdTime(created_time - i)
+                  .setAccountQuorum("a@domain", 1)
+                  .build();
+    // signature of some other data is well-formed, but does not match
+    const auto &signed_blob =
+        (i == kFirstWrong or i == kSecondWrong) ? tx.blob() : tx.payload();
+    tx.addSignature(DefaultCryptoAlgorithmType::sign(signed_blob, keypair),
+                    keypair.publicKey());
+    txs.push_back(std::move(tx));
+  }
+  auto proposal = TestProposalBuilder()
+                      .height(1)
+                      .createdTime(created_time)
+                      .transactions(txs)
+                      .build();
+
+  auto reason = validator_.validate(proposal).reason();
+  auto first = reason.find(txs[kFirstWrong].hash().hex());
+  auto second = reason.find(txs[kSecondWrong].hash().hex());
+  ASSERT_NE(first, std::string::npos) << reason;
+  ASSERT_NE(second, std::string::npos) << reason;
+  ASSERT_LT(first, second);
+
+  size_t wrong_signatures = 0;
+  for (auto pos = reason.find("Wrong signature"); pos != std::string::npos;
+       pos = reason.find("Wrong signature", pos + 1)) {
+    ++wrong_signatures;
+  }
+  ASSERT_EQ(wrong_signatures, 2);
+}
@@ -226,10 +226,12 @@ DROP TABLE IF EXISTS domain;
 DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
+DROP TABLE IF EXISTS height_by_block_hash;
 DROP TABLE IF EXISTS position_by_hash;
 DROP TABLE IF EXISTS height_by_account_set;
 DROP TABLE IF EXISTS index_by_creator_height;
 DROP TABLE IF EXISTS position_by_account_asset;
+DROP SCHEMA IF EXISTS wsv_snapshot CASCADE;
 )";
 
     soci::session sql(*soci::factory_postgresql(), pgopts_);